@@ -0,0 +1,351 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures the worst case decoding cost of the protocol stacks under pathological
+// input: garbage floods, streams of maximum size frames, endless invalid IDs and
+// frames claiming huge lengths which then stall. The input is fed in chunks into the
+// stream consumer, which retries one byte further on every protocol error. Every
+// scenario is run over the growing input sizes and the cost per input byte is
+// compared, the growth beyond the threshold is reported as super-linear behaviour.
+// The scenarios built of the large frames are also run over the growing frame
+// (and claimed) lengths with the same input size, the growth of the cost per byte
+// with the frame length is reported the same way.
+// Usage: marshalling_adversarial_bench [input_size] [growth_threshold]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/marshalling/types/string.hpp>
+#include <nil/network/marshalling/message.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+#include <nil/network/marshalling/protocol/checksum/basic_sum.hpp>
+#include <nil/network/marshalling/protocol/checksum_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/sync_prefix_layer.hpp>
+
+namespace {
+
+    enum bench_msg_id : std::uint8_t { bench_msg_id_order = 1, bench_msg_id_bulk, bench_msg_id_unknown = 0xee };
+
+    using bench_msg_base
+        = nil::marshalling::message<nil::marshalling::option::msg_id_type<bench_msg_id>,
+                                    nil::marshalling::option::big_endian, nil::marshalling::option::id_info_interface,
+                                    nil::marshalling::option::read_iterator<const std::uint8_t *>,
+                                    nil::marshalling::option::write_iterator<std::uint8_t *>,
+                                    nil::marshalling::option::length_info_interface>;
+
+    using bench_field = bench_msg_base::field_type;
+
+    using order_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>>;
+
+    template<bench_msg_id TId>
+    class order_msg
+        : public nil::marshalling::message_base<bench_msg_base, nil::marshalling::option::static_num_id_impl<TId>,
+                                                nil::marshalling::option::fields_impl<order_fields>,
+                                                nil::marshalling::option::msg_type<order_msg<TId>>> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(timestamp, instrument, price, size);
+    };
+
+    using bulk_fields = std::tuple<nil::marshalling::types::string<
+        bench_field, nil::marshalling::option::sequence_size_field_prefix<
+                         nil::marshalling::types::integral<bench_field, std::uint16_t>>>>;
+
+    class bulk : public nil::marshalling::message_base<
+                     bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_bulk>,
+                     nil::marshalling::option::fields_impl<bulk_fields>, nil::marshalling::option::msg_type<bulk>> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(contents);
+    };
+
+    using order = order_msg<bench_msg_id_order>;
+
+    // Not part of the supported messages, written to produce the frames with invalid ID.
+    using unknown = order_msg<bench_msg_id_unknown>;
+
+    using bench_messages = std::tuple<order, bulk>;
+
+    using sync_field = nil::marshalling::types::integral<bench_field, std::uint16_t,
+                                                         nil::marshalling::option::default_num_value<0xabcd>>;
+    using size_field = nil::marshalling::types::integral<bench_field, std::uint16_t>;
+    using id_field
+        = nil::marshalling::types::enumeration<bench_field, bench_msg_id, nil::marshalling::option::fixed_length<1>>;
+    using checksum_field = nil::marshalling::types::integral<bench_field, std::uint16_t>;
+
+    using id_stack = nil::marshalling::protocol::msg_id_layer<id_field, bench_msg_base, bench_messages,
+                                                              nil::marshalling::protocol::msg_data_layer<>>;
+
+    using size_id_stack = nil::marshalling::protocol::msg_size_layer<size_field, id_stack>;
+
+    using sync_size_id_stack = nil::marshalling::protocol::sync_prefix_layer<sync_field, size_id_stack>;
+
+    using sync_checksum_stack = nil::marshalling::protocol::sync_prefix_layer<
+        sync_field, nil::marshalling::protocol::checksum_layer<
+                        checksum_field, nil::marshalling::protocol::checksum::basic_sum<std::uint16_t>, size_id_stack>>;
+
+    // Largest contents of the bulk message fitting into the 16 bit size field.
+    const std::size_t max_bulk_length = 0xffffU - 3U;
+
+    // Contents lengths of the bulk message for the frame length sweep, from 256 bytes
+    // up to 64 KiB (limited by max_bulk_length).
+    const std::size_t sweep_bulk_lengths[] = {256U, 1024U, 4096U, 16384U, 65536U};
+
+    struct scenario_result {
+        std::uint64_t frames = 0U;
+        std::uint64_t errors = 0U;
+        std::uint64_t reads = 0U;
+        double seconds = 0.0;
+    };
+
+    // Typical stream consumer: accumulates the incoming chunks, decodes the
+    // frames from the front, waits for more data on not_enough_data and
+    // drops a single byte on any other error. When hinted, the reported missing
+    // length is used to skip the decoding attempts until enough data arrives.
+    template<typename TStack>
+    scenario_result consume(const std::vector<std::uint8_t> &input, std::size_t chunkSize, bool hinted) {
+        TStack stack;
+        scenario_result result;
+        std::vector<std::uint8_t> buf;
+        buf.reserve(std::max<std::size_t>(chunkSize * 2U, 0x20000U));
+        std::size_t offset = 0U;
+        std::size_t required = 0U;
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t pos = 0U; pos < input.size(); pos += chunkSize) {
+            auto len = std::min(chunkSize, input.size() - pos);
+            buf.insert(buf.end(), input.begin() + static_cast<std::ptrdiff_t>(pos),
+                       input.begin() + static_cast<std::ptrdiff_t>(pos + len));
+
+            while (offset < buf.size()) {
+                auto available = buf.size() - offset;
+                if (available < required) {
+                    break;
+                }
+
+                typename TStack::msg_ptr_type msg;
+                const std::uint8_t *iter = buf.data() + offset;
+                std::size_t missing = 0U;
+                ++result.reads;
+                auto es = stack.read(msg, iter, available, &missing);
+                if (es == nil::marshalling::status_type::not_enough_data) {
+                    required = hinted ? (available + std::max<std::size_t>(missing, 1U)) : 0U;
+                    break;
+                }
+
+                required = 0U;
+                if (es == nil::marshalling::status_type::success) {
+                    ++result.frames;
+                    offset = static_cast<std::size_t>(iter - buf.data());
+                    continue;
+                }
+
+                ++result.errors;
+                ++offset;
+            }
+
+            if ((buf.size() / 2U) < offset) {
+                buf.erase(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(offset));
+                offset = 0U;
+            }
+        }
+
+        result.seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+                  .count();
+        return result;
+    }
+
+    std::uint32_t next_random(std::uint32_t &state) {
+        state = state * 1103515245U + 12345U;
+        return state >> 8U;
+    }
+
+    template<typename TStack, typename TMsg>
+    void append_frame(std::vector<std::uint8_t> &out, const TMsg &msg) {
+        TStack stack;
+        auto len = stack.length(msg);
+        auto offset = out.size();
+        out.resize(offset + len);
+        auto *iter = out.data() + offset;
+        stack.write(msg, iter, len);
+        out.resize(static_cast<std::size_t>(iter - out.data()));
+    }
+
+    struct scenario {
+        const char *name;
+        std::size_t chunk_size;
+        bool frame_length_sweep;
+    };
+
+    const scenario scenarios[] = {
+        {"garbage", 4096U, false},
+        {"max_size_frames", 4096U, true},
+        {"invalid_ids", 4096U, false},
+        {"stalled_length", 64U, true},
+    };
+
+    template<typename TStack>
+    std::vector<std::uint8_t> generate(std::size_t scenarioIdx, std::size_t size, std::size_t bulkLength) {
+        std::vector<std::uint8_t> out;
+        out.reserve(size + 0x10000U);
+        std::uint32_t state = 12345U;
+        if (scenarioIdx == 0U) {
+            while (out.size() < size) {
+                out.push_back(static_cast<std::uint8_t>(next_random(state)));
+            }
+            out.resize(size);
+            return out;
+        }
+
+        if (scenarioIdx == 2U) {
+            while (out.size() < size) {
+                unknown msg;
+                msg.field_timestamp().value() = next_random(state);
+                append_frame<TStack>(out, msg);
+            }
+            out.resize(size);
+            return out;
+        }
+
+        std::vector<std::uint8_t> frame;
+        bulk msg;
+        msg.field_contents().value().assign(std::min(bulkLength, max_bulk_length), 'x');
+        append_frame<TStack>(frame, msg);
+        if (scenarioIdx == 3U) {
+            // The header claims the whole frame, but only its beginning arrives.
+            frame.resize(32U);
+        }
+
+        while (out.size() < size) {
+            out.insert(out.end(), frame.begin(), frame.end());
+        }
+        out.resize(size);
+        return out;
+    }
+
+    // Runs the scenario and reports the cost per input byte.
+    template<typename TStack>
+    double run(const char *stackName, std::size_t scenarioIdx, bool hinted, std::size_t size,
+               std::size_t bulkLength) {
+        auto &info = scenarios[scenarioIdx];
+        auto input = generate<TStack>(scenarioIdx, size, bulkLength);
+        auto result = consume<TStack>(input, info.chunk_size, hinted);
+        auto cost = (result.seconds * 1.0e9) / static_cast<double>(input.size());
+        std::cout << stackName << " " << info.name << (hinted ? " hinted" : " naive") << " " << input.size()
+                  << " bytes";
+        if (info.frame_length_sweep) {
+            std::cout << " (bulk " << std::min(bulkLength, max_bulk_length) << ")";
+        }
+
+        std::cout << ": " << std::fixed << std::setprecision(3) << cost << " ns/byte, reads/byte="
+                  << (static_cast<double>(result.reads) / static_cast<double>(input.size()))
+                  << ", frames=" << result.frames << ", errors=" << result.errors << std::endl;
+        return cost;
+    }
+
+    bool check_growth(const char *stackName, std::size_t scenarioIdx, bool hinted, double firstCost,
+                      double lastCost, double threshold, const char *over) {
+        if ((firstCost <= 0.0) || (lastCost <= (threshold * firstCost))) {
+            return false;
+        }
+
+        std::cout << "SUPER-LINEAR: " << stackName << " " << scenarios[scenarioIdx].name
+                  << (hinted ? " hinted" : " naive") << " cost per byte grew " << (lastCost / firstCost) << "x over "
+                  << over << std::endl;
+        return true;
+    }
+
+    template<typename TStack>
+    bool measure(const char *stackName, std::size_t baseSize, double threshold) {
+        static const std::size_t sweepCount = sizeof(sweep_bulk_lengths) / sizeof(sweep_bulk_lengths[0]);
+        bool superLinear = false;
+        for (std::size_t scenarioIdx = 0U; scenarioIdx < (sizeof(scenarios) / sizeof(scenarios[0])); ++scenarioIdx) {
+            for (auto hinted : {false, true}) {
+                double firstCost = 0.0;
+                double lastCost = 0.0;
+                for (std::size_t scale = 1U; scale <= 4U; scale *= 2U) {
+                    lastCost = run<TStack>(stackName, scenarioIdx, hinted, baseSize * scale, max_bulk_length);
+                    if (scale == 1U) {
+                        firstCost = lastCost;
+                    }
+                }
+
+                superLinear = check_growth(stackName, scenarioIdx, hinted, firstCost, lastCost, threshold, "4x input")
+                              || superLinear;
+
+                if (!scenarios[scenarioIdx].frame_length_sweep) {
+                    continue;
+                }
+
+                for (std::size_t idx = 0U; idx < sweepCount; ++idx) {
+                    lastCost = run<TStack>(stackName, scenarioIdx, hinted, baseSize, sweep_bulk_lengths[idx]);
+                    if (idx == 0U) {
+                        firstCost = lastCost;
+                    }
+                }
+
+                superLinear = check_growth(stackName, scenarioIdx, hinted, firstCost, lastCost, threshold,
+                                           "256 B to 64 KiB frames")
+                              || superLinear;
+            }
+        }
+
+        return superLinear;
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t size = 1024U * 1024U;
+    double threshold = 1.5;
+    if (1 < argc) {
+        size = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        threshold = std::strtod(argv[2], nullptr);
+    }
+
+    bool superLinear = false;
+    superLinear = measure<size_id_stack>("size_id", size, threshold) || superLinear;
+    superLinear = measure<sync_size_id_stack>("sync_size_id", size, threshold) || superLinear;
+    superLinear = measure<sync_checksum_stack>("sync_checksum", size, threshold) || superLinear;
+    return superLinear ? 1 : 0;
+}
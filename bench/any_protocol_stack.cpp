@@ -0,0 +1,196 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Compares the read and write throughput of the type erased protocol stack
+// with the concrete one it wraps.
+// Usage: marshalling_any_protocol_stack_bench [num_of_frames] [num_of_rounds]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/message.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+#include <nil/network/marshalling/protocol/any_protocol_stack.hpp>
+#include <nil/network/marshalling/protocol/checksum/crc.hpp>
+#include <nil/network/marshalling/protocol/checksum_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/sync_prefix_layer.hpp>
+
+namespace {
+
+    enum bench_msg_id : std::uint8_t { bench_msg_id_quote = 1, bench_msg_id_cancel };
+
+    using bench_msg_base
+        = nil::marshalling::message<nil::marshalling::option::msg_id_type<bench_msg_id>,
+                                    nil::marshalling::option::big_endian, nil::marshalling::option::id_info_interface,
+                                    nil::marshalling::option::read_iterator<const std::uint8_t *>,
+                                    nil::marshalling::option::write_iterator<std::uint8_t *>,
+                                    nil::marshalling::option::length_info_interface>;
+
+    using bench_field = bench_msg_base::field_type;
+
+    using quote_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>>;
+
+    class quote : public nil::marshalling::message_base<
+                      bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_quote>,
+                      nil::marshalling::option::fields_impl<quote_fields>, nil::marshalling::option::msg_type<quote>> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(timestamp, instrument, bid_price, bid_size, ask_price, ask_size);
+    };
+
+    using cancel_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                     nil::marshalling::types::integral<bench_field, std::uint64_t>>;
+
+    class cancel : public nil::marshalling::message_base<
+                       bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_cancel>,
+                       nil::marshalling::option::fields_impl<cancel_fields>, nil::marshalling::option::msg_type<cancel>> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(timestamp, order_id);
+    };
+
+    using bench_stack = nil::marshalling::protocol::sync_prefix_layer<
+        nil::marshalling::types::integral<bench_field, std::uint16_t,
+                                          nil::marshalling::option::default_num_value<0xabcd>>,
+        nil::marshalling::protocol::checksum_layer<
+            nil::marshalling::types::integral<bench_field, std::uint16_t>,
+            nil::marshalling::protocol::checksum::crc_ccitt,
+            nil::marshalling::protocol::msg_size_layer<
+                nil::marshalling::types::integral<bench_field, std::uint16_t>,
+                nil::marshalling::protocol::msg_id_layer<
+                    nil::marshalling::types::enumeration<bench_field, bench_msg_id,
+                                                         nil::marshalling::option::fixed_length<1>>,
+                    bench_msg_base, std::tuple<quote, cancel>, nil::marshalling::protocol::msg_data_layer<>,
+                    nil::marshalling::option::in_place_allocation>>>>;
+
+    using any_stack = nil::marshalling::protocol::any_protocol_stack<bench_msg_base, bench_stack::msg_ptr_type>;
+
+    template<typename TStack>
+    double measure_read(TStack &stack, const std::vector<std::uint8_t> &data, std::size_t rounds,
+                        std::uint64_t &sink) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            const std::uint8_t *iter = data.data();
+            const std::uint8_t *end = iter + data.size();
+            while (iter < end) {
+                typename TStack::msg_ptr_type msg;
+                auto es = stack.read(msg, iter, static_cast<std::size_t>(end - iter));
+                if (es != nil::marshalling::status_type::success) {
+                    std::cerr << "Unexpected read failure" << std::endl;
+                    return 0.0;
+                }
+                sink += static_cast<std::uint64_t>(msg->get_id());
+            }
+        }
+
+        return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    template<typename TStack>
+    double measure_write(TStack &stack, const std::vector<quote> &msgs, std::vector<std::uint8_t> &out,
+                         std::size_t rounds) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            std::uint8_t *iter = out.data();
+            for (auto &msg : msgs) {
+                auto es = stack.write(msg, iter, out.size() - static_cast<std::size_t>(iter - out.data()));
+                if (es != nil::marshalling::status_type::success) {
+                    std::cerr << "Unexpected write failure" << std::endl;
+                    return 0.0;
+                }
+            }
+        }
+
+        return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    void report(const char *name, double concrete, double erased, std::size_t frames) {
+        auto overhead = ((erased - concrete) * 100.0) / concrete;
+        std::cout << name << ": concrete=" << (concrete * 1.0e9 / static_cast<double>(frames))
+                  << " ns/frame, erased=" << (erased * 1.0e9 / static_cast<double>(frames))
+                  << " ns/frame, overhead=" << overhead << "%" << (overhead < 5.0 ? "" : " (above 5%)") << std::endl;
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t frames = 10000U;
+    std::size_t rounds = 200U;
+    if (1 < argc) {
+        frames = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        rounds = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    bench_stack concrete;
+    std::vector<quote> msgs(frames);
+    for (std::size_t idx = 0U; idx < frames; ++idx) {
+        msgs[idx].field_timestamp().value() = idx;
+        msgs[idx].field_instrument().value() = static_cast<std::uint32_t>(idx % 512U);
+        msgs[idx].field_bid_price().value() = static_cast<std::int64_t>(idx * 3U);
+        msgs[idx].field_ask_price().value() = static_cast<std::int64_t>(idx * 3U + 1U);
+    }
+
+    std::vector<std::uint8_t> data(frames * concrete.length(msgs[0]));
+    auto *writeIter = data.data();
+    for (auto &msg : msgs) {
+        concrete.write(msg, writeIter, data.size() - static_cast<std::size_t>(writeIter - data.data()));
+    }
+
+    any_stack erased = nil::marshalling::protocol::make_any_protocol_stack<bench_msg_base, bench_stack>();
+    std::uint64_t sink = 0U;
+    std::vector<std::uint8_t> out(data.size());
+
+    // Warm up both paths before the timed runs.
+    measure_read(concrete, data, 1U, sink);
+    measure_read(erased, data, 1U, sink);
+
+    auto concreteRead = measure_read(concrete, data, rounds, sink);
+    auto erasedRead = measure_read(erased, data, rounds, sink);
+    auto concreteWrite = measure_write(concrete, msgs, out, rounds);
+    auto erasedWrite = measure_write(erased, msgs, out, rounds);
+
+    report("read", concreteRead, erasedRead, frames * rounds);
+    report("write", concreteWrite, erasedWrite, frames * rounds);
+    std::cout << "(" << sink << ")" << std::endl;
+    return 0;
+}
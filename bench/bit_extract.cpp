@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures bulk extraction / deposit of 20 members packed into 64 bit status word.
+// Build with BMI2 support (marshalling_bit_extract_bmi2_bench) to compare PEXT/PDEP path.
+// Usage: marshalling_bit_extract_bench [num_of_words] [num_of_rounds]
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <nil/network/marshalling/bit_extract.hpp>
+
+namespace {
+
+    using status_layout
+        = nil::marshalling::bitfield_layout<1, 1, 2, 3, 1, 1, 1, 4, 1, 1, 8, 2, 1, 1, 5, 3, 1, 1, 6, 12>;
+
+    using lane_type = status_layout::lane_type;
+
+    using lanes_type = std::array<lane_type, status_layout::members_count>;
+
+    std::vector<std::uint64_t> generate_words(std::size_t count) {
+        std::vector<std::uint64_t> words(count);
+        std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+        for (auto &w : words) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            w = state;
+        }
+        return words;
+    }
+
+    template<typename TFunc>
+    void measure(const char *name, std::size_t operations, TFunc &&func) {
+        auto start = std::chrono::steady_clock::now();
+        auto checksum = func();
+        auto seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+                  .count();
+        std::cout << name << ": " << (seconds * 1e9 / static_cast<double>(operations)) << " ns/word, "
+                  << (static_cast<double>(operations) / seconds / 1e6) << " Mwords/s (checksum " << checksum << ")"
+                  << std::endl;
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t count = 1U << 16U;
+    std::size_t rounds = 200U;
+    if (1 < argc) {
+        count = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        rounds = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    auto words = generate_words(count);
+    std::vector<lanes_type> lanes(count);
+    auto operations = count * rounds;
+
+    std::cout << "members: " << status_layout::members_count << ", lane bytes: " << sizeof(lane_type)
+              << ", bmi2: " << (status_layout::uses_bmi2() ? "yes" : "no") << std::endl;
+
+    measure("extract_each", operations, [&]() {
+        std::uint64_t sum = 0U;
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            for (std::size_t idx = 0U; idx < count; ++idx) {
+                status_layout::extract_each(words[idx], &lanes[idx][0]);
+            }
+            sum += lanes[r % count][r % status_layout::members_count];
+        }
+        return sum;
+    });
+
+    measure("extract", operations, [&]() {
+        std::uint64_t sum = 0U;
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            for (std::size_t idx = 0U; idx < count; ++idx) {
+                status_layout::extract(words[idx], &lanes[idx][0]);
+            }
+            sum += lanes[r % count][r % status_layout::members_count];
+        }
+        return sum;
+    });
+
+    measure("deposit_each", operations, [&]() {
+        std::uint64_t sum = 0U;
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            for (std::size_t idx = 0U; idx < count; ++idx) {
+                sum += status_layout::deposit_each(&lanes[idx][0]);
+            }
+        }
+        return sum;
+    });
+
+    measure("deposit", operations, [&]() {
+        std::uint64_t sum = 0U;
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            for (std::size_t idx = 0U; idx < count; ++idx) {
+                sum += status_layout::deposit(&lanes[idx][0]);
+            }
+        }
+        return sum;
+    });
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures (de)serialisation of 4 KiB big endian arrays of arithmetic values:
+// element by element conversion, scalar byte swap and bulk vectorised byte swap.
+// Build with SSSE3/AVX2 support (marshalling_bulk_swap_ssse3_bench,
+// marshalling_bulk_swap_avx2_bench) to compare the shuffle based paths.
+// Usage: marshalling_bulk_swap_bench [array_bytes] [num_of_rounds]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nil/network/marshalling/bulk_swap.hpp>
+
+namespace {
+
+    using big_endian = nil::marshalling::endian::big_endian;
+
+    std::vector<std::uint8_t> generate_bytes(std::size_t count) {
+        std::vector<std::uint8_t> bytes(count);
+        std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+        for (auto &b : bytes) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            b = static_cast<std::uint8_t>(state >> 56U);
+        }
+        return bytes;
+    }
+
+    // Mirrors the generic iterator path: every element is assembled byte by byte.
+    template<typename T>
+    void read_each(T *out, const std::uint8_t *in, std::size_t count) {
+        using uint_type = typename std::conditional<
+            sizeof(T) == 2U, std::uint16_t,
+            typename std::conditional<sizeof(T) == 4U, std::uint32_t, std::uint64_t>::type>::type;
+
+        for (std::size_t idx = 0U; idx < count; ++idx) {
+            uint_type value = 0U;
+            for (std::size_t byteIdx = 0U; byteIdx < sizeof(T); ++byteIdx) {
+                value = static_cast<uint_type>((value << 8U) | *in);
+                ++in;
+            }
+            std::memcpy(&out[idx], &value, sizeof(T));
+        }
+    }
+
+    template<typename TFunc>
+    void measure(const std::string &name, std::size_t bytes, std::size_t rounds, TFunc &&func) {
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t checksum = 0U;
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            checksum += func();
+        }
+        auto seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+                  .count();
+        auto total = static_cast<double>(bytes) * static_cast<double>(rounds);
+        std::cout << name << ": " << (seconds * 1e9 / static_cast<double>(rounds)) << " ns/array, "
+                  << (total / seconds / 1e9) << " GB/s (checksum " << checksum << ")" << std::endl;
+    }
+
+    template<typename T>
+    void run(const char *typeName, const std::vector<std::uint8_t> &input, std::size_t rounds) {
+        auto count = input.size() / sizeof(T);
+        auto bytes = count * sizeof(T);
+        std::vector<T> values(count);
+        std::vector<std::uint8_t> output(bytes);
+        auto sample = [&values, count]() -> std::uint64_t {
+            std::uint64_t result = 0U;
+            std::memcpy(&result, &values[count / 2U], sizeof(T) < sizeof(result) ? sizeof(T) : sizeof(result));
+            return result;
+        };
+
+        std::string prefix(typeName);
+        measure(prefix + " read_each", bytes, rounds, [&]() {
+            read_each(&values[0], input.data(), count);
+            return sample();
+        });
+
+        measure(prefix + " read_scalar", bytes, rounds, [&]() {
+            nil::marshalling::detail::bulk_swap::swap_scalar<sizeof(T)>(
+                reinterpret_cast<std::uint8_t *>(&values[0]), input.data(), count);
+            return sample();
+        });
+
+        measure(prefix + " read_bulk", bytes, rounds, [&]() {
+            nil::marshalling::bulk_read_values<big_endian>(&values[0], input.data(), count);
+            return sample();
+        });
+
+        measure(prefix + " write_bulk", bytes, rounds, [&]() {
+            nil::marshalling::bulk_write_values<big_endian>(output.data(), &values[0], count);
+            return static_cast<std::uint64_t>(output[bytes / 2U]);
+        });
+
+        if (std::memcmp(output.data(), input.data(), bytes) != 0) {
+            std::cerr << prefix << ": round trip mismatch" << std::endl;
+            std::exit(1);
+        }
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t bytes = 4096U;
+    std::size_t rounds = 1000000U;
+    if (1 < argc) {
+        bytes = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        rounds = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    auto input = generate_bytes(bytes);
+    std::cout << "array bytes: " << bytes << ", simd: " << (nil::marshalling::bulk_swap_uses_simd() ? "yes" : "no")
+              << ", avx2: " << (MARSHALLING_HAS_AVX2 != 0 ? "yes" : "no") << std::endl;
+
+    run<std::uint16_t>("uint16", input, rounds);
+    run<std::int32_t>("int32", input, rounds);
+    run<float>("float", input, rounds);
+    run<double>("double", input, rounds);
+    return 0;
+}
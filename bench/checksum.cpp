@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures throughput of the checksum calculators over contiguous buffers.
+// Usage: marshalling_checksum_bench [buffer_size] [num_of_rounds]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <nil/network/marshalling/protocol/checksum/adler.hpp>
+#include <nil/network/marshalling/protocol/checksum/basic_sum.hpp>
+#include <nil/network/marshalling/protocol/checksum/crc.hpp>
+#include <nil/network/marshalling/protocol/checksum/fletcher.hpp>
+#include <nil/network/marshalling/protocol/checksum/xxhash.hpp>
+
+namespace {
+
+    namespace checksum = nil::marshalling::protocol::checksum;
+
+    template<typename TCalc>
+    void measure(const char *name, const std::vector<std::uint8_t> &data, std::size_t rounds) {
+        std::uint64_t sink = 0U;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            auto iter = data.data();
+            sink += TCalc()(iter, data.size());
+        }
+
+        auto seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+                  .count();
+        std::cout << name << ": " << (static_cast<double>(data.size() * rounds) / seconds / (1024.0 * 1024.0))
+                  << " MiB/s (" << std::hex << sink << std::dec << ")" << std::endl;
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t size = 64U * 1024U;
+    std::size_t rounds = 20000U;
+    if (1 < argc) {
+        size = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        rounds = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    std::vector<std::uint8_t> data(size);
+    std::uint32_t state = 1U;
+    for (auto &byte : data) {
+        state = state * 1103515245U + 12345U;
+        byte = static_cast<std::uint8_t>(state >> 24U);
+    }
+
+    measure<checksum::basic_sum<std::uint32_t>>("basic_sum<uint32_t>", data, rounds);
+    measure<checksum::fletcher16>("fletcher16", data, rounds);
+    measure<checksum::fletcher32>("fletcher32", data, rounds);
+    measure<checksum::adler32>("adler32", data, rounds);
+    measure<checksum::xxhash32<>>("xxhash32", data, rounds);
+    measure<checksum::xxhash64<>>("xxhash64", data, rounds);
+    measure<checksum::crc_32>("crc_32", data, rounds / 16U);
+    return 0;
+}
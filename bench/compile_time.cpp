@@ -0,0 +1,241 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures the build time and peak compiler memory of the translation units
+// using the protocol stack, message factory and generic handler with the large
+// synthetic message sets. For every message count three source files are
+// generated and compiled:
+//   full - reads the frames using the implicitly instantiated stack,
+//   extern - the same, but the stack instantiation is declared extern,
+//   instantiation - the single source file with the explicit instantiation.
+// Usage: marshalling_compile_time_bench [work_dir] [message_counts...]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef MARSHALLING_COMPILE_TIME_CXX
+#define MARSHALLING_COMPILE_TIME_CXX "c++"
+#endif
+
+#ifndef MARSHALLING_COMPILE_TIME_FLAGS
+#define MARSHALLING_COMPILE_TIME_FLAGS ""
+#endif
+
+namespace {
+
+    const char *const field_sets[] = {
+        "std::tuple<nil::marshalling::types::integral<synth_field, std::uint32_t>,"
+        " nil::marshalling::types::integral<synth_field, std::uint16_t>>",
+        "std::tuple<nil::marshalling::types::integral<synth_field, std::uint64_t>,"
+        " nil::marshalling::types::integral<synth_field, std::int32_t>,"
+        " nil::marshalling::types::integral<synth_field, std::uint8_t>>",
+        "std::tuple<nil::marshalling::types::integral<synth_field, std::int64_t>,"
+        " nil::marshalling::types::integral<synth_field, std::int64_t>,"
+        " nil::marshalling::types::integral<synth_field, std::uint32_t>,"
+        " nil::marshalling::types::integral<synth_field, std::uint32_t>>",
+    };
+
+    void generate_header(const std::string &path, std::size_t count) {
+        std::ofstream out(path);
+        out << "#include <cstdint>\n"
+               "#include <tuple>\n\n"
+               "#include <nil/marshalling/types/integral.hpp>\n"
+               "#include <nil/network/marshalling/generic_handler.hpp>\n"
+               "#include <nil/network/marshalling/instantiation.hpp>\n"
+               "#include <nil/network/marshalling/message.hpp>\n"
+               "#include <nil/network/marshalling/message_base.hpp>\n"
+               "#include <nil/network/marshalling/protocol/msg_data_layer.hpp>\n"
+               "#include <nil/network/marshalling/protocol/msg_id_layer.hpp>\n"
+               "#include <nil/network/marshalling/protocol/msg_size_layer.hpp>\n\n"
+               "class synth_handler;\n\n"
+               "using synth_base = nil::marshalling::message<\n"
+               "    nil::marshalling::option::msg_id_type<std::uint16_t>, nil::marshalling::option::big_endian,\n"
+               "    nil::marshalling::option::id_info_interface,\n"
+               "    nil::marshalling::option::read_iterator<const std::uint8_t *>,\n"
+               "    nil::marshalling::option::write_iterator<std::uint8_t *>,\n"
+               "    nil::marshalling::option::length_info_interface,\n"
+               "    nil::marshalling::option::handler<synth_handler>>;\n\n"
+               "using synth_field = synth_base::field_type;\n\n";
+
+        for (std::size_t idx = 0U; idx < count; ++idx) {
+            out << "class synth_msg_" << idx << " : public nil::marshalling::message_base<synth_base,\n"
+                << "    nil::marshalling::option::static_num_id_impl<" << (idx + 1U) << ">,\n"
+                << "    nil::marshalling::option::fields_impl<"
+                << field_sets[idx % (sizeof(field_sets) / sizeof(field_sets[0]))] << ">,\n"
+                << "    nil::marshalling::option::msg_type<synth_msg_" << idx << ">> { };\n\n";
+        }
+
+        out << "using synth_messages = std::tuple<\n";
+        for (std::size_t idx = 0U; idx < count; ++idx) {
+            out << "    synth_msg_" << idx << (((idx + 1U) < count) ? ",\n" : ">;\n\n");
+        }
+
+        out << "class synth_handler : public nil::marshalling::generic_handler<synth_base, synth_messages> { };\n\n"
+               "using synth_stack = nil::marshalling::protocol::msg_size_layer<\n"
+               "    nil::marshalling::types::integral<synth_field, std::uint16_t>,\n"
+               "    nil::marshalling::protocol::msg_id_layer<nil::marshalling::types::integral<synth_field, "
+               "std::uint16_t>,\n"
+               "        synth_base, synth_messages, nil::marshalling::protocol::msg_data_layer<>>>;\n\n"
+               "#ifdef SYNTH_EXTERN\n"
+               "MARSHALLING_EXTERN_PROTOCOL_STACK(synth_stack);\n"
+               "#endif\n";
+    }
+
+    void generate_sources(const std::string &dir) {
+        std::ofstream consumer(dir + "/consumer.cpp");
+        consumer << "#include \"synth.hpp\"\n\n"
+                    "std::size_t consume(const std::uint8_t *data, std::size_t len) {\n"
+                    "    synth_stack stack;\n"
+                    "    synth_handler handler;\n"
+                    "    std::size_t count = 0U;\n"
+                    "    while (0U < len) {\n"
+                    "        synth_stack::msg_ptr_type msg;\n"
+                    "        auto iter = data;\n"
+                    "        auto es = nil::marshalling::stack_instantiation<synth_stack>::read(\n"
+                    "            stack, msg, iter, len);\n"
+                    "        if (es != nil::marshalling::status_type::success) {\n"
+                    "            break;\n"
+                    "        }\n"
+                    "        msg->dispatch(handler);\n"
+                    "        len -= static_cast<std::size_t>(iter - data);\n"
+                    "        data = iter;\n"
+                    "        ++count;\n"
+                    "    }\n"
+                    "    return count;\n"
+                    "}\n";
+
+        std::ofstream instantiation(dir + "/instantiation.cpp");
+        instantiation << "#include \"synth.hpp\"\n\n"
+                         "MARSHALLING_INSTANTIATE_PROTOCOL_STACK(synth_stack);\n";
+    }
+
+    struct compile_result {
+        bool success = false;
+        double seconds = 0.0;
+        double max_rss_mib = 0.0;
+    };
+
+    compile_result compile(const std::string &dir, const std::string &source, bool externStack) {
+        std::vector<std::string> args = {MARSHALLING_COMPILE_TIME_CXX, "-std=c++17", "-O2", "-c",
+                                         dir + "/" + source, "-o", dir + "/" + source + ".o"};
+        if (MARSHALLING_COMPILE_TIME_FLAGS[0] != '\0') {
+            args.push_back(std::string("@") + MARSHALLING_COMPILE_TIME_FLAGS);
+        }
+
+        if (externStack) {
+            args.push_back("-DSYNTH_EXTERN");
+        }
+
+        std::vector<char *> argv;
+        for (auto &arg : args) {
+            argv.push_back(&arg[0]);
+        }
+        argv.push_back(nullptr);
+
+        compile_result result;
+        auto start = std::chrono::steady_clock::now();
+        auto pid = ::fork();
+        if (pid == 0) {
+            ::execvp(argv[0], argv.data());
+            ::_exit(127);
+        }
+
+        if (pid < 0) {
+            return result;
+        }
+
+        int status = 0;
+        struct rusage usage = {};
+        if (::wait4(pid, &status, 0, &usage) != pid) {
+            return result;
+        }
+
+        result.seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+                  .count();
+        result.max_rss_mib = static_cast<double>(usage.ru_maxrss) / 1024.0;
+        result.success = WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+        return result;
+    }
+
+    void report(std::size_t count, const char *mode, const compile_result &result) {
+        std::cout << count << " messages, " << mode << ": ";
+        if (!result.success) {
+            std::cout << "compilation failed" << std::endl;
+            return;
+        }
+
+        std::cout << result.seconds << " s, " << result.max_rss_mib << " MiB" << std::endl;
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::string dir = "compile_time_bench";
+    std::vector<std::size_t> counts;
+    if (1 < argc) {
+        dir = argv[1];
+    }
+
+    for (int idx = 2; idx < argc; ++idx) {
+        counts.push_back(static_cast<std::size_t>(std::strtoull(argv[idx], nullptr, 10)));
+    }
+
+    if (counts.empty()) {
+        counts = {50U, 200U, 1000U};
+    }
+
+    std::cout << "compiler: " << MARSHALLING_COMPILE_TIME_CXX << std::endl;
+    bool failed = false;
+    for (auto count : counts) {
+        auto countDir = dir + "/" + std::to_string(count);
+        ::mkdir(dir.c_str(), 0755);
+        ::mkdir(countDir.c_str(), 0755);
+        generate_header(countDir + "/synth.hpp", count);
+        generate_sources(countDir);
+
+        auto full = compile(countDir, "consumer.cpp", false);
+        auto externOnly = compile(countDir, "consumer.cpp", true);
+        auto instantiation = compile(countDir, "instantiation.cpp", false);
+        report(count, "full", full);
+        report(count, "extern", externOnly);
+        report(count, "instantiation", instantiation);
+        failed = failed || (!full.success) || (!externOnly.success) || (!instantiation.success);
+    }
+
+    return failed ? 1 : 0;
+}
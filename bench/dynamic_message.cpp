@@ -0,0 +1,168 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Compares decoding of the statically defined message with the dynamic message
+// having the same layout defined by the runtime schema.
+// Usage: marshalling_dynamic_message_bench [num_of_frames] [num_of_rounds]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/dynamic_message.hpp>
+#include <nil/network/marshalling/message.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+
+namespace {
+
+    enum bench_msg_id : std::uint8_t { bench_msg_id_quote = 1, bench_msg_id_partner_quote = 100 };
+
+    using bench_msg_base
+        = nil::marshalling::message<nil::marshalling::option::msg_id_type<bench_msg_id>,
+                                    nil::marshalling::option::big_endian, nil::marshalling::option::id_info_interface,
+                                    nil::marshalling::option::read_iterator<const std::uint8_t *>,
+                                    nil::marshalling::option::write_iterator<std::uint8_t *>,
+                                    nil::marshalling::option::length_info_interface>;
+
+    using bench_field = bench_msg_base::field_type;
+
+    using quote_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint16_t>>;
+
+    class quote : public nil::marshalling::message_base<
+                      bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_quote>,
+                      nil::marshalling::option::fields_impl<quote_fields>, nil::marshalling::option::msg_type<quote>> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(timestamp, instrument, bid_price, bid_size, ask_price, ask_size, flags);
+    };
+
+    const char *const partner_schema = "message 100 partner_quote\n"
+                                       "    u64 timestamp\n"
+                                       "    u32 instrument\n"
+                                       "    i64 bid_price\n"
+                                       "    u32 bid_size\n"
+                                       "    i64 ask_price\n"
+                                       "    u32 ask_size\n"
+                                       "    u16 flags\n"
+                                       "end\n";
+
+    using dynamic_msg = nil::marshalling::dynamic_message<bench_msg_base>;
+
+    using bench_stack = nil::marshalling::protocol::msg_size_layer<
+        nil::marshalling::types::integral<bench_field, std::uint16_t>,
+        nil::marshalling::protocol::msg_id_layer<
+            nil::marshalling::types::enumeration<bench_field, bench_msg_id, nil::marshalling::option::fixed_length<1>>,
+            bench_msg_base, std::tuple<quote>, nil::marshalling::protocol::msg_data_layer<>,
+            nil::marshalling::option::support_generic_message<dynamic_msg>>>;
+
+    double measure(const std::vector<std::uint8_t> &data, std::size_t rounds, std::uint64_t &sink) {
+        bench_stack stack;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            const std::uint8_t *iter = data.data();
+            const std::uint8_t *end = iter + data.size();
+            while (iter < end) {
+                bench_stack::msg_ptr_type msg;
+                auto es = stack.read(msg, iter, static_cast<std::size_t>(end - iter));
+                if (es != nil::marshalling::status_type::success) {
+                    std::cerr << "Unexpected read failure" << std::endl;
+                    return 0.0;
+                }
+                sink += static_cast<std::uint64_t>(msg->get_id());
+            }
+        }
+
+        return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t frames = 10000U;
+    std::size_t rounds = 200U;
+    if (1 < argc) {
+        frames = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        rounds = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    nil::marshalling::dynamic_schema_set schemas;
+    std::istringstream schemaStream(partner_schema);
+    if (!schemas.load(schemaStream)) {
+        std::cerr << "Invalid schema at line " << schemas.error_line() << std::endl;
+        return -1;
+    }
+    dynamic_msg::set_schemas(&schemas);
+
+    bench_stack stack;
+    quote msg;
+    auto frameLen = stack.length(msg);
+    std::vector<std::uint8_t> staticData(frames * frameLen);
+    auto *writeIter = staticData.data();
+    for (std::size_t idx = 0U; idx < frames; ++idx) {
+        msg.field_timestamp().value() = idx;
+        msg.field_instrument().value() = static_cast<std::uint32_t>(idx % 512U);
+        msg.field_bid_price().value() = static_cast<std::int64_t>(idx * 3U);
+        msg.field_ask_price().value() = static_cast<std::int64_t>(idx * 3U + 1U);
+        stack.write(msg, writeIter, frameLen);
+    }
+
+    // The same frames with the ID known only to the runtime schema, located after 2 bytes of size.
+    auto dynamicData = staticData;
+    for (std::size_t idx = 0U; idx < frames; ++idx) {
+        dynamicData[(idx * frameLen) + 2U] = bench_msg_id_partner_quote;
+    }
+
+    std::uint64_t sink = 0U;
+    measure(staticData, 1U, sink);
+    measure(dynamicData, 1U, sink);
+
+    auto staticTime = measure(staticData, rounds, sink);
+    auto dynamicTime = measure(dynamicData, rounds, sink);
+    auto total = static_cast<double>(frames * rounds);
+    auto ratio = dynamicTime / staticTime;
+    std::cout << "static: " << (staticTime * 1.0e9 / total) << " ns/frame" << std::endl;
+    std::cout << "dynamic: " << (dynamicTime * 1.0e9 / total) << " ns/frame" << std::endl;
+    std::cout << "ratio: " << ratio << (ratio <= 2.0 ? "" : " (above 2x)") << " (" << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Compares the read throughput of a protocol stack decoding its transport header
+// on every frame with the same stack memoizing it (option::memoized_header), both
+// for frames sharing the same header and for frames with a header changing every time.
+// Usage: marshalling_header_memo_bench [num_of_frames] [num_of_rounds]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/message.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/transport_value_layer.hpp>
+
+namespace {
+
+    enum bench_msg_id : std::uint8_t { bench_msg_id_sample = 1 };
+
+    using bench_field = nil::marshalling::field_type<nil::marshalling::option::big_endian>;
+
+    using mac_field = nil::marshalling::types::integral<bench_field, std::uint64_t,
+                                                        nil::marshalling::option::fixed_length<6>>;
+    using version_field = nil::marshalling::types::integral<bench_field, std::uint16_t>;
+    using flags_field = nil::marshalling::types::integral<bench_field, std::uint32_t>;
+
+    using bench_transport_fields = std::tuple<mac_field, mac_field, version_field, flags_field>;
+
+    class bench_msg_base
+        : public nil::marshalling::message<
+              nil::marshalling::option::msg_id_type<bench_msg_id>, nil::marshalling::option::big_endian,
+              nil::marshalling::option::id_info_interface,
+              nil::marshalling::option::read_iterator<const std::uint8_t *>,
+              nil::marshalling::option::write_iterator<std::uint8_t *>,
+              nil::marshalling::option::length_info_interface,
+              nil::marshalling::option::extra_transport_fields<bench_transport_fields>> {
+        using Base = nil::marshalling::message<
+            nil::marshalling::option::msg_id_type<bench_msg_id>, nil::marshalling::option::big_endian,
+            nil::marshalling::option::id_info_interface,
+            nil::marshalling::option::read_iterator<const std::uint8_t *>,
+            nil::marshalling::option::write_iterator<std::uint8_t *>,
+            nil::marshalling::option::length_info_interface,
+            nil::marshalling::option::extra_transport_fields<bench_transport_fields>>;
+
+    public:
+        MARSHALLING_MSG_TRANSPORT_FIELDS_ACCESS(dst, src, version, flags);
+    };
+
+    using sample_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                     nil::marshalling::types::integral<bench_field, std::uint32_t>>;
+
+    class sample : public nil::marshalling::message_base<
+                       bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_sample>,
+                       nil::marshalling::option::fields_impl<sample_fields>,
+                       nil::marshalling::option::msg_type<sample>> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(timestamp, value);
+    };
+
+    template<typename... TOptions>
+    using bench_stack = nil::marshalling::protocol::msg_size_layer<
+        nil::marshalling::types::integral<bench_field, std::uint16_t>,
+        nil::marshalling::protocol::transport_value_layer<
+            mac_field, bench_msg_base::TransportFieldIdx_dst,
+            nil::marshalling::protocol::transport_value_layer<
+                mac_field, bench_msg_base::TransportFieldIdx_src,
+                nil::marshalling::protocol::transport_value_layer<
+                    version_field, bench_msg_base::TransportFieldIdx_version,
+                    nil::marshalling::protocol::transport_value_layer<
+                        flags_field, bench_msg_base::TransportFieldIdx_flags,
+                        nil::marshalling::protocol::msg_id_layer<
+                            nil::marshalling::types::enumeration<bench_field, bench_msg_id,
+                                                                 nil::marshalling::option::fixed_length<1>>,
+                            bench_msg_base, std::tuple<sample>, nil::marshalling::protocol::msg_data_layer<>,
+                            nil::marshalling::option::in_place_allocation>>>>,
+            TOptions...>>;
+
+    using plain_stack = bench_stack<>;
+    using memo_stack = bench_stack<nil::marshalling::option::memoized_header>;
+
+    std::vector<std::uint8_t> make_frames(std::size_t frames, bool sameHeader) {
+        plain_stack stack;
+        sample msg;
+        msg.transportField_dst().value() = 0x0a0b0c0d0e0fULL;
+        msg.transportField_src().value() = 0x010203040506ULL;
+        msg.transportField_version().value() = 2U;
+
+        std::vector<std::uint8_t> data(frames * stack.length(msg));
+        auto *iter = data.data();
+        for (std::size_t idx = 0U; idx < frames; ++idx) {
+            msg.transportField_flags().value() = sameHeader ? 0U : static_cast<std::uint32_t>(idx);
+            msg.field_timestamp().value() = idx;
+            msg.field_value().value() = static_cast<std::uint32_t>(idx * 7U);
+            stack.write(msg, iter, data.size() - static_cast<std::size_t>(iter - data.data()));
+        }
+        return data;
+    }
+
+    template<typename TStack>
+    double measure_read(TStack &stack, const std::vector<std::uint8_t> &data, std::size_t rounds,
+                        std::uint64_t &sink) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            const std::uint8_t *iter = data.data();
+            const std::uint8_t *end = iter + data.size();
+            while (iter < end) {
+                typename TStack::msg_ptr_type msg;
+                auto es = stack.read(msg, iter, static_cast<std::size_t>(end - iter));
+                if (es != nil::marshalling::status_type::success) {
+                    std::cerr << "Unexpected read failure" << std::endl;
+                    return 0.0;
+                }
+                sink += msg->transportField_flags().value() + msg->transportField_src().value();
+            }
+        }
+
+        return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    void report(const char *name, double plain, double memoized, std::size_t frames) {
+        std::cout << name << ": plain=" << (plain * 1.0e9 / static_cast<double>(frames))
+                  << " ns/frame, memoized=" << (memoized * 1.0e9 / static_cast<double>(frames))
+                  << " ns/frame, speedup=" << (plain / memoized) << std::endl;
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t frames = 10000U;
+    std::size_t rounds = 200U;
+    if (1 < argc) {
+        frames = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        rounds = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    auto sameData = make_frames(frames, true);
+    auto changingData = make_frames(frames, false);
+
+    plain_stack plain;
+    memo_stack memoized;
+    std::uint64_t sink = 0U;
+
+    // Warm up both paths before the timed runs.
+    measure_read(plain, sameData, 1U, sink);
+    measure_read(memoized, sameData, 1U, sink);
+
+    auto plainSame = measure_read(plain, sameData, rounds, sink);
+    auto memoSame = measure_read(memoized, sameData, rounds, sink);
+    auto plainChanging = measure_read(plain, changingData, rounds, sink);
+    auto memoChanging = measure_read(memoized, changingData, rounds, sink);
+
+    report("same header", plainSame, memoSame, frames * rounds);
+    report("changing header", plainChanging, memoChanging, frames * rounds);
+    std::cout << "(" << sink << ")" << std::endl;
+    return 0;
+}
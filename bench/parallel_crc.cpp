@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures scaling of the parallel CRC-32 calculation of the jumbo frames.
+// Usage: marshalling_parallel_crc_bench [frame_size] [num_of_rounds]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <nil/network/marshalling/protocol/checksum/crc.hpp>
+#include <nil/network/marshalling/protocol/checksum/parallel_crc.hpp>
+
+namespace {
+
+    using serial_crc = nil::marshalling::protocol::checksum::crc_32;
+
+    template<typename TCalc>
+    void measure(const char *name, const std::vector<std::uint8_t> &data, std::size_t rounds,
+                 std::uint32_t expected) {
+        bool valid = true;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0U; r < rounds; ++r) {
+            auto iter = data.data();
+            valid = valid && (TCalc()(iter, data.size()) == expected);
+        }
+
+        auto seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+                  .count();
+        std::cout << name << ": " << (static_cast<double>(data.size() * rounds) / seconds / (1024.0 * 1024.0))
+                  << " MiB/s" << (valid ? "" : " (MISMATCH)") << std::endl;
+    }
+
+    template<std::size_t TThreads>
+    using bench_crc = nil::marshalling::protocol::checksum::parallel_crc<serial_crc, TThreads>;
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t size = 8U * 1024U * 1024U;
+    std::size_t rounds = 20U;
+    if (1 < argc) {
+        size = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (2 < argc) {
+        rounds = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    std::vector<std::uint8_t> data(size);
+    std::uint32_t state = 1U;
+    for (auto &byte : data) {
+        state = state * 1103515245U + 12345U;
+        byte = static_cast<std::uint8_t>(state >> 24U);
+    }
+
+    auto iter = data.data();
+    auto expected = serial_crc()(iter, data.size());
+    std::cout << "frame: " << size << " bytes, rounds: " << rounds << std::endl;
+
+    measure<serial_crc>("serial", data, rounds, expected);
+    measure<bench_crc<1>>("parallel x1", data, rounds, expected);
+    measure<bench_crc<2>>("parallel x2", data, rounds, expected);
+    measure<bench_crc<4>>("parallel x4", data, rounds, expected);
+    measure<bench_crc<8>>("parallel x8", data, rounds, expected);
+    return 0;
+}
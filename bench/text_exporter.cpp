@@ -0,0 +1,202 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures throughput of the text exporters over the synthetic capture.
+// Usage: marshalling_text_exporter_bench [num_of_frames] [chunk_size]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/float_value.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/marshalling/types/string.hpp>
+#include <nil/network/marshalling/message.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/text_exporter.hpp>
+
+namespace {
+
+    enum bench_msg_id : std::uint8_t { bench_msg_id_quote = 1, bench_msg_id_trade };
+
+    using bench_msg_base
+        = nil::marshalling::message<nil::marshalling::option::msg_id_type<bench_msg_id>,
+                                    nil::marshalling::option::big_endian, nil::marshalling::option::id_info_interface,
+                                    nil::marshalling::option::read_iterator<const std::uint8_t *>,
+                                    nil::marshalling::option::write_iterator<std::uint8_t *>,
+                                    nil::marshalling::option::length_info_interface>;
+
+    using bench_field = bench_msg_base::field_type;
+
+    using quote_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>>;
+
+    class quote : public nil::marshalling::message_base<
+                      bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_quote>,
+                      nil::marshalling::option::fields_impl<quote_fields>, nil::marshalling::option::msg_type<quote>,
+                      nil::marshalling::option::has_name> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(timestamp, instrument, bid_price, bid_size, ask_price, ask_size);
+
+        static const char *eval_name() {
+            return "quote";
+        }
+    };
+
+    using trade_fields = std::tuple<
+        nil::marshalling::types::integral<bench_field, std::uint64_t>,
+        nil::marshalling::types::integral<bench_field, std::uint32_t>,
+        nil::marshalling::types::float_value<bench_field, double>,
+        nil::marshalling::types::integral<bench_field, std::uint32_t>,
+        nil::marshalling::types::string<bench_field, nil::marshalling::option::sequence_size_field_prefix<
+                                                         nil::marshalling::types::integral<bench_field, std::uint8_t>>>>;
+
+    class trade : public nil::marshalling::message_base<
+                      bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_trade>,
+                      nil::marshalling::option::fields_impl<trade_fields>, nil::marshalling::option::msg_type<trade>,
+                      nil::marshalling::option::has_name> {
+    public:
+        MARSHALLING_MSG_FIELDS_ACCESS(timestamp, instrument, price, size, venue);
+
+        static const char *eval_name() {
+            return "trade";
+        }
+    };
+
+    using bench_stack = nil::marshalling::protocol::msg_size_layer<
+        nil::marshalling::types::integral<bench_field, std::uint16_t>,
+        nil::marshalling::protocol::msg_id_layer<
+            nil::marshalling::types::enumeration<bench_field, bench_msg_id, nil::marshalling::option::fixed_length<1>>,
+            bench_msg_base, std::tuple<quote, trade>, nil::marshalling::protocol::msg_data_layer<>>>;
+
+    using chunk_type = std::pair<const std::uint8_t *, std::size_t>;
+
+    std::vector<std::uint8_t> generate_capture(std::size_t frames, std::size_t chunkSize, std::vector<chunk_type> &chunks,
+                                               std::vector<std::size_t> &chunkOffsets) {
+        std::vector<std::uint8_t> data(frames * 64U);
+        bench_stack stack;
+        auto *writeIter = data.data();
+        std::size_t chunkBegin = 0U;
+        chunkOffsets.push_back(0U);
+        for (std::size_t idx = 0U; idx < frames; ++idx) {
+            auto frameBegin = static_cast<std::size_t>(writeIter - data.data());
+            if (chunkSize <= (frameBegin - chunkBegin)) {
+                chunkOffsets.push_back(frameBegin);
+                chunkBegin = frameBegin;
+            }
+
+            auto remaining = data.size() - frameBegin;
+            if ((idx % 4U) == 3U) {
+                trade msg;
+                msg.field_timestamp().value() = 1600000000000000000ULL + idx;
+                msg.field_instrument().value() = static_cast<std::uint32_t>(idx % 5000U);
+                msg.field_price().value() = 100.25 + static_cast<double>(idx % 1000U) / 100.0;
+                msg.field_size().value() = static_cast<std::uint32_t>(idx % 10000U);
+                msg.field_venue().value() = "XNAS";
+                stack.write(msg, writeIter, remaining);
+            } else {
+                quote msg;
+                msg.field_timestamp().value() = 1600000000000000000ULL + idx;
+                msg.field_instrument().value() = static_cast<std::uint32_t>(idx % 5000U);
+                msg.field_bid_price().value() = 1000000 + static_cast<std::int64_t>(idx % 777U);
+                msg.field_bid_size().value() = static_cast<std::uint32_t>(idx % 300U);
+                msg.field_ask_price().value() = 1000100 + static_cast<std::int64_t>(idx % 777U);
+                msg.field_ask_size().value() = static_cast<std::uint32_t>(idx % 500U);
+                stack.write(msg, writeIter, remaining);
+            }
+        }
+
+        data.resize(static_cast<std::size_t>(writeIter - data.data()));
+        chunkOffsets.push_back(data.size());
+        for (std::size_t idx = 0U; (idx + 1U) < chunkOffsets.size(); ++idx) {
+            chunks.emplace_back(data.data() + chunkOffsets[idx], chunkOffsets[idx + 1U] - chunkOffsets[idx]);
+        }
+        return data;
+    }
+
+    template<typename TFormat>
+    void run_bench(const char *name, const std::vector<chunk_type> &chunks, std::size_t inputSize) {
+        std::vector<std::size_t> threadCounts = {1U, 2U, 4U, std::max(1U, std::thread::hardware_concurrency())};
+        std::sort(threadCounts.begin(), threadCounts.end());
+        threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+
+        for (auto threads : threadCounts) {
+            nil::marshalling::parallel_text_exporter<bench_stack, TFormat> exporter(threads);
+            exporter.run(chunks);    // warm up, allocates output buffers
+
+            static const std::size_t Rounds = 5U;
+            nil::marshalling::text_export_statistics stats;
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t round = 0U; round < Rounds; ++round) {
+                stats = exporter.run(chunks);
+            }
+            auto elapsed
+                = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start)
+                      .count();
+
+            std::size_t outputSize = 0U;
+            for (std::size_t idx = 0U; idx < chunks.size(); ++idx) {
+                outputSize += exporter.output(idx).size();
+            }
+
+            auto inputGb = static_cast<double>(inputSize * Rounds) / 1e9;
+            auto outputGb = static_cast<double>(outputSize * Rounds) / 1e9;
+            std::cout << name << " threads=" << threads << " messages=" << stats.messages
+                      << " errors=" << stats.errors << " input=" << (inputGb / elapsed) << " GB/s"
+                      << " output=" << (outputGb / elapsed) << " GB/s" << std::endl;
+        }
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    std::size_t frames = (1 < argc) ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 4000000U;
+    std::size_t chunkSize = (2 < argc) ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : 1U << 20U;
+
+    std::vector<chunk_type> chunks;
+    std::vector<std::size_t> chunkOffsets;
+    auto data = generate_capture(frames, chunkSize, chunks, chunkOffsets);
+    std::cout << "input: " << data.size() << " bytes, " << frames << " frames, " << chunks.size() << " chunks"
+              << std::endl;
+
+    run_bench<nil::marshalling::csv_text_format>("csv ", chunks, data.size());
+    run_bench<nil::marshalling::json_text_format>("json", chunks, data.size());
+    return 0;
+}
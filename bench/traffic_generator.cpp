@@ -0,0 +1,231 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Load generator: writes synthetic (or replayed) frames at the target rate
+// into the selected sink and reports the achieved rate and jitter.
+// Usage: marshalling_traffic_generator_bench [rate] [num_of_frames] [null|pipe|socketpair|shm|file|record]
+//            [capture_file]
+// When capture_file is provided, its frames are replayed instead of the synthetic ones.
+// The "file" sink writes the frames into traffic.bin, "record" saves the synthetic
+// frames as capture into traffic.capture for later replay.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/message.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/traffic.hpp>
+
+namespace {
+
+    enum bench_msg_id : std::uint8_t { bench_msg_id_quote = 1, bench_msg_id_trade, bench_msg_id_cancel };
+
+    using bench_msg_base
+        = nil::marshalling::message<nil::marshalling::option::msg_id_type<bench_msg_id>,
+                                    nil::marshalling::option::big_endian, nil::marshalling::option::id_info_interface,
+                                    nil::marshalling::option::read_iterator<const std::uint8_t *>,
+                                    nil::marshalling::option::write_iterator<std::uint8_t *>,
+                                    nil::marshalling::option::length_info_interface>;
+
+    using bench_field = bench_msg_base::field_type;
+
+    using quote_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>>;
+
+    class quote : public nil::marshalling::message_base<
+                      bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_quote>,
+                      nil::marshalling::option::fields_impl<quote_fields>, nil::marshalling::option::msg_type<quote>> {
+    };
+
+    using trade_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>,
+                                    nil::marshalling::types::integral<bench_field, std::int64_t>,
+                                    nil::marshalling::types::integral<bench_field, std::uint32_t>>;
+
+    class trade : public nil::marshalling::message_base<
+                      bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_trade>,
+                      nil::marshalling::option::fields_impl<trade_fields>, nil::marshalling::option::msg_type<trade>> {
+    };
+
+    using cancel_fields = std::tuple<nil::marshalling::types::integral<bench_field, std::uint64_t>>;
+
+    class cancel : public nil::marshalling::message_base<
+                       bench_msg_base, nil::marshalling::option::static_num_id_impl<bench_msg_id_cancel>,
+                       nil::marshalling::option::fields_impl<cancel_fields>,
+                       nil::marshalling::option::msg_type<cancel>> { };
+
+    using all_messages = std::tuple<quote, trade, cancel>;
+
+    using bench_stack = nil::marshalling::protocol::msg_size_layer<
+        nil::marshalling::types::integral<bench_field, std::uint16_t>,
+        nil::marshalling::protocol::msg_id_layer<
+            nil::marshalling::types::enumeration<bench_field, bench_msg_id, nil::marshalling::option::fixed_length<1>>,
+            bench_msg_base, all_messages, nil::marshalling::protocol::msg_data_layer<>>>;
+
+    struct null_sink {
+        bool write(const std::uint8_t *data, std::size_t len) {
+            static_cast<void>(data);
+            static_cast<void>(len);
+            return true;
+        }
+    };
+
+    void print_report(const char *name, const nil::marshalling::traffic_report &report, double rate) {
+        std::cout << name << ": target=" << rate << " fps achieved=" << report.rate << " fps frames=" << report.frames
+                  << " bytes=" << report.bytes << " failures=" << report.failures
+                  << " mean_lateness=" << report.mean_lateness_ns << " ns max_lateness=" << report.max_lateness_ns
+                  << " ns jitter=" << report.jitter_ns << " ns" << std::endl;
+    }
+
+    template<typename TRun>
+    void run_with_fds(const char *name, TRun &&run, bool socketPair) {
+        int fds[2];
+        auto result = socketPair ? ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) : ::pipe(fds);
+        if (result != 0) {
+            std::cerr << name << ": failed to create descriptors" << std::endl;
+            return;
+        }
+
+        std::thread consumer([fd = fds[0]]() {
+            std::uint8_t buf[1U << 16U];
+            while (0 < ::read(fd, buf, sizeof(buf))) {
+            }
+        });
+
+        nil::marshalling::fd_sink sink(fds[1]);
+        run(name, sink);
+        ::close(fds[1]);
+        consumer.join();
+        ::close(fds[0]);
+    }
+
+    template<typename TRun>
+    void run_with_shm(const char *name, TRun &&run) {
+        nil::marshalling::shared_memory_region region("/marshalling_traffic_bench", 1U << 22U, true);
+        if (!region.valid()) {
+            std::cerr << "shared memory is not available" << std::endl;
+            return;
+        }
+
+        auto ring = nil::marshalling::spsc_frame_ring::create(region.data(), region.length());
+        std::atomic<bool> done(false);
+        std::thread consumer([&region, &done]() {
+            auto reader = nil::marshalling::spsc_frame_ring::attach(region.data());
+            auto consume = [](const std::uint8_t *, std::size_t) {};
+            while (reader.try_pop(consume) || (!done.load(std::memory_order_acquire))) {
+            }
+            while (reader.try_pop(consume)) {
+            }
+        });
+
+        nil::marshalling::ring_sink sink(ring);
+        run(name, sink);
+        done.store(true, std::memory_order_release);
+        consumer.join();
+        std::cout << name << ": ring stalls=" << sink.stalls() << std::endl;
+    }
+
+}    // namespace
+
+int main(int argc, const char *argv[]) {
+    double rate = (1 < argc) ? std::strtod(argv[1], nullptr) : 1000000.0;
+    std::size_t frames = (2 < argc) ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : 2000000U;
+    std::string sinkName = (3 < argc) ? argv[3] : "null";
+    std::string captureName = (4 < argc) ? argv[4] : "";
+
+    nil::marshalling::frame_capture capture;
+    bool replay = !captureName.empty();
+    if (replay) {
+        std::ifstream in(captureName, std::ios::binary);
+        if (!capture.load(in)) {
+            std::cerr << "Invalid capture file: " << captureName << std::endl;
+            return -1;
+        }
+    } else {
+        bench_stack stack;
+        nil::marshalling::traffic_random rand;
+        auto es = nil::marshalling::synthesise_frames<all_messages>(stack, capture.frames, 4096U, {8.0, 2.0, 1.0},
+                                                                    rand);
+        if (es != nil::marshalling::status_type::success) {
+            std::cerr << "Failed to synthesise frames" << std::endl;
+            return -1;
+        }
+
+        auto period = (0.0 < rate) ? static_cast<std::uint64_t>(1.0e9 / rate) : 0U;
+        for (std::size_t idx = 0U; idx < capture.frames.size(); ++idx) {
+            capture.times.push_back(idx * period);
+        }
+    }
+
+    auto runner = [&](const char *name, auto &sink) {
+        auto report = replay ? nil::marshalling::traffic_generator::replay(capture, sink) :
+                               nil::marshalling::traffic_generator::run(capture.frames, sink, rate, frames);
+        print_report(name, report, rate);
+    };
+
+    if ((sinkName == "pipe") || (sinkName == "socketpair")) {
+        run_with_fds(sinkName.c_str(), runner, sinkName == "socketpair");
+    } else if (sinkName == "shm") {
+        run_with_shm("shm", runner);
+    } else if (sinkName == "file") {
+        auto fd = ::open("traffic.bin", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::cerr << "Failed to open traffic.bin" << std::endl;
+            return -1;
+        }
+        nil::marshalling::fd_sink sink(fd);
+        runner("file", sink);
+        ::close(fd);
+    } else if (sinkName == "record") {
+        std::ofstream out("traffic.capture", std::ios::binary);
+        capture.save(out);
+        std::cout << "saved " << capture.frames.size() << " frames into traffic.capture" << std::endl;
+    } else {
+        null_sink sink;
+        runner("null", sink);
+    }
+
+    return 0;
+}
@@ -83,6 +83,73 @@ namespace nil {
                     }
                 };
 
+                /// @brief Dynamic memory allocator limited by the in-flight budget.
+                /// @details Similar to @ref dyn_memory, but every allocation is accounted in
+                ///     the global @ref nil::marshalling::msg_memory_budget identified by the
+                ///     @b TBudgetTag. The allocation exceeding the budget fails fast (empty
+                ///     pointer is returned) without invoking operator "new". The budget is
+                ///     released when the object is deleted, or when its construction throws.@n
+                ///     Only the size of the object itself (@b sizeof) is accounted. The heap
+                ///     storage owned by the object, such as the storage of the vector and
+                ///     string fields, is not limited by the budget.
+                /// @tparam TInterface Common interface class for all objects being allocated
+                ///     with this allocator.
+                /// @tparam TBudgetTag Tag of the budget, see
+                ///     @ref nil::marshalling::global_msg_memory_budget().
+                template<typename TInterface, typename TBudgetTag = void>
+                class budgeted_dyn_memory {
+                public:
+                    /// @brief Smart pointer (std::unique_ptr) to the allocated object.
+                    /// @details The custom deleter releases the budget.
+                    using ptr_type = std::unique_ptr<TInterface, detail::budget_deleter<TInterface>>;
+
+                    /// @brief Access the budget.
+                    static msg_memory_budget &budget() {
+                        return global_msg_memory_budget<TBudgetTag>();
+                    }
+
+                    /// @brief Allocation function
+                    /// @tparam TObj Type of the object being allocated, expected to be the
+                    ///     same as or derived from TInterface.
+                    /// @tparam TArgs types of arguments to be passed to the constructor.
+                    /// @return Smart pointer to the allocated object, empty when the budget
+                    ///     is exceeded.
+                    template<typename TObj, typename... TArgs>
+                    static ptr_type alloc(TArgs &&...args) {
+                        static_assert(std::is_base_of<TInterface, TObj>::value,
+                                      "TObj does not inherit from TInterface");
+
+                        static_assert(std::has_virtual_destructor<TInterface>::value
+                                          || std::is_same<TInterface, TObj>::value,
+                                      "TInterface is expected to have virtual destructor");
+
+                        auto &b = budget();
+                        if (!b.acquire(sizeof(TObj))) {
+                            return ptr_type();
+                        }
+
+                        // Releases the budget if operator "new" or the constructor throws
+                        detail::budget_guard guard(b, sizeof(TObj));
+                        auto *obj = new TObj(std::forward<TArgs>(args)...);
+                        guard.dismiss();
+                        return ptr_type(obj, detail::budget_deleter<TInterface>(&b, sizeof(TObj)));
+                    }
+
+                    /// @brief Function used to wrap raw pointer into a smart one
+                    /// @details The object is expected to be previously allocated by this
+                    ///     allocator and released from the smart pointer.
+                    /// @tparam Type of the object, expected to be the
+                    ///     same as or derived from TInterface.
+                    /// @param[in] obj Pointer to previously allocated object.
+                    /// @return Smart pointer to the wrapped object.
+                    template<typename TObj>
+                    static ptr_type wrap(TObj *obj) {
+                        static_assert(std::is_base_of<TInterface, TObj>::value,
+                                      "TObj does not inherit from TInterface");
+                        return ptr_type(obj, detail::budget_deleter<TInterface>(&budget(), sizeof(TObj)));
+                    }
+                };
+
                 /// @brief In-place single object allocator.
                 /// @details May allocate only single object at a time. In order to be able
                 ///     to allocate new object, previous one must be destructed first. The
@@ -0,0 +1,441 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Provides bulk extraction and deposit of the bit members packed into a single
+/// 64 bit word, using BMI2 PEXT/PDEP instructions when available.
+
+#ifndef NETWORK_MARSHALLING_BIT_EXTRACT_HPP
+#define NETWORK_MARSHALLING_BIT_EXTRACT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__BMI2__) && !defined(MARSHALLING_NO_BMI2) && defined(__BYTE_ORDER__) \
+    && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <immintrin.h>
+#define MARSHALLING_HAS_BMI2 1
+#else
+#define MARSHALLING_HAS_BMI2 0
+#endif
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Parallel bits extract (PEXT).
+        /// @details Gathers the bits of @b value selected by @b mask into the low
+        ///     order bits of the result. Uses BMI2 instruction when the code
+        ///     is compiled with its support (e.g. -mbmi2 or -march=native) and
+        ///     @b MARSHALLING_NO_BMI2 is not defined, software emulation otherwise.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        inline std::uint64_t bits_extract(std::uint64_t value, std::uint64_t mask) {
+#if MARSHALLING_HAS_BMI2
+            return static_cast<std::uint64_t>(_pext_u64(value, mask));
+#else
+            std::uint64_t result = 0U;
+            for (std::uint64_t bit = 1U; mask != 0U; bit <<= 1U) {
+                if ((value & mask & (0U - mask)) != 0U) {
+                    result |= bit;
+                }
+                mask &= (mask - 1U);
+            }
+            return result;
+#endif
+        }
+
+        /// @brief Parallel bits deposit (PDEP).
+        /// @details Scatters the low order bits of @b value into the positions
+        ///     selected by @b mask. See @ref bits_extract() for the details of
+        ///     the implementation selection.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        inline std::uint64_t bits_deposit(std::uint64_t value, std::uint64_t mask) {
+#if MARSHALLING_HAS_BMI2
+            return static_cast<std::uint64_t>(_pdep_u64(value, mask));
+#else
+            std::uint64_t result = 0U;
+            for (std::uint64_t bit = 1U; mask != 0U; bit <<= 1U) {
+                if ((value & bit) != 0U) {
+                    result |= (mask & (0U - mask));
+                }
+                mask &= (mask - 1U);
+            }
+            return result;
+#endif
+        }
+
+        /// @brief Description of a single member packed into 64 bit word.
+        /// @tparam TOffset Offset of the least significant bit of the member.
+        /// @tparam TWidth Number of bits the member occupies.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        template<std::size_t TOffset, std::size_t TWidth>
+        struct bit_member {
+            static_assert((0U < TWidth) && ((TOffset + TWidth) <= 64U), "The member must fit into 64 bit word");
+
+            /// @brief Offset of the least significant bit of the member.
+            static const std::size_t offset = TOffset;
+
+            /// @brief Number of bits the member occupies.
+            static const std::size_t width = TWidth;
+
+            /// @brief Mask of the member value, not shifted.
+            static constexpr std::uint64_t value_mask() {
+                return (TWidth == 64U) ? ~std::uint64_t(0U) : ((std::uint64_t(1U) << TWidth) - 1U);
+            }
+
+            /// @brief Mask of the member bits within the word.
+            static constexpr std::uint64_t mask() {
+                return value_mask() << TOffset;
+            }
+        };
+
+        namespace detail {
+            namespace bit_extract {
+
+                template<typename TTuple, std::size_t TIdx>
+                using member_type = typename std::tuple_element<TIdx, TTuple>::type;
+
+                template<typename TTuple, std::size_t TFrom, std::size_t TUntil, bool TEnd = (TUntil <= TFrom)>
+                struct members_info {
+                    using next_type = members_info<TTuple, TFrom + 1U, TUntil>;
+
+                    static constexpr std::uint64_t mask() {
+                        return member_type<TTuple, TFrom>::mask() | next_type::mask();
+                    }
+
+                    static constexpr std::uint64_t lanes_mask(std::size_t laneBits) {
+                        return member_type<TTuple, TFrom>::value_mask()
+                               | ((64U <= laneBits) ? 0U : (next_type::lanes_mask(laneBits) << laneBits));
+                    }
+
+                    static constexpr std::size_t max_width() {
+                        return (next_type::max_width() < member_type<TTuple, TFrom>::width) ?
+                                   member_type<TTuple, TFrom>::width :
+                                   next_type::max_width();
+                    }
+
+                    static constexpr bool ascending(std::size_t minOffset) {
+                        return (minOffset <= member_type<TTuple, TFrom>::offset)
+                               && next_type::ascending(member_type<TTuple, TFrom>::offset
+                                                       + member_type<TTuple, TFrom>::width);
+                    }
+                };
+
+                template<typename TTuple, std::size_t TFrom, std::size_t TUntil>
+                struct members_info<TTuple, TFrom, TUntil, true> {
+                    static constexpr std::uint64_t mask() {
+                        return 0U;
+                    }
+
+                    static constexpr std::uint64_t lanes_mask(std::size_t) {
+                        return 0U;
+                    }
+
+                    static constexpr std::size_t max_width() {
+                        return 0U;
+                    }
+
+                    static constexpr bool ascending(std::size_t) {
+                        return true;
+                    }
+                };
+
+                template<std::size_t TMaxWidth>
+                using lane_type = typename std::conditional<
+                    (TMaxWidth <= 8U), std::uint8_t,
+                    typename std::conditional<
+                        (TMaxWidth <= 16U), std::uint16_t,
+                        typename std::conditional<(TMaxWidth <= 32U), std::uint32_t, std::uint64_t>::type>::type>::
+                    type;
+
+            }    // namespace bit_extract
+        }        // namespace detail
+
+        /// @brief Layout of the bit members packed into single 64 bit word.
+        /// @details Provides compile time generated masks and bulk extraction /
+        ///     deposit of all the members in one step. Every member is extracted
+        ///     into its own "lane" - unsigned integral value of the smallest type
+        ///     capable of holding the widest member. When BMI2 instructions are
+        ///     available, the members are processed in groups of lanes fitting
+        ///     into 64 bits (8 members for up to 8 bits wide ones): PEXT gathers
+        ///     the bits of the whole group, PDEP scatters them into the lanes,
+        ///     which are then stored at once. Otherwise every member is shifted
+        ///     and masked individually using compile time constants.@n
+        ///     Suitable for the value of nil::marshalling::types::bitmask_value
+        ///     as well as serialized value of nil::marshalling::types::bitfield
+        ///     members. See also @ref bitfield_layout and @ref bitmask_layout.@n
+        ///     @b NOTE, that some processors (AMD prior to Zen3) implement
+        ///     PEXT/PDEP in microcode, define @b MARSHALLING_NO_BMI2 to force
+        ///     portable implementation for such targets.
+        /// @tparam TMembers Variadic list of @ref bit_member types, sorted by offset
+        ///     and non overlapping.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        template<typename... TMembers>
+        class bit_members_layout {
+            using members_tuple_type = std::tuple<TMembers...>;
+            using all_info_type = detail::bit_extract::members_info<members_tuple_type, 0U, sizeof...(TMembers)>;
+
+            static_assert(0U < sizeof...(TMembers), "At least one member is expected");
+            static_assert(all_info_type::ascending(0U), "The members must be sorted and must not overlap");
+
+        public:
+            /// @brief Type of the value holding single extracted member.
+            using lane_type = detail::bit_extract::lane_type<all_info_type::max_width()>;
+
+            /// @brief Number of the members.
+            static const std::size_t members_count = sizeof...(TMembers);
+
+            /// @brief Number of the lanes processed in single step.
+            static const std::size_t lanes_per_group = sizeof(std::uint64_t) / sizeof(lane_type);
+
+            /// @brief Number of bits in single lane.
+            static const std::size_t lane_bits = sizeof(lane_type) * 8U;
+
+            /// @brief Number of the processed groups.
+            static const std::size_t groups_count = (members_count + lanes_per_group - 1U) / lanes_per_group;
+
+            /// @brief Type of the member with provided index.
+            template<std::size_t TIdx>
+            using member_type = typename std::tuple_element<TIdx, members_tuple_type>::type;
+
+            /// @brief Check whether BMI2 instructions are used.
+            static constexpr bool uses_bmi2() {
+                return MARSHALLING_HAS_BMI2 != 0;
+            }
+
+            /// @brief Mask of all the members within the word.
+            static constexpr std::uint64_t mask() {
+                return all_info_type::mask();
+            }
+
+            /// @brief Mask of the members of the group within the word.
+            template<std::size_t TGroup>
+            static constexpr std::uint64_t group_mask() {
+                return group_info_type<TGroup>::mask();
+            }
+
+            /// @brief Mask of the member values placed into the group lanes.
+            template<std::size_t TGroup>
+            static constexpr std::uint64_t group_lanes_mask() {
+                return group_info_type<TGroup>::lanes_mask(lane_bits);
+            }
+
+            /// @brief Retrieve value of the single member.
+            template<std::size_t TIdx>
+            static constexpr lane_type get(std::uint64_t word) {
+                return static_cast<lane_type>((word >> member_type<TIdx>::offset) & member_type<TIdx>::value_mask());
+            }
+
+            /// @brief Update value of the single member.
+            template<std::size_t TIdx>
+            static constexpr std::uint64_t set(std::uint64_t word, lane_type value) {
+                return (word & ~member_type<TIdx>::mask())
+                       | ((static_cast<std::uint64_t>(value) & member_type<TIdx>::value_mask())
+                          << member_type<TIdx>::offset);
+            }
+
+            /// @brief Extract all the members at once.
+            /// @param[in] word Packed value.
+            /// @param[out] out Output buffer of at least @ref members_count lanes.
+            static void extract(std::uint64_t word, lane_type *out) {
+#if MARSHALLING_HAS_BMI2
+                group_op<0U>::extract(word, out);
+#else
+                member_op<0U>::extract(word, out);
+#endif
+            }
+
+            /// @brief Extract all the members one by one.
+            /// @details Same result as @ref extract(), but every member is shifted
+            ///     and masked separately regardless of the BMI2 availability.
+            static void extract_each(std::uint64_t word, lane_type *out) {
+                member_op<0U>::extract(word, out);
+            }
+
+            /// @brief Deposit all the members at once.
+            /// @param[in] in Values of all the members, the bits exceeding members' width are ignored.
+            /// @param[in] word Value of the bits not covered by the members.
+            /// @return Packed value.
+            static std::uint64_t deposit(const lane_type *in, std::uint64_t word = 0U) {
+#if MARSHALLING_HAS_BMI2
+                return (word & ~mask()) | group_op<0U>::deposit(in);
+#else
+                return member_op<0U>::deposit(in, word);
+#endif
+            }
+
+            /// @brief Deposit all the members one by one.
+            static std::uint64_t deposit_each(const lane_type *in, std::uint64_t word = 0U) {
+                return member_op<0U>::deposit(in, word);
+            }
+
+        private:
+            template<std::size_t TGroup>
+            using group_info_type = detail::bit_extract::members_info<
+                members_tuple_type, TGroup * lanes_per_group,
+                (((TGroup + 1U) * lanes_per_group) < members_count) ? ((TGroup + 1U) * lanes_per_group) :
+                                                                      members_count>;
+
+            template<std::size_t TGroup, bool TEnd = (groups_count <= TGroup)>
+            struct group_op {
+                static const std::size_t first = TGroup * lanes_per_group;
+                static const std::size_t count
+                    = ((members_count - first) < lanes_per_group) ? (members_count - first) : lanes_per_group;
+
+                static void extract(std::uint64_t word, lane_type *out) {
+                    auto lanes = bits_deposit(bits_extract(word, group_mask<TGroup>()), group_lanes_mask<TGroup>());
+                    std::memcpy(out + first, &lanes, count * sizeof(lane_type));
+                    group_op<TGroup + 1U>::extract(word, out);
+                }
+
+                static std::uint64_t deposit(const lane_type *in) {
+                    std::uint64_t lanes = 0U;
+                    std::memcpy(&lanes, in + first, count * sizeof(lane_type));
+                    return bits_deposit(bits_extract(lanes, group_lanes_mask<TGroup>()), group_mask<TGroup>())
+                           | group_op<TGroup + 1U>::deposit(in);
+                }
+            };
+
+            template<std::size_t TGroup>
+            struct group_op<TGroup, true> {
+                static void extract(std::uint64_t, lane_type *) {
+                }
+
+                static std::uint64_t deposit(const lane_type *) {
+                    return 0U;
+                }
+            };
+
+            template<std::size_t TIdx, bool TEnd = (members_count <= TIdx)>
+            struct member_op {
+                static void extract(std::uint64_t word, lane_type *out) {
+                    out[TIdx] = get<TIdx>(word);
+                    member_op<TIdx + 1U>::extract(word, out);
+                }
+
+                static std::uint64_t deposit(const lane_type *in, std::uint64_t word) {
+                    return member_op<TIdx + 1U>::deposit(in, set<TIdx>(word, in[TIdx]));
+                }
+            };
+
+            template<std::size_t TIdx>
+            struct member_op<TIdx, true> {
+                static void extract(std::uint64_t, lane_type *) {
+                }
+
+                static std::uint64_t deposit(const lane_type *, std::uint64_t word) {
+                    return word;
+                }
+            };
+        };
+
+        namespace detail {
+            namespace bit_extract {
+
+                template<std::size_t TOffset, typename TDone, std::size_t... TWidths>
+                struct bitfield_layout_builder;
+
+                template<std::size_t TOffset, typename... TDone>
+                struct bitfield_layout_builder<TOffset, std::tuple<TDone...>> {
+                    using type = bit_members_layout<TDone...>;
+                };
+
+                template<std::size_t TOffset, typename... TDone, std::size_t TFirst, std::size_t... TRest>
+                struct bitfield_layout_builder<TOffset, std::tuple<TDone...>, TFirst, TRest...> {
+                    using type = typename bitfield_layout_builder<TOffset + TFirst,
+                                                                  std::tuple<TDone..., bit_member<TOffset, TFirst>>,
+                                                                  TRest...>::type;
+                };
+
+                template<typename TField, std::size_t TIdx, typename TDone,
+                         bool TEnd = (std::tuple_size<typename TField::value_type>::value <= TIdx)>
+                struct field_widths_builder;
+
+                template<typename TField, std::size_t TIdx, std::size_t... TWidths>
+                struct field_widths_builder<TField, TIdx, bitfield_layout_builder<0U, std::tuple<>, TWidths...>,
+                                            false> {
+                    using type = typename field_widths_builder<
+                        TField, TIdx + 1U,
+                        bitfield_layout_builder<0U, std::tuple<>, TWidths...,
+                                                TField::template member_bit_length<TIdx>()>>::type;
+                };
+
+                template<typename TField, std::size_t TIdx, typename TBuilder>
+                struct field_widths_builder<TField, TIdx, TBuilder, true> {
+                    using type = typename TBuilder::type;
+                };
+
+                template<std::size_t TCount, std::size_t... TPositions>
+                struct all_bits_builder {
+                    using type = typename all_bits_builder<TCount - 1U, TCount - 1U, TPositions...>::type;
+                };
+
+                template<std::size_t... TPositions>
+                struct all_bits_builder<0U, TPositions...> {
+                    using type = bit_members_layout<bit_member<TPositions, 1U>...>;
+                };
+
+            }    // namespace bit_extract
+        }        // namespace detail
+
+        /// @brief Layout of the contiguous members, such as ones of nil::marshalling::types::bitfield.
+        /// @details Prefer @ref bitfield_layout_of when the bitfield type is available.
+        /// @tparam TWidths Widths of the members in bits, starting from the least significant one.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        template<std::size_t... TWidths>
+        using bitfield_layout =
+            typename detail::bit_extract::bitfield_layout_builder<0U, std::tuple<>, TWidths...>::type;
+
+        /// @brief Layout of the single bit members, such as named bits of nil::marshalling::types::bitmask_value.
+        /// @tparam TPositions Ascending indices of the bits.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        template<std::size_t... TPositions>
+        using bitmask_layout = bit_members_layout<bit_member<TPositions, 1U>...>;
+
+        /// @brief Layout of the members of nil::marshalling::types::bitfield field.
+        /// @details The widths of the members are taken from the field itself
+        ///     (@b member_bit_length()), so the layout follows any change of the
+        ///     field definition. Applicable to the serialized value of the field.
+        /// @tparam TField Bitfield field type.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        template<typename TField>
+        using bitfield_layout_of = typename detail::bit_extract::
+            field_widths_builder<TField, 0U, detail::bit_extract::bitfield_layout_builder<0U, std::tuple<>>>::type;
+
+        /// @brief Layout of all the bits of nil::marshalling::types::bitmask_value field.
+        /// @details Every bit of the field value is a member, i.e. the lane index is
+        ///     the bit index, the @b BitIdx_* values generated by @b MARSHALLING_BITMASK_BITS()
+        ///     can be used directly to access the extracted lanes.
+        /// @tparam TField Bitmask field type.
+        /// @headerfile nil/network/marshalling/bit_extract.h
+        template<typename TField>
+        using bitmask_layout_of = typename detail::bit_extract::all_bits_builder<TField::max_length() * 8U>::type;
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_BIT_EXTRACT_HPP
@@ -0,0 +1,450 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Provides bulk (de)serialisation of the arrays of arithmetic values with the
+/// vectorised byte order conversion, using SSSE3/AVX2 shuffles when available.
+
+#ifndef NETWORK_MARSHALLING_BULK_SWAP_HPP
+#define NETWORK_MARSHALLING_BULK_SWAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/marshalling/status_type.hpp>
+
+#if defined(__SSSE3__) && !defined(MARSHALLING_NO_SIMD)
+#include <immintrin.h>
+#define MARSHALLING_HAS_SSSE3 1
+#else
+#define MARSHALLING_HAS_SSSE3 0
+#endif
+
+#if defined(__AVX2__) && !defined(MARSHALLING_NO_SIMD)
+#include <immintrin.h>
+#define MARSHALLING_HAS_AVX2 1
+#else
+#define MARSHALLING_HAS_AVX2 0
+#endif
+
+namespace nil {
+    namespace marshalling {
+        namespace detail {
+            namespace bulk_swap {
+
+                inline bool host_is_little_endian() {
+#if defined(__BYTE_ORDER__)
+                    return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#else
+                    const std::uint16_t value = 1U;
+                    std::uint8_t first = 0U;
+                    std::memcpy(&first, &value, 1U);
+                    return first == 1U;
+#endif
+                }
+
+                template<typename TEndian>
+                struct is_little_endian : public std::false_type { };
+
+                template<>
+                struct is_little_endian<nil::marshalling::endian::little_endian> : public std::true_type { };
+
+                template<std::size_t TSize>
+                struct scalar_op;
+
+                template<>
+                struct scalar_op<2U> {
+                    using type = std::uint16_t;
+
+                    static type swap(type value) {
+                        return static_cast<type>((value >> 8U) | (value << 8U));
+                    }
+                };
+
+                template<>
+                struct scalar_op<4U> {
+                    using type = std::uint32_t;
+
+                    static type swap(type value) {
+#if defined(__GNUC__)
+                        return __builtin_bswap32(value);
+#else
+                        return ((value & 0xff000000U) >> 24U) | ((value & 0x00ff0000U) >> 8U)
+                               | ((value & 0x0000ff00U) << 8U) | ((value & 0x000000ffU) << 24U);
+#endif
+                    }
+                };
+
+                template<>
+                struct scalar_op<8U> {
+                    using type = std::uint64_t;
+
+                    static type swap(type value) {
+#if defined(__GNUC__)
+                        return __builtin_bswap64(value);
+#else
+                        return (static_cast<type>(scalar_op<4U>::swap(static_cast<std::uint32_t>(value))) << 32U)
+                               | scalar_op<4U>::swap(static_cast<std::uint32_t>(value >> 32U));
+#endif
+                    }
+                };
+
+                template<std::size_t TSize>
+                void swap_scalar(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+                    using op_type = scalar_op<TSize>;
+                    typename op_type::type value;
+                    for (std::size_t idx = 0U; idx < count; ++idx) {
+                        std::memcpy(&value, src, TSize);
+                        value = op_type::swap(value);
+                        std::memcpy(dst, &value, TSize);
+                        dst += TSize;
+                        src += TSize;
+                    }
+                }
+
+                // Shuffle control reversing the bytes of every TSize byte element
+                // within 16 byte lane.
+                template<std::size_t TSize>
+                struct shuffle_control {
+                    static const std::uint8_t *value() {
+                        static const std::uint8_t Control[16] = {
+                            static_cast<std::uint8_t>(TSize - 1U - (0U % TSize) + (0U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (1U % TSize) + (1U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (2U % TSize) + (2U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (3U % TSize) + (3U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (4U % TSize) + (4U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (5U % TSize) + (5U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (6U % TSize) + (6U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (7U % TSize) + (7U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (8U % TSize) + (8U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (9U % TSize) + (9U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (10U % TSize) + (10U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (11U % TSize) + (11U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (12U % TSize) + (12U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (13U % TSize) + (13U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (14U % TSize) + (14U / TSize) * TSize),
+                            static_cast<std::uint8_t>(TSize - 1U - (15U % TSize) + (15U / TSize) * TSize)};
+                        return &Control[0];
+                    }
+                };
+
+                template<std::size_t TSize>
+                void swap_vector(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+                    std::size_t bytes = count * TSize;
+                    std::size_t offset = 0U;
+#if MARSHALLING_HAS_SSSE3 || MARSHALLING_HAS_AVX2
+                    const __m128i control
+                        = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffle_control<TSize>::value()));
+#endif
+#if MARSHALLING_HAS_AVX2
+                    const __m256i control256 = _mm256_broadcastsi128_si256(control);
+                    for (; (offset + 32U) <= bytes; offset += 32U) {
+                        auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + offset));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + offset),
+                                            _mm256_shuffle_epi8(data, control256));
+                    }
+#endif
+#if MARSHALLING_HAS_SSSE3 || MARSHALLING_HAS_AVX2
+                    for (; (offset + 16U) <= bytes; offset += 16U) {
+                        auto data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + offset));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset), _mm_shuffle_epi8(data, control));
+                    }
+#endif
+                    swap_scalar<TSize>(dst + offset, src + offset, (bytes - offset) / TSize);
+                }
+
+                template<std::size_t TSize>
+                struct swapper {
+                    static void copy(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+                        swap_vector<TSize>(dst, src, count);
+                    }
+                };
+
+                template<>
+                struct swapper<1U> {
+                    static void copy(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+                        std::memcpy(dst, src, count);
+                    }
+                };
+
+                template<typename TField>
+                using array_element_type = typename TField::value_type::value_type;
+
+                template<typename TIter, bool TIsPointer = std::is_pointer<TIter>::value>
+                struct is_byte_pointer
+                    : public std::integral_constant<
+                          bool, sizeof(typename std::iterator_traits<TIter>::value_type) == 1U> { };
+
+                template<typename TIter>
+                struct is_byte_pointer<TIter, false> : public std::false_type { };
+
+                template<typename TField, typename TIter>
+                struct bulk_elements_applicable {
+                    using element_type = typename std::decay<array_element_type<TField>>::type;
+
+                    static const bool value = std::is_arithmetic<element_type>::value
+                                              && is_byte_pointer<typename std::decay<TIter>::type>::value;
+                };
+
+                // The bulk read consumes all the provided bytes and the bulk write emits
+                // the raw elements only, any option changing that serialisation
+                // (prefixes, suffixes, fixed or forced size) requires the field's own
+                // read and write.
+                template<typename TField>
+                struct has_raw_sequence_format {
+                    using options_type = typename TField::parsed_options_type;
+
+                    static const bool value = (!options_type::has_sequence_size_forcing)
+                                              && (!options_type::has_sequence_fixed_size)
+                                              && (!options_type::has_sequence_size_field_prefix)
+                                              && (!options_type::has_sequence_ser_length_field_prefix)
+                                              && (!options_type::has_sequence_elem_length_forcing)
+                                              && (!options_type::has_sequence_elem_ser_length_field_prefix)
+                                              && (!options_type::has_sequence_elem_fixed_ser_length_field_prefix)
+                                              && (!options_type::has_sequence_trailing_field_suffix)
+                                              && (!options_type::has_sequence_termination_field_suffix);
+                };
+
+                template<typename TField, typename TIter>
+                struct bulk_applicable {
+                    static const bool value
+                        = bulk_elements_applicable<TField, TIter>::value && has_raw_sequence_format<TField>::value;
+                };
+
+            }    // namespace bulk_swap
+        }        // namespace detail
+
+        /// @brief Check whether the SIMD byte order conversion is used.
+        /// @headerfile nil/network/marshalling/bulk_swap.h
+        inline constexpr bool bulk_swap_uses_simd() {
+            return (MARSHALLING_HAS_SSSE3 != 0) || (MARSHALLING_HAS_AVX2 != 0);
+        }
+
+        /// @brief Deserialise the array of arithmetic values.
+        /// @details Performs bulk copy when the serialisation endian matches the host
+        ///     one, vectorised byte swap otherwise (AVX2 or SSSE3 shuffle when the
+        ///     code is compiled with its support and @b MARSHALLING_NO_SIMD is not
+        ///     defined, scalar loop for the remaining elements and on other platforms).
+        /// @tparam TEndian Serialisation endian, nil::marshalling::endian::big_endian or
+        ///     nil::marshalling::endian::little_endian.
+        /// @tparam T Type of the value, must be arithmetic.
+        /// @param[out] out Output values.
+        /// @param[in] in Serialised data, @b count * sizeof(T) bytes.
+        /// @param[in] count Number of the values.
+        /// @headerfile nil/network/marshalling/bulk_swap.h
+        template<typename TEndian, typename T>
+        void bulk_read_values(T *out, const std::uint8_t *in, std::size_t count) {
+            static_assert(std::is_arithmetic<T>::value, "The value type must be arithmetic");
+            if (count == 0U) {
+                return;
+            }
+
+            auto *dst = reinterpret_cast<std::uint8_t *>(out);
+            if (detail::bulk_swap::is_little_endian<TEndian>::value == detail::bulk_swap::host_is_little_endian()) {
+                std::memcpy(dst, in, count * sizeof(T));
+                return;
+            }
+
+            detail::bulk_swap::swapper<sizeof(T)>::copy(dst, in, count);
+        }
+
+        /// @brief Serialise the array of arithmetic values.
+        /// @details See @ref bulk_read_values() for the details of the implementation selection.
+        /// @tparam TEndian Serialisation endian.
+        /// @tparam T Type of the value, must be arithmetic.
+        /// @param[out] out Output buffer of at least @b count * sizeof(T) bytes.
+        /// @param[in] in Values to serialise.
+        /// @param[in] count Number of the values.
+        /// @headerfile nil/network/marshalling/bulk_swap.h
+        template<typename TEndian, typename T>
+        void bulk_write_values(std::uint8_t *out, const T *in, std::size_t count) {
+            static_assert(std::is_arithmetic<T>::value, "The value type must be arithmetic");
+            if (count == 0U) {
+                return;
+            }
+
+            auto *src = reinterpret_cast<const std::uint8_t *>(in);
+            if (detail::bulk_swap::is_little_endian<TEndian>::value == detail::bulk_swap::host_is_little_endian()) {
+                std::memcpy(out, src, count * sizeof(T));
+                return;
+            }
+
+            detail::bulk_swap::swapper<sizeof(T)>::copy(out, src, count);
+        }
+
+        /// @brief Check whether the array_list field can be read and written in bulk
+        ///     using the provided iterator.
+        /// @details The elements must be of arithmetic type (i.e. the array is defined
+        ///     as nil::marshalling::types::array_list<TFieldBase, std::uint16_t>,
+        ///     without per-element field wrapping) and the iterator must be a pointer to byte.
+        ///     The array must not use the options changing its serialisation, such as
+        ///     size or serialisation length prefix, fixed or forced size, trailing or
+        ///     termination suffix.
+        /// @headerfile nil/network/marshalling/bulk_swap.h
+        template<typename TField, typename TIter>
+        struct is_bulk_array_list
+            : public std::integral_constant<bool, detail::bulk_swap::bulk_applicable<TField, TIter>::value> { };
+
+        namespace detail {
+            namespace bulk_swap {
+
+                template<typename TField, typename TIter>
+                status_type read_n(TField &field, TIter &iter, std::size_t count, std::true_type) {
+                    using element_type = array_element_type<TField>;
+                    auto &vec = field.value();
+                    vec.resize(count);
+                    if (0U < count) {
+                        auto *in = reinterpret_cast<const std::uint8_t *>(iter);
+                        bulk_read_values<typename TField::endian_type>(&vec[0], in, count);
+                    }
+                    iter += count * sizeof(element_type);
+                    return status_type::success;
+                }
+
+                template<typename TField, typename TIter>
+                status_type read(TField &field, TIter &iter, std::size_t len, std::true_type) {
+                    using element_type = array_element_type<TField>;
+                    if ((len % sizeof(element_type)) != 0U) {
+                        return status_type::invalid_msg_data;
+                    }
+
+                    return read_n(field, iter, len / sizeof(element_type), std::true_type());
+                }
+
+                template<typename TField, typename TIter>
+                status_type read(TField &field, TIter &iter, std::size_t len, std::false_type) {
+                    return field.read(iter, len);
+                }
+
+                template<typename TField, typename TIter>
+                status_type write(const TField &field, TIter &iter, std::size_t len, std::true_type) {
+                    using element_type = array_element_type<TField>;
+                    auto &vec = field.value();
+                    auto bytes = vec.size() * sizeof(element_type);
+                    if (len < bytes) {
+                        return status_type::buffer_overflow;
+                    }
+
+                    if (!vec.empty()) {
+                        auto *out = reinterpret_cast<std::uint8_t *>(iter);
+                        bulk_write_values<typename TField::endian_type>(out, &vec[0], vec.size());
+                    }
+                    iter += bytes;
+                    return status_type::success;
+                }
+
+                template<typename TField, typename TIter>
+                status_type write(const TField &field, TIter &iter, std::size_t len, std::false_type) {
+                    return field.write(iter, len);
+                }
+
+            }    // namespace bulk_swap
+        }        // namespace detail
+
+        /// @brief Read the array_list field consuming all the provided bytes.
+        /// @details Uses @ref bulk_read_values() when @ref is_bulk_array_list is true,
+        ///     falls back to field's own read() otherwise, which keeps the wire format of
+        ///     the arrays having size prefix, fixed size or other sequence options.
+        /// @param[in, out] field Field to read, must provide @b endian_type.
+        /// @param[in, out] iter Input iterator.
+        /// @param[in] len Number of bytes, must be multiple of the element size.
+        /// @return Status of the operation, nil::marshalling::status_type::invalid_msg_data
+        ///     when the bytes don't form a whole number of elements.
+        /// @headerfile nil/network/marshalling/bulk_swap.h
+        template<typename TField, typename TIter>
+        status_type array_list_bulk_read(TField &field, TIter &iter, std::size_t len) {
+            return detail::bulk_swap::read(field, iter, len, is_bulk_array_list<TField, TIter>());
+        }
+
+        /// @brief Read exactly @b count elements of the array_list field.
+        /// @details Intended for the arrays which number of the elements is known
+        ///     upfront (fixed size or read from the prefix by the caller). Reads the raw
+        ///     elements only, whatever sequence options the field has.
+        /// @param[in, out] field Field to read.
+        /// @param[in, out] iter Input iterator, must be pointer to byte.
+        /// @param[in] len Number of available bytes.
+        /// @param[in] count Number of the elements.
+        /// @return Status of the operation.
+        /// @headerfile nil/network/marshalling/bulk_swap.h
+        template<typename TField, typename TIter>
+        status_type array_list_bulk_read_n(TField &field, TIter &iter, std::size_t len, std::size_t count) {
+            static_assert(detail::bulk_swap::bulk_elements_applicable<TField, TIter>::value,
+                          "The field must be array_list of arithmetic values, the iterator must be pointer to byte");
+            if ((len / sizeof(detail::bulk_swap::array_element_type<TField>)) < count) {
+                return status_type::not_enough_data;
+            }
+
+            return detail::bulk_swap::read_n(field, iter, count, std::true_type());
+        }
+
+        /// @brief Write the array_list field.
+        /// @details Uses @ref bulk_write_values() when @ref is_bulk_array_list is true,
+        ///     falls back to field's own write() otherwise.
+        /// @param[in] field Field to write, must provide @b endian_type.
+        /// @param[in, out] iter Output iterator.
+        /// @param[in] len Max number of bytes to write.
+        /// @return Status of the operation.
+        /// @headerfile nil/network/marshalling/bulk_swap.h
+        template<typename TField, typename TIter>
+        status_type array_list_bulk_write(const TField &field, TIter &iter, std::size_t len) {
+            return detail::bulk_swap::write(field, iter, len, is_bulk_array_list<TField, TIter>());
+        }
+
+    }    // namespace marshalling
+}    // namespace nil
+
+/// @brief Override read and write of the array_list field to use bulk byte order conversion.
+/// @details Must be used inside the class extending nil::marshalling::types::array_list
+///     of arithmetic values, which is defined with nil::marshalling::option::has_custom_read
+///     option. For other iterators and for the arrays not satisfying
+///     @ref nil::marshalling::is_bulk_array_list (e.g. having size prefix) the base class
+///     read() and write() are used.
+/// @code
+///     class samples : public nil::marshalling::types::array_list<field_type, std::int16_t,
+///                                                                nil::marshalling::option::has_custom_read> {
+///         using base_type = nil::marshalling::types::array_list<field_type, std::int16_t,
+///                                                               nil::marshalling::option::has_custom_read>;
+///     public:
+///         MARSHALLING_ARRAY_LIST_BULK_ACCESS(base_type);
+///     };
+/// @endcode
+/// @param base_ Type of the array_list base class.
+/// @related nil::marshalling::array_list_bulk_read
+#define MARSHALLING_ARRAY_LIST_BULK_ACCESS(base_)                                             \
+    template<typename TIter>                                                                  \
+    nil::marshalling::status_type read(TIter &iter, std::size_t len) {                        \
+        return nil::marshalling::array_list_bulk_read(static_cast<base_ &>(*this), iter, len); \
+    }                                                                                         \
+                                                                                              \
+    template<typename TIter>                                                                  \
+    nil::marshalling::status_type write(TIter &iter, std::size_t len) const {                 \
+        return nil::marshalling::array_list_bulk_write(static_cast<const base_ &>(*this), iter, len); \
+    }
+
+#endif    // NETWORK_MARSHALLING_BULK_SWAP_HPP
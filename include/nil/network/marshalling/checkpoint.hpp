@@ -0,0 +1,458 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of the decoder state checkpointing facilities used
+///     to hand the partially received frames over to the restarted process.
+
+#ifndef NETWORK_MARSHALLING_CHECKPOINT_HPP
+#define NETWORK_MARSHALLING_CHECKPOINT_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <nil/marshalling/status_type.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MARSHALLING_CHECKPOINT_HAS_POSIX 1
+#else
+#define MARSHALLING_CHECKPOINT_HAS_POSIX 0
+#endif
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Snapshot of the per stream decoder state.
+        /// @details Holds the bytes of the partially received frame, which are
+        ///     still waiting for the rest of the frame, the header fields cached by
+        ///     the application (e.g. session or channel identifiers) and the sequence
+        ///     state of the stream. The structure is trivially copyable and is expected
+        ///     to be stored in the @ref checkpoint_file as is, either directly or as a
+        ///     member of the application defined record, which may also contain other
+        ///     trivially copyable state, such as @ref feed_arbitrator::state_type.
+        /// @tparam TPartialCapacity Max number of the partial frame bytes.
+        /// @tparam TFieldsCount Number of the cached header field values.
+        /// @headerfile nil/network/marshalling/checkpoint.h
+        template<std::size_t TPartialCapacity = 2048U, std::size_t TFieldsCount = 4U>
+        struct stream_checkpoint {
+            /// @brief Max number of the partial frame bytes.
+            static const std::size_t partial_capacity = TPartialCapacity;
+
+            /// @brief Number of the cached header field values.
+            static const std::size_t fields_count = TFieldsCount;
+
+            std::uint64_t stream_id;                          ///< Application defined stream identifier.
+            std::uint64_t sequence;                           ///< Last processed sequence number.
+            std::array<std::uint64_t, TFieldsCount> fields;   ///< Cached header field values.
+            std::uint32_t missing_size;                       ///< Missing size reported by the last read.
+            std::uint32_t partial_length;                     ///< Number of the partial frame bytes.
+            std::uint32_t flags;                              ///< Application defined flags.
+            std::uint32_t sequence_valid;                     ///< Non-zero when @ref sequence is valid.
+            std::array<std::uint8_t, TPartialCapacity> partial;    ///< Partial frame bytes.
+
+            /// @brief Clear the snapshot.
+            void clear() {
+                stream_id = 0U;
+                sequence = 0U;
+                fields.fill(0U);
+                missing_size = 0U;
+                partial_length = 0U;
+                flags = 0U;
+                sequence_valid = 0U;
+            }
+
+            /// @brief Store the bytes of the partially received frame.
+            /// @param[in] data Beginning of the partial frame.
+            /// @param[in] len Number of the received bytes.
+            /// @param[in] missingSize Number of missing bytes reported by the protocol
+            ///     stack read() operation, if known.
+            /// @return nil::marshalling::status_type::buffer_overflow when the partial
+            ///     frame doesn't fit, nil::marshalling::status_type::success otherwise.
+            status_type set_partial(const std::uint8_t *data, std::size_t len, std::size_t missingSize = 0U) {
+                if (TPartialCapacity < len) {
+                    return status_type::buffer_overflow;
+                }
+
+                if (0U < len) {
+                    std::memcpy(partial.data(), data, len);
+                }
+                partial_length = static_cast<std::uint32_t>(len);
+                missing_size = static_cast<std::uint32_t>(missingSize);
+                return status_type::success;
+            }
+
+            /// @brief Beginning of the stored partial frame.
+            const std::uint8_t *partial_data() const {
+                return partial.data();
+            }
+
+            /// @brief Number of the stored partial frame bytes.
+            std::size_t partial_size() const {
+                return std::min(static_cast<std::size_t>(partial_length), TPartialCapacity);
+            }
+
+            /// @brief Store the sequence number of the last processed frame.
+            void set_sequence(std::uint64_t seq) {
+                sequence = seq;
+                sequence_valid = 1U;
+            }
+        };
+
+#if MARSHALLING_CHECKPOINT_HAS_POSIX
+
+        namespace detail {
+
+            struct checkpoint_header {
+                char magic[8];
+                std::uint32_t version;
+                std::uint32_t record_size;
+                std::uint64_t capacity;
+                std::uint64_t count;
+                std::uint64_t generation;
+                std::uint32_t committed;
+                std::uint32_t reserved;
+                std::uint8_t padding[16];    // Keep the records cache line aligned.
+            };
+
+            static const char checkpoint_magic[8] = {'N', 'M', 'C', 'K', 'P', 'T', '0', '1'};
+
+        }    // namespace detail
+
+        /// @brief Memory mapped file holding the array of the checkpoint records.
+        /// @details The records are accessed directly in the mapped memory, so the
+        ///     checkpoint is neither serialised upon writing nor parsed upon restore,
+        ///     the new process only maps the file and validates its header. The file
+        ///     layout is: header (magic, layout version, record size, capacity, number
+        ///     of the records, generation, commit flag) followed by the records.
+        ///
+        ///     The typical usage by the exiting process:
+        ///     @code
+        ///     checkpoint_file<my_record> file;
+        ///     if (file.create(path, connections.size(), MyLayoutVersion)) {
+        ///         for (auto& c : connections) {
+        ///             auto* rec = file.append();
+        ///             ... // fill the record
+        ///         }
+        ///         file.commit();
+        ///     }
+        ///     @endcode
+        ///     and by the new one:
+        ///     @code
+        ///     checkpoint_file<my_record> file;
+        ///     if (file.open(path, MyLayoutVersion)) {
+        ///         for (auto& rec : file) {
+        ///             ... // restore the connection
+        ///         }
+        ///     }
+        ///     @endcode
+        ///     The file is opened only if it has been committed and its layout (version
+        ///     and record size) matches the expected one, otherwise the streams are
+        ///     expected to be resynchronised as usual. The records are written in the
+        ///     native byte order, the file is not meant to be moved between hosts.
+        /// @tparam TRecord Type of the record, must be trivially copyable.
+        /// @headerfile nil/network/marshalling/checkpoint.h
+        template<typename TRecord>
+        class checkpoint_file {
+            static_assert(std::is_trivially_copyable<TRecord>::value, "The record must be trivially copyable");
+            static_assert(std::alignment_of<TRecord>::value <= sizeof(detail::checkpoint_header),
+                          "Record alignment is not supported");
+
+            using header_type = detail::checkpoint_header;
+
+        public:
+            /// @brief Type of the record.
+            using record_type = TRecord;
+
+            /// @brief Type of the iterator.
+            using iterator = TRecord *;
+
+            /// @brief Type of the const iterator.
+            using const_iterator = const TRecord *;
+
+            /// @brief Default constructor, no file is mapped.
+            checkpoint_file() = default;
+
+            /// @brief Copy constructor is deleted.
+            checkpoint_file(const checkpoint_file &) = delete;
+
+            /// @brief Copy assignment is deleted.
+            checkpoint_file &operator=(const checkpoint_file &) = delete;
+
+            /// @brief Destructor, unmaps the file, doesn't commit it.
+            ~checkpoint_file() noexcept {
+                close();
+            }
+
+            /// @brief Create (or truncate) the file capable of holding @b capacity records.
+            /// @details The created file is not committed until @ref commit() is called.
+            /// @param[in] path Path to the file.
+            /// @param[in] capacity Max number of the records.
+            /// @param[in] version Application defined version of the record layout.
+            /// @return true on success.
+            bool create(const std::string &path, std::size_t capacity, std::uint32_t version = 0U) {
+                close();
+                auto fd = ::open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+                if (fd < 0) {
+                    return false;
+                }
+
+                auto len = sizeof(header_type) + (capacity * sizeof(TRecord));
+                if (::ftruncate(fd, static_cast<off_t>(len)) != 0) {
+                    ::close(fd);
+                    return false;
+                }
+
+                if (!map(fd, len, 0)) {
+                    return false;
+                }
+
+                auto &hdr = header();
+                std::memcpy(hdr.magic, detail::checkpoint_magic, sizeof(hdr.magic));
+                hdr.version = version;
+                hdr.record_size = static_cast<std::uint32_t>(sizeof(TRecord));
+                hdr.capacity = capacity;
+                hdr.count = 0U;
+                hdr.generation = 0U;
+                hdr.committed = 0U;
+                capacity_ = capacity;
+                count_ = 0U;
+                return true;
+            }
+
+            /// @brief Open and map the previously committed file.
+            /// @param[in] path Path to the file.
+            /// @param[in] version Expected version of the record layout.
+            /// @return true on success, false when the file doesn't exist, hasn't been
+            ///     committed or its layout doesn't match.
+            bool open(const std::string &path, std::uint32_t version = 0U) {
+                close();
+                auto fd = ::open(path.c_str(), O_RDWR);
+                if (fd < 0) {
+                    return false;
+                }
+
+                struct stat st;
+                if ((::fstat(fd, &st) != 0) || (static_cast<std::size_t>(st.st_size) < sizeof(header_type))) {
+                    ::close(fd);
+                    return false;
+                }
+
+                int flags = 0;
+#ifdef MAP_POPULATE
+                // Fault in all the pages at once instead of one by one upon access.
+                flags = MAP_POPULATE;
+#endif
+                auto len = static_cast<std::size_t>(st.st_size);
+                if (!map(fd, len, flags)) {
+                    return false;
+                }
+
+                auto &hdr = header();
+                if ((std::memcmp(hdr.magic, detail::checkpoint_magic, sizeof(hdr.magic)) != 0)
+                    || (hdr.version != version) || (hdr.record_size != sizeof(TRecord)) || (hdr.committed == 0U)
+                    || (hdr.capacity < hdr.count)
+                    || (((len - sizeof(header_type)) / sizeof(TRecord)) < hdr.capacity)) {
+                    close();
+                    return false;
+                }
+
+                capacity_ = static_cast<std::size_t>(hdr.capacity);
+                count_ = static_cast<std::size_t>(hdr.count);
+                return true;
+            }
+
+            /// @brief Unmap the file.
+            void close() {
+                if (mem_ != nullptr) {
+                    ::munmap(mem_, len_);
+                }
+                mem_ = nullptr;
+                len_ = 0U;
+                capacity_ = 0U;
+                count_ = 0U;
+            }
+
+            /// @brief Check whether the file is mapped.
+            bool valid() const {
+                return mem_ != nullptr;
+            }
+
+            /// @brief Append new record.
+            /// @details The record is zero initialised. The file is marked as not
+            ///     committed until the next @ref commit().
+            /// @return Pointer to the record, nullptr when the capacity is exhausted.
+            TRecord *append() {
+                if ((mem_ == nullptr) || (capacity_ <= count_)) {
+                    return nullptr;
+                }
+
+                uncommit();
+                auto *rec = records() + count_;
+                std::memset(static_cast<void *>(rec), 0, sizeof(TRecord));
+                ++count_;
+                return rec;
+            }
+
+            /// @brief Remove all the records, marks the file as not committed.
+            void clear() {
+                if (mem_ == nullptr) {
+                    return;
+                }
+
+                uncommit();
+                count_ = 0U;
+            }
+
+            /// @brief Commit the records, making them visible to @ref open().
+            /// @param[in] sync Flush the file to the storage (@b msync()), not needed
+            ///     when the file resides in the memory backed file system (e.g. /dev/shm)
+            ///     and the machine is not rebooted.
+            /// @return true on success.
+            bool commit(bool sync = true) {
+                if (mem_ == nullptr) {
+                    return false;
+                }
+
+                auto &hdr = header();
+                hdr.count = count_;
+                ++hdr.generation;
+                std::atomic_thread_fence(std::memory_order_release);
+                hdr.committed = 1U;
+                if (sync && (::msync(mem_, len_, MS_SYNC) != 0)) {
+                    return false;
+                }
+                return true;
+            }
+
+            /// @brief Number of the records.
+            std::size_t size() const {
+                return count_;
+            }
+
+            /// @brief Check whether there are no records.
+            bool empty() const {
+                return count_ == 0U;
+            }
+
+            /// @brief Max number of the records.
+            std::size_t capacity() const {
+                return capacity_;
+            }
+
+            /// @brief Number of times the file has been committed.
+            std::uint64_t generation() const {
+                return (mem_ == nullptr) ? 0U : header().generation;
+            }
+
+            /// @brief Access the record.
+            TRecord &operator[](std::size_t idx) {
+                return records()[idx];
+            }
+
+            /// @brief Access the record.
+            const TRecord &operator[](std::size_t idx) const {
+                return records()[idx];
+            }
+
+            /// @brief Beginning of the records.
+            iterator begin() {
+                return records();
+            }
+
+            /// @brief End of the records.
+            iterator end() {
+                return records() + count_;
+            }
+
+            /// @brief Beginning of the records.
+            const_iterator begin() const {
+                return records();
+            }
+
+            /// @brief End of the records.
+            const_iterator end() const {
+                return records() + count_;
+            }
+
+        private:
+            bool map(int fd, std::size_t len, int flags) {
+                auto *mem = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED | flags, fd, 0);
+                ::close(fd);
+                if (mem == MAP_FAILED) {
+                    return false;
+                }
+
+                mem_ = mem;
+                len_ = len;
+                return true;
+            }
+
+            void uncommit() {
+                auto &hdr = header();
+                if (hdr.committed != 0U) {
+                    hdr.committed = 0U;
+                    std::atomic_thread_fence(std::memory_order_release);
+                }
+            }
+
+            header_type &header() {
+                return *static_cast<header_type *>(mem_);
+            }
+
+            const header_type &header() const {
+                return *static_cast<const header_type *>(mem_);
+            }
+
+            TRecord *records() {
+                return reinterpret_cast<TRecord *>(static_cast<std::uint8_t *>(mem_) + sizeof(header_type));
+            }
+
+            const TRecord *records() const {
+                return reinterpret_cast<const TRecord *>(static_cast<const std::uint8_t *>(mem_)
+                                                         + sizeof(header_type));
+            }
+
+            void *mem_ = nullptr;
+            std::size_t len_ = 0U;
+            std::size_t capacity_ = 0U;
+            std::size_t count_ = 0U;
+        };
+
+#endif    // #if MARSHALLING_CHECKPOINT_HAS_POSIX
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_CHECKPOINT_HPP
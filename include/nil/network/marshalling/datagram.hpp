@@ -0,0 +1,580 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of the datagram based batched reading and writing of the frames.
+
+#ifndef NETWORK_MARSHALLING_DATAGRAM_HPP
+#define NETWORK_MARSHALLING_DATAGRAM_HPP
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#include <nil/marshalling/status_type.hpp>
+
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#endif
+
+namespace nil {
+    namespace marshalling {
+
+        namespace detail {
+
+            template<typename T, typename = void>
+            struct has_frame_context_tag : public std::false_type { };
+
+            template<typename T>
+            struct has_frame_context_tag<T, typename std::conditional<false, typename T::frame_context_tag, void>::type>
+                : public std::true_type { };
+
+        }    // namespace detail
+
+        /// @brief Check whether the handler accepts the context of the read frames.
+        /// @details The handler declares itself context-capable by defining
+        ///     @b frame_context_tag internal type. Such handler must also define
+        ///     the following member function (in addition to @b handle() ones):
+        ///     @code
+        ///     void frame_context(const TContext& context);
+        ///     @endcode
+        ///     which is invoked prior to dispatching every message read from the frame,
+        ///     for example with @ref datagram_frame_context.
+        /// @headerfile nil/network/marshalling/datagram.h
+        template<typename THandler>
+        constexpr bool is_frame_context_handler() {
+            return detail::has_frame_context_tag<THandler>::value;
+        }
+
+        /// @brief Type of the receive timestamp.
+        /// @details Time since epoch (@b CLOCK_REALTIME) reported by the kernel,
+        ///     zero if not available.
+        /// @headerfile nil/network/marshalling/datagram.h
+        using receive_time_type = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
+        /// @brief Type of the raw hardware receive timestamp.
+        /// @details Time reported by the PTP hardware clock (PHC) of the network adapter,
+        ///     which is @b NOT related to @b CLOCK_REALTIME unless the PHC is synchronised
+        ///     to it (e.g. by @b phc2sys), zero if not available.
+        /// @headerfile nil/network/marshalling/datagram.h
+        using hardware_receive_time_type = std::chrono::nanoseconds;
+
+        /// @brief Read single frame, which is known to be complete.
+        /// @details Intended for the datagram transports, where the datagram contains
+        ///     complete frame(s). The missing size calculation is not requested from
+        ///     the protocol stack, and nil::marshalling::status_type::not_enough_data
+        ///     is reported as nil::marshalling::status_type::protocol_error, i.e. no
+        ///     stream recovery (waiting for more data or resync) is expected from the caller.
+        /// @param[in] stack Protocol stack.
+        /// @param[out] msg Smart pointer to the message object to be allocated.
+        /// @param[in, out] iter Input iterator.
+        /// @param[in] size Number of bytes in the frame.
+        /// @return Status of the read operation.
+        /// @headerfile nil/network/marshalling/datagram.h
+        template<typename TStack, typename TMsgPtr, typename TIter>
+        status_type complete_frame_read(TStack &stack, TMsgPtr &msg, TIter &iter, std::size_t size) {
+            auto es = stack.read(msg, iter, size);
+            if (es == status_type::not_enough_data) {
+                return status_type::protocol_error;
+            }
+
+            return es;
+        }
+
+        namespace detail {
+
+            template<typename THandler, typename TContext>
+            void apply_frame_context(THandler &handler, const TContext &context, std::true_type) {
+                handler.frame_context(context);
+            }
+
+            template<typename THandler, typename TContext>
+            void apply_frame_context(THandler &handler, const TContext &context, std::false_type) {
+                static_cast<void>(handler);
+                static_cast<void>(context);
+            }
+
+            struct no_frame_context { };
+
+        }    // namespace detail
+
+        /// @brief Read and dispatch all the frames residing in a single datagram
+        ///     providing the context to the handler.
+        /// @details Same as @ref dispatch_datagram(), but when the handler is
+        ///     context-capable (see @ref is_frame_context_handler()), its
+        ///     @b frame_context() member function is invoked with the provided
+        ///     context object prior to dispatching every message.
+        /// @param[in] stack Protocol stack.
+        /// @param[in] iter Iterator to the beginning of the datagram.
+        /// @param[in] size Length of the datagram.
+        /// @param[in] handler Handler object.
+        /// @param[in] framesCount Expected number of frames in the datagram, 0 means
+        ///     all the frames until the end of the datagram.
+        /// @param[in] context Context of the frames, such as @ref datagram_frame_context.
+        /// @return Number of dispatched messages.
+        /// @headerfile nil/network/marshalling/datagram.h
+        template<typename TStack, typename TIter, typename THandler, typename TContext>
+        std::size_t dispatch_datagram(TStack &stack, TIter iter, std::size_t size, THandler &handler,
+                                      std::size_t framesCount, const TContext &context) {
+            using context_tag = std::integral_constant<bool, is_frame_context_handler<THandler>()
+                                                                 && (!std::is_same<TContext, detail::no_frame_context>::value)>;
+            std::size_t dispatched = 0U;
+            while ((0U < size) && ((framesCount == 0U) || (dispatched < framesCount))) {
+                typename TStack::msg_ptr_type msg;
+                auto frameIter = iter;
+                auto es = complete_frame_read(stack, msg, iter, size);
+                if (es != status_type::success) {
+                    break;
+                }
+
+                auto consumed = static_cast<std::size_t>(std::distance(frameIter, iter));
+                size -= consumed;
+                detail::apply_frame_context(handler, context, context_tag());
+                msg->dispatch(handler);
+                ++dispatched;
+            }
+
+            return dispatched;
+        }
+
+        /// @brief Read and dispatch all the frames residing in a single datagram.
+        /// @details The frames are read using @ref complete_frame_read() and every
+        ///     successfully read message is dispatched to the handler. The processing
+        ///     stops on the first error, the rest of the datagram is dropped.
+        /// @param[in] stack Protocol stack.
+        /// @param[in] iter Iterator to the beginning of the datagram.
+        /// @param[in] size Length of the datagram.
+        /// @param[in] handler Handler object.
+        /// @param[in] framesCount Expected number of frames in the datagram, 0 means
+        ///     all the frames until the end of the datagram.
+        /// @return Number of dispatched messages.
+        /// @headerfile nil/network/marshalling/datagram.h
+        template<typename TStack, typename TIter, typename THandler>
+        std::size_t dispatch_datagram(TStack &stack, TIter iter, std::size_t size, THandler &handler,
+                                      std::size_t framesCount = 0U) {
+            return dispatch_datagram(stack, iter, size, handler, framesCount, detail::no_frame_context());
+        }
+
+#if defined(__linux__)
+
+        /// @brief Context of the frames read from the single datagram.
+        /// @details Passed to the context-capable handlers (see @ref is_frame_context_handler())
+        ///     by @ref datagram_reader prior to dispatching every message.
+        /// @headerfile nil/network/marshalling/datagram.h
+        struct datagram_frame_context {
+            receive_time_type timestamp;          ///< Kernel receive timestamp, zero if not available.
+            const ::sockaddr_storage *source;    ///< Source address of the datagram.
+            std::size_t index;                   ///< Index of the datagram in the received batch.
+            hardware_receive_time_type hardware_timestamp;    ///< Raw hardware receive timestamp (NIC clock).
+        };
+
+        /// @brief Enable kernel receive timestamps on the socket.
+        /// @details Uses @b SO_TIMESTAMPNS for the software timestamps, or
+        ///     @b SO_TIMESTAMPING when the hardware timestamps are requested.
+        ///     The software timestamps are reported in both cases, the raw hardware
+        ///     ones are reported separately in the clock domain of the network adapter
+        ///     (see @ref hardware_receive_time_type).
+        /// @param[in] fd Socket descriptor.
+        /// @param[in] hardware Request hardware timestamps.
+        /// @return true on success, errno is set otherwise.
+        /// @headerfile nil/network/marshalling/datagram.h
+        inline bool enable_receive_timestamps(int fd, bool hardware = false) {
+            if (!hardware) {
+                int enabled = 1;
+                return ::setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enabled, sizeof(enabled)) == 0;
+            }
+
+            int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_SOFTWARE
+                        | SOF_TIMESTAMPING_RAW_HARDWARE;
+            return ::setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0;
+        }
+
+        namespace detail {
+
+            inline receive_time_type to_receive_time(const ::timespec &ts) {
+                return receive_time_type(std::chrono::nanoseconds(static_cast<std::int64_t>(ts.tv_sec) * 1000000000LL
+                                                                  + static_cast<std::int64_t>(ts.tv_nsec)));
+            }
+
+            inline receive_time_type receive_timestamp(const ::msghdr &hdr, hardware_receive_time_type &hardware) {
+                hardware = hardware_receive_time_type();
+                if ((hdr.msg_control == nullptr) || (hdr.msg_controllen == 0U)) {
+                    return receive_time_type();
+                }
+
+                for (auto *cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+                     cmsg = CMSG_NXTHDR(const_cast<::msghdr *>(&hdr), cmsg)) {
+                    if (cmsg->cmsg_level != SOL_SOCKET) {
+                        continue;
+                    }
+
+                    if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                        ::timespec ts;
+                        std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                        return to_receive_time(ts);
+                    }
+
+                    if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+                        // Software timestamp (CLOCK_REALTIME) first, raw hardware one (NIC clock) last
+                        ::timespec ts[3];
+                        std::memcpy(&ts[0], CMSG_DATA(cmsg), sizeof(ts));
+                        hardware = to_receive_time(ts[2]).time_since_epoch();
+                        return to_receive_time(ts[0]);
+                    }
+                }
+
+                return receive_time_type();
+            }
+
+        }    // namespace detail
+
+        /// @brief Statistics gathered by @ref datagram_reader.
+        /// @headerfile nil/network/marshalling/datagram.h
+        struct datagram_statistics {
+            std::uint64_t datagrams = 0;    ///< Number of received datagrams.
+            std::uint64_t messages = 0;     ///< Number of dispatched messages.
+            std::uint64_t truncated = 0;    ///< Number of datagrams dropped due to truncation.
+            std::uint64_t malformed = 0;    ///< Number of datagrams containing invalid frame(s).
+        };
+
+        /// @brief Batched datagram reader.
+        /// @details Receives up to @b TCapacity datagrams per system call (using
+        ///     @b recvmmsg()) into the preallocated buffers, which are reused between
+        ///     the calls. The kernel receive timestamps (see @ref enable_receive_timestamps())
+        ///     are captured per datagram. Linux only.
+        /// @tparam TCapacity Maximal number of datagrams received by single call.
+        /// @tparam TMaxLength Maximal length of the single datagram.
+        /// @tparam TByte Type of the buffer element, must be compatible with the read
+        ///     iterator of the message interface (pointer to const @b TByte).
+        /// @headerfile nil/network/marshalling/datagram.h
+        template<std::size_t TCapacity, std::size_t TMaxLength = 1500U, typename TByte = std::uint8_t>
+        class datagram_reader {
+            static_assert(0U < TCapacity, "Capacity must be positive");
+            static_assert(sizeof(TByte) == sizeof(std::uint8_t), "Buffer element must be a byte");
+
+        public:
+            /// @brief Type of the buffer element.
+            using byte_type = TByte;
+
+            /// @brief Maximal number of datagrams received by single call.
+            static constexpr std::size_t capacity() {
+                return TCapacity;
+            }
+
+            /// @brief Maximal length of the single datagram.
+            static constexpr std::size_t max_length() {
+                return TMaxLength;
+            }
+
+            /// @brief Constructor
+            datagram_reader() {
+                for (std::size_t idx = 0U; idx < TCapacity; ++idx) {
+                    iovs_[idx].iov_base = &buffers_[idx][0];
+                    iovs_[idx].iov_len = TMaxLength;
+                }
+            }
+
+            /// @brief Copy constructor is deleted, the message headers refer to internal buffers.
+            datagram_reader(const datagram_reader &) = delete;
+
+            /// @brief Copy assignment is deleted.
+            datagram_reader &operator=(const datagram_reader &) = delete;
+
+            /// @brief Receive the datagrams.
+            /// @details Previously received datagrams are discarded.
+            /// @param[in] fd Socket descriptor.
+            /// @param[in] flags Flags passed to @b recvmmsg(), by default returns after
+            ///     the first datagram if no more are available.
+            /// @return Number of received datagrams, 0 on error (see @ref error()).
+            std::size_t receive(int fd, int flags = MSG_WAITFORONE) {
+                for (std::size_t idx = 0U; idx < TCapacity; ++idx) {
+                    auto &hdr = headers_[idx].msg_hdr;
+                    hdr.msg_name = &sources_[idx];
+                    hdr.msg_namelen = sizeof(sources_[idx]);
+                    hdr.msg_iov = &iovs_[idx];
+                    hdr.msg_iovlen = 1U;
+                    hdr.msg_control = &controls_[idx].buf_[0];
+                    hdr.msg_controllen = sizeof(controls_[idx].buf_);
+                    hdr.msg_flags = 0;
+                    headers_[idx].msg_len = 0U;
+                }
+
+                auto result = ::recvmmsg(fd, &headers_[0], static_cast<unsigned>(TCapacity), flags, nullptr);
+                if (result < 0) {
+                    error_ = errno;
+                    count_ = 0U;
+                    return 0U;
+                }
+
+                error_ = 0;
+                count_ = static_cast<std::size_t>(result);
+                for (std::size_t idx = 0U; idx < count_; ++idx) {
+                    timestamps_[idx] = detail::receive_timestamp(headers_[idx].msg_hdr, hardware_timestamps_[idx]);
+                }
+                stats_.datagrams += count_;
+                return count_;
+            }
+
+            /// @brief Number of datagrams received by the last @ref receive() call.
+            std::size_t count() const {
+                return count_;
+            }
+
+            /// @brief Error code (errno) of the last failed @ref receive() call, 0 if succeeded.
+            int error() const {
+                return error_;
+            }
+
+            /// @brief Access the contents of the received datagram.
+            const byte_type *data(std::size_t idx) const {
+                return &buffers_[idx][0];
+            }
+
+            /// @brief Length of the received datagram.
+            std::size_t length(std::size_t idx) const {
+                return static_cast<std::size_t>(headers_[idx].msg_len);
+            }
+
+            /// @brief Check whether the received datagram has been truncated
+            ///     due to insufficient buffer length.
+            bool truncated(std::size_t idx) const {
+                return (headers_[idx].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+            }
+
+            /// @brief Source address of the received datagram.
+            const ::sockaddr_storage &source(std::size_t idx) const {
+                return sources_[idx];
+            }
+
+            /// @brief Kernel receive timestamp of the datagram.
+            /// @details Zero if the timestamps are not enabled on the socket.
+            receive_time_type timestamp(std::size_t idx) const {
+                return timestamps_[idx];
+            }
+
+            /// @brief Raw hardware receive timestamp of the datagram.
+            /// @details Zero if the hardware timestamps are not enabled on the socket
+            ///     or not supported by the network adapter. Note the clock domain
+            ///     (see @ref hardware_receive_time_type).
+            hardware_receive_time_type hardware_timestamp(std::size_t idx) const {
+                return hardware_timestamps_[idx];
+            }
+
+            /// @brief Read and dispatch the messages from all the received datagrams.
+            /// @details Every datagram is processed using @ref dispatch_datagram(),
+            ///     the truncated datagrams are dropped without decoding. The context-capable
+            ///     handlers receive @ref datagram_frame_context of every datagram.
+            /// @param[in] stack Protocol stack.
+            /// @param[in] handler Handler object.
+            /// @param[in] framesCount Expected number of frames per datagram, 0 means
+            ///     all the frames until the end of the datagram.
+            /// @return Number of dispatched messages.
+            template<typename TStack, typename THandler>
+            std::size_t process(TStack &stack, THandler &handler, std::size_t framesCount = 0U) {
+                std::size_t dispatched = 0U;
+                for (std::size_t idx = 0U; idx < count_; ++idx) {
+                    if (truncated(idx)) {
+                        ++stats_.truncated;
+                        continue;
+                    }
+
+                    auto len = length(idx);
+                    datagram_frame_context context
+                        = {timestamps_[idx], &sources_[idx], idx, hardware_timestamps_[idx]};
+                    auto msgsCount = dispatch_datagram(stack, data(idx), len, handler, framesCount, context);
+                    if ((msgsCount == 0U) || ((framesCount != 0U) && (msgsCount < framesCount))) {
+                        ++stats_.malformed;
+                    }
+                    dispatched += msgsCount;
+                }
+
+                stats_.messages += dispatched;
+                return dispatched;
+            }
+
+            /// @brief Gathered statistics.
+            const datagram_statistics &statistics() const {
+                return stats_;
+            }
+
+        private:
+            std::array<std::array<byte_type, TMaxLength>, TCapacity> buffers_;
+            std::array<::iovec, TCapacity> iovs_;
+            std::array<::mmsghdr, TCapacity> headers_;
+            struct control_buffer {
+                alignas(::cmsghdr) char buf_[CMSG_SPACE(sizeof(::timespec) * 3U)];
+            };
+
+            std::array<::sockaddr_storage, TCapacity> sources_;
+            std::array<control_buffer, TCapacity> controls_;
+            std::array<receive_time_type, TCapacity> timestamps_;
+            std::array<hardware_receive_time_type, TCapacity> hardware_timestamps_;
+            datagram_statistics stats_;
+            std::size_t count_ = 0U;
+            int error_ = 0;
+        };
+
+        /// @brief Batched datagram writer.
+        /// @details Serializes messages into the preallocated buffers, one frame per
+        ///     datagram, and sends up to @b TCapacity datagrams per system call (using
+        ///     @b sendmmsg()). Linux only.
+        /// @tparam TCapacity Maximal number of datagrams sent by single call.
+        /// @tparam TMaxLength Maximal length of the single datagram.
+        /// @tparam TByte Type of the buffer element, must be compatible with the write
+        ///     iterator of the message interface (pointer to @b TByte).
+        /// @headerfile nil/network/marshalling/datagram.h
+        template<std::size_t TCapacity, std::size_t TMaxLength = 1500U, typename TByte = std::uint8_t>
+        class datagram_writer {
+            static_assert(0U < TCapacity, "Capacity must be positive");
+            static_assert(sizeof(TByte) == sizeof(std::uint8_t), "Buffer element must be a byte");
+
+        public:
+            /// @brief Type of the buffer element.
+            using byte_type = TByte;
+
+            /// @brief Maximal number of datagrams sent by single call.
+            static constexpr std::size_t capacity() {
+                return TCapacity;
+            }
+
+            /// @brief Maximal length of the single datagram.
+            static constexpr std::size_t max_length() {
+                return TMaxLength;
+            }
+
+            /// @brief Constructor
+            datagram_writer() = default;
+
+            /// @brief Copy constructor is deleted, the message headers refer to internal buffers.
+            datagram_writer(const datagram_writer &) = delete;
+
+            /// @brief Copy assignment is deleted.
+            datagram_writer &operator=(const datagram_writer &) = delete;
+
+            /// @brief Serialize the message into the next datagram.
+            /// @param[in] stack Protocol stack.
+            /// @param[in] msg Message object.
+            /// @param[in] dest Destination address, nullptr for the connected sockets.
+            /// @param[in] destLen Length of the destination address.
+            /// @return Status of the write operation, nil::marshalling::status_type::buffer_overflow
+            ///     when all the datagrams are in use, nil::marshalling::status_type::not_supported
+            ///     when the destination address does not fit into @b sockaddr_storage.
+            template<typename TStack, typename TMsg>
+            status_type append(TStack &stack, const TMsg &msg, const ::sockaddr *dest = nullptr,
+                               ::socklen_t destLen = 0U) {
+                if (TCapacity <= count_) {
+                    return status_type::buffer_overflow;
+                }
+
+                if ((dest != nullptr) && (sizeof(::sockaddr_storage) < static_cast<std::size_t>(destLen))) {
+                    return status_type::not_supported;
+                }
+
+                auto *begIter = &buffers_[count_][0];
+                auto iter = begIter;
+                auto es = stack.write(msg, iter, TMaxLength);
+                if (es != status_type::success) {
+                    return es;
+                }
+
+                iovs_[count_].iov_base = begIter;
+                iovs_[count_].iov_len = static_cast<std::size_t>(std::distance(begIter, iter));
+
+                auto &hdr = headers_[count_].msg_hdr;
+                std::memset(&hdr, 0, sizeof(hdr));
+                hdr.msg_iov = &iovs_[count_];
+                hdr.msg_iovlen = 1U;
+                if (dest != nullptr) {
+                    std::memcpy(&dests_[count_], dest, destLen);
+                    hdr.msg_name = &dests_[count_];
+                    hdr.msg_namelen = destLen;
+                }
+
+                ++count_;
+                return status_type::success;
+            }
+
+            /// @brief Number of datagrams pending to be sent.
+            std::size_t pending() const {
+                return count_ - sent_;
+            }
+
+            /// @brief Send the pending datagrams.
+            /// @details Datagrams, which could not be sent remain pending and are
+            ///     sent by the next call. Once all the datagrams are sent, the buffers
+            ///     become available to @ref append().
+            /// @param[in] fd Socket descriptor.
+            /// @param[in] flags Flags passed to @b sendmmsg().
+            /// @return Number of datagrams sent by this call.
+            std::size_t flush(int fd, int flags = 0) {
+                std::size_t sentCount = 0U;
+                while (sent_ < count_) {
+                    auto result
+                        = ::sendmmsg(fd, &headers_[sent_], static_cast<unsigned>(count_ - sent_), flags);
+                    if (result <= 0) {
+                        error_ = (result < 0) ? errno : 0;
+                        return sentCount;
+                    }
+
+                    sent_ += static_cast<std::size_t>(result);
+                    sentCount += static_cast<std::size_t>(result);
+                }
+
+                error_ = 0;
+                count_ = 0U;
+                sent_ = 0U;
+                return sentCount;
+            }
+
+            /// @brief Error code (errno) of the last failed @ref flush() call, 0 if succeeded.
+            int error() const {
+                return error_;
+            }
+
+        private:
+            std::array<std::array<byte_type, TMaxLength>, TCapacity> buffers_;
+            std::array<::iovec, TCapacity> iovs_;
+            std::array<::mmsghdr, TCapacity> headers_;
+            std::array<::sockaddr_storage, TCapacity> dests_;
+            std::size_t count_ = 0U;
+            std::size_t sent_ = 0U;
+            int error_ = 0;
+        };
+
+#endif    // #if defined(__linux__)
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_DATAGRAM_HPP
@@ -40,6 +40,8 @@
 #include <nil/marshalling/assert_type.hpp>
 #include <nil/marshalling/processing/tuple.hpp>
 
+#include <nil/network/marshalling/msg_budget.hpp>
+
 namespace nil {
     namespace marshalling {
         namespace processing {
@@ -102,6 +104,61 @@ namespace nil {
                         bool *allocated_;
                     };
 
+
+                    template<typename T>
+                    class budget_deleter {
+                        template<typename U>
+                        friend class budget_deleter;
+
+                    public:
+                        budget_deleter(msg_memory_budget *budget = nullptr, std::size_t bytes = 0U) :
+                            budget_(budget), bytes_(bytes) {
+                        }
+
+                        template<typename U>
+                        budget_deleter(const budget_deleter<U> &other) : budget_(other.budget_), bytes_(other.bytes_) {
+                            static_assert(std::is_convertible<U *, T *>::value,
+                                          "To make Deleter convertible, their template parameters "
+                                          "must be convertible.");
+                        }
+
+                        void operator()(T *obj) const {
+                            delete obj;
+                            if (budget_ != nullptr) {
+                                budget_->release(bytes_);
+                            }
+                        }
+
+                    private:
+                        msg_memory_budget *budget_;
+                        std::size_t bytes_;
+                    };
+
+                    class budget_guard {
+                    public:
+                        budget_guard(msg_memory_budget &budget, std::size_t bytes) :
+                            budget_(&budget), bytes_(bytes) {
+                        }
+
+                        budget_guard(const budget_guard &) = delete;
+
+                        budget_guard &operator=(const budget_guard &) = delete;
+
+                        ~budget_guard() noexcept {
+                            if (budget_ != nullptr) {
+                                budget_->release(bytes_);
+                            }
+                        }
+
+                        void dismiss() {
+                            budget_ = nullptr;
+                        }
+
+                    private:
+                        msg_memory_budget *budget_;
+                        std::size_t bytes_;
+                    };
+
                 }    // namespace detail
             }    // namespace alloc
         }    // namespace processing
@@ -0,0 +1,73 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_DETAIL_EXACT_TYPE_HPP
+#define NETWORK_MARSHALLING_DETAIL_EXACT_TYPE_HPP
+
+#if defined(__GXX_RTTI) || defined(_CPPRTTI) || defined(__cpp_rtti)
+#include <typeinfo>
+#define NETWORK_MARSHALLING_RTTI 1
+#else
+#define NETWORK_MARSHALLING_RTTI 0
+#endif
+
+namespace nil {
+    namespace marshalling {
+        namespace detail {
+
+            template<typename TMessage, bool TRtti = (NETWORK_MARSHALLING_RTTI != 0)>
+            struct exact_type_checker;
+
+#if NETWORK_MARSHALLING_RTTI
+            template<typename TMessage>
+            struct exact_type_checker<TMessage, true> {
+                static constexpr bool supported() {
+                    return true;
+                }
+
+                template<typename TMsgBase>
+                static bool check(const TMsgBase &msg) {
+                    return typeid(msg) == typeid(TMessage);
+                }
+            };
+#endif
+
+            template<typename TMessage>
+            struct exact_type_checker<TMessage, false> {
+                static constexpr bool supported() {
+                    return false;
+                }
+
+                template<typename TMsgBase>
+                static bool check(const TMsgBase &) {
+                    return false;
+                }
+            };
+
+        }    // namespace detail
+    }        // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_DETAIL_EXACT_TYPE_HPP
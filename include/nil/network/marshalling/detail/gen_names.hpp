@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_GEN_NAMES_HPP
+#define NETWORK_MARSHALLING_GEN_NAMES_HPP
+
+#include <cstddef>
+
+#include <nil/marshalling/detail/macro_common.hpp>
+
+#define MARSHALLING_WRAP_NAME(v_) #v_
+
+#define MARSHALLING_NAME_VAL_0(...)
+#define MARSHALLING_NAME_VAL_1(v_) MARSHALLING_WRAP_NAME(v_)
+#define MARSHALLING_NAME_VAL_2(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_1(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_3(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_2(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_4(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_3(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_5(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_4(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_6(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_5(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_7(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_6(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_8(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_7(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_9(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_8(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_10(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_9(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_11(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_10(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_12(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_11(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_13(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_12(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_14(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_13(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_15(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_14(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_16(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_15(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_17(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_16(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_18(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_17(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_19(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_18(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_20(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_19(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_21(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_20(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_22(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_21(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_23(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_22(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_24(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_23(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_25(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_24(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_26(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_25(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_27(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_26(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_28(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_27(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_29(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_28(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_30(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_29(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_31(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_30(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_32(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_31(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_33(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_32(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_34(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_33(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_35(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_34(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_36(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_35(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_37(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_36(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_38(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_37(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_39(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_38(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_40(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_39(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_41(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_40(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_42(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_41(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_43(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_42(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_44(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_43(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_45(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_44(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_46(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_45(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_47(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_46(__VA_ARGS__))
+#define MARSHALLING_NAME_VAL_48(v_, ...) \
+    MARSHALLING_WRAP_NAME(v_), MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_47(__VA_ARGS__))
+
+#define MARSHALLING_CHOOSE_NAMES_(N, ...) MARSHALLING_EXPAND(MARSHALLING_NAME_VAL_##N(__VA_ARGS__))
+#define MARSHALLING_CHOOSE_NAMES(N, ...) MARSHALLING_EXPAND(MARSHALLING_CHOOSE_NAMES_(N, __VA_ARGS__))
+#define MARSHALLING_DO_NAMES(...) \
+    MARSHALLING_EXPAND(MARSHALLING_CHOOSE_NAMES(MARSHALLING_NUM_ARGS(__VA_ARGS__), __VA_ARGS__))
+
+#define MARSHALLING_DEFINE_NAMES_FUNC(f_, ...)                                                    \
+    static const char *f_(std::size_t idx) {                                                      \
+        static const char *const Names[] = {MARSHALLING_EXPAND(MARSHALLING_DO_NAMES(__VA_ARGS__))}; \
+        return (idx < (sizeof(Names) / sizeof(Names[0]))) ? Names[idx] : nullptr;                 \
+    }
+#endif    // NETWORK_MARSHALLING_GEN_NAMES_HPP
@@ -35,6 +35,9 @@
 #include <nil/marshalling/processing/tuple.hpp>
 #include <nil/marshalling/status_type.hpp>
 #include <nil/network/marshalling/detail/message/implementation_options_parser.hpp>
+#ifdef MARSHALLING_TRACING
+#include <nil/network/marshalling/trace.hpp>
+#endif
 
 namespace nil {
     namespace marshalling {
@@ -1130,6 +1133,9 @@ namespace nil {
                     virtual typename TBase::DispatchRetType
                         dispatch_impl(typename TBase::handler_type &handler) override {
                         static_assert(std::is_base_of<TBase, TActual>::value, "TActual is not derived class");
+#ifdef MARSHALLING_TRACING
+                        MARSHALLING_TRACE_SPAN("dispatch");
+#endif
                         return handler.handle(static_cast<TActual &>(*this));
                     }
                 };
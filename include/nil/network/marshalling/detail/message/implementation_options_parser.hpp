@@ -52,6 +52,8 @@ namespace nil {
                     constexpr static const bool has_custom_refresh = false;
                     constexpr static const bool has_name = false;
                     constexpr static const bool has_do_get_id = false;
+                    constexpr static const bool has_dispatch_priority = false;
+                    constexpr static const std::intmax_t dispatch_priority = 0;
                 };
 
                 template<std::intmax_t TId, typename... TOptions>
@@ -72,6 +74,19 @@ namespace nil {
                     constexpr static const auto msg_id = TId;
                 };
 
+                template<std::intmax_t TPriority, typename... TOptions>
+                class impl_options_parser<nil::marshalling::option::dispatch_priority<TPriority>, TOptions...>
+                    : public impl_options_parser<TOptions...> {
+                    using base_impl_type = impl_options_parser<TOptions...>;
+
+                    static_assert(!base_impl_type::has_dispatch_priority,
+                                  "nil::marshalling::option::dispatch_priority option is used more than once");
+
+                public:
+                    constexpr static const bool has_dispatch_priority = true;
+                    constexpr static const std::intmax_t dispatch_priority = TPriority;
+                };
+
                 template<typename... TOptions>
                 class impl_options_parser<nil::marshalling::option::no_dispatch_impl, TOptions...>
                     : public impl_options_parser<TOptions...> {
@@ -34,6 +34,10 @@
 #include <nil/marshalling/assert_type.hpp>
 #include <nil/marshalling/processing/tuple.hpp>
 #include <nil/network/marshalling/alloc.hpp>
+#include <nil/network/marshalling/detail/exact_type.hpp>
+#ifdef MARSHALLING_TRACING
+#include <nil/network/marshalling/trace.hpp>
+#endif
 
 namespace nil {
     namespace marshalling {
@@ -71,7 +75,39 @@ namespace nil {
 
                 template<typename TAll, typename TOpt>
                 using all_messages_bundle_type = typename all_messages_retrieve_helper<
-                    TOpt::has_in_place_allocation && TOpt::has_support_generic_message>::template type<TAll, TOpt>;
+                    (TOpt::has_in_place_allocation || TOpt::has_in_place_pool_allocation)
+                    && TOpt::has_support_generic_message>::template type<TAll, TOpt>;
+
+                template<bool THasBudget>
+                struct budgeted_allocator_helper;
+
+                template<>
+                struct budgeted_allocator_helper<true> {
+                    template<typename TMsgBase, typename TOpt>
+                    using type = processing::alloc::budgeted_dyn_memory<TMsgBase, typename TOpt::budget_tag>;
+                };
+
+                template<>
+                struct budgeted_allocator_helper<false> {
+                    template<typename TMsgBase, typename TOpt>
+                    using type = processing::alloc::dyn_memory<TMsgBase>;
+                };
+
+                template<bool THasPool>
+                struct pool_allocator_helper;
+
+                template<>
+                struct pool_allocator_helper<true> {
+                    template<typename TMsgBase, typename TAll, typename TOpt>
+                    using type = processing::alloc::in_place_pool<TMsgBase, TOpt::in_place_pool_size, TAll>;
+                };
+
+                template<>
+                struct pool_allocator_helper<false> {
+                    template<typename TMsgBase, typename TAll, typename TOpt>
+                    using type = typename budgeted_allocator_helper<TOpt::has_budgeted_allocation>::template type<
+                        TMsgBase, TOpt>;
+                };
 
                 template<typename TMsgBase, typename TAllMessages, typename... TOptions>
                 class base {
@@ -83,10 +119,20 @@ namespace nil {
 
                     using all_messages_internal_type
                         = all_messages_bundle_type<TAllMessages, parsed_options_internal_type>;
+                    static_assert(!(parsed_options_internal_type::has_in_place_allocation
+                                    && parsed_options_internal_type::has_budgeted_allocation),
+                                  "The in_place_allocation and budgeted_allocation options cannot be combined");
+                    static_assert(!(parsed_options_internal_type::has_in_place_pool_allocation
+                                    && (parsed_options_internal_type::has_in_place_allocation
+                                        || parsed_options_internal_type::has_budgeted_allocation)),
+                                  "The in_place_pool_allocation option cannot be combined with in_place_allocation "
+                                  "or budgeted_allocation");
+
                     using allocator_type = typename std::conditional<
                         parsed_options_internal_type::has_in_place_allocation,
                         processing::alloc::in_place_single<TMsgBase, all_messages_internal_type>,
-                        processing::alloc::dyn_memory<TMsgBase>>::type;
+                        typename pool_allocator_helper<parsed_options_internal_type::has_in_place_pool_allocation>::
+                            template type<TMsgBase, all_messages_internal_type, parsed_options_internal_type>>::type;
 
                 public:
                     using parsed_options_type = parsed_options_internal_type;
@@ -105,6 +151,19 @@ namespace nil {
                         return create_generic_msg_internal(id, tag());
                     }
 
+                    template<typename TObj>
+                    msg_ptr_type alloc_clone(const TObj &msg) const {
+                        static_assert(std::is_copy_constructible<TObj>::value,
+                                      "Cloned message type must be copy constructible");
+                        static_assert(!parsed_options_internal_type::has_in_place_allocation,
+                                      "Cloning is not supported with in_place_allocation option, the only in-place "
+                                      "storage is occupied by the message being cloned");
+#ifdef MARSHALLING_TRACING
+                        MARSHALLING_TRACE_SPAN("factory_clone");
+#endif
+                        return alloc_msg<TObj>(msg);
+                    }
+
                 protected:
                     base() = default;
 
@@ -116,6 +175,22 @@ namespace nil {
 
                     base &operator=(base &&) = default;
 
+                    class factory_method;
+
+                    msg_ptr_type clone_by_method(const factory_method *method, const TMsgBase &msg) const {
+                        static_assert(!parsed_options_internal_type::has_in_place_allocation,
+                                      "Cloning is not supported with in_place_allocation option, the only in-place "
+                                      "storage is occupied by the message being cloned");
+                        static_assert(exact_type_checker<TMsgBase>::supported(),
+                                      "Cloning via message interface requires RTTI to verify the actual type "
+                                      "of the message");
+                        if (method == nullptr) {
+                            return msg_ptr_type();
+                        }
+
+                        return method->clone(*this, msg);
+                    }
+
                     class factory_method {
                     public:
                         msg_id_param_type get_id() const {
@@ -126,12 +201,18 @@ namespace nil {
                             return create_impl(factory);
                         }
 
+                        msg_ptr_type clone(const base &factory, const TMsgBase &msg) const {
+                            return clone_impl(factory, msg);
+                        }
+
                     protected:
                         factory_method() = default;
 
                         virtual msg_id_param_type get_id_impl() const = 0;
 
                         virtual msg_ptr_type create_impl(const base &factory) const = 0;
+
+                        virtual msg_ptr_type clone_impl(const base &factory, const TMsgBase &msg) const = 0;
                     };
 
                     template<typename TMessage>
@@ -151,6 +232,10 @@ namespace nil {
                         virtual msg_ptr_type create_impl(const base &factory) const {
                             return factory.template alloc_msg<message_type>();
                         }
+
+                        virtual msg_ptr_type clone_impl(const base &factory, const TMsgBase &msg) const {
+                            return factory.template clone_exact<message_type>(msg);
+                        }
                     };
 
                     template<typename TMessage>
@@ -173,6 +258,10 @@ namespace nil {
                             return factory.template alloc_msg<message_type>();
                         }
 
+                        virtual msg_ptr_type clone_impl(const base &factory, const TMsgBase &msg) const {
+                            return factory.template clone_exact<message_type>(msg);
+                        }
+
                     private:
                         typename message_type::msg_id_type id_;
                     };
@@ -185,16 +274,46 @@ namespace nil {
                         static_assert(std::is_base_of<message_type, TObj>::value, "TObj is not a proper message type");
 
                         static_assert(
-                            (!parsed_options_internal_type::has_in_place_allocation)
+                            (!(parsed_options_internal_type::has_in_place_allocation
+                               || parsed_options_internal_type::has_in_place_pool_allocation))
                                 || nil::detail::is_in_tuple<TObj, all_messages_internal_type>::value,
                             "TObj must be in provided tuple of supported messages");
 
+#ifdef MARSHALLING_TRACING
+                        MARSHALLING_TRACE_SPAN("factory_allocate");
+#endif
                         return alloc_.template alloc<TObj>(std::forward<TArgs>(args)...);
                     }
 
                 private:
                     struct AllocGenericTag { };
                     struct NoAllocTag { };
+                    struct CloneTag { };
+                    struct NoCloneTag { };
+
+                    template<typename TObj>
+                    msg_ptr_type clone_exact(const TMsgBase &msg) const {
+                        using tag = typename std::conditional<(!parsed_options_type::has_in_place_allocation)
+                                                                  && exact_type_checker<TObj>::supported(),
+                                                              CloneTag,
+                                                              NoCloneTag>::type;
+
+                        return clone_exact_internal<TObj>(msg, tag());
+                    }
+
+                    template<typename TObj>
+                    msg_ptr_type clone_exact_internal(const TMsgBase &msg, CloneTag) const {
+                        if (!exact_type_checker<TObj>::check(msg)) {
+                            return msg_ptr_type();
+                        }
+
+                        return alloc_clone<TObj>(static_cast<const TObj &>(msg));
+                    }
+
+                    template<typename TObj>
+                    static msg_ptr_type clone_exact_internal(const TMsgBase &, NoCloneTag) {
+                        return msg_ptr_type();
+                    }
 
                     msg_ptr_type create_generic_msg_internal(msg_id_param_type id, AllocGenericTag) const {
                         static_assert(
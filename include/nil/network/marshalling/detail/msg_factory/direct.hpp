@@ -62,6 +62,17 @@ namespace nil {
                         return method->create(*this);
                     }
 
+                    msg_ptr_type clone_msg(const TMsgBase &msg, unsigned idx = 0) const {
+                        static_assert(TMsgBase::has_get_id(),
+                                      "Cloning via message interface requires polymorphic ID retrieval. "
+                                      "Use nil::marshalling::option::id_info_interface option in message interface.");
+                        if (0 < idx) {
+                            return msg_ptr_type();
+                        }
+
+                        return base_impl_type::clone_by_method(get_method(msg.get_id()), msg);
+                    }
+
                     std::size_t msg_count(msg_id_param_type id) const {
                         auto method = get_method(id);
                         if (method == nullptr) {
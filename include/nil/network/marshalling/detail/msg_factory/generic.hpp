@@ -44,20 +44,19 @@ namespace nil {
                     using msg_id_type = typename base_impl_type::msg_id_type;
 
                     msg_ptr_type create_msg(msg_id_param_type id, unsigned idx = 0) const {
-                        auto range = std::equal_range(
-                            base_impl_type::registry().begin(), base_impl_type::registry().end(), id,
-                            [](const comp_wrapper &idWrapper1, const comp_wrapper &idWrapper2) -> bool {
-                                return idWrapper1.get_id() < idWrapper2.get_id();
-                            });
-
-                        auto dist = static_cast<unsigned>(std::distance(range.first, range.second));
-                        if (dist <= idx) {
+                        auto method = get_method(id, idx);
+                        if (method == nullptr) {
                             return msg_ptr_type();
                         }
 
-                        auto iter = range.first + idx;
-                        MARSHALLING_ASSERT(*iter);
-                        return (*iter)->create(*this);
+                        return method->create(*this);
+                    }
+
+                    msg_ptr_type clone_msg(const TMsgBase &msg, unsigned idx = 0) const {
+                        static_assert(TMsgBase::has_get_id(),
+                                      "Cloning via message interface requires polymorphic ID retrieval. "
+                                      "Use nil::marshalling::option::id_info_interface option in message interface.");
+                        return base_impl_type::clone_by_method(get_method(msg.get_id(), idx), msg);
                     }
 
                     std::size_t msg_count(msg_id_param_type id) const {
@@ -77,6 +76,23 @@ namespace nil {
                 private:
                     using factory_method_type = typename base_impl_type::factory_method_type;
 
+                    const factory_method_type *get_method(msg_id_param_type id, unsigned idx) const {
+                        auto range = std::equal_range(
+                            base_impl_type::registry().begin(), base_impl_type::registry().end(), id,
+                            [](const comp_wrapper &idWrapper1, const comp_wrapper &idWrapper2) -> bool {
+                                return idWrapper1.get_id() < idWrapper2.get_id();
+                            });
+
+                        auto dist = static_cast<unsigned>(std::distance(range.first, range.second));
+                        if (dist <= idx) {
+                            return nullptr;
+                        }
+
+                        auto iter = range.first + idx;
+                        MARSHALLING_ASSERT(*iter);
+                        return *iter;
+                    }
+
                     class comp_wrapper {
                     public:
                         comp_wrapper(msg_id_param_type id) : m_id(id) {
@@ -41,6 +41,8 @@ namespace nil {
                 public:
                     static const bool has_in_place_allocation = false;
                     static const bool has_support_generic_message = false;
+                    static const bool has_budgeted_allocation = false;
+                    static const bool has_in_place_pool_allocation = false;
                 };
 
                 template<typename... TOptions>
@@ -50,6 +52,22 @@ namespace nil {
                     static const bool has_in_place_allocation = true;
                 };
 
+                template<std::size_t TSize, typename... TOptions>
+                class options_parser<nil::marshalling::option::in_place_pool_allocation<TSize>, TOptions...>
+                    : public options_parser<TOptions...> {
+                public:
+                    static const bool has_in_place_pool_allocation = true;
+                    static const std::size_t in_place_pool_size = TSize;
+                };
+
+                template<typename TTag, typename... TOptions>
+                class options_parser<nil::marshalling::option::budgeted_allocation<TTag>, TOptions...>
+                    : public options_parser<TOptions...> {
+                public:
+                    static const bool has_budgeted_allocation = true;
+                    using budget_tag = TTag;
+                };
+
                 template<typename TMsg, typename... TOptions>
                 class options_parser<nil::marshalling::option::support_generic_message<TMsg>, TOptions...>
                     : public options_parser<TOptions...> {
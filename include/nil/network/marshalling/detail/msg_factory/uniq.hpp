@@ -48,28 +48,27 @@ namespace nil {
                             return msg_ptr_type();
                         }
 
-                        auto iter = find_method(id);
-                        if (iter == base_impl_type::registry().end()) {
+                        auto method = get_method(id);
+                        if (method == nullptr) {
                             return msg_ptr_type();
                         }
 
-                        MARSHALLING_ASSERT(*iter != nullptr);
-                        if ((*iter)->get_id() != id) {
+                        return method->create(*this);
+                    }
+
+                    msg_ptr_type clone_msg(const TMsgBase &msg, unsigned idx = 0) const {
+                        static_assert(TMsgBase::has_get_id(),
+                                      "Cloning via message interface requires polymorphic ID retrieval. "
+                                      "Use nil::marshalling::option::id_info_interface option in message interface.");
+                        if (0 < idx) {
                             return msg_ptr_type();
                         }
 
-                        return (*iter)->create(*this);
+                        return base_impl_type::clone_by_method(get_method(msg.get_id()), msg);
                     }
 
                     std::size_t msg_count(msg_id_param_type id) const {
-                        auto iter = find_method(id);
-
-                        if (iter == base_impl_type::registry().end()) {
-                            return 0U;
-                        }
-
-                        MARSHALLING_ASSERT(*iter != nullptr);
-                        if ((*iter)->get_id() != id) {
+                        if (get_method(id) == nullptr) {
                             return 0U;
                         }
 
@@ -91,6 +90,20 @@ namespace nil {
                                 return method->get_id() < idParam;
                             });
                     }
+
+                    const factory_method_type *get_method(msg_id_param_type id) const {
+                        auto iter = find_method(id);
+                        if (iter == base_impl_type::registry().end()) {
+                            return nullptr;
+                        }
+
+                        MARSHALLING_ASSERT(*iter != nullptr);
+                        if ((*iter)->get_id() != id) {
+                            return nullptr;
+                        }
+
+                        return *iter;
+                    }
                 };
 
             }    // namespace msg_factory
@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_DETAIL_TEXT_EXPORT_FORMAT_HPP
+#define NETWORK_MARSHALLING_DETAIL_TEXT_EXPORT_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if (__cplusplus >= 201703L) && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace nil {
+    namespace marshalling {
+        namespace detail {
+            namespace text_export {
+
+                /// @brief Max number of characters required to format any integral value.
+                static const std::size_t max_integral_chars = std::numeric_limits<std::uint64_t>::digits10 + 2U;
+
+                /// @brief Max number of characters required to format floating point value.
+                static const std::size_t max_floating_point_chars = 32U;
+
+                inline const char *digits_lut() {
+                    return "00010203040506070809"
+                           "10111213141516171819"
+                           "20212223242526272829"
+                           "30313233343536373839"
+                           "40414243444546474849"
+                           "50515253545556575859"
+                           "60616263646566676869"
+                           "70717273747576777879"
+                           "80818283848586878889"
+                           "90919293949596979899";
+                }
+
+                inline std::size_t format_unsigned(std::uint64_t value, char *out) {
+                    char buf[max_integral_chars];
+                    char *pos = buf + max_integral_chars;
+                    auto *lut = digits_lut();
+                    while (100U <= value) {
+                        auto idx = static_cast<std::size_t>((value % 100U) * 2U);
+                        value /= 100U;
+                        *--pos = lut[idx + 1];
+                        *--pos = lut[idx];
+                    }
+
+                    if (value < 10U) {
+                        *--pos = static_cast<char>('0' + value);
+                    } else {
+                        auto idx = static_cast<std::size_t>(value * 2U);
+                        *--pos = lut[idx + 1];
+                        *--pos = lut[idx];
+                    }
+
+                    auto len = static_cast<std::size_t>((buf + max_integral_chars) - pos);
+                    std::memcpy(out, pos, len);
+                    return len;
+                }
+
+                inline std::size_t format_signed(std::int64_t value, char *out) {
+                    if (0 <= value) {
+                        return format_unsigned(static_cast<std::uint64_t>(value), out);
+                    }
+
+                    *out = '-';
+                    return 1U + format_unsigned(0U - static_cast<std::uint64_t>(value), out + 1);
+                }
+
+                template<typename T>
+                std::size_t format_integral(T value, char *out, std::true_type) {
+                    return format_signed(static_cast<std::int64_t>(value), out);
+                }
+
+                template<typename T>
+                std::size_t format_integral(T value, char *out, std::false_type) {
+                    return format_unsigned(static_cast<std::uint64_t>(value), out);
+                }
+
+                /// @brief Format integral value.
+                /// @pre @b out has at least @ref max_integral_chars bytes available.
+                template<typename T>
+                std::size_t format_integral(T value, char *out) {
+                    static_assert(std::is_integral<T>::value, "Integral type is expected");
+                    return format_integral(value, out, std::integral_constant<bool, std::is_signed<T>::value>());
+                }
+
+                /// @brief Format floating point value using the shortest representation
+                ///     which is guaranteed to be parsed back to the same value.
+                /// @pre @b out has at least @ref max_floating_point_chars bytes available.
+                template<typename T>
+                std::size_t format_floating_point(T value, char *out) {
+                    static_assert(std::is_floating_point<T>::value, "Floating point type is expected");
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+                    auto result = std::to_chars(out, out + max_floating_point_chars, value);
+                    return static_cast<std::size_t>(result.ptr - out);
+#else
+                    auto len = std::snprintf(out, max_floating_point_chars, "%.*g",
+                                             std::numeric_limits<T>::max_digits10, static_cast<double>(value));
+                    return (len < 0) ? 0U : static_cast<std::size_t>(len);
+#endif
+                }
+
+                inline char hex_digit(unsigned value) {
+                    return "0123456789abcdef"[value & 0xfU];
+                }
+
+            }    // namespace text_export
+        }        // namespace detail
+    }            // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_DETAIL_TEXT_EXPORT_FORMAT_HPP
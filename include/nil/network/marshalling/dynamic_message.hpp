@@ -0,0 +1,838 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Provides implementation of @ref nil::marshalling::dynamic_message class and
+/// the runtime schemas describing its contents.
+
+#ifndef NETWORK_MARSHALLING_DYNAMIC_MESSAGE_HPP
+#define NETWORK_MARSHALLING_DYNAMIC_MESSAGE_HPP
+
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nil/network/marshalling/options.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Kind of the field described by @ref dynamic_field_def.
+        enum class dynamic_field_kind : std::uint8_t {
+            unsigned_integral,    ///< Unsigned integral value.
+            signed_integral,      ///< Signed integral value.
+            list                  ///< Count prefixed list of the elements.
+        };
+
+        /// @brief Runtime definition of the single field of @ref dynamic_message.
+        /// @headerfile nil/network/marshalling/dynamic_message.h
+        struct dynamic_field_def {
+            std::string name;                                            ///< Name of the field.
+            dynamic_field_kind kind = dynamic_field_kind::unsigned_integral;    ///< Kind of the field.
+            std::uint8_t width = 1U;           ///< Serialization length (of the count prefix for lists), 1 - 8.
+            bool little_endian = false;        ///< Serialization endian of the value (count prefix for lists).
+            bool optional = false;             ///< The field exists only when the flag field matches the mask.
+            std::string flag;                  ///< Name of the preceding field of the same scope used as flag.
+            std::uint64_t mask = 0U;           ///< Mask applied to the flag value.
+            std::vector<dynamic_field_def> elements;    ///< Fields of every list element, integral only.
+        };
+
+        /// @brief Runtime definition of the message layout.
+        /// @headerfile nil/network/marshalling/dynamic_message.h
+        struct dynamic_schema {
+            std::uintmax_t id = 0U;                    ///< Numeric ID of the message.
+            std::string name;                          ///< Name of the message.
+            std::vector<dynamic_field_def> fields;     ///< Fields in the serialization order.
+        };
+
+        /// @brief Operation code of @ref dynamic_op.
+        enum class dynamic_opcode : std::uint8_t {
+            read_unsigned,    ///< Unsigned integral value.
+            read_signed,      ///< Signed integral value, sign extended.
+            list              ///< List, followed by the operations of its element.
+        };
+
+        /// @brief Single operation of the decode plan.
+        /// @headerfile nil/network/marshalling/dynamic_message.h
+        struct dynamic_op {
+            dynamic_opcode code = dynamic_opcode::read_unsigned;    ///< Operation code.
+            std::uint8_t width = 1U;                ///< Serialization length of the value or list count.
+            bool little_endian = false;             ///< Serialization endian.
+            bool optional = false;                  ///< Presence depends on the flag slot.
+            std::uint16_t slot = 0U;                ///< Slot in the field table, relative to the scope.
+            std::uint16_t flag_slot = 0U;           ///< Slot of the flag value, relative to the scope.
+            std::uint16_t element_ops = 0U;         ///< Number of the operations of the list element.
+            std::uint16_t element_slots = 0U;       ///< Number of the slots of the list element.
+            std::uint64_t mask = 0U;                ///< Mask applied to the flag value.
+        };
+
+        /// @brief Decode plan of the @ref dynamic_message compiled from @ref dynamic_schema.
+        /// @details The plan is a flat sequence of the operations, interpreted in a single
+        ///     pass over the input. The decoded values are stored in the field table of
+        ///     64 bit slots: the top level fields occupy the first @ref slots() entries,
+        ///     the list slot holds the index of the list region appended at the end of the
+        ///     table, which starts with the elements count followed by the element slots.
+        ///     Absent optional fields are stored as 0.
+        /// @headerfile nil/network/marshalling/dynamic_message.h
+        class dynamic_plan {
+        public:
+            /// @brief Compile the schema.
+            /// @return false if the schema is invalid (unsupported width, nested list,
+            ///     unknown or succeeding flag field, too many fields).
+            bool compile(const dynamic_schema &schema) {
+                ops_.clear();
+                op_names_.clear();
+                top_ops_.clear();
+                id_ = schema.id;
+                name_ = schema.name;
+                if (!compile_scope(schema.fields, true)) {
+                    ops_.clear();
+                    op_names_.clear();
+                    top_ops_.clear();
+                    return false;
+                }
+                return true;
+            }
+
+            /// @brief Numeric ID of the message.
+            std::uintmax_t id() const {
+                return id_;
+            }
+
+            /// @brief Name of the message.
+            const std::string &name() const {
+                return name_;
+            }
+
+            /// @brief Operations of the plan.
+            const std::vector<dynamic_op> &ops() const {
+                return ops_;
+            }
+
+            /// @brief Number of the top level slots.
+            std::size_t slots() const {
+                return top_ops_.size();
+            }
+
+            /// @brief Index of the top level field, slots() if not found.
+            std::size_t field_index(const std::string &name) const {
+                for (std::size_t idx = 0U; idx < top_ops_.size(); ++idx) {
+                    if (op_names_[top_ops_[idx]] == name) {
+                        return idx;
+                    }
+                }
+                return top_ops_.size();
+            }
+
+            /// @brief Index of the field within the element of the list,
+            ///     number of the element slots if not found.
+            std::size_t element_index(std::size_t listIdx, const std::string &name) const {
+                auto opIdx = top_ops_[listIdx];
+                auto &op = ops_[opIdx];
+                for (std::size_t idx = 0U; idx < op.element_ops; ++idx) {
+                    if (op_names_[opIdx + 1U + idx] == name) {
+                        return idx;
+                    }
+                }
+                return op.element_ops;
+            }
+
+            /// @brief Name of the top level field.
+            const std::string &field_name(std::size_t idx) const {
+                return op_names_[top_ops_[idx]];
+            }
+
+            /// @brief Operation of the top level field.
+            const dynamic_op &field_op(std::size_t idx) const {
+                return ops_[top_ops_[idx]];
+            }
+
+            /// @brief Decode the values into the field table.
+            template<typename TIter>
+            status_type decode(TIter &iter, std::size_t size, std::vector<std::uint64_t> &table) const {
+                table.assign(top_ops_.size(), 0U);
+                for (std::size_t opIdx = 0U; opIdx < ops_.size(); ++opIdx) {
+                    auto &op = ops_[opIdx];
+                    if (op.optional && ((table[op.flag_slot] & op.mask) == 0U)) {
+                        opIdx += op.element_ops;
+                        continue;
+                    }
+
+                    if (op.code != dynamic_opcode::list) {
+                        auto es = decode_value(op, iter, size, table[op.slot]);
+                        if (es != status_type::success) {
+                            return es;
+                        }
+                        continue;
+                    }
+
+                    std::uint64_t count = 0U;
+                    auto es = decode_value(op, iter, size, count);
+                    if (es != status_type::success) {
+                        return es;
+                    }
+
+                    if ((size / element_min_length(opIdx)) < count) {
+                        return status_type::not_enough_data;
+                    }
+
+                    auto region = table.size();
+                    table[op.slot] = region;
+                    table.resize(region + 1U + (static_cast<std::size_t>(count) * op.element_slots), 0U);
+                    table[region] = count;
+                    for (std::size_t elem = 0U; elem < count; ++elem) {
+                        auto base = region + 1U + (elem * op.element_slots);
+                        for (std::size_t elemOp = 1U; elemOp <= op.element_ops; ++elemOp) {
+                            auto &inner = ops_[opIdx + elemOp];
+                            if (inner.optional && ((table[base + inner.flag_slot] & inner.mask) == 0U)) {
+                                continue;
+                            }
+
+                            es = decode_value(inner, iter, size, table[base + inner.slot]);
+                            if (es != status_type::success) {
+                                return es;
+                            }
+                        }
+                    }
+
+                    opIdx += op.element_ops;
+                }
+
+                return status_type::success;
+            }
+
+            /// @brief Encode the values of the field table.
+            template<typename TIter>
+            status_type encode(const std::vector<std::uint64_t> &table, TIter &iter, std::size_t size) const {
+                if (size < length(table)) {
+                    return status_type::buffer_overflow;
+                }
+
+                for_each_value(table, [&iter](const dynamic_op &op, std::uint64_t value) {
+                    encode_value(op, value, iter);
+                });
+                return status_type::success;
+            }
+
+            /// @brief Serialization length of the values of the field table.
+            std::size_t length(const std::vector<std::uint64_t> &table) const {
+                std::size_t result = 0U;
+                for_each_value(table, [&result](const dynamic_op &op, std::uint64_t) { result += op.width; });
+                return result;
+            }
+
+        private:
+            bool compile_scope(const std::vector<dynamic_field_def> &fields, bool topLevel) {
+                std::vector<std::string> scopeNames;
+                for (auto &field : fields) {
+                    if ((field.width == 0U) || (8U < field.width)
+                        || (std::numeric_limits<std::uint16_t>::max() <= scopeNames.size())) {
+                        return false;
+                    }
+
+                    dynamic_op op;
+                    op.width = field.width;
+                    op.little_endian = field.little_endian;
+                    op.slot = static_cast<std::uint16_t>(scopeNames.size());
+                    op.optional = field.optional;
+                    op.mask = field.mask;
+                    if (field.optional) {
+                        std::size_t flagIdx = 0U;
+                        while ((flagIdx < scopeNames.size()) && (scopeNames[flagIdx] != field.flag)) {
+                            ++flagIdx;
+                        }
+
+                        if ((flagIdx == scopeNames.size())
+                            || (ops_[scope_op(flagIdx, topLevel)].code == dynamic_opcode::list)) {
+                            return false;
+                        }
+                        op.flag_slot = static_cast<std::uint16_t>(flagIdx);
+                    }
+
+                    scopeNames.push_back(field.name);
+                    if (field.kind != dynamic_field_kind::list) {
+                        op.code = (field.kind == dynamic_field_kind::signed_integral) ? dynamic_opcode::read_signed :
+                                                                                        dynamic_opcode::read_unsigned;
+                        if (topLevel) {
+                            top_ops_.push_back(ops_.size());
+                        } else {
+                            scope_ops_.push_back(ops_.size());
+                        }
+                        ops_.push_back(op);
+                        op_names_.push_back(field.name);
+                        continue;
+                    }
+
+                    if ((!topLevel) || field.elements.empty()) {
+                        return false;
+                    }
+
+                    op.code = dynamic_opcode::list;
+                    op.element_ops = static_cast<std::uint16_t>(field.elements.size());
+                    op.element_slots = static_cast<std::uint16_t>(field.elements.size());
+                    top_ops_.push_back(ops_.size());
+                    ops_.push_back(op);
+                    op_names_.push_back(field.name);
+                    scope_ops_.clear();
+                    if (!compile_scope(field.elements, false)) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            std::size_t scope_op(std::size_t idx, bool topLevel) const {
+                return topLevel ? top_ops_[idx] : scope_ops_[idx];
+            }
+
+            std::size_t element_min_length(std::size_t listOpIdx) const {
+                auto &op = ops_[listOpIdx];
+                std::size_t result = 0U;
+                for (std::size_t elemOp = 1U; elemOp <= op.element_ops; ++elemOp) {
+                    auto &inner = ops_[listOpIdx + elemOp];
+                    if (!inner.optional) {
+                        result += inner.width;
+                    }
+                }
+                return (result == 0U) ? 1U : result;
+            }
+
+            template<typename TIter>
+            static status_type decode_value(const dynamic_op &op, TIter &iter, std::size_t &size,
+                                            std::uint64_t &value) {
+                if (size < op.width) {
+                    return status_type::not_enough_data;
+                }
+
+                std::uint64_t result = 0U;
+                if (op.little_endian) {
+                    for (std::size_t idx = 0U; idx < op.width; ++idx) {
+                        result |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(*iter)) << (idx * 8U);
+                        ++iter;
+                    }
+                } else {
+                    for (std::size_t idx = 0U; idx < op.width; ++idx) {
+                        result = (result << 8U) | static_cast<std::uint64_t>(static_cast<std::uint8_t>(*iter));
+                        ++iter;
+                    }
+                }
+
+                if ((op.code == dynamic_opcode::read_signed) && (op.width < 8U)) {
+                    auto shift = static_cast<unsigned>((8U - op.width) * 8U);
+                    result = static_cast<std::uint64_t>(static_cast<std::int64_t>(result << shift) >> shift);
+                }
+
+                size -= op.width;
+                value = result;
+                return status_type::success;
+            }
+
+            template<typename TIter>
+            static void encode_value(const dynamic_op &op, std::uint64_t value, TIter &iter) {
+                using value_type = typename std::iterator_traits<TIter>::value_type;
+                using byte_type = typename std::conditional<std::is_void<value_type>::value, std::uint8_t,
+                                                            value_type>::type;
+                for (std::size_t idx = 0U; idx < op.width; ++idx) {
+                    auto shift = op.little_endian ? (idx * 8U) : ((op.width - 1U - idx) * 8U);
+                    *iter = static_cast<byte_type>(static_cast<std::uint8_t>(value >> shift));
+                    ++iter;
+                }
+            }
+
+            template<typename TFunc>
+            void for_each_value(const std::vector<std::uint64_t> &table, TFunc &&func) const {
+                for (std::size_t opIdx = 0U; opIdx < ops_.size(); ++opIdx) {
+                    auto &op = ops_[opIdx];
+                    if (op.optional && ((table[op.flag_slot] & op.mask) == 0U)) {
+                        opIdx += op.element_ops;
+                        continue;
+                    }
+
+                    if (op.code != dynamic_opcode::list) {
+                        func(op, table[op.slot]);
+                        continue;
+                    }
+
+                    // Region 0 is never valid, it is occupied by the top level slot.
+                    auto region = static_cast<std::size_t>(table[op.slot]);
+                    auto count = ((region != 0U) && (region < table.size())) ? table[region] : 0U;
+                    func(op, count);
+                    for (std::size_t elem = 0U; elem < count; ++elem) {
+                        auto base = region + 1U + (elem * op.element_slots);
+                        for (std::size_t elemOp = 1U; elemOp <= op.element_ops; ++elemOp) {
+                            auto &inner = ops_[opIdx + elemOp];
+                            if (inner.optional && ((table[base + inner.flag_slot] & inner.mask) == 0U)) {
+                                continue;
+                            }
+                            func(inner, table[base + inner.slot]);
+                        }
+                    }
+
+                    opIdx += op.element_ops;
+                }
+            }
+
+            std::uintmax_t id_ = 0U;
+            std::string name_;
+            std::vector<dynamic_op> ops_;
+            std::vector<std::string> op_names_;
+            std::vector<std::size_t> top_ops_;
+            std::vector<std::size_t> scope_ops_;
+        };
+
+        /// @brief Collection of the compiled @ref dynamic_plan objects indexed by the message ID.
+        /// @details All the schemas are expected to be added before the messages
+        ///     referring to them are created.
+        /// @headerfile nil/network/marshalling/dynamic_message.h
+        class dynamic_schema_set {
+        public:
+            /// @brief Compile and add the schema.
+            /// @return false if the schema is invalid or its ID has already been added.
+            bool add(const dynamic_schema &schema) {
+                if (index_.find(schema.id) != index_.end()) {
+                    return false;
+                }
+
+                dynamic_plan plan;
+                if (!plan.compile(schema)) {
+                    return false;
+                }
+
+                index_.insert(std::make_pair(schema.id, plans_.size()));
+                plans_.push_back(std::move(plan));
+                return true;
+            }
+
+            /// @brief Find the plan of the message.
+            /// @return nullptr if the ID is unknown.
+            const dynamic_plan *find(std::uintmax_t id) const {
+                auto iter = index_.find(id);
+                if (iter == index_.end()) {
+                    return nullptr;
+                }
+                return &plans_[iter->second];
+            }
+
+            /// @brief Number of the schemas.
+            std::size_t size() const {
+                return plans_.size();
+            }
+
+            /// @brief Parse and add the schemas in the textual format.
+            /// @details Every line contains a single statement, '#' starts a comment:
+            ///     @code
+            ///     message <id> <name>
+            ///         <type> <name>
+            ///         optional <flag_field> <mask> <type> <name>
+            ///         list <count_type> <name>
+            ///             <type> <name>
+            ///         end
+            ///     end
+            ///     @endcode
+            ///     where @b type is @b u or @b i (unsigned or signed) followed by the
+            ///     number of bits (8 - 64, multiple of 8) and optional @b be or @b le
+            ///     endian suffix (big endian by default), for example @b u16le.
+            ///     The @b list may be prefixed with @b optional as well, the lists
+            ///     cannot be nested.
+            /// @return false on the first error, see @ref error_line().
+            bool load(std::istream &in) {
+                error_line_ = 0U;
+                std::string line;
+                std::size_t lineNum = 0U;
+                dynamic_schema schema;
+                dynamic_field_def *list = nullptr;
+                bool inMessage = false;
+                while (std::getline(in, line)) {
+                    ++lineNum;
+                    auto comment = line.find('#');
+                    if (comment != std::string::npos) {
+                        line.erase(comment);
+                    }
+
+                    std::istringstream stream(line);
+                    std::vector<std::string> tokens;
+                    std::string token;
+                    while (stream >> token) {
+                        tokens.push_back(token);
+                    }
+
+                    if (tokens.empty()) {
+                        continue;
+                    }
+
+                    bool ok = true;
+                    if (tokens[0] == "message") {
+                        ok = (!inMessage) && (tokens.size() == 3U) && parse_number(tokens[1], schema.id);
+                        schema.name = ok ? tokens[2] : std::string();
+                        schema.fields.clear();
+                        inMessage = ok;
+                    } else if (!inMessage) {
+                        ok = false;
+                    } else if (tokens[0] == "end") {
+                        ok = (tokens.size() == 1U);
+                        if (ok && (list != nullptr)) {
+                            list = nullptr;
+                        } else if (ok) {
+                            ok = add(schema);
+                            inMessage = false;
+                        }
+                    } else {
+                        dynamic_field_def field;
+                        ok = parse_field(tokens, field);
+                        auto &scope = (list != nullptr) ? list->elements : schema.fields;
+                        if (ok) {
+                            auto isList = (field.kind == dynamic_field_kind::list);
+                            ok = (list == nullptr) || (!isList);
+                            scope.push_back(std::move(field));
+                            if (ok && isList) {
+                                list = &scope.back();
+                            }
+                        }
+                    }
+
+                    if (!ok) {
+                        error_line_ = lineNum;
+                        return false;
+                    }
+                }
+
+                if (inMessage) {
+                    error_line_ = lineNum;
+                    return false;
+                }
+                return true;
+            }
+
+            /// @brief Number of the line of the last @ref load() error, 0 if none.
+            std::size_t error_line() const {
+                return error_line_;
+            }
+
+        private:
+            template<typename T>
+            static bool parse_number(const std::string &str, T &value) {
+                char *end = nullptr;
+                auto result = std::strtoull(str.c_str(), &end, 0);
+                if ((end == str.c_str()) || (*end != '\0')) {
+                    return false;
+                }
+                value = static_cast<T>(result);
+                return true;
+            }
+
+            static bool parse_type(const std::string &str, dynamic_field_def &field) {
+                if (str.size() < 2U) {
+                    return false;
+                }
+
+                if (str[0] == 'u') {
+                    field.kind = dynamic_field_kind::unsigned_integral;
+                } else if (str[0] == 'i') {
+                    field.kind = dynamic_field_kind::signed_integral;
+                } else {
+                    return false;
+                }
+
+                auto bits = str.substr(1U);
+                field.little_endian = false;
+                if ((2U < bits.size()) && ((bits.compare(bits.size() - 2U, 2U, "le") == 0)
+                                           || (bits.compare(bits.size() - 2U, 2U, "be") == 0))) {
+                    field.little_endian = (bits[bits.size() - 2U] == 'l');
+                    bits.erase(bits.size() - 2U);
+                }
+
+                unsigned bitsCount = 0U;
+                if ((!parse_number(bits, bitsCount)) || (bitsCount == 0U) || (64U < bitsCount)
+                    || ((bitsCount % 8U) != 0U)) {
+                    return false;
+                }
+                field.width = static_cast<std::uint8_t>(bitsCount / 8U);
+                return true;
+            }
+
+            static bool parse_field(const std::vector<std::string> &tokens, dynamic_field_def &field) {
+                std::size_t pos = 0U;
+                if (tokens[0] == "optional") {
+                    if ((tokens.size() < 4U) || (!parse_number(tokens[2], field.mask))) {
+                        return false;
+                    }
+                    field.optional = true;
+                    field.flag = tokens[1];
+                    pos = 3U;
+                }
+
+                if (tokens[pos] == "list") {
+                    if ((tokens.size() != (pos + 3U)) || (!parse_type(tokens[pos + 1U], field))
+                        || (field.kind != dynamic_field_kind::unsigned_integral)) {
+                        return false;
+                    }
+                    field.kind = dynamic_field_kind::list;
+                    field.name = tokens[pos + 2U];
+                    return true;
+                }
+
+                if ((tokens.size() != (pos + 2U)) || (!parse_type(tokens[pos], field))) {
+                    return false;
+                }
+                field.name = tokens[pos + 1U];
+                return true;
+            }
+
+            std::vector<dynamic_plan> plans_;
+            std::unordered_map<std::uintmax_t, std::size_t> index_;
+            std::size_t error_line_ = 0U;
+        };
+
+        /// @brief Message with the layout defined by the runtime schema.
+        /// @details Substitutes the definition of the message, which is not known at
+        ///     compile time. The layout is looked up by the message ID in the
+        ///     @ref dynamic_schema_set assigned using @ref set_schemas(), and the
+        ///     message is decoded by the interpretation of the compiled
+        ///     @ref dynamic_plan into the compact field table of 64 bit values.
+        ///     When the schema is not found, the payload is kept as raw bytes,
+        ///     the same way as @ref nil::marshalling::generic_message does. Expected
+        ///     to be used as the fallback for unknown IDs in the
+        ///     @ref nil::marshalling::protocol::msg_id_layer:
+        ///     @code
+        ///     using my_dynamic_message = nil::marshalling::dynamic_message<my_message>;
+        ///     using my_id_layer = nil::marshalling::protocol::msg_id_layer<
+        ///         my_id_field, my_message, all_messages, my_data_layer,
+        ///         nil::marshalling::option::support_generic_message<my_dynamic_message> >;
+        ///
+        ///     my_dynamic_message::set_schemas(&schemas);
+        ///     @endcode
+        /// @tparam TMessage Common message interface class, becomes one of the
+        ///     base classes.
+        /// @tparam TExtraOpts Extra option(s) (multple options need to be bundled in
+        ///     @b std::tuple) to be passed to @ref nil::marshalling::message_base which is base
+        ///     to this one.
+        /// @headerfile nil/network/marshalling/dynamic_message.h
+        template<typename TMessage, typename TExtraOpts = nil::marshalling::option::empty_option>
+        class dynamic_message
+            : public nil::marshalling::message_base<
+                  TMessage, nil::marshalling::option::zero_fields_impl,
+                  nil::marshalling::option::msg_type<dynamic_message<TMessage, TExtraOpts>>,
+                  nil::marshalling::option::has_do_get_id, nil::marshalling::option::has_name, TExtraOpts> {
+            using Base = nil::marshalling::message_base<
+                TMessage, nil::marshalling::option::zero_fields_impl,
+                nil::marshalling::option::msg_type<dynamic_message<TMessage, TExtraOpts>>,
+                nil::marshalling::option::has_do_get_id, nil::marshalling::option::has_name, TExtraOpts>;
+
+        public:
+            /// @brief Type of the message ID
+            using msg_id_type = typename Base::msg_id_type;
+
+            /// @brief Type of the message ID passed as parameter
+            using msg_id_param_type = typename Base::msg_id_param_type;
+
+            /// @brief Default constructor is deleted
+            dynamic_message() = delete;
+
+            /// @brief Constructor
+            /// @param[in] id ID of the message
+            explicit dynamic_message(msg_id_param_type id) :
+                id_(id), plan_((schemas() != nullptr) ? schemas()->find(static_cast<std::uintmax_t>(id)) : nullptr) {
+                if (plan_ != nullptr) {
+                    table_.assign(plan_->slots(), 0U);
+                }
+            }
+
+            /// @brief Copy constructor
+            dynamic_message(const dynamic_message &) = default;
+
+            /// @brief Move constructor
+            dynamic_message(dynamic_message &&) = default;
+
+            /// @brief Destructor
+            ~dynamic_message() noexcept = default;
+
+            /// @brief Copy assignment
+            dynamic_message &operator=(const dynamic_message &) = default;
+
+            /// @brief Move assignment
+            dynamic_message &operator=(dynamic_message &&) = default;
+
+            /// @brief Assign the schemas used by the newly created messages.
+            /// @details The schemas object must outlive all the messages.
+            static void set_schemas(const dynamic_schema_set *value) {
+                schemas_storage().store(value, std::memory_order_release);
+            }
+
+            /// @brief Currently assigned schemas.
+            static const dynamic_schema_set *schemas() {
+                return schemas_storage().load(std::memory_order_acquire);
+            }
+
+            /// @brief Decode plan of the message, nullptr if its schema is unknown.
+            const dynamic_plan *plan() const {
+                return plan_;
+            }
+
+            /// @brief Field table, see @ref dynamic_plan.
+            const std::vector<std::uint64_t> &table() const {
+                return table_;
+            }
+
+            /// @brief Raw payload of the message with the unknown schema.
+            const std::vector<std::uint8_t> &raw() const {
+                return raw_;
+            }
+
+            /// @brief Value of the top level integral field.
+            std::uint64_t value(std::size_t idx) const {
+                return table_[idx];
+            }
+
+            /// @brief Value of the top level signed integral field.
+            std::int64_t signed_value(std::size_t idx) const {
+                return static_cast<std::int64_t>(table_[idx]);
+            }
+
+            /// @brief Update the value of the top level integral field.
+            void set_value(std::size_t idx, std::uint64_t val) {
+                table_[idx] = val;
+            }
+
+            /// @brief Check whether the top level field is present.
+            bool is_present(std::size_t idx) const {
+                auto &op = plan_->field_op(idx);
+                return (!op.optional) || ((table_[op.flag_slot] & op.mask) != 0U);
+            }
+
+            /// @brief Number of the elements in the top level list field.
+            std::size_t list_size(std::size_t idx) const {
+                auto region = static_cast<std::size_t>(table_[idx]);
+                return ((region != 0U) && (region < table_.size())) ? static_cast<std::size_t>(table_[region]) : 0U;
+            }
+
+            /// @brief Resize the top level list field, all the element values are reset to 0.
+            void resize_list(std::size_t idx, std::size_t count) {
+                auto &op = plan_->field_op(idx);
+                auto region = table_.size();
+                table_.resize(region + 1U + (count * op.element_slots), 0U);
+                table_[region] = count;
+                table_[idx] = region;
+            }
+
+            /// @brief Value of the field of the list element.
+            std::uint64_t element_value(std::size_t idx, std::size_t elem, std::size_t field) const {
+                return table_[element_slot(idx, elem, field)];
+            }
+
+            /// @brief Update the value of the field of the list element.
+            void set_element_value(std::size_t idx, std::size_t elem, std::size_t field, std::uint64_t val) {
+                table_[element_slot(idx, elem, field)] = val;
+            }
+
+            /// @brief Get message ID information
+            msg_id_param_type eval_get_id() const {
+                return id_;
+            }
+
+            /// @brief Get message name information.
+            const char *eval_name() const {
+                return (plan_ != nullptr) ? plan_->name().c_str() : "Dynamic message";
+            }
+
+            /// @brief Custom read functionality, interprets the decode plan.
+            template<typename TIter>
+            status_type eval_read(TIter &iter, std::size_t size) {
+                if (plan_ != nullptr) {
+                    return plan_->decode(iter, size, table_);
+                }
+
+                raw_.resize(size);
+                for (auto &byte : raw_) {
+                    byte = static_cast<std::uint8_t>(*iter);
+                    ++iter;
+                }
+                return status_type::success;
+            }
+
+            /// @brief Custom write functionality.
+            template<typename TIter>
+            status_type eval_write(TIter &iter, std::size_t size) const {
+                if (plan_ != nullptr) {
+                    return plan_->encode(table_, iter, size);
+                }
+
+                if (size < raw_.size()) {
+                    return status_type::buffer_overflow;
+                }
+
+                using value_type = typename std::iterator_traits<TIter>::value_type;
+                using byte_type = typename std::conditional<std::is_void<value_type>::value, std::uint8_t,
+                                                            value_type>::type;
+                for (auto byte : raw_) {
+                    *iter = static_cast<byte_type>(byte);
+                    ++iter;
+                }
+                return status_type::success;
+            }
+
+            /// @brief Custom length calculation.
+            std::size_t eval_length() const {
+                return (plan_ != nullptr) ? plan_->length(table_) : raw_.size();
+            }
+
+            /// @brief Custom validity check.
+            bool eval_valid() const {
+                return true;
+            }
+
+        private:
+            static std::atomic<const dynamic_schema_set *> &schemas_storage() {
+                static std::atomic<const dynamic_schema_set *> storage(nullptr);
+                return storage;
+            }
+
+            std::size_t element_slot(std::size_t idx, std::size_t elem, std::size_t field) const {
+                auto &op = plan_->field_op(idx);
+                return static_cast<std::size_t>(table_[idx]) + 1U + (elem * op.element_slots) + field;
+            }
+
+            msg_id_type id_;
+            const dynamic_plan *plan_;
+            std::vector<std::uint64_t> table_;
+            std::vector<std::uint8_t> raw_;
+        };
+
+    }    // namespace marshalling
+}    // namespace nil
+#endif    // NETWORK_MARSHALLING_DYNAMIC_MESSAGE_HPP
@@ -0,0 +1,440 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of nil::marshalling::feed_arbitrator class.
+
+#ifndef NETWORK_MARSHALLING_FEED_ARBITRATOR_HPP
+#define NETWORK_MARSHALLING_FEED_ARBITRATOR_HPP
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include <nil/marshalling/status_type.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Identifier of the redundant feed line.
+        /// @headerfile nil/network/marshalling/feed_arbitrator.h
+        enum class feed_line : std::size_t {
+            a,           ///< Primary line (A)
+            b,           ///< Secondary line (B)
+            num_of_values    ///< Limit for the values
+        };
+
+        /// @brief Verdict reported by @ref feed_arbitrator for a single frame.
+        /// @headerfile nil/network/marshalling/feed_arbitrator.h
+        enum class feed_arbitration_result {
+            delivered,    ///< First copy of the sequence number, must be processed.
+            duplicate,    ///< Sequence number has already been delivered, frame is dropped.
+            stale         ///< Sequence number is too old to be tracked, frame is dropped.
+        };
+
+        /// @brief Per line statistics gathered by @ref feed_arbitrator.
+        /// @headerfile nil/network/marshalling/feed_arbitrator.h
+        struct feed_line_statistics {
+            std::uint64_t received = 0;      ///< Number of frames received on the line.
+            std::uint64_t delivered = 0;     ///< Number of frames won by the line.
+            std::uint64_t duplicates = 0;    ///< Number of frames dropped as duplicates.
+            std::uint64_t stale = 0;         ///< Number of frames dropped as too old.
+            std::uint64_t gaps = 0;          ///< Number of sequence numbers never seen on the line.
+        };
+
+        /// @brief Sequence number retriever which reads the field located at the
+        ///     fixed offset of the raw frame without decoding the frame itself.
+        /// @details Suitable for the sequence number reported as a transport field
+        ///     (see @ref nil::marshalling::protocol::transport_value_layer) or residing
+        ///     in the fixed position of the message payload.
+        /// @tparam TField Type of the field holding the sequence number, must be of
+        ///     integral type.
+        /// @tparam TOffset Offset of the field from the beginning of the frame.
+        /// @headerfile nil/network/marshalling/feed_arbitrator.h
+        template<typename TField, std::size_t TOffset>
+        struct sequence_field_peek {
+            /// @brief Type of the field holding the sequence number.
+            using field_type = TField;
+
+            /// @brief Retrieve sequence number.
+            /// @param[in] iter Iterator pointing to the beginning of the frame, taken by value.
+            /// @param[in] size Number of bytes in the frame.
+            /// @param[out] seq Retrieved sequence number.
+            /// @return Status of the field read operation.
+            template<typename TIter>
+            status_type operator()(TIter iter, std::size_t size, std::uint64_t &seq) const {
+                if (size < TOffset) {
+                    return status_type::not_enough_data;
+                }
+
+                std::advance(iter, TOffset);
+                field_type field;
+                auto es = field.read(iter, size - TOffset);
+                if (es != status_type::success) {
+                    return es;
+                }
+
+                seq = static_cast<std::uint64_t>(field.value());
+                return status_type::success;
+            }
+        };
+
+        /// @brief Arbitrator of the redundant (A/B) feeds.
+        /// @details Receives the same sequence of frames from two independent lines
+        ///     and makes sure every sequence number is delivered exactly once,
+        ///     from whichever line provides it first. The check happens on the raw
+        ///     frame, prior to the decoding of the message payload, so the duplicates
+        ///     are dropped at the cost of reading the sequence number only.@n
+        ///     Delivered sequence numbers are tracked using the bitmap covering
+        ///     @b TWindowSize latest numbers. Any number that falls below the window
+        ///     is reported as @ref feed_arbitration_result::stale, while the numbers
+        ///     that left the window without being delivered by any of the lines are
+        ///     accounted as unrecovered losses.@n
+        ///     The class doesn't use dynamic memory allocation and doesn't perform
+        ///     any synchronization, both lines are expected to be serviced by the
+        ///     same thread.
+        /// @tparam TSequencePeek Functor retrieving the sequence number from the raw
+        ///     frame, must provide the following operator:
+        ///     @code
+        ///     template <typename TIter>
+        ///     nil::marshalling::status_type operator()(TIter iter, std::size_t size, std::uint64_t& seq) const;
+        ///     @endcode
+        ///     See @ref sequence_field_peek.
+        /// @tparam TWindowSize Number of the latest sequence numbers to track, must be
+        ///     a non-zero multiple of 64.
+        /// @headerfile nil/network/marshalling/feed_arbitrator.h
+        template<typename TSequencePeek, std::size_t TWindowSize = 1024>
+        class feed_arbitrator {
+            static_assert((0U < TWindowSize) && ((TWindowSize % 64U) == 0U),
+                          "Window size must be non-zero multiple of 64");
+
+        public:
+            /// @brief Type of the sequence number retriever.
+            using sequence_peek_type = TSequencePeek;
+
+            /// @brief Type of the sequence number.
+            using sequence_type = std::uint64_t;
+
+            /// @brief Number of tracked sequence numbers.
+            static const std::size_t window_size = TWindowSize;
+
+        private:
+            static const std::size_t bits_per_word = std::numeric_limits<std::uint64_t>::digits;
+            static const std::size_t num_of_lines = static_cast<std::size_t>(feed_line::num_of_values);
+
+        public:
+            /// @brief Arbitration state and statistics.
+            /// @details Trivially copyable, may be stored as is in the checkpoint
+            ///     (see @ref checkpoint_file) and restored by the new process without
+            ///     losing the tracking window.
+            struct state_type {
+                /// @brief Last sequence number seen on the line.
+                struct line_last_seq {
+                    sequence_type seq = 0U;
+                    bool valid = false;
+                };
+
+                /// @brief Storage of the delivered sequence numbers bitmap.
+                using bits_storage_type = std::array<std::uint64_t, TWindowSize / bits_per_word>;
+
+                /// @brief Delivered sequence numbers within the window.
+                bits_storage_type bits = bits_storage_type();
+
+                /// @brief Per line statistics.
+                std::array<feed_line_statistics, num_of_lines> stats = std::array<feed_line_statistics, num_of_lines>();
+
+                /// @brief Per line last seen sequence numbers.
+                std::array<line_last_seq, num_of_lines> last = std::array<line_last_seq, num_of_lines>();
+
+                sequence_type first = 0U;          ///< First delivered sequence number.
+                sequence_type highest = 0U;        ///< Highest delivered sequence number.
+                std::uint64_t unrecovered = 0U;    ///< Number of unrecovered losses.
+                bool initialized = false;          ///< At least one frame has been delivered.
+            };
+
+            /// @brief Default constructor.
+            feed_arbitrator() = default;
+
+            /// @brief Constructor with custom sequence number retriever.
+            explicit feed_arbitrator(const sequence_peek_type &peek) : peek_(peek) {
+            }
+
+            /// @brief Access to the sequence number retriever.
+            sequence_peek_type &sequence_peek() {
+                return peek_;
+            }
+
+            /// @brief Const access to the sequence number retriever.
+            const sequence_peek_type &sequence_peek() const {
+                return peek_;
+            }
+
+            /// @brief Arbitrate already retrieved sequence number.
+            /// @details Updates the line statistics and marks the sequence number as
+            ///     delivered in case the verdict is @ref feed_arbitration_result::delivered.
+            /// @param[in] line Line the frame was received on.
+            /// @param[in] seq Sequence number of the frame.
+            /// @return Arbitration verdict.
+            feed_arbitration_result arbitrate(feed_line line, sequence_type seq) {
+                auto &stats = line_stats(line);
+                auto &lineLast = state_.last[line_idx(line)];
+                ++stats.received;
+                if (!lineLast.valid) {
+                    lineLast.valid = true;
+                    lineLast.seq = seq;
+                } else if (lineLast.seq < seq) {
+                    stats.gaps += (seq - lineLast.seq - 1U);
+                    lineLast.seq = seq;
+                }
+
+                if (!state_.initialized) {
+                    init(seq);
+                    ++stats.delivered;
+                    return feed_arbitration_result::delivered;
+                }
+
+                if (state_.highest < seq) {
+                    advance(seq);
+                    set_bit(seq);
+                    ++stats.delivered;
+                    return feed_arbitration_result::delivered;
+                }
+
+                if ((seq < state_.first) || (TWindowSize <= (state_.highest - seq))) {
+                    ++stats.stale;
+                    return feed_arbitration_result::stale;
+                }
+
+                if (test_bit(seq)) {
+                    ++stats.duplicates;
+                    return feed_arbitration_result::duplicate;
+                }
+
+                set_bit(seq);
+                ++stats.delivered;
+                return feed_arbitration_result::delivered;
+            }
+
+            /// @brief Arbitrate raw frame.
+            /// @details Retrieves the sequence number using the @ref sequence_peek()
+            ///     functor and invokes @ref arbitrate(feed_line, sequence_type).
+            /// @param[in] line Line the frame was received on.
+            /// @param[in] iter Iterator pointing to the beginning of the frame, not updated.
+            /// @param[in] size Number of bytes in the frame.
+            /// @param[out] result Arbitration verdict, updated only on success.
+            /// @return Status of the sequence number retrieval.
+            template<typename TIter>
+            status_type arbitrate(feed_line line, const TIter &iter, std::size_t size,
+                                  feed_arbitration_result &result) {
+                sequence_type seq = 0U;
+                auto es = peek_(iter, size, seq);
+                if (es != status_type::success) {
+                    return es;
+                }
+
+                result = arbitrate(line, seq);
+                return status_type::success;
+            }
+
+            /// @brief Read the frame using provided protocol stack unless it is a duplicate.
+            /// @details The frame is expected to be complete (e.g. single datagram).
+            ///     When the frame is dropped, the iterator is advanced by @b size bytes,
+            ///     the message object is not updated and
+            ///     nil::marshalling::status_type::success is returned. When the frame is
+            ///     delivered, but the protocol stack fails to decode it, the delivery
+            ///     is retracted, so the copy from the other line may still be accepted.
+            /// @param[in] line Line the frame was received on.
+            /// @param[in] stack Protocol stack used to decode the frame.
+            /// @param[in, out] msg Smart pointer or message object passed to stack's read().
+            /// @param[in, out] iter Input iterator.
+            /// @param[in] size Number of bytes in the frame.
+            /// @param[out] result Arbitration verdict, may be nullptr.
+            /// @param[out] missingSize Passed to stack's read(), may be nullptr.
+            /// @return Status of the operation.
+            template<typename TStack, typename TMsg, typename TIter>
+            status_type read(feed_line line, TStack &stack, TMsg &msg, TIter &iter, std::size_t size,
+                             feed_arbitration_result *result = nullptr, std::size_t *missingSize = nullptr) {
+                sequence_type seq = 0U;
+                auto es = peek_(static_cast<const TIter &>(iter), size, seq);
+                if (es != status_type::success) {
+                    return es;
+                }
+
+                auto verdict = arbitrate(line, seq);
+                if (result != nullptr) {
+                    *result = verdict;
+                }
+
+                if (verdict != feed_arbitration_result::delivered) {
+                    std::advance(iter, size);
+                    return status_type::success;
+                }
+
+                es = stack.read(msg, iter, size, missingSize);
+                if (es != status_type::success) {
+                    retract(line, seq);
+                }
+
+                return es;
+            }
+
+            /// @brief Retract previously reported delivery of the sequence number.
+            /// @details Allows the copy from the other line to be delivered. Has no
+            ///     effect if the sequence number is outside the tracking window.
+            void retract(feed_line line, sequence_type seq) {
+                if ((!state_.initialized) || (state_.highest < seq) || (seq < state_.first)
+                    || (TWindowSize <= (state_.highest - seq))
+                    || (!test_bit(seq))) {
+                    return;
+                }
+
+                clear_bit(seq);
+                auto &stats = line_stats(line);
+                if (0U < stats.delivered) {
+                    --stats.delivered;
+                }
+            }
+
+            /// @brief Get statistics of the line.
+            const feed_line_statistics &line_statistics(feed_line line) const {
+                return state_.stats[line_idx(line)];
+            }
+
+            /// @brief Number of sequence numbers that left the tracking window without being
+            ///     delivered by any of the lines.
+            std::uint64_t unrecovered() const {
+                return state_.unrecovered;
+            }
+
+            /// @brief Number of sequence numbers within the tracking window that haven't
+            ///     been delivered yet.
+            std::uint64_t pending_gaps() const {
+                if (!state_.initialized) {
+                    return 0U;
+                }
+
+                std::uint64_t count = 0U;
+                for (auto word : state_.bits) {
+                    count += (std::numeric_limits<std::uint64_t>::digits - std::bitset<64>(word).count());
+                }
+                return count;
+            }
+
+            /// @brief Highest delivered sequence number.
+            /// @pre At least one frame has been delivered.
+            sequence_type highest() const {
+                return state_.highest;
+            }
+
+            /// @brief Access the arbitration state, e.g. to checkpoint it.
+            const state_type &state() const {
+                return state_;
+            }
+
+            /// @brief Restore previously saved arbitration state.
+            void restore(const state_type &state) {
+                state_ = state;
+            }
+
+            /// @brief Reset the arbitration state and statistics.
+            void reset() {
+                state_.initialized = false;
+                state_.first = 0U;
+                state_.highest = 0U;
+                state_.unrecovered = 0U;
+                state_.bits.fill(0U);
+                state_.stats.fill(feed_line_statistics());
+                state_.last.fill(line_last_seq());
+            }
+
+        private:
+            using line_last_seq = typename state_type::line_last_seq;
+
+            static std::size_t line_idx(feed_line line) {
+                return static_cast<std::size_t>(line);
+            }
+
+            feed_line_statistics &line_stats(feed_line line) {
+                return state_.stats[line_idx(line)];
+            }
+
+            static std::size_t bit_pos(sequence_type seq) {
+                return static_cast<std::size_t>(seq % TWindowSize);
+            }
+
+            bool test_bit(sequence_type seq) const {
+                auto pos = bit_pos(seq);
+                return (state_.bits[pos / bits_per_word] & (std::uint64_t(1U) << (pos % bits_per_word))) != 0U;
+            }
+
+            void set_bit(sequence_type seq) {
+                auto pos = bit_pos(seq);
+                state_.bits[pos / bits_per_word] |= (std::uint64_t(1U) << (pos % bits_per_word));
+            }
+
+            void clear_bit(sequence_type seq) {
+                auto pos = bit_pos(seq);
+                state_.bits[pos / bits_per_word] &= ~(std::uint64_t(1U) << (pos % bits_per_word));
+            }
+
+            void init(sequence_type seq) {
+                state_.initialized = true;
+                state_.first = seq;
+                state_.highest = seq;
+                // Sequence numbers preceding the first one are not expected,
+                // treat them as delivered to avoid accounting them as losses.
+                state_.bits.fill(std::numeric_limits<std::uint64_t>::max());
+            }
+
+            void advance(sequence_type seq) {
+                auto distance = seq - state_.highest;
+                if (TWindowSize <= distance) {
+                    state_.unrecovered += pending_gaps() + (distance - TWindowSize);
+                    state_.bits.fill(0U);
+                    state_.highest = seq;
+                    return;
+                }
+
+                while (state_.highest < seq) {
+                    ++state_.highest;
+                    if (!test_bit(state_.highest)) {
+                        ++state_.unrecovered;
+                    }
+                    clear_bit(state_.highest);
+                }
+            }
+
+            sequence_peek_type peek_;
+            state_type state_;
+        };
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_FEED_ARBITRATOR_HPP
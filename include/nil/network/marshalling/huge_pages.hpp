@@ -0,0 +1,497 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of the memory regions backed by the huge pages, used
+/// by the pool allocators and the receive/transmit buffers.
+
+#ifndef NETWORK_MARSHALLING_HUGE_PAGES_HPP
+#define NETWORK_MARSHALLING_HUGE_PAGES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <nil/network/marshalling/alloc.hpp>
+
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define NETWORK_MARSHALLING_HUGE_PAGES_MMAP 1
+#endif
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Requested backing of the memory region.
+        enum class huge_page_policy {
+            any,         ///< Try explicit huge pages, then transparent ones, then regular pages.
+            transparent, ///< Skip explicit huge pages, advise transparent huge pages.
+            none         ///< Use regular pages only.
+        };
+
+        /// @brief Actual backing of the memory region.
+        enum class huge_page_backing {
+            none,        ///< No memory is allocated.
+            explicit_,   ///< Explicit huge pages, i.e. @b mmap() with @b MAP_HUGETLB.
+            transparent, ///< Regular mapping advised with @b madvise(MADV_HUGEPAGE).
+            regular      ///< Regular pages, the huge pages are not available.
+        };
+
+        /// @brief Size of the huge page the mappings are rounded up to.
+        static const std::size_t huge_page_size = 2U * 1024U * 1024U;
+
+        /// @brief Memory region preferably backed by the huge pages.
+        /// @details Allocates the memory with @b mmap() and @b MAP_HUGETLB, when it fails
+        ///     (no huge pages are reserved in the system) falls back to the regular
+        ///     anonymous mapping aligned to the huge page boundary and advised with
+        ///     @b madvise(MADV_HUGEPAGE). When neither is available (non POSIX platform)
+        ///     the memory is allocated with @b operator new. The fallback is transparent,
+        ///     the actual backing is reported by @ref backing().
+        ///
+        ///     When requested (default), every page of the region is touched upon
+        ///     construction, so the first messages do not take page faults.
+        ///     The allocated memory is always zero initialised. Unless
+        ///     @ref huge_page_policy::none is requested, the length is rounded up to the
+        ///     @ref huge_page_size, so the region is intended for the large pools and buffers.
+        /// @headerfile nil/network/marshalling/huge_pages.h
+        class huge_page_region {
+        public:
+            /// @brief Default constructor, no memory is allocated.
+            huge_page_region() = default;
+
+            /// @brief Constructor, allocates the memory.
+            /// @param[in] len Minimal length of the region in bytes.
+            /// @param[in] policy Requested backing.
+            /// @param[in] prefault Touch all the pages of the region.
+            explicit huge_page_region(std::size_t len, huge_page_policy policy = huge_page_policy::any,
+                                      bool prefault = true) {
+                allocate(len, policy);
+                if (prefault && (data_ != nullptr)) {
+                    touch();
+                }
+            }
+
+            /// @brief Copy constructor is deleted.
+            huge_page_region(const huge_page_region &) = delete;
+
+            /// @brief Move constructor.
+            huge_page_region(huge_page_region &&other) noexcept :
+                data_(other.data_), size_(other.size_), mapped_(other.mapped_), mappedSize_(other.mappedSize_),
+                backing_(other.backing_) {
+                other.release_ownership();
+            }
+
+            /// @brief Destructor, releases the memory.
+            ~huge_page_region() {
+                free();
+            }
+
+            /// @brief Copy assignment is deleted.
+            huge_page_region &operator=(const huge_page_region &) = delete;
+
+            /// @brief Move assignment.
+            huge_page_region &operator=(huge_page_region &&other) noexcept {
+                if (this != &other) {
+                    free();
+                    data_ = other.data_;
+                    size_ = other.size_;
+                    mapped_ = other.mapped_;
+                    mappedSize_ = other.mappedSize_;
+                    backing_ = other.backing_;
+                    other.release_ownership();
+                }
+                return *this;
+            }
+
+            /// @brief Pointer to the beginning of the region.
+            void *data() {
+                return data_;
+            }
+
+            /// @brief Pointer to the beginning of the region.
+            const void *data() const {
+                return data_;
+            }
+
+            /// @brief Usable length of the region, not less than requested.
+            std::size_t size() const {
+                return size_;
+            }
+
+            /// @brief Check whether the region is allocated.
+            bool valid() const {
+                return data_ != nullptr;
+            }
+
+            /// @brief Actual backing of the region.
+            huge_page_backing backing() const {
+                return backing_;
+            }
+
+            /// @brief Check whether the region is backed by the huge pages (explicit or transparent).
+            bool huge() const {
+                return (backing_ == huge_page_backing::explicit_) || (backing_ == huge_page_backing::transparent);
+            }
+
+            /// @brief Touch every page of the region to make kernel fault them in.
+            void touch() {
+                auto *bytes = static_cast<volatile std::uint8_t *>(data_);
+                auto step = regular_page_size();
+                for (std::size_t offset = 0U; offset < size_; offset += step) {
+                    bytes[offset] = 0U;
+                }
+            }
+
+        private:
+            static std::size_t round_up(std::size_t len, std::size_t align) {
+                return ((len + align - 1U) / align) * align;
+            }
+
+            static std::size_t regular_page_size() {
+#ifdef NETWORK_MARSHALLING_HUGE_PAGES_MMAP
+                auto result = ::sysconf(_SC_PAGESIZE);
+                if (0 < result) {
+                    return static_cast<std::size_t>(result);
+                }
+#endif
+                return 4096U;
+            }
+
+            void allocate(std::size_t len, huge_page_policy policy) {
+                if (len == 0U) {
+                    return;
+                }
+
+#ifdef NETWORK_MARSHALLING_HUGE_PAGES_MMAP
+#ifdef MAP_HUGETLB
+                if ((policy == huge_page_policy::any) && map_explicit(len)) {
+                    return;
+                }
+#endif
+                if (map_regular(len, policy)) {
+                    return;
+                }
+#else
+                static_cast<void>(policy);
+#endif
+                data_ = ::operator new(len, std::nothrow);
+                if (data_ == nullptr) {
+                    return;
+                }
+
+                auto *bytes = static_cast<std::uint8_t *>(data_);
+                std::fill_n(bytes, len, std::uint8_t(0U));
+                size_ = len;
+                backing_ = huge_page_backing::regular;
+            }
+
+#ifdef NETWORK_MARSHALLING_HUGE_PAGES_MMAP
+#ifdef MAP_HUGETLB
+            bool map_explicit(std::size_t len) {
+                auto mapLen = round_up(len, huge_page_size);
+                auto *ptr
+                    = ::mmap(nullptr, mapLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (ptr == MAP_FAILED) {
+                    return false;
+                }
+
+                data_ = ptr;
+                size_ = mapLen;
+                mapped_ = ptr;
+                mappedSize_ = mapLen;
+                backing_ = huge_page_backing::explicit_;
+                return true;
+            }
+#endif
+
+            bool map_regular(std::size_t len, huge_page_policy policy) {
+                bool advise = (policy != huge_page_policy::none);
+                auto dataLen = advise ? round_up(len, huge_page_size) : round_up(len, regular_page_size());
+                auto mapLen = advise ? (dataLen + huge_page_size) : dataLen;
+                auto *ptr = ::mmap(nullptr, mapLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr == MAP_FAILED) {
+                    return false;
+                }
+
+                mapped_ = ptr;
+                mappedSize_ = mapLen;
+                data_ = ptr;
+                size_ = dataLen;
+                backing_ = huge_page_backing::regular;
+                if (!advise) {
+                    return true;
+                }
+
+                // The transparent huge pages are used only for the aligned ranges.
+                auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+                auto aligned = round_up(static_cast<std::size_t>(addr), huge_page_size);
+                data_ = reinterpret_cast<void *>(aligned);
+
+#ifdef MADV_HUGEPAGE
+                if (::madvise(data_, dataLen, MADV_HUGEPAGE) == 0) {
+                    backing_ = huge_page_backing::transparent;
+                }
+#endif
+                return true;
+            }
+#endif
+
+            void free() {
+                if (data_ == nullptr) {
+                    return;
+                }
+
+#ifdef NETWORK_MARSHALLING_HUGE_PAGES_MMAP
+                if (mapped_ != nullptr) {
+                    ::munmap(mapped_, mappedSize_);
+                    release_ownership();
+                    return;
+                }
+#endif
+                ::operator delete(data_);
+                release_ownership();
+            }
+
+            void release_ownership() {
+                data_ = nullptr;
+                size_ = 0U;
+                mapped_ = nullptr;
+                mappedSize_ = 0U;
+                backing_ = huge_page_backing::none;
+            }
+
+            void *data_ = nullptr;
+            std::size_t size_ = 0U;
+            void *mapped_ = nullptr;
+            std::size_t mappedSize_ = 0U;
+            huge_page_backing backing_ = huge_page_backing::none;
+        };
+
+        /// @brief Fixed capacity byte buffer preferably backed by the huge pages.
+        /// @details Intended to be used as a storage of the large receive rings and
+        ///     stream buffers, the iterators are plain pointers and may be passed
+        ///     directly to the protocol stack read/write operations.
+        /// @tparam TByte Type of the buffer element.
+        /// @headerfile nil/network/marshalling/huge_pages.h
+        template<typename TByte = std::uint8_t>
+        class huge_page_buffer {
+            static_assert(std::is_trivial<TByte>::value, "Buffer element must be trivial");
+
+        public:
+            /// @brief Type of the buffer element.
+            using value_type = TByte;
+
+            /// @brief Iterator type.
+            using iterator = TByte *;
+
+            /// @brief Const iterator type.
+            using const_iterator = const TByte *;
+
+            /// @brief Default constructor, no memory is allocated.
+            huge_page_buffer() = default;
+
+            /// @brief Constructor, allocates the memory.
+            /// @param[in] capacity Minimal number of the elements.
+            /// @param[in] policy Requested backing.
+            /// @param[in] prefault Touch all the pages of the buffer.
+            explicit huge_page_buffer(std::size_t capacity, huge_page_policy policy = huge_page_policy::any,
+                                      bool prefault = true) :
+                region_(capacity * sizeof(TByte), policy, prefault) {
+            }
+
+            /// @brief Pointer to the first element.
+            TByte *data() {
+                return static_cast<TByte *>(region_.data());
+            }
+
+            /// @brief Pointer to the first element.
+            const TByte *data() const {
+                return static_cast<const TByte *>(region_.data());
+            }
+
+            /// @brief Number of the available elements, not less than requested.
+            std::size_t capacity() const {
+                return region_.size() / sizeof(TByte);
+            }
+
+            /// @brief Beginning of the buffer.
+            iterator begin() {
+                return data();
+            }
+
+            /// @brief End of the buffer.
+            iterator end() {
+                return data() + capacity();
+            }
+
+            /// @brief Beginning of the buffer.
+            const_iterator begin() const {
+                return data();
+            }
+
+            /// @brief End of the buffer.
+            const_iterator end() const {
+                return data() + capacity();
+            }
+
+            /// @brief Access the element.
+            TByte &operator[](std::size_t idx) {
+                return data()[idx];
+            }
+
+            /// @brief Access the element.
+            const TByte &operator[](std::size_t idx) const {
+                return data()[idx];
+            }
+
+            /// @brief Access the underlying memory region.
+            const huge_page_region &region() const {
+                return region_;
+            }
+
+        private:
+            huge_page_region region_;
+        };
+
+        namespace processing {
+            namespace alloc {
+
+                /// @brief Object pool allocator residing in the huge pages.
+                /// @details Same as @ref in_place_pool, but the pool elements are placed
+                ///     in the @ref nil::marshalling::huge_page_region instead of the allocator
+                ///     object itself, which reduces TLB misses for the large pools. The
+                ///     memory is obtained and prefaulted upon construction, falling back
+                ///     to the regular pages when the huge ones are not available.
+                /// @tparam TInterface Common interface class for all objects being allocated
+                ///     with this allocator.
+                /// @tparam TSize Number of objects this allocator is allowed to allocate.
+                /// @tparam TAllTypes All the possible types that can be allocated with this
+                ///     allocator bundled in @b std::tuple.
+                template<typename TInterface, std::size_t TSize, typename TAllTypes = std::tuple<TInterface>>
+                class huge_page_pool {
+                    using pool_element_type = in_place_single<TInterface, TAllTypes>;
+
+                    static_assert(0U < TSize, "The pool must not be empty");
+                    static_assert(std::alignment_of<pool_element_type>::value <= 4096U,
+                                  "Pool element alignment is not supported");
+
+                public:
+                    /// @brief Smart pointer (std::unique_ptr) to the allocated object.
+                    /// @details Same as in_place_single::Ptr;
+                    using ptr_type = typename pool_element_type::ptr_type;
+
+                    /// @brief Constructor, allocates the pool memory.
+                    /// @param[in] policy Requested backing of the pool memory.
+                    explicit huge_page_pool(huge_page_policy policy = huge_page_policy::any) :
+                        region_(sizeof(pool_element_type) * TSize, policy, true) {
+                        if (!region_.valid()) {
+                            return;
+                        }
+
+                        pool_ = static_cast<pool_element_type *>(region_.data());
+                        for (std::size_t idx = 0U; idx < TSize; ++idx) {
+                            new (&pool_[idx]) pool_element_type();
+                        }
+                    }
+
+                    /// @brief Copy constructor is deleted, the allocated objects refer to the pool.
+                    huge_page_pool(const huge_page_pool &) = delete;
+
+                    /// @brief Destructor.
+                    /// @pre All the allocated objects are released.
+                    ~huge_page_pool() {
+                        if (pool_ == nullptr) {
+                            return;
+                        }
+
+                        for (std::size_t idx = 0U; idx < TSize; ++idx) {
+                            MARSHALLING_ASSERT(!pool_[idx].allocated());
+                            pool_[idx].~pool_element_type();
+                        }
+                    }
+
+                    /// @brief Copy assignment is deleted.
+                    huge_page_pool &operator=(const huge_page_pool &) = delete;
+
+                    /// @copydoc in_place_single::alloc
+                    template<typename TObj, typename... TArgs>
+                    ptr_type alloc(TArgs &&...args) {
+                        auto iter = std::find_if(begin(), end(), [](const pool_element_type &elem) -> bool {
+                            return !elem.allocated();
+                        });
+
+                        if (iter == end()) {
+                            return ptr_type();
+                        }
+
+                        return iter->template alloc<TObj>(std::forward<TArgs>(args)...);
+                    }
+
+                    /// @brief Function used to wrap raw pointer into a smart one
+                    /// @tparam Type of the object, expected to be the
+                    ///     same as or derived from TInterface.
+                    /// @param[in] obj Pointer to previously allocated object.
+                    /// @return Smart pointer to the wrapped object.
+                    template<typename TObj>
+                    ptr_type wrap(TObj *obj) {
+                        auto iter = std::find_if(begin(), end(), [obj](const pool_element_type &elem) -> bool {
+                            return elem.allocated() && (elem.alloc_addr() == obj);
+                        });
+
+                        if (iter == end()) {
+                            return ptr_type();
+                        }
+
+                        return iter->wrap(obj);
+                    }
+
+                    /// @brief Actual backing of the pool memory.
+                    huge_page_backing backing() const {
+                        return region_.backing();
+                    }
+
+                private:
+                    pool_element_type *begin() {
+                        return pool_;
+                    }
+
+                    pool_element_type *end() {
+                        return (pool_ == nullptr) ? pool_ : (pool_ + TSize);
+                    }
+
+                    huge_page_region region_;
+                    pool_element_type *pool_ = nullptr;
+                };
+
+            }    // namespace alloc
+        }    // namespace processing
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_HUGE_PAGES_HPP
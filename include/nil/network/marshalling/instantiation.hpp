@@ -0,0 +1,177 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Provides support for the explicit instantiation of the protocol stacks and
+/// message factories, allowing the heavy instantiations to live in a single
+/// object file.
+
+#ifndef NETWORK_MARSHALLING_INSTANTIATION_HPP
+#define NETWORK_MARSHALLING_INSTANTIATION_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <nil/marshalling/status_type.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Explicitly instantiable entry points of the protocol stack.
+        /// @details The member functions forward to the ones of the stack, they are
+        ///     defined out of the class body and therefore are not implicitly inline.
+        ///     Declaring the instantiation extern (see @ref MARSHALLING_EXTERN_PROTOCOL_STACK())
+        ///     in the common header and defining it (see @ref MARSHALLING_INSTANTIATE_PROTOCOL_STACK())
+        ///     in a single source file prevents the instantiation of the whole
+        ///     stack (with all the layers, message factory and messages read/write)
+        ///     in every translation unit which reads or writes the frames using
+        ///     these functions instead of the member functions of the stack.
+        /// @tparam TStack Type of the protocol stack, its message interface class must
+        ///     define both @b read_iterator and @b write_iterator.
+        /// @headerfile nil/network/marshalling/instantiation.h
+        template<typename TStack>
+        struct stack_instantiation {
+            /// @brief Type of the protocol stack.
+            using stack_type = TStack;
+
+            /// @brief Smart pointer to the message object.
+            using msg_ptr_type = typename TStack::msg_ptr_type;
+
+            /// @brief Common interface class of the messages.
+            using message_type = typename std::decay<decltype(*std::declval<msg_ptr_type>())>::type;
+
+            /// @brief Type of the iterator used for reading.
+            using read_iterator = typename message_type::read_iterator;
+
+            /// @brief Type of the iterator used for writing.
+            using write_iterator = typename message_type::write_iterator;
+
+            /// @brief Same as @b read() member function of the stack.
+            static status_type read(stack_type &stack, msg_ptr_type &msg, read_iterator &iter, std::size_t size,
+                                    std::size_t *missingSize = nullptr);
+
+            /// @brief Same as @b write() member function of the stack.
+            static status_type write(const stack_type &stack, const message_type &msg, write_iterator &iter,
+                                     std::size_t size);
+
+            /// @brief Same as @b length() member function of the stack.
+            static std::size_t length(const stack_type &stack, const message_type &msg);
+        };
+
+        template<typename TStack>
+        status_type stack_instantiation<TStack>::read(stack_type &stack, msg_ptr_type &msg, read_iterator &iter,
+                                                      std::size_t size, std::size_t *missingSize) {
+            return stack.read(msg, iter, size, missingSize);
+        }
+
+        template<typename TStack>
+        status_type stack_instantiation<TStack>::write(const stack_type &stack, const message_type &msg,
+                                                       write_iterator &iter, std::size_t size) {
+            return stack.write(msg, iter, size);
+        }
+
+        template<typename TStack>
+        std::size_t stack_instantiation<TStack>::length(const stack_type &stack, const message_type &msg) {
+            return stack.length(msg);
+        }
+
+        /// @brief Explicitly instantiable entry points of the message factory.
+        /// @details Similar to @ref stack_instantiation, but for
+        ///     @ref nil::marshalling::msg_factory.
+        /// @tparam TFactory Type of the message factory.
+        /// @headerfile nil/network/marshalling/instantiation.h
+        template<typename TFactory>
+        struct msg_factory_instantiation {
+            /// @brief Type of the message factory.
+            using factory_type = TFactory;
+
+            /// @brief Smart pointer to the message object.
+            using msg_ptr_type = typename TFactory::msg_ptr_type;
+
+            /// @brief Type of the message ID passed as parameter.
+            using msg_id_param_type = typename TFactory::msg_id_param_type;
+
+            /// @brief Same as @b create_msg() member function of the factory.
+            static msg_ptr_type create_msg(const factory_type &factory, msg_id_param_type id, unsigned idx = 0);
+
+            /// @brief Same as @b create_generic_msg() member function of the factory.
+            static msg_ptr_type create_generic_msg(const factory_type &factory, msg_id_param_type id);
+
+            /// @brief Same as @b msg_count() member function of the factory.
+            static std::size_t msg_count(const factory_type &factory, msg_id_param_type id);
+        };
+
+        template<typename TFactory>
+        typename msg_factory_instantiation<TFactory>::msg_ptr_type
+            msg_factory_instantiation<TFactory>::create_msg(const factory_type &factory, msg_id_param_type id,
+                                                            unsigned idx) {
+            return factory.create_msg(id, idx);
+        }
+
+        template<typename TFactory>
+        typename msg_factory_instantiation<TFactory>::msg_ptr_type
+            msg_factory_instantiation<TFactory>::create_generic_msg(const factory_type &factory,
+                                                                    msg_id_param_type id) {
+            return factory.create_generic_msg(id);
+        }
+
+        template<typename TFactory>
+        std::size_t msg_factory_instantiation<TFactory>::msg_count(const factory_type &factory,
+                                                                   msg_id_param_type id) {
+            return factory.msg_count(id);
+        }
+
+    }    // namespace marshalling
+}    // namespace nil
+
+/// @brief Declare the explicit instantiation of @ref nil::marshalling::stack_instantiation
+///     for the protocol stack, expected to be used in the common header.
+/// @code
+///     MARSHALLING_EXTERN_PROTOCOL_STACK(my_stack);
+/// @endcode
+/// @related nil::marshalling::stack_instantiation
+#define MARSHALLING_EXTERN_PROTOCOL_STACK(...) \
+    extern template struct nil::marshalling::stack_instantiation<__VA_ARGS__>
+
+/// @brief Define the explicit instantiation of @ref nil::marshalling::stack_instantiation
+///     for the protocol stack, expected to be used in exactly one source file.
+/// @related nil::marshalling::stack_instantiation
+#define MARSHALLING_INSTANTIATE_PROTOCOL_STACK(...) \
+    template struct nil::marshalling::stack_instantiation<__VA_ARGS__>
+
+/// @brief Declare the explicit instantiation of @ref nil::marshalling::msg_factory_instantiation
+///     for the message factory, expected to be used in the common header.
+/// @related nil::marshalling::msg_factory_instantiation
+#define MARSHALLING_EXTERN_MSG_FACTORY(...) \
+    extern template struct nil::marshalling::msg_factory_instantiation<__VA_ARGS__>
+
+/// @brief Define the explicit instantiation of @ref nil::marshalling::msg_factory_instantiation
+///     for the message factory, expected to be used in exactly one source file.
+/// @related nil::marshalling::msg_factory_instantiation
+#define MARSHALLING_INSTANTIATE_MSG_FACTORY(...) \
+    template struct nil::marshalling::msg_factory_instantiation<__VA_ARGS__>
+
+#endif    // NETWORK_MARSHALLING_INSTANTIATION_HPP
@@ -0,0 +1,235 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains keyed (jump table based) reading of the variant fields.
+
+#ifndef NETWORK_MARSHALLING_KEYED_VARIANT_HPP
+#define NETWORK_MARSHALLING_KEYED_VARIANT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include <nil/marshalling/status_type.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Retriever of the key the variant alternative starts with.
+        /// @details The default implementation default constructs the alternative
+        ///     (usually nil::marshalling::types::bundle) and returns value of its first
+        ///     member, i.e. the key must be defined using
+        ///     nil::marshalling::option::default_num_value option. May be specialised
+        ///     for the alternatives reporting their key differently.
+        /// @tparam TKey Type of the key value.
+        /// @tparam TAlternative Type of the variant alternative.
+        /// @headerfile nil/network/marshalling/keyed_variant.h
+        template<typename TKey, typename TAlternative>
+        struct variant_alternative_key {
+            static TKey value() {
+                TAlternative alternative;
+                return static_cast<TKey>(std::get<0>(alternative.value()).value());
+            }
+        };
+
+        namespace detail {
+            namespace keyed_variant {
+
+                template<std::size_t... TIndices>
+                struct indices { };
+
+                template<std::size_t TCount, std::size_t... TIndices>
+                struct make_indices : public make_indices<TCount - 1U, TCount - 1U, TIndices...> { };
+
+                template<std::size_t... TIndices>
+                struct make_indices<0U, TIndices...> {
+                    using type = indices<TIndices...>;
+                };
+
+                template<typename TVariant, typename TIter, std::size_t TIdx>
+                status_type read_alternative(TVariant &field, TIter &iter, std::size_t len) {
+                    auto &member = field.template init_field<TIdx>();
+                    return member.read(iter, len);
+                }
+
+                template<typename TVariant, typename TIter>
+                using read_func_type = status_type (*)(TVariant &, TIter &, std::size_t);
+
+                template<typename TVariant, typename TIter, std::size_t... TIndices>
+                const read_func_type<TVariant, TIter> *read_funcs(indices<TIndices...>) {
+                    static const read_func_type<TVariant, TIter> Funcs[] = {
+                        &read_alternative<TVariant, TIter, TIndices>...};
+                    return &Funcs[0];
+                }
+
+            }    // namespace keyed_variant
+        }        // namespace detail
+
+        /// @brief Lookup table mapping keys to the indices of the variant alternatives.
+        /// @details The table of the read functions is generated at compile time,
+        ///     the keys are collected (using @ref variant_alternative_key) and sorted
+        ///     once upon the first use. When several alternatives share the same key,
+        ///     the first one (in the order of definition) is selected.
+        /// @tparam TKeyField Type of the key field every alternative starts with.
+        /// @tparam TVariant Type of the variant field (nil::marshalling::types::variant).
+        /// @headerfile nil/network/marshalling/keyed_variant.h
+        template<typename TKeyField, typename TVariant>
+        class keyed_variant_table {
+            using members_type = typename TVariant::members_type;
+
+        public:
+            /// @brief Type of the key value.
+            using key_type = typename TKeyField::value_type;
+
+            /// @brief Number of the variant alternatives.
+            static const std::size_t alternatives_count = std::tuple_size<members_type>::value;
+
+            /// @brief Get the table instance.
+            static const keyed_variant_table &instance() {
+                static const keyed_variant_table Table;
+                return Table;
+            }
+
+            /// @brief Find index of the alternative starting with the key.
+            /// @return Index of the alternative or @ref alternatives_count if not found.
+            std::size_t find(key_type key) const {
+                auto begin = entries_.begin();
+                auto end = begin + entries_count_;
+                auto iter = std::lower_bound(begin, end, key,
+                                             [](const entry_type &e, key_type k) -> bool { return e.key_ < k; });
+                if ((iter == end) || (iter->key_ != key)) {
+                    return alternatives_count;
+                }
+
+                return iter->idx_;
+            }
+
+            /// @brief Number of the distinct keys.
+            std::size_t keys_count() const {
+                return entries_count_;
+            }
+
+        private:
+            struct entry_type {
+                key_type key_;
+                std::size_t idx_;
+            };
+
+            keyed_variant_table() {
+                fill(typename detail::keyed_variant::make_indices<alternatives_count>::type());
+                std::stable_sort(entries_.begin(), entries_.end(),
+                                 [](const entry_type &e1, const entry_type &e2) -> bool { return e1.key_ < e2.key_; });
+                auto end = std::unique(entries_.begin(), entries_.end(),
+                                       [](const entry_type &e1, const entry_type &e2) -> bool {
+                                           return e1.key_ == e2.key_;
+                                       });
+                entries_count_ = static_cast<std::size_t>(std::distance(entries_.begin(), end));
+            }
+
+            template<std::size_t... TIndices>
+            void fill(detail::keyed_variant::indices<TIndices...>) {
+                entries_ = {{entry_type {
+                    variant_alternative_key<key_type, typename std::tuple_element<TIndices, members_type>::type>::value(),
+                    TIndices}...}};
+            }
+
+            std::array<entry_type, alternatives_count> entries_;
+            std::size_t entries_count_ = 0U;
+        };
+
+        /// @brief Read the variant field using keyed dispatch.
+        /// @details Reads the key field once (without advancing the iterator),
+        ///     looks up the matching alternative in @ref keyed_variant_table and
+        ///     jumps directly to its read through the compile time generated table
+        ///     of read functions, instead of trying the alternatives one by one.
+        ///     When no alternative matches the key, the ordinary read of the variant
+        ///     is performed, which preserves semantics of the "catch all" alternatives.
+        ///     When the read of the matching alternative fails, the variant is reset
+        ///     and its status (including nil::marshalling::status_type::not_enough_data)
+        ///     is reported without trying the other alternatives.
+        /// @tparam TKeyField Type of the key field every alternative starts with.
+        /// @param[in, out] field Variant field (nil::marshalling::types::variant) to read,
+        ///     must not have its own read overridden by @ref MARSHALLING_VARIANT_KEYED_READ.
+        /// @param[in, out] iter Input iterator, must be copyable.
+        /// @param[in] len Number of remaining bytes in the input buffer.
+        /// @return Status of the read operation.
+        /// @headerfile nil/network/marshalling/keyed_variant.h
+        template<typename TKeyField, typename TVariant, typename TIter>
+        status_type keyed_variant_read(TVariant &field, TIter &iter, std::size_t len) {
+            using table_type = keyed_variant_table<TKeyField, TVariant>;
+
+            TKeyField keyField;
+            auto keyIter = iter;
+            auto es = keyField.read(keyIter, len);
+            if (es != status_type::success) {
+                return es;
+            }
+
+            auto idx = table_type::instance().find(keyField.value());
+            if (idx < table_type::alternatives_count) {
+                auto *funcs = detail::keyed_variant::read_funcs<TVariant, TIter>(
+                    typename detail::keyed_variant::make_indices<table_type::alternatives_count>::type());
+                auto readIter = iter;
+                es = funcs[idx](field, readIter, len);
+                if (es != status_type::success) {
+                    field.reset();
+                    return es;
+                }
+
+                iter = readIter;
+                return es;
+            }
+
+            return field.read(iter, len);
+        }
+
+    }    // namespace marshalling
+}    // namespace nil
+
+/// @brief Override read of the variant field to use keyed dispatch.
+/// @details Must be used inside the class extending nil::marshalling::types::variant
+///     after the @b MARSHALLING_VARIANT_MEMBERS_ACCESS macro (which defines
+///     @b as_variant() member function). The variant must be defined with
+///     nil::marshalling::option::has_custom_read option. Every alternative of the
+///     variant is expected to start with the key field.
+/// @code
+///     class property : public nil::marshalling::types::variant<..., nil::marshalling::option::has_custom_read> {
+///     public:
+///         MARSHALLING_VARIANT_MEMBERS_ACCESS(prop1, prop2, prop3);
+///         MARSHALLING_VARIANT_KEYED_READ(property_key);
+///     };
+/// @endcode
+/// @param key_field_ Type of the key field.
+/// @related nil::marshalling::keyed_variant_read
+#define MARSHALLING_VARIANT_KEYED_READ(key_field_)                                       \
+    template<typename TIter>                                                             \
+    nil::marshalling::status_type read(TIter &iter, std::size_t len) {                   \
+        return nil::marshalling::keyed_variant_read<key_field_>(as_variant(), iter, len); \
+    }
+
+#endif    // NETWORK_MARSHALLING_KEYED_VARIANT_HPP
@@ -32,6 +32,7 @@
 #include <nil/network/marshalling/detail/message/implementation_builder.hpp>
 #include <nil/network/marshalling/detail/macro_common.hpp>
 #include <nil/network/marshalling/detail/fields_access.hpp>
+#include <nil/network/marshalling/detail/gen_names.hpp>
 
 namespace nil {
     namespace marshalling {
@@ -904,6 +905,8 @@ namespace nil {
 ///     @li @b FieldIdx enum. The names are prefixed with @b FieldIdx_. The
 ///         @b FieldIdx_nameOfValues value is automatically added at the end.
 ///     @li Accessor functions prefixed with @b field_
+///     @li Static @b eval_field_name(std::size_t idx) function returning the
+///         provided name of the field as a string (@b nullptr for invalid index).
 ///
 ///     As the result, the fields can be accessed using @b FieldIdx enum
 ///     @code
@@ -946,6 +949,7 @@ namespace nil {
                       "Invalid number of names for fields tuple");                    \
         return val;                                                                   \
     }                                                                                 \
-    MARSHALLING_EXPAND(MARSHALLING_DO_FIELD_ACC_FUNC(all_fields_type, fields(), __VA_ARGS__))
+    MARSHALLING_EXPAND(MARSHALLING_DO_FIELD_ACC_FUNC(all_fields_type, fields(), __VA_ARGS__))  \
+    MARSHALLING_EXPAND(MARSHALLING_DEFINE_NAMES_FUNC(eval_field_name, __VA_ARGS__))
 
 #endif    // NETWORK_MARSHALLING_MESSAGE_BASE_HPP
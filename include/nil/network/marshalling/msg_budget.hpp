@@ -0,0 +1,309 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of the in-flight message memory budget used by
+///     the message factory for the admission control.
+
+#ifndef NETWORK_MARSHALLING_MSG_BUDGET_HPP
+#define NETWORK_MARSHALLING_MSG_BUDGET_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Statistics of the @ref msg_memory_budget.
+        /// @headerfile nil/network/marshalling/msg_budget.h
+        struct msg_budget_statistics {
+            std::size_t in_flight_bytes = 0;     ///< Number of bytes occupied by the allocated messages.
+            std::size_t in_flight_msgs = 0;      ///< Number of the allocated messages.
+            std::size_t high_water_bytes = 0;    ///< Max number of the in-flight bytes.
+            std::size_t high_water_msgs = 0;     ///< Max number of the in-flight messages.
+            std::uint64_t admitted = 0;          ///< Number of the admitted allocations.
+            std::uint64_t rejected = 0;          ///< Number of the rejected allocations.
+        };
+
+        /// @brief Budget of the in-flight (allocated, but not released yet) messages.
+        /// @details Limits both the number of bytes occupied by the message objects and
+        ///     the number of the messages. The allocation that would exceed any of the
+        ///     limits is rejected, so the memory stays bounded under the burst load.
+        ///     The accounting is lock free and may be shared by multiple threads and
+        ///     multiple factories, see @ref global_msg_memory_budget(). Under contention
+        ///     the admission is conservative, i.e. an allocation may be rejected while
+        ///     the concurrent one is being rolled back, but the limits are never exceeded.@n
+        ///     The bytes accounted by the allocators are the sizes of the message objects
+        ///     only, the heap storage owned by the messages (e.g. by the vector or string
+        ///     fields) is not accounted.
+        /// @headerfile nil/network/marshalling/msg_budget.h
+        class msg_memory_budget {
+        public:
+            /// @brief Default constructor, the budget is unlimited.
+            msg_memory_budget() = default;
+
+            /// @brief Constructor
+            /// @param[in] maxBytes Max number of in-flight bytes, 0 means unlimited.
+            /// @param[in] maxMsgs Max number of in-flight messages, 0 means unlimited.
+            msg_memory_budget(std::size_t maxBytes, std::size_t maxMsgs) : maxBytes_(maxBytes), maxMsgs_(maxMsgs) {
+            }
+
+            /// @brief Copy constructor is deleted.
+            msg_memory_budget(const msg_memory_budget &) = delete;
+
+            /// @brief Copy assignment is deleted.
+            msg_memory_budget &operator=(const msg_memory_budget &) = delete;
+
+            /// @brief Update the limits.
+            /// @details Doesn't affect the already allocated messages, even if they
+            ///     exceed the new limits.
+            /// @param[in] maxBytes Max number of in-flight bytes, 0 means unlimited.
+            /// @param[in] maxMsgs Max number of in-flight messages, 0 means unlimited.
+            void set_limits(std::size_t maxBytes, std::size_t maxMsgs) {
+                maxBytes_.store(maxBytes, std::memory_order_relaxed);
+                maxMsgs_.store(maxMsgs, std::memory_order_relaxed);
+            }
+
+            /// @brief Max number of in-flight bytes, 0 means unlimited.
+            std::size_t max_bytes() const {
+                return maxBytes_.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Max number of in-flight messages, 0 means unlimited.
+            std::size_t max_msgs() const {
+                return maxMsgs_.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Try to account the new message.
+            /// @param[in] bytes Size of the message object.
+            /// @return true if the message is admitted, false if it exceeds the budget.
+            bool acquire(std::size_t bytes) {
+                auto msgLimit = maxMsgs_.load(std::memory_order_relaxed);
+                auto msgs = msgs_.fetch_add(1U, std::memory_order_relaxed) + 1U;
+                if ((msgLimit != 0U) && (msgLimit < msgs)) {
+                    msgs_.fetch_sub(1U, std::memory_order_relaxed);
+                    rejected_.fetch_add(1U, std::memory_order_relaxed);
+                    return false;
+                }
+
+                auto byteLimit = maxBytes_.load(std::memory_order_relaxed);
+                auto total = bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                if ((byteLimit != 0U) && (byteLimit < total)) {
+                    bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+                    msgs_.fetch_sub(1U, std::memory_order_relaxed);
+                    rejected_.fetch_add(1U, std::memory_order_relaxed);
+                    return false;
+                }
+
+                update_max(highWaterMsgs_, msgs);
+                update_max(highWaterBytes_, total);
+                admitted_.fetch_add(1U, std::memory_order_relaxed);
+                return true;
+            }
+
+            /// @brief Release previously acquired message.
+            /// @param[in] bytes Size of the message object, same as passed to @ref acquire().
+            void release(std::size_t bytes) {
+                bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+                msgs_.fetch_sub(1U, std::memory_order_relaxed);
+            }
+
+            /// @brief Number of bytes occupied by the allocated messages.
+            std::size_t in_flight_bytes() const {
+                return bytes_.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Number of the allocated messages.
+            std::size_t in_flight_msgs() const {
+                return msgs_.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Get the statistics.
+            msg_budget_statistics statistics() const {
+                msg_budget_statistics stats;
+                stats.in_flight_bytes = bytes_.load(std::memory_order_relaxed);
+                stats.in_flight_msgs = msgs_.load(std::memory_order_relaxed);
+                stats.high_water_bytes = highWaterBytes_.load(std::memory_order_relaxed);
+                stats.high_water_msgs = highWaterMsgs_.load(std::memory_order_relaxed);
+                stats.admitted = admitted_.load(std::memory_order_relaxed);
+                stats.rejected = rejected_.load(std::memory_order_relaxed);
+                return stats;
+            }
+
+            /// @brief Reset the high-water marks to the current in-flight values
+            ///     and the admission counters to 0.
+            void reset_statistics() {
+                highWaterBytes_.store(bytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                highWaterMsgs_.store(msgs_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                admitted_.store(0U, std::memory_order_relaxed);
+                rejected_.store(0U, std::memory_order_relaxed);
+            }
+
+        private:
+            static void update_max(std::atomic<std::size_t> &mark, std::size_t value) {
+                auto prev = mark.load(std::memory_order_relaxed);
+                while ((prev < value) && (!mark.compare_exchange_weak(prev, value, std::memory_order_relaxed))) {
+                }
+            }
+
+            std::atomic<std::size_t> maxBytes_ {0U};
+            std::atomic<std::size_t> maxMsgs_ {0U};
+            std::atomic<std::size_t> bytes_ {0U};
+            std::atomic<std::size_t> msgs_ {0U};
+            std::atomic<std::size_t> highWaterBytes_ {0U};
+            std::atomic<std::size_t> highWaterMsgs_ {0U};
+            std::atomic<std::uint64_t> admitted_ {0U};
+            std::atomic<std::uint64_t> rejected_ {0U};
+        };
+
+        /// @brief Access the global budget identified by the tag.
+        /// @details Used by the message factories defined with
+        ///     @ref nil::marshalling::option::budgeted_allocation option, all the factories
+        ///     using the same tag share the budget.
+        /// @tparam TTag Tag type distinguishing independent budgets.
+        /// @headerfile nil/network/marshalling/msg_budget.h
+        template<typename TTag = void>
+        msg_memory_budget &global_msg_memory_budget() {
+            static msg_memory_budget budget;
+            return budget;
+        }
+
+        /// @brief Bounded queue of the raw frames, which decoding has been postponed.
+        /// @details When the message allocation is rejected by the budget, the
+        ///     protocol stack reports nil::marshalling::status_type::msg_alloc_failure
+        ///     and the read iterator is advanced past the frame. Instead of dropping
+        ///     the frame it can be stored in this queue and decoded again when the
+        ///     in-flight messages are released. The storage is allocated once upon
+        ///     construction, so the queued frames don't grow the memory usage.
+        /// @headerfile nil/network/marshalling/msg_budget.h
+        class deferred_frame_queue {
+            using length_type = std::uint32_t;
+
+        public:
+            /// @brief Constructor
+            /// @param[in] capacity Number of bytes available for the frames, every
+            ///     frame occupies additional 4 bytes.
+            explicit deferred_frame_queue(std::size_t capacity) : data_(capacity) {
+            }
+
+            /// @brief Store the frame.
+            /// @return false if there is no room for the frame, the frame is not stored.
+            bool push(const std::uint8_t *frame, std::size_t len) {
+                auto required = sizeof(length_type) + len;
+                if ((data_.size() - size_) < required) {
+                    return false;
+                }
+
+                auto len32 = static_cast<length_type>(len);
+                write_bytes(tail_, reinterpret_cast<const std::uint8_t *>(&len32), sizeof(len32));
+                write_bytes(advance(tail_, sizeof(len32)), frame, len);
+                tail_ = advance(tail_, required);
+                size_ += required;
+                ++count_;
+                return true;
+            }
+
+            /// @brief Length of the oldest frame.
+            /// @pre The queue is not empty.
+            std::size_t front_length() const {
+                length_type len32 = 0U;
+                read_bytes(head_, reinterpret_cast<std::uint8_t *>(&len32), sizeof(len32));
+                return len32;
+            }
+
+            /// @brief Copy out and remove the oldest frame.
+            /// @param[out] buf Output buffer, must be at least @ref front_length() bytes long.
+            /// @return Length of the frame.
+            /// @pre The queue is not empty.
+            std::size_t pop(std::uint8_t *buf) {
+                auto len = front_length();
+                read_bytes(advance(head_, sizeof(length_type)), buf, len);
+                auto occupied = sizeof(length_type) + len;
+                head_ = advance(head_, occupied);
+                size_ -= occupied;
+                --count_;
+                return len;
+            }
+
+            /// @brief Number of the queued frames.
+            std::size_t size() const {
+                return count_;
+            }
+
+            /// @brief Check whether the queue is empty.
+            bool empty() const {
+                return count_ == 0U;
+            }
+
+            /// @brief Number of occupied bytes.
+            std::size_t occupied() const {
+                return size_;
+            }
+
+            /// @brief Number of bytes available for the frames.
+            std::size_t capacity() const {
+                return data_.size();
+            }
+
+            /// @brief Drop all the queued frames.
+            void clear() {
+                head_ = 0U;
+                tail_ = 0U;
+                size_ = 0U;
+                count_ = 0U;
+            }
+
+        private:
+            std::size_t advance(std::size_t pos, std::size_t count) const {
+                return (pos + count) % data_.size();
+            }
+
+            void write_bytes(std::size_t pos, const std::uint8_t *src, std::size_t len) {
+                auto first = std::min(len, data_.size() - pos);
+                std::copy_n(src, first, &data_[pos]);
+                std::copy_n(src + first, len - first, data_.data());
+            }
+
+            void read_bytes(std::size_t pos, std::uint8_t *dst, std::size_t len) const {
+                auto first = std::min(len, data_.size() - pos);
+                std::copy_n(&data_[pos], first, dst);
+                std::copy_n(data_.data(), len - first, dst + first);
+            }
+
+            std::vector<std::uint8_t> data_;
+            std::size_t head_ = 0U;
+            std::size_t tail_ = 0U;
+            std::size_t size_ = 0U;
+            std::size_t count_ = 0U;
+        };
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_MSG_BUDGET_HPP
@@ -32,6 +32,8 @@
 #include <type_traits>
 #include <algorithm>
 
+#include <nil/detail/type_traits.hpp>
+
 #include <nil/marshalling/assert_type.hpp>
 #include <nil/marshalling/processing/tuple.hpp>
 #include <nil/network/marshalling/alloc.hpp>
@@ -75,6 +77,11 @@ namespace nil {
         ///         If nil::marshalling::option::InPlaceAllocation option is NOT used, than the
         ///         requested message objects are allocated using dynamic memory and
         ///         returned wrapped in std::unique_ptr without custom deleter.
+        ///     @li nil::marshalling::option::in_place_pool_allocation - Same as
+        ///         nil::marshalling::option::InPlaceAllocation, but the private storage
+        ///         is a pool of the specified number of elements, so that many messages
+        ///         (including the clones) may be allocated at the same time. When the
+        ///         pool is exhausted, create_msg() returns empty pointer.
         ///     @li nil::marshalling::option::SupportGenericMessage - Option used to allow
         ///         allocation of @ref nil::marshalling::generic_message. If such option is
         ///         provided, the createGenericMsg() member function will be able
@@ -82,6 +89,12 @@ namespace nil {
         ///         the base class of @ref nil::marshalling::generic_message type (first template
         ///         parameter) must be equal to @b TMsgBase (first template parameter)
         ///         of @b this class.
+        ///     @li nil::marshalling::option::budgeted_allocation - Option to limit the
+        ///         dynamically allocated messages by the global in-flight byte and message
+        ///         budget (see @ref nil::marshalling::global_msg_memory_budget()). When the
+        ///         budget is exceeded, create_msg() returns empty pointer without allocating
+        ///         and the protocol stack reports nil::marshalling::status_type::msg_alloc_failure.
+        ///         The budget statistics expose the high-water marks.
         /// @pre TMsgBase is a base class for all the messages in TAllMessages.
         /// @pre message type is TAllMessages must be sorted based on their IDs.
         /// @pre If nil::marshalling::option::InPlaceAllocation option is provided, only one custom
@@ -145,6 +158,38 @@ namespace nil {
                 return factory_.create_generic_msg(id);
             }
 
+            /// @brief Clone message object of known type.
+            /// @details The copy is allocated by the same allocator that is used by
+            ///     create_msg(), i.e. from the dynamic memory, under the message budget or
+            ///     from the in-place pool (see nil::marshalling::option::in_place_pool_allocation),
+            ///     depending on the options provided to the factory, and is initialised
+            ///     by the copy constructor of the message. Cloning is rejected at compile
+            ///     time when nil::marshalling::option::in_place_allocation option is used,
+            ///     because the only in-place storage is occupied by the original message.
+            /// @param msg Message object to clone, its type must be one of @ref all_messages_type.
+            /// @return Smart pointer to the copy, empty in case of allocation failure.
+            template<typename TMessage>
+            typename std::enable_if<nil::detail::is_in_tuple<TMessage, all_messages_type>::value,
+                                    msg_ptr_type>::type
+                clone(const TMessage &msg) const {
+                return factory_.template alloc_clone<TMessage>(msg);
+            }
+
+            /// @brief Clone message object accessed via its common interface.
+            /// @details The actual type of the message is looked up by the reported
+            ///     ID the same way create_msg() does. The message interface is required
+            ///     to support polymorphic ID retrieval (see nil::marshalling::option::id_info_interface).
+            ///     The dynamic type of the message is verified (using RTTI) to be exactly
+            ///     the registered one before the copy is made, cloning via interface is
+            ///     rejected at compile time when RTTI is disabled.
+            /// @param msg Message object to clone.
+            /// @param idx Relative index of the message with the same ID, see create_msg().
+            /// @return Smart pointer to the copy, empty when the ID is unknown, the type of
+            ///     the message differs from the registered one or the allocation failed.
+            msg_ptr_type clone(const message_type &msg, unsigned idx = 0) const {
+                return factory_.clone_msg(msg, idx);
+            }
+
             /// @brief Get number of message types from @ref all_messages_type, that have the specified ID.
             /// @param id ID of the message.
             /// @return Number of message classes that report same ID.
@@ -96,6 +96,14 @@ namespace nil {
             template<std::intmax_t TId>
             struct static_num_id_impl { };
 
+            /// @brief Option used to specify dispatch priority of the message.
+            /// @details Used by nil::marshalling::priority_batch_dispatcher, the messages
+            ///     with higher priority are dispatched first. The default priority is 0.
+            /// @tparam TPriority Priority value.
+            /// @headerfile nil/marshalling/options.h
+            template<std::intmax_t TPriority>
+            struct dispatch_priority { };
+
             /// @brief Option used to specify that message doesn't have valid ID.
             /// @headerfile nil/marshalling/options.h
             struct no_id_impl { };
@@ -188,6 +196,34 @@ namespace nil {
             /// @headerfile nil/marshalling/options.h
             struct in_place_allocation { };
 
+            /// @brief Option that forces "in place" allocation of the messages in the
+            ///     pool of TSize elements residing in the factory object itself
+            ///     (see @ref nil::marshalling::processing::alloc::in_place_pool).
+            /// @details Unlike @ref in_place_allocation, up to TSize messages may be
+            ///     allocated at the same time, which allows the messages to be cloned
+            ///     by the factory. When all the elements are occupied the allocation
+            ///     fails, the released elements are reused. Cannot be combined with
+            ///     @ref in_place_allocation or @ref budgeted_allocation.
+            /// @tparam TSize Number of the pool elements.
+            /// @headerfile nil/marshalling/options.h
+            template<std::size_t TSize>
+            struct in_place_pool_allocation { };
+
+            /// @brief Option that limits the dynamically allocated messages by the global
+            ///     in-flight budget (see @ref nil::marshalling::global_msg_memory_budget()).
+            /// @details When the budget is exceeded the allocation fails and the protocol
+            ///     stack reports nil::marshalling::status_type::msg_alloc_failure. The
+            ///     allocated messages are returned in the smart pointer with the custom
+            ///     deleter, which releases the budget. Only the size of the message
+            ///     object itself is accounted, the heap storage owned by its fields is
+            ///     not limited. Cannot be combined with @ref in_place_allocation or
+            ///     @ref in_place_pool_allocation.
+            /// @tparam TTag Tag type of the budget, the factories using the same tag
+            ///     share the budget.
+            /// @headerfile nil/marshalling/options.h
+            template<typename TTag = void>
+            struct budgeted_allocation { };
+
             /// @brief Option used to allow @ref nil::marshalling::generic_message generation inside
             ///  @ref nil::marshalling::msg_factory and/or @ref nil::marshalling::protocol::msg_id_layer classes.
             /// @tparam TGenericMessage Type of message, expected to be a variant of
@@ -206,6 +242,30 @@ namespace nil {
             /// @headerfile nil/marshalling/options.h
             struct checksum_layer_verify_before_read { };
 
+            /// @brief Force nil::marshalling::protocol::checksum_layer to calculate the
+            ///     checksum while the wrapped layer(s) decode the data, instead of
+            ///     a separate pass over the read data.
+            /// @details The checksum calculator must support incremental calculation
+            ///     (see nil::marshalling::protocol::checksum::checksum_iterator).
+            ///     Only the transport fields and the payload of the messages read
+            ///     directly (by the message object of known type) are fused. The
+            ///     polymorphic read of the payload requires the @b read_iterator of the
+            ///     message interface, so such payload is decoded first and then accounted
+            ///     by the checksum in a second pass over the (already cached) bytes.
+            ///     Cannot be combined with @ref checksum_layer_verify_before_read.
+            /// @headerfile nil/marshalling/options.h
+            struct checksum_layer_fused_read { };
+
+            /// @brief Force nil::marshalling::protocol::checksum_layer to defer the checksum
+            ///     verification, allowing the read message to be dispatched to the handler
+            ///     before the verification is complete.
+            /// @details The verification must be performed explicitly after the read,
+            ///     see nil::marshalling::speculative_dispatch(). Requires contiguous
+            ///     input buffer, which must remain valid until the verification.
+            ///     Cannot be combined with other checksum read modes.
+            /// @headerfile nil/marshalling/options.h
+            struct checksum_layer_speculative_read { };
+
             /// @brief Option to force @ref nil::marshalling::protocol::ProtocolLayerBase class to
             ///     split read operation "until" and "from" data (payload) layer.
             /// @details Can be used by some layers which require its read operation to be
@@ -238,6 +298,15 @@ namespace nil {
             ///     mark that the handled field is a "pseudo" one, i.e. is not serialized.
             struct pseudo_value { };
 
+            /// @brief Option for @ref nil::marshalling::protocol::transport_value_layer to
+            ///     memoize the raw header bytes of the last successfully read frame.
+            /// @details Covers the field of the layer and of all the directly following
+            ///     transport_value_layer layers, i.e. the whole transport header handled by them.
+            ///     When the header bytes of the next frame are equal to the memoized ones, the
+            ///     previously decoded values are reassigned to the message instead of decoding
+            ///     the fields once again. All the covered fields must be of fixed length.
+            struct memoized_header { };
+
         }    // namespace option
     }        // namespace marshalling
 }    // namespace nil
@@ -0,0 +1,293 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of nil::marshalling::priority_batch_dispatcher class.
+
+#ifndef NETWORK_MARSHALLING_PRIORITY_DISPATCH_HPP
+#define NETWORK_MARSHALLING_PRIORITY_DISPATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Dispatch priority of the message type.
+        /// @details Specified using nil::marshalling::option::dispatch_priority option
+        ///     passed to nil::marshalling::message_base, 0 if not specified.
+        /// @tparam TMessage Message type.
+        /// @headerfile nil/network/marshalling/priority_dispatch.h
+        template<typename TMessage>
+        constexpr std::intmax_t message_dispatch_priority() {
+            return TMessage::impl_options_type::dispatch_priority;
+        }
+
+        /// @brief Key extractor of @ref priority_batch_dispatcher, which does not
+        ///     impose any ordering constraints.
+        /// @headerfile nil/network/marshalling/priority_dispatch.h
+        struct no_dispatch_key {
+            /// @brief Type of the key.
+            using key_type = std::size_t;
+
+            /// @brief Retrieve the key, always reports message as having no key.
+            template<typename TMsg>
+            bool operator()(const TMsg &msg, key_type &key) const {
+                static_cast<void>(msg);
+                static_cast<void>(key);
+                return false;
+            }
+        };
+
+        namespace detail {
+
+            namespace priority_dispatch {
+
+                template<std::size_t...>
+                struct indices { };
+
+                template<std::size_t TCount, std::size_t... TIndices>
+                struct make_indices : public make_indices<TCount - 1U, TCount - 1U, TIndices...> { };
+
+                template<std::size_t... TIndices>
+                struct make_indices<0U, TIndices...> {
+                    using type = indices<TIndices...>;
+                };
+
+                template<typename TMessage>
+                struct priority_entry_value {
+                    static_assert(TMessage::impl_options_type::has_static_msg_id,
+                                  "Messages must define their IDs using nil::marshalling::option::static_num_id_impl");
+
+                    static constexpr std::intmax_t id() {
+                        return TMessage::impl_options_type::msg_id;
+                    }
+
+                    static constexpr std::intmax_t priority() {
+                        return message_dispatch_priority<TMessage>();
+                    }
+                };
+
+            }    // namespace priority_dispatch
+
+        }    // namespace detail
+
+        /// @brief Dispatcher of the decoded batch of messages, which dispatches
+        ///     the messages with higher priority first.
+        /// @details The priorities of the message types are specified at compile time
+        ///     using nil::marshalling::option::dispatch_priority option and looked up by
+        ///     the message ID. The messages of the same priority are dispatched in the
+        ///     arrival order. In addition the messages sharing the same key (reported by
+        ///     @b TKeyOf) are always dispatched in the arrival order: the earlier messages
+        ///     inherit the priority of the later ones with the same key, i.e. an urgent
+        ///     message pulls forward the pending messages it depends on.
+        /// @tparam TMsgPtr Type of the smart pointer holding the message, i.e.
+        ///     @b msg_ptr_type of the protocol stack.
+        /// @tparam TAllMessages All the message types in std::tuple, the ones which
+        ///     share the same ID must have the same priority.
+        /// @tparam TKeyOf Key extractor, must define @b key_type (hashable) and
+        ///     @code bool operator()(const TMsgBase& msg, key_type& key) const; @endcode
+        ///     returning false when the message has no key.
+        /// @headerfile nil/network/marshalling/priority_dispatch.h
+        template<typename TMsgPtr, typename TAllMessages, typename TKeyOf = no_dispatch_key>
+        class priority_batch_dispatcher {
+            static const std::size_t messages_count = std::tuple_size<TAllMessages>::value;
+
+        public:
+            /// @brief Type of the smart pointer holding the message.
+            using msg_ptr_type = TMsgPtr;
+
+            /// @brief Common interface class of the messages.
+            using interface_type = typename std::pointer_traits<TMsgPtr>::element_type;
+
+            /// @brief Type of the key used for ordering constraints.
+            using key_type = typename TKeyOf::key_type;
+
+            /// @brief Constructor
+            /// @param[in] keyOf Key extractor.
+            explicit priority_batch_dispatcher(TKeyOf keyOf = TKeyOf()) : keyOf_(std::move(keyOf)) {
+            }
+
+            /// @brief Priority of the message object, retrieved by its ID.
+            static std::intmax_t priority(const interface_type &msg) {
+                auto &table = priority_table();
+                auto id = static_cast<std::intmax_t>(msg.get_id());
+                auto iter = std::lower_bound(table.begin(), table.end(), id,
+                                             [](const priority_entry &e, std::intmax_t i) -> bool { return e.id_ < i; });
+                if ((iter == table.end()) || (iter->id_ != id)) {
+                    return 0;
+                }
+
+                return iter->priority_;
+            }
+
+            /// @brief Add the message to the batch.
+            /// @details Null pointers are ignored.
+            void push(msg_ptr_type msg) {
+                if (!msg) {
+                    return;
+                }
+
+                auto prio = priority(*msg);
+                entries_.push_back(entry {std::move(msg), prio});
+            }
+
+            /// @brief Number of messages in the batch.
+            std::size_t size() const {
+                return entries_.size();
+            }
+
+            /// @brief Check whether the batch is empty.
+            bool empty() const {
+                return entries_.empty();
+            }
+
+            /// @brief Reserve space for the batch of the provided size.
+            void reserve(std::size_t count) {
+                entries_.reserve(count);
+                order_.reserve(count);
+            }
+
+            /// @brief Dispatch all the messages in the batch to the handler and clear the batch.
+            /// @param[in] handler Handler object.
+            /// @return Number of dispatched messages.
+            template<typename THandler>
+            std::size_t dispatch(THandler &handler) {
+                arrange();
+                for (auto idx : order_) {
+                    entries_[idx].msg_->dispatch(handler);
+                }
+
+                auto count = entries_.size();
+                entries_.clear();
+                return count;
+            }
+
+            /// @brief Arrange the batch and invoke the functor with every message in
+            ///     the dispatch order, then clear the batch.
+            /// @details The functor receives the smart pointer to the message and
+            ///     takes over its ownership if needed.
+            /// @return Number of processed messages.
+            template<typename TFunc>
+            std::size_t drain(TFunc &&func) {
+                arrange();
+                for (auto idx : order_) {
+                    func(std::move(entries_[idx].msg_));
+                }
+
+                auto count = entries_.size();
+                entries_.clear();
+                return count;
+            }
+
+        private:
+            struct entry {
+                msg_ptr_type msg_;
+                std::intmax_t priority_;
+            };
+
+            struct priority_entry {
+                std::intmax_t id_;
+                std::intmax_t priority_;
+            };
+
+            using priority_table_type = std::array<priority_entry, messages_count>;
+
+            static const priority_table_type &priority_table() {
+                static const priority_table_type Table
+                    = make_table(typename detail::priority_dispatch::make_indices<messages_count>::type());
+                return Table;
+            }
+
+            template<std::size_t... TIndices>
+            static priority_table_type make_table(detail::priority_dispatch::indices<TIndices...>) {
+                priority_table_type table = {{priority_entry {
+                    detail::priority_dispatch::priority_entry_value<
+                        typename std::tuple_element<TIndices, TAllMessages>::type>::id(),
+                    detail::priority_dispatch::priority_entry_value<
+                        typename std::tuple_element<TIndices, TAllMessages>::type>::priority()}...}};
+                std::stable_sort(table.begin(), table.end(), [](const priority_entry &e1, const priority_entry &e2) {
+                    return e1.id_ < e2.id_;
+                });
+                return table;
+            }
+
+            void arrange() {
+                inherit_priorities(std::is_same<TKeyOf, no_dispatch_key>());
+
+                order_.resize(entries_.size());
+                for (std::size_t idx = 0U; idx < order_.size(); ++idx) {
+                    order_[idx] = idx;
+                }
+
+                std::stable_sort(order_.begin(), order_.end(), [this](std::size_t idx1, std::size_t idx2) -> bool {
+                    return entries_[idx2].priority_ < entries_[idx1].priority_;
+                });
+            }
+
+            void inherit_priorities(std::true_type) {
+            }
+
+            void inherit_priorities(std::false_type) {
+                // Walk backwards, so every message inherits the highest priority of
+                // the later messages with the same key.
+                lastPriority_.clear();
+                for (auto idx = entries_.size(); 0U < idx; --idx) {
+                    auto &e = entries_[idx - 1U];
+                    key_type key;
+                    if (!keyOf_(*e.msg_, key)) {
+                        continue;
+                    }
+
+                    auto iter = lastPriority_.find(key);
+                    if (iter == lastPriority_.end()) {
+                        lastPriority_.emplace(key, e.priority_);
+                        continue;
+                    }
+
+                    e.priority_ = std::max(e.priority_, iter->second);
+                    iter->second = e.priority_;
+                }
+            }
+
+            TKeyOf keyOf_;
+            std::vector<entry> entries_;
+            std::vector<std::size_t> order_;
+            std::unordered_map<key_type, std::intmax_t> lastPriority_;
+        };
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_PRIORITY_DISPATCH_HPP
@@ -0,0 +1,247 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Provides type erased wrapper of the protocol stack.
+
+#ifndef NETWORK_MARSHALLING_ANY_PROTOCOL_STACK_HPP
+#define NETWORK_MARSHALLING_ANY_PROTOCOL_STACK_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <nil/marshalling/assert_type.hpp>
+#include <nil/marshalling/status_type.hpp>
+
+namespace nil {
+    namespace marshalling {
+        namespace protocol {
+
+            namespace detail {
+
+                template<typename TMsgBase, typename TMsgPtr>
+                class any_protocol_stack_holder_base {
+                public:
+                    using read_iterator = typename TMsgBase::read_iterator;
+                    using write_iterator = typename TMsgBase::write_iterator;
+
+                    virtual ~any_protocol_stack_holder_base() noexcept = default;
+
+                    virtual status_type read(TMsgPtr &msg, read_iterator &iter, std::size_t size,
+                                             std::size_t *missingSize)
+                        = 0;
+                    virtual status_type write(const TMsgBase &msg, write_iterator &iter, std::size_t size) const = 0;
+                    virtual std::size_t length(const TMsgBase &msg) const = 0;
+                    virtual std::size_t length() const = 0;
+                    virtual void *stack() = 0;
+                };
+
+                template<typename TMsgBase, typename TMsgPtr, typename TStack>
+                class any_protocol_stack_holder final : public any_protocol_stack_holder_base<TMsgBase, TMsgPtr> {
+                    using base_type = any_protocol_stack_holder_base<TMsgBase, TMsgPtr>;
+
+                public:
+                    using read_iterator = typename base_type::read_iterator;
+                    using write_iterator = typename base_type::write_iterator;
+
+                    template<typename... TArgs>
+                    explicit any_protocol_stack_holder(TArgs &&...args) : stack_(std::forward<TArgs>(args)...) {
+                    }
+
+                    status_type read(TMsgPtr &msg, read_iterator &iter, std::size_t size,
+                                     std::size_t *missingSize) override {
+                        return stack_.read(msg, iter, size, missingSize);
+                    }
+
+                    status_type write(const TMsgBase &msg, write_iterator &iter, std::size_t size) const override {
+                        return stack_.write(msg, iter, size);
+                    }
+
+                    std::size_t length(const TMsgBase &msg) const override {
+                        return stack_.length(msg);
+                    }
+
+                    std::size_t length() const override {
+                        return stack_.length();
+                    }
+
+                    void *stack() override {
+                        return &stack_;
+                    }
+
+                private:
+                    TStack stack_;
+                };
+
+            }    // namespace detail
+
+            /// @brief Type erased protocol stack.
+            /// @details Wraps any concrete protocol stack, which handles the messages
+            ///     with common interface class @b TMsgBase, allowing selection of the
+            ///     stack configuration (checksum, size width, sync word, etc...) at
+            ///     runtime. The whole frame is processed by the concrete stack, i.e.
+            ///     there is only a single virtual call per @ref read(), @ref write() or
+            ///     @ref length() invocation, while the layers and fields of the wrapped
+            ///     stack remain inlined.
+            /// @tparam TMsgBase Common interface class of the messages, must define
+            ///     @b read_iterator and @b write_iterator types.
+            /// @tparam TMsgPtr Smart pointer to the message object, must be the same
+            ///     as @b msg_ptr_type of the wrapped stacks.
+            /// @headerfile nil/network/marshalling/protocol/any_protocol_stack.h
+            template<typename TMsgBase, typename TMsgPtr = std::unique_ptr<TMsgBase>>
+            class any_protocol_stack {
+                using holder_base_type = detail::any_protocol_stack_holder_base<TMsgBase, TMsgPtr>;
+
+            public:
+                /// @brief Common interface class of the messages.
+                using message_type = TMsgBase;
+
+                /// @brief Smart pointer to the message object.
+                using msg_ptr_type = TMsgPtr;
+
+                /// @brief Type of the iterator used for reading.
+                using read_iterator = typename TMsgBase::read_iterator;
+
+                /// @brief Type of the iterator used for writing.
+                using write_iterator = typename TMsgBase::write_iterator;
+
+                /// @brief Default constructor, creates empty object.
+                any_protocol_stack() = default;
+
+                /// @brief Move constructor.
+                any_protocol_stack(any_protocol_stack &&) = default;
+
+                /// @brief Copy constructor is deleted.
+                any_protocol_stack(const any_protocol_stack &) = delete;
+
+                /// @brief Construct wrapping the concrete stack.
+                template<typename TStack,
+                         typename = typename std::enable_if<
+                             !std::is_same<typename std::decay<TStack>::type, any_protocol_stack>::value>::type>
+                explicit any_protocol_stack(TStack &&stack) {
+                    emplace<typename std::decay<TStack>::type>(std::forward<TStack>(stack));
+                }
+
+                /// @brief Destructor
+                ~any_protocol_stack() noexcept = default;
+
+                /// @brief Move assignment.
+                any_protocol_stack &operator=(any_protocol_stack &&) = default;
+
+                /// @brief Copy assignment is deleted.
+                any_protocol_stack &operator=(const any_protocol_stack &) = delete;
+
+                /// @brief Construct the concrete stack in place, replacing the previous one.
+                /// @tparam TStack Type of the concrete protocol stack.
+                /// @param[in] args Arguments forwarded to the constructor of the stack.
+                /// @return Reference to the constructed stack.
+                template<typename TStack, typename... TArgs>
+                TStack &emplace(TArgs &&...args) {
+                    static_assert(std::is_same<typename TStack::msg_ptr_type, msg_ptr_type>::value,
+                                  "The message pointer type of the stack must be the same as msg_ptr_type");
+                    using holder_type = detail::any_protocol_stack_holder<TMsgBase, TMsgPtr, TStack>;
+                    holder_.reset(new holder_type(std::forward<TArgs>(args)...));
+                    return *static_cast<TStack *>(holder_->stack());
+                }
+
+                /// @brief Check whether the concrete stack has been assigned.
+                bool valid() const {
+                    return static_cast<bool>(holder_);
+                }
+
+                /// @brief Check whether the concrete stack has been assigned.
+                explicit operator bool() const {
+                    return valid();
+                }
+
+                /// @brief Remove the concrete stack.
+                void reset() {
+                    holder_.reset();
+                }
+
+                /// @brief Access the wrapped stack.
+                /// @tparam TStack Type of the concrete protocol stack, must be the same
+                ///     as the one used for the construction.
+                template<typename TStack>
+                TStack &stack() {
+                    MARSHALLING_ASSERT(valid());
+                    return *static_cast<TStack *>(holder_->stack());
+                }
+
+                /// @brief Deserialize the message object, see
+                ///     nil::marshalling::protocol::protocol_layer_base::read().
+                /// @pre @ref valid() returns true.
+                status_type read(msg_ptr_type &msg, read_iterator &iter, std::size_t size,
+                                 std::size_t *missingSize = nullptr) {
+                    MARSHALLING_ASSERT(valid());
+                    return holder_->read(msg, iter, size, missingSize);
+                }
+
+                /// @brief Serialize the message object, see
+                ///     nil::marshalling::protocol::protocol_layer_base::write().
+                /// @pre @ref valid() returns true.
+                status_type write(const message_type &msg, write_iterator &iter, std::size_t size) const {
+                    MARSHALLING_ASSERT(valid());
+                    return holder_->write(msg, iter, size);
+                }
+
+                /// @brief Serialization length of the message, see
+                ///     nil::marshalling::protocol::protocol_layer_base::length().
+                /// @pre @ref valid() returns true.
+                std::size_t length(const message_type &msg) const {
+                    MARSHALLING_ASSERT(valid());
+                    return holder_->length(msg);
+                }
+
+                /// @brief Serialization length of the transport fields (without the payload).
+                /// @pre @ref valid() returns true.
+                std::size_t length() const {
+                    MARSHALLING_ASSERT(valid());
+                    return holder_->length();
+                }
+
+            private:
+                std::unique_ptr<holder_base_type> holder_;
+            };
+
+            /// @brief Create the type erased stack wrapping the concrete one.
+            /// @tparam TMsgBase Common interface class of the messages.
+            /// @tparam TStack Type of the concrete protocol stack.
+            /// @param[in] args Arguments forwarded to the constructor of the stack.
+            /// @headerfile nil/network/marshalling/protocol/any_protocol_stack.h
+            template<typename TMsgBase, typename TStack, typename... TArgs>
+            any_protocol_stack<TMsgBase, typename TStack::msg_ptr_type> make_any_protocol_stack(TArgs &&...args) {
+                any_protocol_stack<TMsgBase, typename TStack::msg_ptr_type> result;
+                result.template emplace<TStack>(std::forward<TArgs>(args)...);
+                return result;
+            }
+
+        }    // namespace protocol
+    }        // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_ANY_PROTOCOL_STACK_HPP
@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_ADLER_HPP
+#define NETWORK_MARSHALLING_ADLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <nil/network/marshalling/protocol/checksum/detail/wide_access.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        namespace protocol {
+
+            namespace checksum {
+
+                /// @brief Adler-32 checksum calculator.
+                /// @details The modulo reduction is deferred to the end of the blocks
+                ///     which cannot overflow 32 bit accumulators. The pointer ranges are
+                ///     loaded 16 bytes (SSE2) or 64 bit word at a time, the weighted sums
+                ///     of the loaded bytes are added to the accumulators at once.
+                /// @headerfile nil/network/marshalling/protocol/checksum/adler.h
+                class adler32 {
+                public:
+                    /// @brief Type of the intermediate state of incremental calculation.
+                    struct state_type {
+                        std::uint32_t a_;
+                        std::uint32_t b_;
+                    };
+
+                    /// @brief Initial state of incremental calculation.
+                    static constexpr state_type init() {
+                        return state_type {1U, 0U};
+                    }
+
+                    /// @brief Update state of incremental calculation with a single byte.
+                    static state_type update(state_type state, std::uint8_t byte) {
+                        state.a_ = (state.a_ + byte) % Modulo;
+                        state.b_ = (state.b_ + state.a_) % Modulo;
+                        return state;
+                    }
+
+                    /// @brief Retrieve the checksum value out of the state of incremental calculation.
+                    static constexpr std::uint32_t finalize(state_type state) {
+                        return (state.b_ << 16U) | state.a_;
+                    }
+
+                    /// @brief Operator that is invoked to calculate the checksum value
+                    /// @param[in, out] iter Input iterator,
+                    /// @param[in] len Number of bytes to summarise.
+                    /// @return The checksum value.
+                    /// @post The iterator is advanced by number of bytes read (len).
+                    template<typename TIter>
+                    std::uint32_t operator()(TIter &iter, std::size_t len) const {
+                        return calc_internal(iter, len, detail::access_tag<TIter>());
+                    }
+
+                private:
+                    static const std::uint32_t Modulo = 65521U;
+                    static const std::size_t MaxBlockLength = 5552U;
+
+                    template<typename TIter>
+                    static std::uint32_t calc_internal(TIter &iter, std::size_t len, detail::wide_access_tag) {
+                        auto *data = detail::as_bytes(iter);
+                        iter += len;
+
+                        std::uint64_t a = 1U;
+                        std::uint64_t b = 0U;
+                        while (0U < len) {
+                            auto blockLen = (len < MaxBlockLength) ? len : MaxBlockLength;
+                            detail::fletcher_byte_sums(data, blockLen, a, b);
+                            data += blockLen;
+                            len -= blockLen;
+                            a %= Modulo;
+                            b %= Modulo;
+                        }
+
+                        return finalize(state_type {static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b)});
+                    }
+
+                    template<typename TIter>
+                    static std::uint32_t calc_internal(TIter &iter, std::size_t len, detail::byte_access_tag) {
+                        std::uint32_t a = 1U;
+                        std::uint32_t b = 0U;
+                        while (0U < len) {
+                            auto blockLen = (len < MaxBlockLength) ? len : MaxBlockLength;
+                            len -= blockLen;
+                            for (; 0U < blockLen; --blockLen) {
+                                a += detail::read_byte(iter);
+                                b += a;
+                            }
+
+                            a %= Modulo;
+                            b %= Modulo;
+                        }
+
+                        return finalize(state_type {a, b});
+                    }
+                };
+
+            }    // namespace checksum
+
+        }    // namespace protocol
+
+    }    // namespace marshalling
+}    // namespace nil
+#endif    // NETWORK_MARSHALLING_ADLER_HPP
@@ -26,7 +26,11 @@
 #ifndef NETWORK_MARSHALLING_BASIC_SUM_HPP
 #define NETWORK_MARSHALLING_BASIC_SUM_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+
+#include <nil/network/marshalling/protocol/checksum/detail/wide_access.hpp>
 
 namespace nil {
     namespace marshalling {
@@ -37,12 +41,31 @@ namespace nil {
 
                 /// @brief Summary of all bytes checksum calculator.
                 /// @details The checksum calculator class that sums all the bytes and
-                ///     returns the result as a checksum value.
+                ///     returns the result as a checksum value. The sequences referenced by
+                ///     pointers are summed using SIMD (SSE2) or wide-word operations.
                 /// @tparam TResult Type of the checksum result value.
                 /// @headerfile nil/network/marshalling/protocol/checksum/BasicSum.h
                 template<typename TResult = std::uint8_t>
                 class basic_sum {
                 public:
+                    /// @brief Type of the intermediate state of incremental calculation.
+                    using state_type = TResult;
+
+                    /// @brief Initial state of incremental calculation.
+                    static constexpr state_type init() {
+                        return state_type(0);
+                    }
+
+                    /// @brief Update state of incremental calculation with a single byte.
+                    static constexpr state_type update(state_type state, std::uint8_t byte) {
+                        return static_cast<state_type>(state + static_cast<TResult>(byte));
+                    }
+
+                    /// @brief Retrieve the checksum value out of the state of incremental calculation.
+                    static constexpr TResult finalize(state_type state) {
+                        return state;
+                    }
+
                     /// @brief Operator that is invoked to calculate the checksum value
                     /// @param[in, out] iter Input iterator,
                     /// @param[in] len Number of bytes to summarise.
@@ -50,6 +73,12 @@ namespace nil {
                     /// @post The iterator is advanced by number of bytes read (len).
                     template<typename TIter>
                     TResult operator()(TIter &iter, std::size_t len) const {
+                        return calc_internal(iter, len, detail::access_tag<TIter>());
+                    }
+
+                private:
+                    template<typename TIter>
+                    static TResult calc_internal(TIter &iter, std::size_t len, detail::byte_access_tag) {
                         using byte_type = typename std::make_unsigned<typename std::decay<decltype(*iter)>::type>::type;
 
                         auto checksum = TResult(0);
@@ -59,6 +88,15 @@ namespace nil {
                         }
                         return checksum;
                     }
+
+                    template<typename TIter>
+                    static TResult calc_internal(TIter &iter, std::size_t len, detail::wide_access_tag) {
+                        // The sum is accumulated in 64 bits, truncation provides the
+                        // same wraparound as summing in TResult.
+                        auto sum = detail::byte_sum(detail::as_bytes(iter), len);
+                        iter += len;
+                        return static_cast<TResult>(sum);
+                    }
                 };
 
             }    // namespace checksum
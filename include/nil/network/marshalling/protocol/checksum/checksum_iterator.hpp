@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_CHECKSUM_ITERATOR_HPP
+#define NETWORK_MARSHALLING_CHECKSUM_ITERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace nil {
+    namespace marshalling {
+
+        namespace protocol {
+
+            namespace checksum {
+
+                /// @brief State of the checksum calculated incrementally while the data
+                ///     is consumed through @ref checksum_iterator.
+                /// @details Keeps the "frontier" - position up to which the bytes have
+                ///     already been accounted. The bytes are accounted once regardless
+                ///     of how many iterator copies pass over them.
+                /// @tparam TIter Type of the underlying random access iterator.
+                /// @tparam TCalc Checksum calculator, must provide incremental calculation
+                ///     interface: @b state_type type, static @b init(), @b update() and
+                ///     @b finalize() member functions (see @ref basic_sum or @ref crc).
+                /// @headerfile nil/network/marshalling/protocol/checksum/checksum_iterator.h
+                template<typename TIter, typename TCalc>
+                class checksum_accumulator {
+                    using byte_type = typename std::make_unsigned<
+                        typename std::decay<typename std::iterator_traits<TIter>::value_type>::type>::type;
+
+                public:
+                    /// @brief Type of the checksum calculation state.
+                    using state_type = typename TCalc::state_type;
+
+                    /// @brief Type of the checksum value.
+                    using result_type = decltype(TCalc::finalize(TCalc::init()));
+
+                    /// @brief Constructor
+                    /// @param[in] from Position of the first byte to be accounted.
+                    explicit checksum_accumulator(TIter from) : from_(from), frontier_(from), state_(TCalc::init()) {
+                    }
+
+                    /// @brief Account all the bytes until the provided position.
+                    /// @details The consumed span is passed to the calculator at once when it
+                    ///     provides @b update(state, iter, len) overload, otherwise the bytes
+                    ///     are accounted one by one on the local copy of the state.
+                    void advance_to(TIter to) {
+                        if (!(frontier_ < to)) {
+                            return;
+                        }
+
+                        state_ = update_span(state_, frontier_, static_cast<std::size_t>(std::distance(frontier_, to)),
+                                             has_span_update_tag<TCalc>());
+                    }
+
+                    /// @brief Get checksum of the bytes in range [from, to).
+                    /// @details When the bytes beyond @b to have been accounted (some
+                    ///     iterator copy was advanced further and discarded), the checksum
+                    ///     is recalculated from the beginning using the calculator directly.
+                    result_type value(TIter to) {
+                        if (to < frontier_) {
+                            auto iter = from_;
+                            return static_cast<result_type>(
+                                TCalc()(iter, static_cast<std::size_t>(std::distance(from_, to))));
+                        }
+
+                        advance_to(to);
+                        return TCalc::finalize(state_);
+                    }
+
+                private:
+                    template<typename TCalc2, typename = void>
+                    struct has_span_update_tag : public std::false_type { };
+
+                    template<typename TCalc2>
+                    struct has_span_update_tag<
+                        TCalc2,
+                        decltype(static_cast<void>(
+                            TCalc2::update(std::declval<state_type>(), std::declval<TIter &>(), std::size_t())))>
+                        : public std::true_type { };
+
+                    static state_type update_span(state_type state, TIter &iter, std::size_t len, std::true_type) {
+                        return TCalc::update(state, iter, len);
+                    }
+
+                    static state_type update_span(state_type state, TIter &iter, std::size_t len, std::false_type) {
+                        for (std::size_t idx = 0U; idx < len; ++idx) {
+                            state = TCalc::update(state, static_cast<std::uint8_t>(static_cast<byte_type>(*iter)));
+                            ++iter;
+                        }
+
+                        return state;
+                    }
+
+                    TIter from_;
+                    TIter frontier_;
+                    state_type state_;
+                };
+
+                /// @brief Random access iterator adapter updating incremental checksum
+                ///     while the data is being read.
+                /// @details Every forward movement (increment and addition assignment)
+                ///     accounts the bytes that have been passed over in the referenced
+                ///     @ref checksum_accumulator, i.e. the checksum is calculated while
+                ///     the fields are decoded, and the data is loaded from memory once.
+                /// @tparam TIter Type of the underlying random access iterator.
+                /// @tparam TCalc Checksum calculator.
+                /// @headerfile nil/network/marshalling/protocol/checksum/checksum_iterator.h
+                template<typename TIter, typename TCalc>
+                class checksum_iterator {
+                    using traits_type = std::iterator_traits<TIter>;
+
+                    static_assert(std::is_same<typename traits_type::iterator_category,
+                                               std::random_access_iterator_tag>::value,
+                                  "The underlying iterator is expected to be random access one");
+
+                public:
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = typename traits_type::value_type;
+                    using difference_type = typename traits_type::difference_type;
+                    using pointer = typename traits_type::pointer;
+                    using reference = typename traits_type::reference;
+
+                    /// @brief Type of the checksum accumulator.
+                    using accumulator_type = checksum_accumulator<TIter, TCalc>;
+
+                    /// @brief Constructor
+                    checksum_iterator(TIter iter, accumulator_type &accumulator) :
+                        iter_(iter), accumulator_(&accumulator) {
+                    }
+
+                    /// @brief Get the underlying iterator.
+                    TIter base() const {
+                        return iter_;
+                    }
+
+                    reference operator*() const {
+                        return *iter_;
+                    }
+
+                    reference operator[](difference_type diff) const {
+                        return iter_[diff];
+                    }
+
+                    checksum_iterator &operator++() {
+                        ++iter_;
+                        accumulator_->advance_to(iter_);
+                        return *this;
+                    }
+
+                    checksum_iterator operator++(int) {
+                        checksum_iterator copy(*this);
+                        ++(*this);
+                        return copy;
+                    }
+
+                    checksum_iterator &operator--() {
+                        --iter_;
+                        return *this;
+                    }
+
+                    checksum_iterator operator--(int) {
+                        checksum_iterator copy(*this);
+                        --iter_;
+                        return copy;
+                    }
+
+                    checksum_iterator &operator+=(difference_type diff) {
+                        iter_ += diff;
+                        accumulator_->advance_to(iter_);
+                        return *this;
+                    }
+
+                    checksum_iterator &operator-=(difference_type diff) {
+                        iter_ -= diff;
+                        return *this;
+                    }
+
+                    checksum_iterator operator+(difference_type diff) const {
+                        return checksum_iterator(iter_ + diff, *accumulator_);
+                    }
+
+                    checksum_iterator operator-(difference_type diff) const {
+                        return checksum_iterator(iter_ - diff, *accumulator_);
+                    }
+
+                    difference_type operator-(const checksum_iterator &other) const {
+                        return iter_ - other.iter_;
+                    }
+
+                    bool operator==(const checksum_iterator &other) const {
+                        return iter_ == other.iter_;
+                    }
+
+                    bool operator!=(const checksum_iterator &other) const {
+                        return iter_ != other.iter_;
+                    }
+
+                    bool operator<(const checksum_iterator &other) const {
+                        return iter_ < other.iter_;
+                    }
+
+                    bool operator>(const checksum_iterator &other) const {
+                        return iter_ > other.iter_;
+                    }
+
+                    bool operator<=(const checksum_iterator &other) const {
+                        return iter_ <= other.iter_;
+                    }
+
+                    bool operator>=(const checksum_iterator &other) const {
+                        return iter_ >= other.iter_;
+                    }
+
+                private:
+                    TIter iter_;
+                    accumulator_type *accumulator_;
+                };
+
+                template<typename TIter, typename TCalc>
+                checksum_iterator<TIter, TCalc>
+                    operator+(typename checksum_iterator<TIter, TCalc>::difference_type diff,
+                              const checksum_iterator<TIter, TCalc> &iter) {
+                    return iter + diff;
+                }
+
+            }    // namespace checksum
+
+        }    // namespace protocol
+
+    }    // namespace marshalling
+}    // namespace nil
+#endif    // NETWORK_MARSHALLING_CHECKSUM_ITERATOR_HPP
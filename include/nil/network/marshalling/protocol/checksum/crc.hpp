@@ -45,19 +45,15 @@ namespace nil {
                         using table_type = crc_init_table_type<TResult>;
 
                         static const table_type &get() {
-                            static table_type table;
-                            static bool tableFilled = false;
-
-                            if (!tableFilled) {
-                                fill_table(table);
-                                tableFilled = true;
-                            }
-
-                            return table;
+                            // Initialised in one step, thread safe since C++11, the table
+                            // is shared by the threads of parallel_crc.
+                            static const table_type Table = make_table();
+                            return Table;
                         }
 
                     private:
-                        static void fill_table(table_type &table) {
+                        static table_type make_table() {
+                            table_type table;
                             static const std::size_t Width
                                 = sizeof(TResult) * std::numeric_limits<std::uint8_t>::digits;
                             static const auto Msb = static_cast<TResult>(1) << (Width - 1);
@@ -75,6 +71,8 @@ namespace nil {
 
                                 table[idx] = rem;
                             }
+
+                            return table;
                         }
                     };
 
@@ -217,6 +215,52 @@ namespace nil {
                                   "The TResult type is expected to be unsigned integral one");
 
                 public:
+                    /// @brief Type of the intermediate state of incremental calculation.
+                    using state_type = TResult;
+
+                    /// @brief Initial state of incremental calculation.
+                    static constexpr state_type init() {
+                        return TInit;
+                    }
+
+                    /// @brief Update state of incremental calculation with a single byte.
+                    static state_type update(state_type state, std::uint8_t byte) {
+                        static const std::size_t Width = sizeof(TResult) * std::numeric_limits<std::uint8_t>::digits;
+                        auto &initTable = detail::crc_init_table<TResult, TPoly>::get();
+                        auto val = static_cast<std::uint8_t>(reflect(byte) ^ (state >> (Width - 8)));
+                        return static_cast<state_type>(initTable[val] ^ (state << 8));
+                    }
+
+                    /// @brief Retrieve the checksum value out of the state of incremental calculation.
+                    static TResult finalize(state_type state) {
+                        return static_cast<TResult>(reflect_rem(state) ^ TFin);
+                    }
+
+                    /// @brief Update state of incremental calculation with the sequence of bytes.
+                    /// @post The iterator is advanced by number of bytes read (len).
+                    template<typename TIter>
+                    static state_type update(state_type state, TIter &iter, std::size_t len) {
+                        using byte_type = typename std::make_unsigned<typename std::decay<decltype(*iter)>::type>::type;
+
+                        for (std::size_t byte = 0U; byte < len; ++byte) {
+                            state = update(state, static_cast<std::uint8_t>(static_cast<byte_type>(*iter)));
+                            ++iter;
+                        }
+
+                        return state;
+                    }
+
+                    /// @brief Combine states of incremental calculation of two consecutive sequences.
+                    /// @details Allows calculation of the CRC of the parts of the sequence independently.
+                    /// @param[in] first State after the first sequence.
+                    /// @param[in] second State after the second sequence, calculation of which
+                    ///     started with zero state (not @ref init()).
+                    /// @param[in] secondLen Length of the second sequence in bytes.
+                    /// @return State after both sequences.
+                    static state_type combine(state_type first, state_type second, std::uint64_t secondLen) {
+                        return static_cast<state_type>(multiply(first, x_power(secondLen * 8U)) ^ second);
+                    }
+
                     /// @brief Operator that is invoked to calculate the checksum value
                     /// @param[in, out] iter Input iterator,
                     /// @param[in] len Number of bytes to summarise.
@@ -243,6 +287,41 @@ namespace nil {
                     }
 
                 private:
+                    static TResult multiply(TResult first, TResult second) {
+                        static const std::size_t Width = sizeof(TResult) * std::numeric_limits<std::uint8_t>::digits;
+                        static const auto Msb = static_cast<TResult>(static_cast<TResult>(1) << (Width - 1));
+
+                        TResult result = 0U;
+                        for (auto bit = Width; bit > 0U; --bit) {
+                            if ((result & Msb) != 0) {
+                                result = static_cast<TResult>(static_cast<TResult>(result << 1) ^ TPoly);
+                            } else {
+                                result = static_cast<TResult>(result << 1);
+                            }
+
+                            if (((second >> (bit - 1U)) & 0x1) != 0) {
+                                result = static_cast<TResult>(result ^ first);
+                            }
+                        }
+
+                        return result;
+                    }
+
+                    static TResult x_power(std::uint64_t exp) {
+                        TResult result = 1U;
+                        TResult base = 2U;
+                        while (exp != 0U) {
+                            if ((exp & 0x1) != 0U) {
+                                result = multiply(result, base);
+                            }
+
+                            base = multiply(base, base);
+                            exp >>= 1U;
+                        }
+
+                        return result;
+                    }
+
                     struct no_reflect_tag { };
                     struct eval_reflect_tag { };
 
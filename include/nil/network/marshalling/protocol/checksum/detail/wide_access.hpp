@@ -0,0 +1,230 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_CHECKSUM_WIDE_ACCESS_HPP
+#define NETWORK_MARSHALLING_CHECKSUM_WIDE_ACCESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__SSE2__) && defined(__x86_64__)) || defined(_M_X64)
+#include <emmintrin.h>
+#define MARSHALLING_CHECKSUM_HAS_SSE2 1
+#else
+#define MARSHALLING_CHECKSUM_HAS_SSE2 0
+#endif
+
+namespace nil {
+    namespace marshalling {
+        namespace protocol {
+            namespace checksum {
+                namespace detail {
+
+                    template<typename TIter>
+                    struct is_byte_pointer {
+                        using iter_type = typename std::decay<TIter>::type;
+                        static const bool value = std::is_pointer<iter_type>::value
+                                                  && (sizeof(typename std::remove_pointer<iter_type>::type) == 1U);
+                    };
+
+                    struct wide_access_tag { };
+                    struct byte_access_tag { };
+
+                    template<typename TIter>
+                    using access_tag =
+                        typename std::conditional<is_byte_pointer<TIter>::value, wide_access_tag, byte_access_tag>::type;
+
+                    template<typename TIter>
+                    const std::uint8_t *as_bytes(TIter iter) {
+                        return reinterpret_cast<const std::uint8_t *>(iter);
+                    }
+
+                    template<typename TIter>
+                    std::uint8_t read_byte(TIter &iter) {
+                        using byte_type = typename std::make_unsigned<typename std::decay<decltype(*iter)>::type>::type;
+                        auto byte = static_cast<std::uint8_t>(static_cast<byte_type>(*iter));
+                        ++iter;
+                        return byte;
+                    }
+
+                    inline std::uint32_t load_le32(const std::uint8_t *data) {
+                        return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8U)
+                               | (static_cast<std::uint32_t>(data[2]) << 16U)
+                               | (static_cast<std::uint32_t>(data[3]) << 24U);
+                    }
+
+                    inline std::uint64_t load_le64(const std::uint8_t *data) {
+                        return static_cast<std::uint64_t>(load_le32(data))
+                               | (static_cast<std::uint64_t>(load_le32(data + 4)) << 32U);
+                    }
+
+                    /// Sum of all the bytes (modulo 2^64).
+                    inline std::uint64_t byte_sum(const std::uint8_t *data, std::size_t len) {
+                        std::uint64_t sum = 0U;
+                        std::size_t idx = 0U;
+#if MARSHALLING_CHECKSUM_HAS_SSE2
+                        auto zero = _mm_setzero_si128();
+                        auto acc = _mm_setzero_si128();
+                        for (; (idx + 16U) <= len; idx += 16U) {
+                            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + idx));
+                            acc = _mm_add_epi64(acc, _mm_sad_epu8(block, zero));
+                        }
+
+                        sum += static_cast<std::uint64_t>(_mm_cvtsi128_si64(acc));
+                        sum += static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+#else
+                        // Sum pairs of bytes in 16 bit lanes of 64 bit word, the lanes
+                        // can't overflow within 128 words.
+                        static const std::uint64_t LanesMask = 0x00ff00ff00ff00ffULL;
+                        while ((idx + 8U) <= len) {
+                            std::uint64_t lanes = 0U;
+                            for (std::size_t word = 0U; (word < 128U) && ((idx + 8U) <= len); ++word, idx += 8U) {
+                                auto value = load_le64(data + idx);
+                                lanes += (value & LanesMask) + ((value >> 8U) & LanesMask);
+                            }
+
+                            lanes = (lanes & 0x0000ffff0000ffffULL) + ((lanes >> 16U) & 0x0000ffff0000ffffULL);
+                            sum += (lanes & 0xffffffffULL) + (lanes >> 32U);
+                        }
+#endif
+                        for (; idx < len; ++idx) {
+                            sum += data[idx];
+                        }
+
+                        return sum;
+                    }
+
+#if MARSHALLING_CHECKSUM_HAS_SSE2
+                    inline std::uint64_t horizontal_sum64(__m128i value) {
+                        return static_cast<std::uint64_t>(_mm_cvtsi128_si64(value))
+                               + static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(value, value)));
+                    }
+
+                    inline std::uint64_t horizontal_sum32(__m128i value) {
+                        value = _mm_add_epi32(value, _mm_shuffle_epi32(value, 0x4e));
+                        value = _mm_add_epi32(value, _mm_shuffle_epi32(value, 0xb1));
+                        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(value));
+                    }
+#endif
+
+                    /// Applies Fletcher recurrence (sum1 += byte; sum2 += sum1) to all the bytes.
+                    /// Over the chunk of N bytes sum2 gains N * sum1 plus the bytes weighted
+                    /// by their distance from the end of the chunk, and sum1 gains the byte sum.
+                    /// The weighted sums are accumulated in 32 bit lanes, len must not exceed 64 KiB.
+                    inline void fletcher_byte_sums(const std::uint8_t *data, std::size_t len, std::uint64_t &sum1,
+                                                   std::uint64_t &sum2) {
+#if MARSHALLING_CHECKSUM_HAS_SSE2
+                        auto zero = _mm_setzero_si128();
+                        auto weightsLo = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+                        auto weightsHi = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+                        auto sums = zero;
+                        auto prefixes = zero;
+                        auto weighted = zero;
+                        auto chunks = len / 16U;
+                        for (std::size_t chunk = 0U; chunk < chunks; ++chunk, data += 16U) {
+                            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+                            prefixes = _mm_add_epi64(prefixes, sums);
+                            sums = _mm_add_epi64(sums, _mm_sad_epu8(block, zero));
+                            auto low = _mm_madd_epi16(_mm_unpacklo_epi8(block, zero), weightsLo);
+                            auto high = _mm_madd_epi16(_mm_unpackhi_epi8(block, zero), weightsHi);
+                            weighted = _mm_add_epi32(weighted, _mm_add_epi32(low, high));
+                        }
+
+                        sum2 += (16U * chunks * sum1) + (16U * horizontal_sum64(prefixes)) + horizontal_sum32(weighted);
+                        sum1 += horizontal_sum64(sums);
+                        len -= chunks * 16U;
+#else
+                        // The bytes are split into 16 bit lanes, multiplication by the
+                        // lane weights gathers the (weighted) sum in the top lane.
+                        static const std::uint64_t LanesMask = 0x00ff00ff00ff00ffULL;
+                        static const std::uint64_t LanesSum = 0x0001000100010001ULL;
+                        static const std::uint64_t EvenWeights = 0x0008000600040002ULL;
+                        static const std::uint64_t OddWeights = 0x0007000500030001ULL;
+                        for (; 8U <= len; len -= 8U, data += 8U) {
+                            auto value = load_le64(data);
+                            auto even = value & LanesMask;
+                            auto odd = (value >> 8U) & LanesMask;
+                            sum2 += (8U * sum1) + (((even * EvenWeights) + (odd * OddWeights)) >> 48U);
+                            sum1 += ((even + odd) * LanesSum) >> 48U;
+                        }
+#endif
+                        for (; 0U < len; --len, ++data) {
+                            sum1 += *data;
+                            sum2 += sum1;
+                        }
+                    }
+
+                    /// Same as @ref fletcher_byte_sums, but for the 16 bit little endian words,
+                    /// the word is split into the low and high (multiplied by 256) bytes.
+                    /// The weighted sums are accumulated in 32 bit lanes, count must not exceed 1024.
+                    inline void fletcher_word_sums(const std::uint8_t *data, std::size_t count, std::uint64_t &sum1,
+                                                   std::uint64_t &sum2) {
+#if MARSHALLING_CHECKSUM_HAS_SSE2
+                        auto zero = _mm_setzero_si128();
+                        auto lowMask = _mm_set1_epi16(0xff);
+                        auto weights = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+                        auto sums = zero;
+                        auto prefixes = zero;
+                        auto weighted = zero;
+                        auto chunks = count / 8U;
+                        for (std::size_t chunk = 0U; chunk < chunks; ++chunk, data += 16U) {
+                            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+                            auto low = _mm_and_si128(block, lowMask);
+                            auto high = _mm_srli_epi16(block, 8);
+                            prefixes = _mm_add_epi64(prefixes, sums);
+                            sums = _mm_add_epi64(sums, _mm_sad_epu8(low, zero));
+                            sums = _mm_add_epi64(sums, _mm_slli_epi64(_mm_sad_epu8(high, zero), 8));
+                            weighted = _mm_add_epi32(weighted, _mm_madd_epi16(low, weights));
+                            weighted = _mm_add_epi32(weighted, _mm_slli_epi32(_mm_madd_epi16(high, weights), 8));
+                        }
+
+                        sum2 += (8U * chunks * sum1) + (8U * horizontal_sum64(prefixes)) + horizontal_sum32(weighted);
+                        sum1 += horizontal_sum64(sums);
+                        count -= chunks * 8U;
+#else
+                        static const std::uint64_t LanesMask = 0x00ff00ff00ff00ffULL;
+                        static const std::uint64_t LanesSum = 0x0001000100010001ULL;
+                        static const std::uint64_t Weights = 0x0004000300020001ULL;
+                        for (; 4U <= count; count -= 4U, data += 8U) {
+                            auto value = load_le64(data);
+                            auto low = value & LanesMask;
+                            auto high = (value >> 8U) & LanesMask;
+                            sum2 += (4U * sum1) + ((low * Weights) >> 48U) + (((high * Weights) >> 48U) << 8U);
+                            sum1 += ((low * LanesSum) >> 48U) + (((high * LanesSum) >> 48U) << 8U);
+                        }
+#endif
+                        for (; 0U < count; --count, data += 2U) {
+                            sum1 += static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8U);
+                            sum2 += sum1;
+                        }
+                    }
+
+                }    // namespace detail
+            }        // namespace checksum
+        }            // namespace protocol
+    }                // namespace marshalling
+}    // namespace nil
+#endif    // NETWORK_MARSHALLING_CHECKSUM_WIDE_ACCESS_HPP
@@ -0,0 +1,245 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_FLETCHER_HPP
+#define NETWORK_MARSHALLING_FLETCHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <nil/network/marshalling/protocol/checksum/detail/wide_access.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        namespace protocol {
+
+            namespace checksum {
+
+                /// @brief Fletcher-16 checksum calculator.
+                /// @details Sums the bytes modulo 255, the result is
+                ///     (sum2 << 8) | sum1. The modulo reduction is deferred to the
+                ///     end of the blocks which cannot overflow 32 bit accumulators.
+                ///     The pointer ranges are loaded 16 bytes (SSE2) or 64 bit word at a time.
+                /// @headerfile nil/network/marshalling/protocol/checksum/fletcher.h
+                class fletcher16 {
+                public:
+                    /// @brief Type of the intermediate state of incremental calculation.
+                    struct state_type {
+                        std::uint32_t sum1_;
+                        std::uint32_t sum2_;
+                    };
+
+                    /// @brief Initial state of incremental calculation.
+                    static constexpr state_type init() {
+                        return state_type {0U, 0U};
+                    }
+
+                    /// @brief Update state of incremental calculation with a single byte.
+                    static state_type update(state_type state, std::uint8_t byte) {
+                        state.sum1_ = (state.sum1_ + byte) % 255U;
+                        state.sum2_ = (state.sum2_ + state.sum1_) % 255U;
+                        return state;
+                    }
+
+                    /// @brief Retrieve the checksum value out of the state of incremental calculation.
+                    static constexpr std::uint16_t finalize(state_type state) {
+                        return static_cast<std::uint16_t>((state.sum2_ << 8U) | state.sum1_);
+                    }
+
+                    /// @brief Operator that is invoked to calculate the checksum value
+                    /// @param[in, out] iter Input iterator,
+                    /// @param[in] len Number of bytes to summarise.
+                    /// @return The checksum value.
+                    /// @post The iterator is advanced by number of bytes read (len).
+                    template<typename TIter>
+                    std::uint16_t operator()(TIter &iter, std::size_t len) const {
+                        return calc_internal(iter, len, detail::access_tag<TIter>());
+                    }
+
+                private:
+                    static const std::size_t MaxBlockLength = 5802U;
+
+                    template<typename TIter>
+                    static std::uint16_t calc_internal(TIter &iter, std::size_t len, detail::wide_access_tag) {
+                        auto *data = detail::as_bytes(iter);
+                        iter += len;
+
+                        std::uint64_t sum1 = 0U;
+                        std::uint64_t sum2 = 0U;
+                        while (0U < len) {
+                            auto blockLen = (len < MaxBlockLength) ? len : MaxBlockLength;
+                            detail::fletcher_byte_sums(data, blockLen, sum1, sum2);
+                            data += blockLen;
+                            len -= blockLen;
+                            sum1 %= 255U;
+                            sum2 %= 255U;
+                        }
+
+                        return finalize(
+                            state_type {static_cast<std::uint32_t>(sum1), static_cast<std::uint32_t>(sum2)});
+                    }
+
+                    template<typename TIter>
+                    static std::uint16_t calc_internal(TIter &iter, std::size_t len, detail::byte_access_tag) {
+                        std::uint32_t sum1 = 0U;
+                        std::uint32_t sum2 = 0U;
+                        while (0U < len) {
+                            auto blockLen = (len < MaxBlockLength) ? len : MaxBlockLength;
+                            len -= blockLen;
+                            for (; 0U < blockLen; --blockLen) {
+                                sum1 += detail::read_byte(iter);
+                                sum2 += sum1;
+                            }
+
+                            sum1 %= 255U;
+                            sum2 %= 255U;
+                        }
+
+                        return finalize(state_type {sum1, sum2});
+                    }
+                };
+
+                /// @brief Fletcher-32 checksum calculator.
+                /// @details Sums the 16 bit little endian words modulo 65535, the result is
+                ///     (sum2 << 16) | sum1. Odd trailing byte is zero padded. The modulo
+                ///     reduction is deferred to the end of the blocks which cannot overflow
+                ///     32 bit accumulators. The pointer ranges are loaded 16 bytes (SSE2)
+                ///     or 64 bit word at a time.
+                /// @headerfile nil/network/marshalling/protocol/checksum/fletcher.h
+                class fletcher32 {
+                public:
+                    /// @brief Type of the intermediate state of incremental calculation.
+                    struct state_type {
+                        std::uint32_t sum1_;
+                        std::uint32_t sum2_;
+                        std::uint32_t pending_;    ///< Low byte of the incomplete word + 0x100 if present.
+                    };
+
+                    /// @brief Initial state of incremental calculation.
+                    static constexpr state_type init() {
+                        return state_type {0U, 0U, 0U};
+                    }
+
+                    /// @brief Update state of incremental calculation with a single byte.
+                    static state_type update(state_type state, std::uint8_t byte) {
+                        if (state.pending_ == 0U) {
+                            state.pending_ = 0x100U | byte;
+                            return state;
+                        }
+
+                        return add_word(state, (state.pending_ & 0xffU) | (static_cast<std::uint32_t>(byte) << 8U));
+                    }
+
+                    /// @brief Retrieve the checksum value out of the state of incremental calculation.
+                    static std::uint32_t finalize(state_type state) {
+                        if (state.pending_ != 0U) {
+                            state = add_word(state, state.pending_ & 0xffU);
+                        }
+
+                        return (state.sum2_ << 16U) | state.sum1_;
+                    }
+
+                    /// @brief Operator that is invoked to calculate the checksum value
+                    /// @param[in, out] iter Input iterator,
+                    /// @param[in] len Number of bytes to summarise.
+                    /// @return The checksum value.
+                    /// @post The iterator is advanced by number of bytes read (len).
+                    template<typename TIter>
+                    std::uint32_t operator()(TIter &iter, std::size_t len) const {
+                        return calc_internal(iter, len, detail::access_tag<TIter>());
+                    }
+
+                private:
+                    static const std::size_t MaxBlockWords = 359U;
+
+                    static state_type add_word(state_type state, std::uint32_t word) {
+                        state.sum1_ = (state.sum1_ + word) % 65535U;
+                        state.sum2_ = (state.sum2_ + state.sum1_) % 65535U;
+                        state.pending_ = 0U;
+                        return state;
+                    }
+
+                    template<typename TIter>
+                    static std::uint32_t calc_internal(TIter &iter, std::size_t len, detail::wide_access_tag) {
+                        auto *data = detail::as_bytes(iter);
+                        iter += len;
+
+                        std::uint64_t sum1 = 0U;
+                        std::uint64_t sum2 = 0U;
+                        auto words = len / 2U;
+                        while (0U < words) {
+                            auto blockWords = (words < MaxBlockWords) ? words : MaxBlockWords;
+                            detail::fletcher_word_sums(data, blockWords, sum1, sum2);
+                            data += blockWords * 2U;
+                            words -= blockWords;
+                            sum1 %= 65535U;
+                            sum2 %= 65535U;
+                        }
+
+                        state_type state {static_cast<std::uint32_t>(sum1), static_cast<std::uint32_t>(sum2), 0U};
+                        if ((len % 2U) != 0U) {
+                            state.pending_ = 0x100U | *data;
+                        }
+
+                        return finalize(state);
+                    }
+
+                    template<typename TIter>
+                    static std::uint32_t calc_internal(TIter &iter, std::size_t len, detail::byte_access_tag) {
+                        std::uint32_t sum1 = 0U;
+                        std::uint32_t sum2 = 0U;
+                        auto words = len / 2U;
+                        while (0U < words) {
+                            auto blockWords = (words < MaxBlockWords) ? words : MaxBlockWords;
+                            words -= blockWords;
+                            for (; 0U < blockWords; --blockWords) {
+                                std::uint32_t word = detail::read_byte(iter);
+                                word |= static_cast<std::uint32_t>(detail::read_byte(iter)) << 8U;
+                                sum1 += word;
+                                sum2 += sum1;
+                            }
+
+                            sum1 %= 65535U;
+                            sum2 %= 65535U;
+                        }
+
+                        state_type state {sum1, sum2, 0U};
+                        if ((len % 2U) != 0U) {
+                            state.pending_ = 0x100U | detail::read_byte(iter);
+                        }
+
+                        return finalize(state);
+                    }
+                };
+
+            }    // namespace checksum
+
+        }    // namespace protocol
+
+    }    // namespace marshalling
+}    // namespace nil
+#endif    // NETWORK_MARSHALLING_FLETCHER_HPP
@@ -0,0 +1,247 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_PARALLEL_CRC_HPP
+#define NETWORK_MARSHALLING_PARALLEL_CRC_HPP
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <nil/network/marshalling/protocol/checksum/crc.hpp>
+
+namespace nil {
+    namespace marshalling {
+        namespace protocol {
+            namespace checksum {
+                namespace detail {
+
+                    class checksum_worker_pool {
+                    public:
+                        explicit checksum_worker_pool(std::size_t threads) {
+                            workers_.reserve(threads);
+                            for (std::size_t idx = 0U; idx < threads; ++idx) {
+                                workers_.emplace_back([this]() { run(); });
+                            }
+                        }
+
+                        checksum_worker_pool(const checksum_worker_pool &) = delete;
+                        checksum_worker_pool &operator=(const checksum_worker_pool &) = delete;
+
+                        ~checksum_worker_pool() noexcept {
+                            {
+                                std::lock_guard<std::mutex> guard(lock_);
+                                stopped_ = true;
+                            }
+
+                            cond_.notify_all();
+                            for (auto &w : workers_) {
+                                w.join();
+                            }
+                        }
+
+                        void post(std::function<void()> &&task) {
+                            {
+                                std::lock_guard<std::mutex> guard(lock_);
+                                tasks_.push_back(std::move(task));
+                            }
+
+                            cond_.notify_one();
+                        }
+
+                    private:
+                        void run() {
+                            while (true) {
+                                std::function<void()> task;
+                                {
+                                    std::unique_lock<std::mutex> guard(lock_);
+                                    cond_.wait(guard, [this]() { return stopped_ || (!tasks_.empty()); });
+                                    if (tasks_.empty()) {
+                                        return;
+                                    }
+
+                                    task = std::move(tasks_.front());
+                                    tasks_.pop_front();
+                                }
+
+                                task();
+                            }
+                        }
+
+                        std::mutex lock_;
+                        std::condition_variable cond_;
+                        std::deque<std::function<void()>> tasks_;
+                        std::vector<std::thread> workers_;
+                        bool stopped_ = false;
+                    };
+
+                    class checksum_completion {
+                    public:
+                        explicit checksum_completion(std::size_t count) : remaining_(count) {
+                        }
+
+                        void done() {
+                            std::lock_guard<std::mutex> guard(lock_);
+                            --remaining_;
+                            if (remaining_ == 0U) {
+                                cond_.notify_one();
+                            }
+                        }
+
+                        void wait() {
+                            std::unique_lock<std::mutex> guard(lock_);
+                            cond_.wait(guard, [this]() { return remaining_ == 0U; });
+                        }
+
+                    private:
+                        std::mutex lock_;
+                        std::condition_variable cond_;
+                        std::size_t remaining_;
+                    };
+
+                }    // namespace detail
+
+                /// @brief CRC calculator splitting long sequences into chunks processed in parallel.
+                /// @details The sequences shorter than @b TMinLength are calculated serially
+                ///     in the calling thread. Longer ones are split into up to @b TThreads
+                ///     chunks, the CRC states of which are calculated by the calling thread and
+                ///     the shared pool of (@b TThreads - 1) worker threads, and then merged
+                ///     using CRC combine (see @ref crc::combine()). The result is identical
+                ///     to the one of @b TCrc. Can be used as @b TCalc parameter of
+                ///     @ref nil::marshalling::protocol::checksum_layer.
+                /// @tparam TCrc Serial CRC calculator, instantiation of @ref crc.
+                /// @tparam TThreads Maximal number of the threads sharing single calculation.
+                /// @tparam TMinLength Minimal length of the sequence to be processed in parallel.
+                /// @headerfile nil/network/marshalling/protocol/checksum/parallel_crc.h
+                template<typename TCrc, std::size_t TThreads = 4U, std::size_t TMinLength = 256U * 1024U>
+                class parallel_crc {
+                    static_assert(0U < TThreads, "At least one thread is expected");
+
+                public:
+                    /// @brief Type of the intermediate state of incremental calculation.
+                    using state_type = typename TCrc::state_type;
+
+                    /// @brief Type of the checksum value.
+                    using result_type = decltype(TCrc::finalize(TCrc::init()));
+
+                    /// @brief Minimal length of the single chunk.
+                    static const std::size_t min_chunk_length = 16U * 1024U;
+
+                    /// @brief Initial state of incremental calculation.
+                    static constexpr state_type init() {
+                        return TCrc::init();
+                    }
+
+                    /// @brief Update state of incremental calculation with a single byte.
+                    static state_type update(state_type state, std::uint8_t byte) {
+                        return TCrc::update(state, byte);
+                    }
+
+                    /// @brief Retrieve the checksum value out of the state of incremental calculation.
+                    static result_type finalize(state_type state) {
+                        return TCrc::finalize(state);
+                    }
+
+                    /// @brief Operator that is invoked to calculate the checksum value
+                    /// @param[in, out] iter Input iterator,
+                    /// @param[in] len Number of bytes to summarise.
+                    /// @return The checksum value.
+                    /// @post The iterator is advanced by number of bytes read (len).
+                    template<typename TIter>
+                    result_type operator()(TIter &iter, std::size_t len) const {
+                        using IterType = typename std::decay<decltype(iter)>::type;
+                        using tag = typename std::conditional<
+                            std::is_same<typename std::iterator_traits<IterType>::iterator_category,
+                                         std::random_access_iterator_tag>::value,
+                            random_access_tag, serial_tag>::type;
+
+                        return calc_internal(iter, len, tag());
+                    }
+
+                private:
+                    struct random_access_tag { };
+                    struct serial_tag { };
+
+                    static detail::checksum_worker_pool &pool() {
+                        static detail::checksum_worker_pool Pool(TThreads - 1U);
+                        return Pool;
+                    }
+
+                    template<typename TIter>
+                    static result_type calc_internal(TIter &iter, std::size_t len, serial_tag) {
+                        return static_cast<result_type>(TCrc()(iter, len));
+                    }
+
+                    template<typename TIter>
+                    static result_type calc_internal(TIter &iter, std::size_t len, random_access_tag) {
+                        auto chunksCount = std::min(TThreads, len / min_chunk_length);
+                        if ((len < TMinLength) || (chunksCount < 2U)) {
+                            return calc_internal(iter, len, serial_tag());
+                        }
+
+                        auto chunkLen = len / chunksCount;
+                        std::array<state_type, TThreads> states;
+                        std::array<std::size_t, TThreads> lengths;
+                        detail::checksum_completion completion(chunksCount - 1U);
+                        for (std::size_t idx = 1U; idx < chunksCount; ++idx) {
+                            auto offset = idx * chunkLen;
+                            lengths[idx] = (idx == (chunksCount - 1U)) ? (len - offset) : chunkLen;
+                            auto chunkIter = iter + static_cast<typename std::iterator_traits<TIter>::difference_type>(offset);
+                            auto *state = &states[idx];
+                            auto chunkLength = lengths[idx];
+                            pool().post([chunkIter, chunkLength, state, &completion]() mutable {
+                                *state = TCrc::update(state_type(0U), chunkIter, chunkLength);
+                                completion.done();
+                            });
+                        }
+
+                        auto firstIter = iter;
+                        states[0] = TCrc::update(TCrc::init(), firstIter, chunkLen);
+                        completion.wait();
+
+                        auto state = states[0];
+                        for (std::size_t idx = 1U; idx < chunksCount; ++idx) {
+                            state = TCrc::combine(state, states[idx], lengths[idx]);
+                        }
+
+                        std::advance(iter, len);
+                        return TCrc::finalize(state);
+                    }
+                };
+
+            }    // namespace checksum
+        }    // namespace protocol
+    }    // namespace marshalling
+}    // namespace nil
+#endif    // NETWORK_MARSHALLING_PARALLEL_CRC_HPP
@@ -0,0 +1,256 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef NETWORK_MARSHALLING_XXHASH_HPP
+#define NETWORK_MARSHALLING_XXHASH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <nil/network/marshalling/protocol/checksum/detail/wide_access.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        namespace protocol {
+
+            namespace checksum {
+
+                namespace detail {
+
+                    template<typename T>
+                    constexpr T rotl(T value, unsigned bits) {
+                        return static_cast<T>((value << bits) | (value >> ((sizeof(T) * 8U) - bits)));
+                    }
+
+                    struct xxhash32_traits {
+                        using value_type = std::uint32_t;
+
+                        static const std::size_t stripe_length = 16U;
+                        static const value_type prime1 = 2654435761U;
+                        static const value_type prime2 = 2246822519U;
+                        static const value_type prime3 = 3266489917U;
+                        static const value_type prime4 = 668265263U;
+                        static const value_type prime5 = 374761393U;
+
+                        static value_type load(const std::uint8_t *data) {
+                            return load_le32(data);
+                        }
+
+                        static value_type round(value_type acc, value_type input) {
+                            return rotl<value_type>(acc + input * prime2, 13U) * prime1;
+                        }
+
+                        static value_type converge(const value_type *acc) {
+                            return rotl(acc[0], 1U) + rotl(acc[1], 7U) + rotl(acc[2], 12U) + rotl(acc[3], 18U);
+                        }
+
+                        static value_type finalize(value_type hash, const std::uint8_t *data, std::size_t len) {
+                            for (; 4U <= len; len -= 4U, data += 4U) {
+                                hash = rotl<value_type>(hash + load_le32(data) * prime3, 17U) * prime4;
+                            }
+
+                            for (; 0U < len; --len, ++data) {
+                                hash = rotl<value_type>(hash + (*data) * prime5, 11U) * prime1;
+                            }
+
+                            hash ^= hash >> 15U;
+                            hash *= prime2;
+                            hash ^= hash >> 13U;
+                            hash *= prime3;
+                            hash ^= hash >> 16U;
+                            return hash;
+                        }
+                    };
+
+                    struct xxhash64_traits {
+                        using value_type = std::uint64_t;
+
+                        static const std::size_t stripe_length = 32U;
+                        static const value_type prime1 = 11400714785074694791ULL;
+                        static const value_type prime2 = 14029467366897019727ULL;
+                        static const value_type prime3 = 1609587929392839161ULL;
+                        static const value_type prime4 = 9650029242287828579ULL;
+                        static const value_type prime5 = 2870177450012600261ULL;
+
+                        static value_type load(const std::uint8_t *data) {
+                            return load_le64(data);
+                        }
+
+                        static value_type round(value_type acc, value_type input) {
+                            return rotl<value_type>(acc + input * prime2, 31U) * prime1;
+                        }
+
+                        static value_type merge(value_type hash, value_type acc) {
+                            return ((hash ^ round(0U, acc)) * prime1) + prime4;
+                        }
+
+                        static value_type converge(const value_type *acc) {
+                            value_type hash = rotl(acc[0], 1U) + rotl(acc[1], 7U) + rotl(acc[2], 12U) + rotl(acc[3], 18U);
+                            for (std::size_t idx = 0U; idx < 4U; ++idx) {
+                                hash = merge(hash, acc[idx]);
+                            }
+                            return hash;
+                        }
+
+                        static value_type finalize(value_type hash, const std::uint8_t *data, std::size_t len) {
+                            for (; 8U <= len; len -= 8U, data += 8U) {
+                                hash = (rotl<value_type>(hash ^ round(0U, load_le64(data)), 27U) * prime1) + prime4;
+                            }
+
+                            if (4U <= len) {
+                                hash = (rotl<value_type>(hash ^ (load_le32(data) * prime1), 23U) * prime2) + prime3;
+                                len -= 4U;
+                                data += 4U;
+                            }
+
+                            for (; 0U < len; --len, ++data) {
+                                hash = rotl<value_type>(hash ^ ((*data) * prime5), 11U) * prime1;
+                            }
+
+                            hash ^= hash >> 33U;
+                            hash *= prime2;
+                            hash ^= hash >> 29U;
+                            hash *= prime3;
+                            hash ^= hash >> 32U;
+                            return hash;
+                        }
+                    };
+
+                    template<typename TTraits, typename TTraits::value_type TSeed>
+                    class xxhash_base {
+                        using value_type = typename TTraits::value_type;
+                        static const std::size_t stripe_length = TTraits::stripe_length;
+                        static const std::size_t lane_length = sizeof(value_type);
+
+                    public:
+                        struct state_type {
+                            std::array<value_type, 4> acc_;
+                            std::array<std::uint8_t, stripe_length> buf_;
+                            std::uint64_t total_;
+                        };
+
+                        static state_type init() {
+                            state_type state;
+                            init_acc(&state.acc_[0]);
+                            state.total_ = 0U;
+                            return state;
+                        }
+
+                        static state_type update(state_type state, std::uint8_t byte) {
+                            auto bufLen = static_cast<std::size_t>(state.total_ % stripe_length);
+                            state.buf_[bufLen] = byte;
+                            ++state.total_;
+                            if ((bufLen + 1U) == stripe_length) {
+                                process_stripe(&state.acc_[0], &state.buf_[0]);
+                            }
+                            return state;
+                        }
+
+                        static value_type finalize(const state_type &state) {
+                            value_type hash = (state.total_ < stripe_length) ? (TSeed + TTraits::prime5) :
+                                                                               TTraits::converge(&state.acc_[0]);
+                            hash += static_cast<value_type>(state.total_);
+                            return TTraits::finalize(hash, &state.buf_[0],
+                                                     static_cast<std::size_t>(state.total_ % stripe_length));
+                        }
+
+                        template<typename TIter>
+                        value_type operator()(TIter &iter, std::size_t len) const {
+                            return calc_internal(iter, len, access_tag<TIter>());
+                        }
+
+                    private:
+                        static void init_acc(value_type *acc) {
+                            acc[0] = TSeed + TTraits::prime1 + TTraits::prime2;
+                            acc[1] = TSeed + TTraits::prime2;
+                            acc[2] = TSeed;
+                            acc[3] = TSeed - TTraits::prime1;
+                        }
+
+                        static void process_stripe(value_type *acc, const std::uint8_t *data) {
+                            acc[0] = TTraits::round(acc[0], TTraits::load(data));
+                            acc[1] = TTraits::round(acc[1], TTraits::load(data + lane_length));
+                            acc[2] = TTraits::round(acc[2], TTraits::load(data + 2U * lane_length));
+                            acc[3] = TTraits::round(acc[3], TTraits::load(data + 3U * lane_length));
+                        }
+
+                        template<typename TIter>
+                        static value_type calc_internal(TIter &iter, std::size_t len, wide_access_tag) {
+                            auto *data = as_bytes(iter);
+                            iter += len;
+
+                            value_type hash = TSeed + TTraits::prime5;
+                            auto remLen = len;
+                            if (stripe_length <= len) {
+                                value_type acc[4];
+                                init_acc(&acc[0]);
+                                for (; stripe_length <= remLen; remLen -= stripe_length, data += stripe_length) {
+                                    process_stripe(&acc[0], data);
+                                }
+                                hash = TTraits::converge(&acc[0]);
+                            }
+
+                            hash += static_cast<value_type>(len);
+                            return TTraits::finalize(hash, data, remLen);
+                        }
+
+                        template<typename TIter>
+                        static value_type calc_internal(TIter &iter, std::size_t len, byte_access_tag) {
+                            auto state = init();
+                            for (; 0U < len; --len) {
+                                state = update(state, read_byte(iter));
+                            }
+                            return finalize(state);
+                        }
+                    };
+
+                }    // namespace detail
+
+                /// @brief xxHash32 non-cryptographic hash calculator.
+                /// @details The pointer ranges are processed in 16 byte stripes of four
+                ///     independent 32 bit lanes.
+                /// @tparam TSeed Seed value.
+                /// @headerfile nil/network/marshalling/protocol/checksum/xxhash.h
+                template<std::uint32_t TSeed = 0U>
+                class xxhash32 : public detail::xxhash_base<detail::xxhash32_traits, TSeed> { };
+
+                /// @brief xxHash64 non-cryptographic hash calculator.
+                /// @details The pointer ranges are processed in 32 byte stripes of four
+                ///     independent 64 bit lanes.
+                /// @tparam TSeed Seed value.
+                /// @headerfile nil/network/marshalling/protocol/checksum/xxhash.h
+                template<std::uint64_t TSeed = 0U>
+                class xxhash64 : public detail::xxhash_base<detail::xxhash64_traits, TSeed> { };
+
+            }    // namespace checksum
+
+        }    // namespace protocol
+
+    }    // namespace marshalling
+}    // namespace nil
+#endif    // NETWORK_MARSHALLING_XXHASH_HPP
@@ -26,16 +26,56 @@
 #ifndef NETWORK_MARSHALLING_CHECKSUM_LAYER_HPP
 #define NETWORK_MARSHALLING_CHECKSUM_LAYER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <type_traits>
 #include <nil/marshalling/type_traits.hpp>
 
 #include <nil/network/marshalling/protocol/protocol_layer_base.hpp>
+#include <nil/network/marshalling/protocol/checksum/checksum_iterator.hpp>
 #include <nil/network/marshalling/protocol/detail/checksum_layer_options_parser.hpp>
 
 namespace nil {
     namespace marshalling {
         namespace protocol {
+            namespace detail {
+
+                template<typename TValue, bool TSpeculative>
+                class checksum_layer_pending_base {
+                protected:
+                    struct pending_verification {
+                        const std::uint8_t *data_ = nullptr;
+                        std::size_t len_ = 0U;
+                        TValue expected_ = TValue();
+                    };
+
+                    pending_verification &pending() {
+                        return pending_;
+                    }
+
+                    const pending_verification &pending() const {
+                        return pending_;
+                    }
+
+                private:
+                    pending_verification pending_;
+                };
+
+                template<typename TValue>
+                class checksum_layer_pending_base<TValue, false> {
+                protected:
+                    struct pending_verification {
+                        static constexpr const std::uint8_t *data_ = nullptr;
+                    };
+
+                    static pending_verification pending() {
+                        return pending_verification();
+                    }
+                };
+
+            }    // namespace detail
+
             /// @brief Protocol layer that is responsible to calculate checksum on the
             ///     data written by all the wrapped internal layers and append it to the end of
             ///     the written data. When reading, this layer is responsible to verify
@@ -59,14 +99,35 @@ namespace nil {
             ///         checksum value. Usage of nil::marshalling::option::checksum_layer_verify_before_read
             ///         modifies the default behaviour by forcing the checksum verification
             ///         prior to invocation of @b read operation in the wrapped layer(s).
+            ///     @li nil::marshalling::option::checksum_layer_fused_read - Forces the
+            ///         @b checksum_layer to pass nil::marshalling::protocol::checksum::checksum_iterator
+            ///         to the wrapped layers, so the checksum is calculated incrementally
+            ///         while the fields are decoded, and the read data is traversed only once.
+            ///         The payload decoded through the polymorphic read of the message
+            ///         interface is still checksummed in a second pass.
+            ///         Requires @b TCalc to support incremental calculation (@b state_type,
+            ///         @b init(), @b update() and @b finalize()).
+            ///     @li nil::marshalling::option::checksum_layer_speculative_read - Forces the
+            ///         @b checksum_layer to only record the read checksum value, the verification
+            ///         must be completed using @ref verify_pending() after the read
+            ///         message is (speculatively) dispatched, see nil::marshalling::speculative_dispatch().
+            ///         The read iterator must be a pointer to byte. Without this option the
+            ///         layer doesn't store any pending verification state.
             /// @headerfile nil/network/marshalling/protocol/checksum_layer.h
             template<typename TField, typename TCalc, typename TNextLayer, typename... TOptions>
             class checksum_layer
                 : public protocol_layer_base<TField, TNextLayer, checksum_layer<TField, TCalc, TNextLayer, TOptions...>,
-                                             nil::marshalling::option::protocol_layer_disallow_read_until_data_split> {
+                                             nil::marshalling::option::protocol_layer_disallow_read_until_data_split>,
+                  private detail::checksum_layer_pending_base<
+                      typename TField::value_type,
+                      detail::checksum_layer_options_parser<TOptions...>::has_speculative_read> {
                 using base_impl_type
                     = protocol_layer_base<TField, TNextLayer, checksum_layer<TField, TCalc, TNextLayer, TOptions...>,
                                           nil::marshalling::option::protocol_layer_disallow_read_until_data_split>;
+                using pending_base_type
+                    = detail::checksum_layer_pending_base<typename TField::value_type,
+                                                          detail::checksum_layer_options_parser<
+                                                              TOptions...>::has_speculative_read>;
 
             public:
                 /// @brief Parsed options
@@ -75,6 +136,11 @@ namespace nil {
                 /// @brief Type of the field object used to read/write checksum value.
                 using field_type = typename base_impl_type::field_type;
 
+                /// @brief Name of the layer reported by the tracing.
+                static constexpr const char *trace_name() {
+                    return "checksum_layer";
+                }
+
                 /// @brief Default constructor.
                 checksum_layer() = default;
 
@@ -139,6 +205,34 @@ namespace nil {
                                          std::forward<TNextLayerReader>(nextLayerReader), verify_tag());
                 }
 
+                /// @brief Check whether the checksum verification of the last read is pending.
+                /// @details Relevant only when nil::marshalling::option::checksum_layer_speculative_read
+                ///     option is used.
+                bool is_verification_pending() const {
+                    return pending_base_type::pending().data_ != nullptr;
+                }
+
+                /// @brief Complete the deferred checksum verification of the last read.
+                /// @details Relevant only when nil::marshalling::option::checksum_layer_speculative_read
+                ///     option is used. The input buffer of the last read must still be valid.
+                ///     Every read discards the verification pending from the previous one,
+                ///     so this function must be invoked before the next read.
+                /// @return true if there was no pending verification or the checksum matches.
+                bool verify_pending() {
+                    static_assert(parsed_options_type::has_speculative_read,
+                                  "checksum_layer_speculative_read option hasn't been used");
+
+                    auto &pending = pending_base_type::pending();
+                    if (pending.data_ == nullptr) {
+                        return true;
+                    }
+
+                    auto *iter = pending.data_;
+                    auto checksum = TCalc()(iter, pending.len_);
+                    pending.data_ = nullptr;
+                    return pending.expected_ == static_cast<typename field_type::value_type>(checksum);
+                }
+
                 /// @brief Customized write functionality, invoked by @ref write().
                 /// @details First, executes the write() member function of the next layer.
                 ///     If the call returns nil::marshalling::ErrorStatus::Success and it is possible
@@ -210,11 +304,24 @@ namespace nil {
                 static_assert(field_type::min_length() == field_type::max_length(),
                               "The checksum field is expected to be of fixed length");
 
+                static_assert((static_cast<unsigned>(parsed_options_type::has_verify_before_read)
+                               + static_cast<unsigned>(parsed_options_type::has_fused_read)
+                               + static_cast<unsigned>(parsed_options_type::has_speculative_read))
+                                  <= 1U,
+                              "Only one of checksum_layer_verify_before_read, checksum_layer_fused_read and "
+                              "checksum_layer_speculative_read options can be used");
+
                 struct verify_before_read_tag { };
                 struct verify_after_read_tag { };
+                struct fused_read_tag { };
+                struct speculative_read_tag { };
 
-                using verify_tag = typename std::conditional<parsed_options_type::has_verify_before_read,
-                                                             verify_before_read_tag, verify_after_read_tag>::type;
+                using verify_tag = typename std::conditional<
+                    parsed_options_type::has_verify_before_read, verify_before_read_tag,
+                    typename std::conditional<
+                        parsed_options_type::has_fused_read, fused_read_tag,
+                        typename std::conditional<parsed_options_type::has_speculative_read, speculative_read_tag,
+                                                  verify_after_read_tag>::type>::type>::type;
 
                 template<typename TMsg, typename TIter, typename TReader>
                 status_type verify_read(field_type &field, TMsg &msg, TIter &iter, std::size_t size,
@@ -278,6 +385,109 @@ namespace nil {
                     return es;
                 }
 
+                template<typename TMsg, typename TIter, typename TReader>
+                status_type fused_read(field_type &field, TMsg &msg, TIter &iter, std::size_t size,
+                                       std::size_t *missingSize, TReader &&nextLayerReader) {
+                    using IterType = typename std::decay<decltype(iter)>::type;
+                    using AccumulatorType = checksum::checksum_accumulator<IterType, TCalc>;
+                    using ChecksumIterType = checksum::checksum_iterator<IterType, TCalc>;
+
+                    auto fromIter = iter;
+                    AccumulatorType accumulator(fromIter);
+                    ChecksumIterType readIter(iter, accumulator);
+
+                    auto es = nextLayerReader.read(msg, readIter, size - field_type::min_length(), missingSize);
+                    iter = readIter.base();
+                    if ((es == status_type::not_enough_data) || (es == status_type::protocol_error)) {
+                        return es;
+                    }
+
+                    auto len = static_cast<std::size_t>(std::distance(fromIter, iter));
+                    MARSHALLING_ASSERT(len <= size);
+                    auto remSize = size - len;
+                    auto checksum = accumulator.value(iter);
+                    auto checksumEs = field.read(iter, remSize);
+                    if (checksumEs == status_type::not_enough_data) {
+                        base_impl_type::update_missing_size(field, remSize, missingSize);
+                    }
+
+                    if (checksumEs != status_type::success) {
+                        base_impl_type::reset_msg(msg);
+                        return checksumEs;
+                    }
+
+                    auto expectedValue = field.value();
+
+                    if (expectedValue != static_cast<decltype(expectedValue)>(checksum)) {
+                        base_impl_type::reset_msg(msg);
+                        return status_type::protocol_error;
+                    }
+
+                    return es;
+                }
+
+                template<typename TMsg, typename TIter, typename TReader>
+                status_type speculative_read(field_type &field, TMsg &msg, TIter &iter, std::size_t size,
+                                             std::size_t *missingSize, TReader &&nextLayerReader) {
+                    using iter_type = typename std::decay<TIter>::type;
+                    using iter_value_type = typename std::iterator_traits<iter_type>::value_type;
+                    static_assert(std::is_pointer<iter_type>::value && (sizeof(iter_value_type) == 1U),
+                                  "The speculative read requires the read iterator to be a pointer to byte");
+
+                    // The verification of the previous read, if still pending, is discarded.
+                    auto &pending = pending_base_type::pending();
+                    pending.data_ = nullptr;
+                    auto fromIter = iter;
+
+                    auto es = nextLayerReader.read(msg, iter, size - field_type::min_length(), missingSize);
+                    if ((es == status_type::not_enough_data) || (es == status_type::protocol_error)) {
+                        return es;
+                    }
+
+                    auto len = static_cast<std::size_t>(std::distance(fromIter, iter));
+                    MARSHALLING_ASSERT(len <= size);
+                    auto remSize = size - len;
+                    auto checksumEs = field.read(iter, remSize);
+                    if (checksumEs == status_type::not_enough_data) {
+                        base_impl_type::update_missing_size(field, remSize, missingSize);
+                    }
+
+                    if (checksumEs != status_type::success) {
+                        base_impl_type::reset_msg(msg);
+                        return checksumEs;
+                    }
+
+                    if (es != status_type::success) {
+                        // Not dispatched, verify right away
+                        auto checksum = TCalc()(fromIter, len);
+                        auto expectedValue = field.value();
+                        if (expectedValue != static_cast<decltype(expectedValue)>(checksum)) {
+                            base_impl_type::reset_msg(msg);
+                            return status_type::protocol_error;
+                        }
+
+                        return es;
+                    }
+
+                    pending.data_ = reinterpret_cast<const std::uint8_t *>(fromIter);
+                    pending.len_ = len;
+                    pending.expected_ = field.value();
+                    return es;
+                }
+
+                template<typename TMsg, typename TIter, typename TReader>
+                status_type read_internal(field_type &field, TMsg &msg, TIter &iter, std::size_t size,
+                                          std::size_t *missingSize, TReader &&nextLayerReader, speculative_read_tag) {
+                    return speculative_read(field, msg, iter, size, missingSize,
+                                            std::forward<TReader>(nextLayerReader));
+                }
+
+                template<typename TMsg, typename TIter, typename TReader>
+                status_type read_internal(field_type &field, TMsg &msg, TIter &iter, std::size_t size,
+                                          std::size_t *missingSize, TReader &&nextLayerReader, fused_read_tag) {
+                    return fused_read(field, msg, iter, size, missingSize, std::forward<TReader>(nextLayerReader));
+                }
+
                 template<typename TMsg, typename TIter, typename TReader>
                 status_type read_internal(field_type &field, TMsg &msg, TIter &iter, std::size_t size,
                                           std::size_t *missingSize, TReader &&nextLayerReader, verify_before_read_tag) {
@@ -80,6 +80,11 @@ namespace nil {
                 /// @brief Type of the field object used to read/write checksum value.
                 using field_type = typename base_impl_type::field_type;
 
+                /// @brief Name of the layer reported by the tracing.
+                static constexpr const char *trace_name() {
+                    return "checksum_prefix_layer";
+                }
+
                 /// @brief Default constructor.
                 checksum_prefix_layer() = default;
 
@@ -42,6 +42,8 @@ namespace nil {
                 class checksum_layer_options_parser<> {
                 public:
                     static const bool has_verify_before_read = false;
+                    static const bool has_fused_read = false;
+                    static const bool has_speculative_read = false;
                 };
 
                 template<typename... TOptions>
@@ -51,6 +53,20 @@ namespace nil {
                     static const bool has_verify_before_read = true;
                 };
 
+                template<typename... TOptions>
+                class checksum_layer_options_parser<nil::marshalling::option::checksum_layer_fused_read, TOptions...>
+                    : public checksum_layer_options_parser<TOptions...> {
+                public:
+                    static const bool has_fused_read = true;
+                };
+
+                template<typename... TOptions>
+                class checksum_layer_options_parser<nil::marshalling::option::checksum_layer_speculative_read,
+                                                    TOptions...> : public checksum_layer_options_parser<TOptions...> {
+                public:
+                    static const bool has_speculative_read = true;
+                };
+
                 template<typename... TOptions>
                 class checksum_layer_options_parser<nil::marshalling::option::empty_option, TOptions...>
                     : public checksum_layer_options_parser<TOptions...> { };
@@ -26,6 +26,17 @@
 #ifndef NETWORK_MARSHALLING_TRANSPORT_VALUE_LAYER_ADAPTER_HPP
 #define NETWORK_MARSHALLING_TRANSPORT_VALUE_LAYER_ADAPTER_HPP
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <nil/marshalling/status_type.hpp>
+
 #include <nil/network/marshalling/protocol/detail/transport_value_layer_options_parser.hpp>
 
 namespace nil {
@@ -72,13 +83,199 @@ namespace nil {
                 using transport_value_layer_pseudo_base_type =
                     typename transport_value_layer_process_pseudo_base<TOpt::has_pseudo_value>::template type<TBase>;
 
+                template<typename...>
+                struct transport_value_layer_void {
+                    using type = void;
+                };
+
+                template<typename TLayer, typename = void>
+                struct is_transport_value_layer : public std::false_type { };
+
+                template<typename TLayer>
+                struct is_transport_value_layer<
+                    TLayer,
+                    typename transport_value_layer_void<typename TLayer::transport_parsed_options_type>::type>
+                    : public std::true_type { };
+
+                /// Run of directly following transport_value_layer layers, starting at TLayer,
+                /// that form a single memoized header. The first other layer is its payload.
+                template<typename TLayer, bool TIsValueLayer = is_transport_value_layer<TLayer>::value>
+                struct transport_value_layer_header {
+                    using next_header_type = transport_value_layer_header<typename TLayer::next_layer_type>;
+                    using fields_type = typename std::decay<decltype(
+                        std::tuple_cat(std::declval<std::tuple<typename TLayer::field_type>>(),
+                                       std::declval<typename next_header_type::fields_type>()))>::type;
+                    using payload_layer_type = typename next_header_type::payload_layer_type;
+
+                    static constexpr bool is_fixed_length() {
+                        return (TLayer::transport_parsed_options_type::has_pseudo_value
+                                || (TLayer::field_type::min_length() == TLayer::field_type::max_length()))
+                               && next_header_type::is_fixed_length();
+                    }
+
+                    static constexpr std::size_t length() {
+                        return TLayer::eval_field_length() + next_header_type::length();
+                    }
+
+                    template<std::size_t TFieldIdx, typename TFields, typename TIter>
+                    static status_type read(TLayer &layer, TFields &fields, TIter &iter, std::size_t &len) {
+                        auto es = layer.read_header_field(std::get<TFieldIdx>(fields), iter, len);
+                        if (es != status_type::success) {
+                            return es;
+                        }
+
+                        return next_header_type::template read<TFieldIdx + 1U>(layer.next_layer(), fields, iter,
+                                                                                len);
+                    }
+
+                    template<std::size_t TFieldIdx, typename TFields, typename TMsg>
+                    static void assign(const TFields &fields, TMsg &msg) {
+                        TLayer::assign_transport_field(std::get<TFieldIdx>(fields), msg);
+                        next_header_type::template assign<TFieldIdx + 1U>(fields, msg);
+                    }
+
+                    static payload_layer_type &payload(TLayer &layer) {
+                        return next_header_type::payload(layer.next_layer());
+                    }
+                };
+
+                template<typename TLayer>
+                struct transport_value_layer_header<TLayer, false> {
+                    using fields_type = std::tuple<>;
+                    using payload_layer_type = TLayer;
+
+                    static constexpr bool is_fixed_length() {
+                        return true;
+                    }
+
+                    static constexpr std::size_t length() {
+                        return 0U;
+                    }
+
+                    template<std::size_t TFieldIdx, typename TFields, typename TIter>
+                    static status_type read(TLayer &, TFields &, TIter &, std::size_t &) {
+                        return status_type::success;
+                    }
+
+                    template<std::size_t TFieldIdx, typename TFields, typename TMsg>
+                    static void assign(const TFields &, TMsg &) {
+                    }
+
+                    static payload_layer_type &payload(TLayer &layer) {
+                        return layer;
+                    }
+                };
+
+                template<typename TBase, bool THasPseudoValue>
+                class transport_value_layer_memo_base : public TBase {
+                    using base_impl_type = TBase;
+                    using field_impl_type = typename base_impl_type::field_type;
+                    using next_header_type = transport_value_layer_header<typename base_impl_type::next_layer_type>;
+
+                    static_assert((THasPseudoValue || (field_impl_type::min_length() == field_impl_type::max_length()))
+                                      && next_header_type::is_fixed_length(),
+                                  "Only fixed length headers can be memoized");
+
+                public:
+                    /// @brief Length of the memoized raw header.
+                    static const std::size_t memo_length =
+                        (THasPseudoValue ? 0U : field_impl_type::max_length()) + next_header_type::length();
+
+                    /// @brief Check whether the memo holds the previously read header.
+                    bool is_memo_valid() const {
+                        return memoValid_;
+                    }
+
+                    /// @brief Drop the memoized header, forcing the next read to decode it.
+                    void reset_memo() {
+                        memoValid_ = false;
+                    }
+
+                protected:
+                    using memo_fields_type = typename std::decay<decltype(
+                        std::tuple_cat(std::declval<std::tuple<field_impl_type>>(),
+                                       std::declval<typename next_header_type::fields_type>()))>::type;
+
+                    using memo_payload_layer_type = typename next_header_type::payload_layer_type;
+
+                    memo_payload_layer_type &memo_payload_layer() {
+                        return next_header_type::payload(base_impl_type::next_layer());
+                    }
+
+                    template<typename TIter>
+                    bool memo_matches(TIter iter) const {
+                        using value_type = typename std::iterator_traits<TIter>::value_type;
+                        using tag = typename std::conditional<std::is_pointer<TIter>::value
+                                                                  && (sizeof(value_type) == sizeof(std::uint8_t)),
+                                                              raw_bytes_tag, generic_bytes_tag>::type;
+                        return memoValid_ && bytes_equal(iter, tag());
+                    }
+
+                    memo_fields_type &memo_fields() {
+                        return memoFields_;
+                    }
+
+                    template<typename TIter>
+                    void update_memo(TIter iter) {
+                        std::transform(iter, iter + memo_length, memoBytes_.begin(),
+                                       [](typename std::iterator_traits<TIter>::value_type byte) -> std::uint8_t {
+                                           return static_cast<std::uint8_t>(byte);
+                                       });
+                        memoValid_ = true;
+                    }
+
+                private:
+                    struct raw_bytes_tag { };
+                    struct generic_bytes_tag { };
+
+                    template<typename TIter>
+                    bool bytes_equal(TIter iter, raw_bytes_tag) const {
+                        // Fixed length comparison, gets inlined into a few wide word compares
+                        return std::memcmp(memoBytes_.data(), iter, memo_length) == 0;
+                    }
+
+                    template<typename TIter>
+                    bool bytes_equal(TIter iter, generic_bytes_tag) const {
+                        return std::equal(memoBytes_.begin(), memoBytes_.end(), iter,
+                                          [](std::uint8_t memoByte,
+                                             typename std::iterator_traits<TIter>::value_type byte) {
+                                              return memoByte == static_cast<std::uint8_t>(byte);
+                                          });
+                    }
+
+                    std::array<std::uint8_t, memo_length> memoBytes_;
+                    memo_fields_type memoFields_;
+                    bool memoValid_ = false;
+                };
+
+                template<bool THasMemoizedHeader>
+                struct transport_value_layer_process_memo_base;
+
+                template<>
+                struct transport_value_layer_process_memo_base<true> {
+                    template<typename TBase, bool THasPseudoValue>
+                    using type = transport_value_layer_memo_base<TBase, THasPseudoValue>;
+                };
+
+                template<>
+                struct transport_value_layer_process_memo_base<false> {
+                    template<typename TBase, bool THasPseudoValue>
+                    using type = TBase;
+                };
+
+                template<typename TBase, typename TOpt>
+                using transport_value_layer_memo_base_type =
+                    typename transport_value_layer_process_memo_base<TOpt::has_memoized_header>::template type<
+                        TBase, TOpt::has_pseudo_value>;
+
                 template<typename TBase, typename... TOptions>
                 class transport_value_layer_adapter {
                     using options_type = transport_value_layer_options_parser<TOptions...>;
                     using pseudo_base_type = transport_value_layer_pseudo_base_type<TBase, options_type>;
+                    using memo_base_type = transport_value_layer_memo_base_type<pseudo_base_type, options_type>;
 
                 public:
-                    using type = pseudo_base_type;
+                    using type = memo_base_type;
                 };
 
                 template<typename TBase, typename... TOptions>
@@ -42,6 +42,7 @@ namespace nil {
                 class transport_value_layer_options_parser<> {
                 public:
                     static const bool has_pseudo_value = false;
+                    static const bool has_memoized_header = false;
                 };
 
                 template<typename... TOptions>
@@ -51,6 +52,13 @@ namespace nil {
                     static const bool has_pseudo_value = true;
                 };
 
+                template<typename... TOptions>
+                class transport_value_layer_options_parser<nil::marshalling::option::memoized_header, TOptions...>
+                    : public transport_value_layer_options_parser<TOptions...> {
+                public:
+                    static const bool has_memoized_header = true;
+                };
+
                 template<typename... TOptions>
                 class transport_value_layer_options_parser<nil::marshalling::option::empty_option, TOptions...>
                     : public transport_value_layer_options_parser<TOptions...> { };
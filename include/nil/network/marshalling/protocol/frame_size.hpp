@@ -0,0 +1,241 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Provides compile time calculation of the frame sizes produced by the protocol stack.
+
+#ifndef NETWORK_MARSHALLING_FRAME_SIZE_HPP
+#define NETWORK_MARSHALLING_FRAME_SIZE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <nil/marshalling/processing/tuple.hpp>
+
+namespace nil {
+    namespace marshalling {
+        namespace protocol {
+
+            namespace detail {
+
+                constexpr std::size_t frame_size_saturating_add(std::size_t first, std::size_t second) {
+                    return ((std::numeric_limits<std::size_t>::max() - first) < second) ?
+                               std::numeric_limits<std::size_t>::max() :
+                               first + second;
+                }
+
+                template<typename TLayer, bool TIsDataLayer = (TLayer::layers_amount == 1U)>
+                struct frame_transport_length_helper;
+
+                template<typename TLayer>
+                struct frame_transport_length_helper<TLayer, true> {
+                    static constexpr std::size_t min_value() {
+                        return 0U;
+                    }
+
+                    static constexpr std::size_t max_value() {
+                        return 0U;
+                    }
+                };
+
+                template<typename TLayer>
+                struct frame_transport_length_helper<TLayer, false> {
+                    using next_helper_type = frame_transport_length_helper<typename TLayer::next_layer_type>;
+
+                    // Layers that do not serialize their field (such as "pseudo"
+                    // transport_value_layer) report zero field length.
+                    static constexpr std::size_t field_max_value() {
+                        return (TLayer::eval_field_length() == 0U) ? 0U : TLayer::field_type::max_length();
+                    }
+
+                    static constexpr std::size_t min_value() {
+                        return TLayer::eval_field_length() + next_helper_type::min_value();
+                    }
+
+                    static constexpr std::size_t max_value() {
+                        return frame_size_saturating_add(field_max_value(), next_helper_type::max_value());
+                    }
+                };
+
+                template<typename TStack>
+                struct frame_min_length_accumulator;
+
+                template<typename TStack>
+                struct frame_max_length_accumulator;
+
+                struct msg_object_size_accumulator {
+                    template<typename TMsg>
+                    constexpr std::size_t operator()(std::size_t value) const {
+                        return (value < sizeof(TMsg)) ? sizeof(TMsg) : value;
+                    }
+                };
+
+                struct msg_object_alignment_accumulator {
+                    template<typename TMsg>
+                    constexpr std::size_t operator()(std::size_t value) const {
+                        return (value < alignof(TMsg)) ? alignof(TMsg) : value;
+                    }
+                };
+
+            }    // namespace detail
+
+            /// @brief Compile time retrieval of the minimal length of all the transport
+            ///     information (all the layers except @ref msg_data_layer) wrapping the message payload.
+            /// @tparam TStack Type of the outermost protocol layer.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TStack>
+            constexpr std::size_t transport_min_length() {
+                return detail::frame_transport_length_helper<TStack>::min_value();
+            }
+
+            /// @brief Compile time retrieval of the maximal length of all the transport
+            ///     information (all the layers except @ref msg_data_layer) wrapping the message payload.
+            /// @details Saturates at std::numeric_limits<std::size_t>::max() in case
+            ///     any of the transport fields doesn't have an upper length limit.
+            /// @tparam TStack Type of the outermost protocol layer.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TStack>
+            constexpr std::size_t transport_max_length() {
+                return detail::frame_transport_length_helper<TStack>::max_value();
+            }
+
+            /// @brief Compile time retrieval of the minimal length of the frame
+            ///     containing provided message type.
+            /// @details Equals to @ref transport_min_length() plus minimal serialization
+            ///     length of the message fields.
+            /// @tparam TStack Type of the outermost protocol layer.
+            /// @tparam TMsg Type of the message, must be defined using
+            ///     nil::marshalling::option::fields_impl (or zero_fields_impl) option.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TStack, typename TMsg>
+            constexpr std::size_t frame_min_length() {
+                return transport_min_length<TStack>() + TMsg::eval_min_length();
+            }
+
+            /// @brief Compile time retrieval of the maximal length of the frame
+            ///     containing provided message type.
+            /// @details Equals to @ref transport_max_length() plus maximal serialization
+            ///     length of the message fields. Saturates at
+            ///     std::numeric_limits<std::size_t>::max() in case the message or
+            ///     transport information doesn't have an upper length limit.
+            /// @tparam TStack Type of the outermost protocol layer.
+            /// @tparam TMsg Type of the message, must be defined using
+            ///     nil::marshalling::option::fields_impl (or zero_fields_impl) option.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TStack, typename TMsg>
+            constexpr std::size_t frame_max_length() {
+                return detail::frame_size_saturating_add(transport_max_length<TStack>(), TMsg::eval_max_length());
+            }
+
+            namespace detail {
+
+                template<typename TStack>
+                struct frame_min_length_accumulator {
+                    template<typename TMsg>
+                    constexpr std::size_t operator()(std::size_t value) const {
+                        return (frame_min_length<TStack, TMsg>() < value) ? frame_min_length<TStack, TMsg>() : value;
+                    }
+                };
+
+                template<typename TStack>
+                struct frame_max_length_accumulator {
+                    template<typename TMsg>
+                    constexpr std::size_t operator()(std::size_t value) const {
+                        return (value < frame_max_length<TStack, TMsg>()) ? frame_max_length<TStack, TMsg>() : value;
+                    }
+                };
+
+            }    // namespace detail
+
+            /// @brief Compile time retrieval of the shortest possible frame among all
+            ///     the provided messages.
+            /// @details Can be used to decide how many bytes must be accumulated before
+            ///     the first read attempt is worth performing.
+            /// @tparam TStack Type of the outermost protocol layer.
+            /// @tparam TAllMessages All the message types bundled into std::tuple, defaults
+            ///     to the types the stack was defined with.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TStack, typename TAllMessages = typename TStack::all_messages_type>
+            constexpr std::size_t min_frame_length() {
+                return nil::marshalling::processing::tuple_type_accumulate<TAllMessages>(
+                    std::numeric_limits<std::size_t>::max(), detail::frame_min_length_accumulator<TStack>());
+            }
+
+            /// @brief Compile time retrieval of the longest possible frame among all
+            ///     the provided messages.
+            /// @details Can be used to define exact size of the static receive
+            ///     and transmit buffers, for example:
+            ///     @code
+            ///     std::array<std::uint8_t, nil::marshalling::protocol::max_frame_length<ProtStack>()> outBuf;
+            ///     @endcode
+            ///     Saturates at std::numeric_limits<std::size_t>::max() in case any
+            ///     of the frames doesn't have an upper length limit.
+            /// @tparam TStack Type of the outermost protocol layer.
+            /// @tparam TAllMessages All the message types bundled into std::tuple, defaults
+            ///     to the types the stack was defined with.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TStack, typename TAllMessages = typename TStack::all_messages_type>
+            constexpr std::size_t max_frame_length() {
+                return nil::marshalling::processing::tuple_type_accumulate<TAllMessages>(
+                    std::size_t(0U), detail::frame_max_length_accumulator<TStack>());
+            }
+
+            /// @brief Compile time check whether all the frames have an upper length limit.
+            /// @tparam TStack Type of the outermost protocol layer.
+            /// @tparam TAllMessages All the message types bundled into std::tuple, defaults
+            ///     to the types the stack was defined with.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TStack, typename TAllMessages = typename TStack::all_messages_type>
+            constexpr bool is_frame_length_bounded() {
+                return max_frame_length<TStack, TAllMessages>() != std::numeric_limits<std::size_t>::max();
+            }
+
+            /// @brief Compile time retrieval of the largest sizeof() among all the message objects.
+            /// @details Can be used to provision slots of the in-place allocators
+            ///     (nil::marshalling::processing::alloc::in_place_single,
+            ///     nil::marshalling::processing::alloc::in_place_pool).
+            /// @tparam TAllMessages All the message types bundled into std::tuple.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TAllMessages>
+            constexpr std::size_t max_msg_object_size() {
+                return nil::marshalling::processing::tuple_type_accumulate<TAllMessages>(
+                    std::size_t(0U), detail::msg_object_size_accumulator());
+            }
+
+            /// @brief Compile time retrieval of the strictest alignment among all the message objects.
+            /// @tparam TAllMessages All the message types bundled into std::tuple.
+            /// @headerfile nil/network/marshalling/protocol/frame_size.h
+            template<typename TAllMessages>
+            constexpr std::size_t max_msg_object_alignment() {
+                return nil::marshalling::processing::tuple_type_accumulate<TAllMessages>(
+                    std::size_t(1U), detail::msg_object_alignment_accumulator());
+            }
+
+        }    // namespace protocol
+    }        // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_FRAME_SIZE_HPP
@@ -41,6 +41,10 @@
 #include <nil/network/marshalling/message.hpp>
 #include <nil/network/marshalling/message_base.hpp>
 #include <nil/network/marshalling/protocol/protocol_layer_base.hpp>
+#include <nil/network/marshalling/protocol/checksum/checksum_iterator.hpp>
+#ifdef MARSHALLING_TRACING
+#include <nil/network/marshalling/trace.hpp>
+#endif
 #include <nil/network/marshalling/type_traits.hpp>
 
 namespace nil {
@@ -81,6 +85,11 @@ namespace nil {
                 /// @brief Static constant indicating amount of transport layers used.
                 static const std::size_t layers_amount = 1;
 
+                /// @brief Name of the layer reported by the tracing.
+                static constexpr const char *trace_name() {
+                    return "msg_data_layer";
+                }
+
                 /// @brief Default constructor
                 msg_data_layer() = default;
 
@@ -131,6 +140,9 @@ namespace nil {
                     using tag = typename std::conditional<has_type_impl_options_type<msg_type>::value,
                                                           direct_op_tag, polymorphic_op_tag>::type;
 
+#ifdef MARSHALLING_TRACING
+                    MARSHALLING_TRACE_SPAN(trace_name());
+#endif
                     return read_internal(msg, iter, size, missingSize, tag());
                 }
 
@@ -270,6 +282,9 @@ namespace nil {
                     using tag = typename std::conditional<detail::protocol_layer_has_fields_impl<msg_type>::value,
                                                           direct_op_tag, polymorphic_op_tag>::type;
 
+#ifdef MARSHALLING_TRACING
+                    MARSHALLING_TRACE_SPAN(trace_name());
+#endif
                     return write_internal(msg, iter, size, tag());
                 }
 
@@ -519,6 +534,19 @@ namespace nil {
                     return result;
                 }
 
+                template<typename TMsgPtr, typename TIter, typename TCalc>
+                static status_type read_internal_polymorphic(TMsgPtr &msgPtr,
+                                                             checksum::checksum_iterator<TIter, TCalc> &iter,
+                                                             std::size_t size, std::size_t *missingSize = nullptr) {
+                    // Polymorphic read requires the message's read_iterator, the payload
+                    // is accounted by the checksum in a second pass right after being read,
+                    // only the direct read is fused.
+                    auto readIter = iter.base();
+                    auto result = read_internal_polymorphic(msgPtr, readIter, size, missingSize);
+                    iter += std::distance(iter.base(), readIter);
+                    return result;
+                }
+
                 template<typename TMsg, typename TIter>
                 static status_type read_internal_direct(TMsg &msg, TIter &iter, std::size_t size,
                                                         std::size_t *missingSize = nullptr) {
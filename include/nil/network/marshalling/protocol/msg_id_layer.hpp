@@ -106,6 +106,11 @@ namespace nil {
                                   || is_no_value<field_type>::value,
                               "field_type must be of integral or enumeration types");
 
+                /// @brief Name of the layer reported by the tracing.
+                static constexpr const char *trace_name() {
+                    return "msg_id_layer";
+                }
+
                 /// @brief Default constructor.
                 explicit msg_id_layer() = default;
 
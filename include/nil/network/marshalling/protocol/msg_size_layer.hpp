@@ -59,6 +59,11 @@ namespace nil {
                 static_assert(is_integral<field_type>::value,
                               "field_type must be of integral type");
 
+                /// @brief Name of the layer reported by the tracing.
+                static constexpr const char *trace_name() {
+                    return "msg_size_layer";
+                }
+
                 /// @brief Default constructor
                 explicit msg_size_layer() = default;
 
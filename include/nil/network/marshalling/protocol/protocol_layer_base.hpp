@@ -41,6 +41,9 @@
 #include <nil/network/marshalling/protocol/detail/protocol_layer_base_options_parser.hpp>
 #include <nil/network/marshalling/detail/protocol_layers_access.hpp>
 #include <nil/network/marshalling/type_traits.hpp>
+#ifdef MARSHALLING_TRACING
+#include <nil/network/marshalling/trace.hpp>
+#endif
 
 namespace nil {
     namespace marshalling {
@@ -273,6 +276,9 @@ namespace nil {
 
                     static_assert(std::is_same<tag, normal_read_tag>::value || can_split_read(),
                                   "Read split is disallowed by at least one of the inner layers");
+#ifdef MARSHALLING_TRACING
+                    MARSHALLING_TRACE_SPAN(nil::marshalling::trace_name<TDerived>());
+#endif
                     return read_internal(msg, iter, size, missingSize, tag());
                 }
 
@@ -481,6 +487,9 @@ namespace nil {
                 /// @return Status of the write operation.
                 template<typename TMsg, typename TIter>
                 nil::marshalling::status_type write(const TMsg &msg, TIter &iter, std::size_t size) const {
+#ifdef MARSHALLING_TRACING
+                    MARSHALLING_TRACE_SPAN(nil::marshalling::trace_name<TDerived>());
+#endif
                     field_type field;
                     auto &derivedObj = static_cast<const TDerived &>(*this);
                     return derivedObj.eval_write(field, msg, iter, size, create_next_layer_writer());
@@ -26,6 +26,9 @@
 #ifndef NETWORK_MARSHALLING_TRANSPORT_VALUE_LAYER_HPP
 #define NETWORK_MARSHALLING_TRANSPORT_VALUE_LAYER_HPP
 
+#include <iterator>
+#include <type_traits>
+
 #include <nil/network/marshalling/protocol/protocol_layer_base.hpp>
 #include <nil/network/marshalling/protocol/detail/transport_value_layer_adapter.hpp>
 
@@ -53,6 +56,9 @@ namespace nil {
             /// @tparam TOptions Extending functionality options. Supported options are:
             ///     @li @ref nil::marshalling::option::PseudoValue - Mark the handled value to be "pseudo"
             ///         one, i.e. the field is not getting serialized.
+            ///     @li @ref nil::marshalling::option::memoized_header - Memoize the raw bytes of the
+            ///         header formed by this layer and all the directly following transport_value_layer
+            ///         ones. The option is expected to be passed to the outermost of them only.
             /// @headerfile nil/network/marshalling/protocol/transport_value_layer.h
             /// @extends ProtocolLayerBase
             template<typename TField, std::size_t TIdx, typename TNextLayer, typename... TOptions>
@@ -75,6 +81,11 @@ namespace nil {
                 /// @brief Parsed options
                 using transport_parsed_options_type = detail::transport_value_layer_options_parser<TOptions...>;
 
+                /// @brief Name of the layer reported by the tracing.
+                static constexpr const char *trace_name() {
+                    return "transport_value_layer";
+                }
+
                 /// @brief Default constructor
                 transport_value_layer() = default;
 
@@ -123,27 +134,9 @@ namespace nil {
                 template<typename TMsg, typename TIter, typename TNextLayerReader>
                 nil::marshalling::status_type eval_read(field_type &field, TMsg &msg, TIter &iter, std::size_t size,
                                                         std::size_t *missingSize, TNextLayerReader &&nextLayerReader) {
-                    auto es = read_field_internal(field, iter, size, missingSize, value_tag());
-                    if (es != nil::marshalling::status_type::success) {
-                        return es;
-                    }
-
-                    es = nextLayerReader.read(msg, iter, size, missingSize);
-
-                    using tag = typename std::conditional<
-                        base_impl_type::template is_message_obj_ref<typename std::decay<decltype(msg)>::type>(),
-                        msg_obj_tag, smart_ptr_tag>::type;
-
-                    if (valid_msg(msg, tag())) {
-                        auto &allTransportFields = transport_fields(msg, tag());
-                        auto &transportField = std::get<TIdx>(allTransportFields);
-
-                        using field_type = typename std::decay<decltype(transportField)>::type;
-                        using value_type = typename field_type::value_type;
-
-                        transportField.value() = static_cast<value_type>(field.value());
-                    }
-                    return es;
+                    return eval_read_internal(field, msg, iter, size, missingSize,
+                                              std::forward<TNextLayerReader>(nextLayerReader),
+                                              memo_tag<TIter, TNextLayerReader>());
                 }
 
                 /// @brief Customized write functionality, invoked by @ref write().
@@ -201,7 +194,47 @@ namespace nil {
                     return eval_field_length();
                 }
 
+                /// @brief Read the field of this layer as part of the memoized header.
+                /// @details Invoked when the header is decoded by the layer having
+                ///     @ref nil::marshalling::option::memoized_header option.
+                template<typename TIter>
+                nil::marshalling::status_type read_header_field(field_type &field, TIter &iter, std::size_t &len) {
+                    return read_field_internal(field, iter, len, nullptr, value_tag());
+                }
+
+                /// @brief Assign value of the field to the appropriate extra transport field of the message.
+                /// @details Does nothing if the message object hasn't been allocated.
+                template<typename TMsg>
+                static void assign_transport_field(const field_type &field, TMsg &msg) {
+                    using tag = typename std::conditional<
+                        base_impl_type::template is_message_obj_ref<typename std::decay<decltype(msg)>::type>(),
+                        msg_obj_tag, smart_ptr_tag>::type;
+
+                    if (!valid_msg(msg, tag())) {
+                        return;
+                    }
+
+                    auto &allTransportFields = transport_fields(msg, tag());
+                    auto &transportField = std::get<TIdx>(allTransportFields);
+
+                    using transport_field_type = typename std::decay<decltype(transportField)>::type;
+                    using value_type = typename transport_field_type::value_type;
+
+                    transportField.value() = static_cast<value_type>(field.value());
+                }
+
 #ifdef FOR_DOXYGEN_DOC_ONLY
+                /// @brief Check whether the memo holds the previously read header.
+                /// @detail The function exists only if @ref nil::marshalling::option::memoized_header
+                ///     option has been used.
+                bool is_memo_valid() const;
+
+                /// @brief Drop the memoized header, forcing the next read to decode it.
+                /// @detail The function exists only if @ref nil::marshalling::option::memoized_header
+                ///     option has been used. Values of the "pseudo" fields are memoized together
+                ///     with the header, the memo needs to be dropped when they are changed.
+                void reset_memo();
+
                 /// @brief Access to pseudo field stored internally.
                 /// @detail The function exists only if @ref nil::marshalling::option::pseudo_value
                 ///     option has been used.
@@ -222,6 +255,27 @@ namespace nil {
                 using value_tag = typename std::conditional<transport_parsed_options_type::has_pseudo_value,
                                                             pseudo_value_tag, normal_value_tag>::type;
 
+                struct no_memo_tag { };
+                struct memo_read_tag { };
+                struct memo_read_until_data_tag { };
+
+                template<typename TNextLayerReader, typename TReader>
+                using is_reader = std::is_same<typename std::decay<TNextLayerReader>::type, TReader>;
+
+                template<typename TNextLayerReader>
+                using memo_reader_tag = typename std::conditional<
+                    is_reader<TNextLayerReader, typename base_impl_type::next_layer_reader>::value, memo_read_tag,
+                    typename std::conditional<
+                        is_reader<TNextLayerReader, typename base_impl_type::next_layer_until_data_reader>::value,
+                        memo_read_until_data_tag, no_memo_tag>::type>::type;
+
+                template<typename TIter, typename TNextLayerReader>
+                using memo_tag = typename std::conditional<
+                    transport_parsed_options_type::has_memoized_header
+                        && std::is_base_of<std::random_access_iterator_tag,
+                                           typename std::iterator_traits<TIter>::iterator_category>::value,
+                    memo_reader_tag<TNextLayerReader>, no_memo_tag>::type;
+
                 template<typename TMsg>
                 static bool valid_msg(TMsg &msgPtr, smart_ptr_tag) {
                     using MsgPtrType = typename std::decay<decltype(msgPtr)>::type;
@@ -257,6 +311,65 @@ namespace nil {
                     return msg.transport_fields();
                 }
 
+                template<typename TMsg, typename TIter, typename TNextLayerReader>
+                nil::marshalling::status_type eval_read_internal(field_type &field, TMsg &msg, TIter &iter,
+                                                                 std::size_t size, std::size_t *missingSize,
+                                                                 TNextLayerReader &&nextLayerReader, no_memo_tag) {
+                    auto es = read_field_internal(field, iter, size, missingSize, value_tag());
+                    if (es != nil::marshalling::status_type::success) {
+                        return es;
+                    }
+
+                    es = nextLayerReader.read(msg, iter, size, missingSize);
+                    assign_transport_field(field, msg);
+                    return es;
+                }
+
+                template<typename TMsg, typename TIter, typename TNextLayerReader, typename TMemoTag>
+                nil::marshalling::status_type eval_read_internal(field_type &field, TMsg &msg, TIter &iter,
+                                                                 std::size_t size, std::size_t *missingSize,
+                                                                 TNextLayerReader &&nextLayerReader, TMemoTag) {
+                    using header_type = detail::transport_value_layer_header<transport_value_layer>;
+                    static_assert(header_type::length() == base_impl_type::memo_length, "Invalid assumption");
+
+                    if (size < base_impl_type::memo_length) {
+                        return eval_read_internal(field, msg, iter, size, missingSize,
+                                                  std::forward<TNextLayerReader>(nextLayerReader), no_memo_tag());
+                    }
+
+                    auto &fields = base_impl_type::memo_fields();
+                    if (!base_impl_type::memo_matches(iter)) {
+                        auto headerIter = iter;
+                        auto len = size;
+                        auto es = header_type::template read<0U>(*this, fields, headerIter, len);
+                        if (es != nil::marshalling::status_type::success) {
+                            base_impl_type::reset_memo();
+                            return eval_read_internal(field, msg, iter, size, missingSize,
+                                                      std::forward<TNextLayerReader>(nextLayerReader), no_memo_tag());
+                        }
+
+                        base_impl_type::update_memo(iter);
+                    }
+
+                    field = std::get<0>(fields);
+                    std::advance(iter, base_impl_type::memo_length);
+                    auto es = read_payload(msg, iter, size - base_impl_type::memo_length, missingSize, TMemoTag());
+                    header_type::template assign<0U>(fields, msg);
+                    return es;
+                }
+
+                template<typename TMsg, typename TIter>
+                nil::marshalling::status_type read_payload(TMsg &msg, TIter &iter, std::size_t size,
+                                                           std::size_t *missingSize, memo_read_tag) {
+                    return base_impl_type::memo_payload_layer().read(msg, iter, size, missingSize);
+                }
+
+                template<typename TMsg, typename TIter>
+                nil::marshalling::status_type read_payload(TMsg &msg, TIter &iter, std::size_t size,
+                                                           std::size_t *missingSize, memo_read_until_data_tag) {
+                    return base_impl_type::memo_payload_layer().read_until_data(msg, iter, size, missingSize);
+                }
+
                 static constexpr std::size_t eval_field_length_internal(pseudo_value_tag) {
                     return 0U;
                 }
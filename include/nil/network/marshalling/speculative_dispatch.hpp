@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains speculative dispatch of the read messages with deferred checksum verification.
+
+#ifndef NETWORK_MARSHALLING_SPECULATIVE_DISPATCH_HPP
+#define NETWORK_MARSHALLING_SPECULATIVE_DISPATCH_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <nil/marshalling/status_type.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        namespace detail {
+
+            template<typename T, typename = void>
+            struct has_speculative_tag : public std::false_type { };
+
+            template<typename T>
+            struct has_speculative_tag<T, typename std::conditional<false, typename T::speculative_tag, void>::type>
+                : public std::true_type { };
+
+        }    // namespace detail
+
+        /// @brief Check whether the handler is capable of speculative message handling.
+        /// @details The handler declares itself speculative-capable by defining
+        ///     @b speculative_tag internal type. Such handler must also define
+        ///     the following member functions (in addition to @b handle() ones):
+        ///     @code
+        ///     void confirm(TMsg& msg); // The checksum of the handled message is valid
+        ///     void retract(TMsg& msg); // The checksum of the handled message is invalid
+        ///     @endcode
+        ///     where TMsg is the common interface class of the messages.
+        /// @headerfile nil/network/marshalling/speculative_dispatch.h
+        template<typename THandler>
+        constexpr bool is_speculative_handler() {
+            return detail::has_speculative_tag<THandler>::value;
+        }
+
+        namespace detail {
+
+            template<typename TLayer, typename TMsgPtr, typename THandler>
+            status_type speculative_dispatch_verified(TLayer &checksumLayer, TMsgPtr &msg, THandler &handler,
+                                                      std::true_type) {
+                msg->dispatch(handler);
+                if (checksumLayer.verify_pending()) {
+                    handler.confirm(*msg);
+                    return status_type::success;
+                }
+
+                handler.retract(*msg);
+                msg.reset();
+                return status_type::protocol_error;
+            }
+
+            template<typename TLayer, typename TMsgPtr, typename THandler>
+            status_type speculative_dispatch_verified(TLayer &checksumLayer, TMsgPtr &msg, THandler &handler,
+                                                      std::false_type) {
+                if (!checksumLayer.verify_pending()) {
+                    msg.reset();
+                    return status_type::protocol_error;
+                }
+
+                msg->dispatch(handler);
+                return status_type::success;
+            }
+
+        }    // namespace detail
+
+        /// @brief Read the message and dispatch it to the handler prior to the checksum verification.
+        /// @details Reads the message using the protocol stack containing
+        ///     nil::marshalling::protocol::checksum_layer with
+        ///     nil::marshalling::option::checksum_layer_speculative_read option.
+        ///     When the handler is speculative-capable (see @ref is_speculative_handler()),
+        ///     the read message is dispatched to it right away, the checksum is verified
+        ///     immediately after, and the handler receives either @b confirm() or
+        ///     @b retract() callback. Otherwise the checksum is verified before the dispatch.
+        /// @param[in] stack Protocol stack.
+        /// @param[in] checksumLayer Checksum layer of the protocol stack.
+        /// @param[out] msg Smart pointer to the message object to be allocated.
+        /// @param[in, out] iter Input iterator, must refer to the contiguous buffer.
+        /// @param[in] size Number of bytes available for reading.
+        /// @param[in] handler Handler object.
+        /// @param[out] missingSize Minimal number of missing bytes, see protocol layer read().
+        /// @return Status of the read, nil::marshalling::status_type::protocol_error when
+        ///     the checksum verification fails. The message is dispatched only if the checksum
+        ///     is valid or the handler is speculative-capable.
+        /// @headerfile nil/network/marshalling/speculative_dispatch.h
+        template<typename TStack, typename TLayer, typename TMsgPtr, typename TIter, typename THandler>
+        status_type speculative_dispatch(TStack &stack, TLayer &checksumLayer, TMsgPtr &msg, TIter &iter,
+                                         std::size_t size, THandler &handler, std::size_t *missingSize = nullptr) {
+            static_assert(TLayer::parsed_options_type::has_speculative_read,
+                          "The checksum layer must use checksum_layer_speculative_read option");
+
+            auto es = stack.read(msg, iter, size, missingSize);
+            if ((es != status_type::success) || (!checksumLayer.is_verification_pending())) {
+                if (es == status_type::success) {
+                    msg->dispatch(handler);
+                }
+
+                return es;
+            }
+
+            return detail::speculative_dispatch_verified(
+                checksumLayer, msg, handler,
+                std::integral_constant<bool, is_speculative_handler<THandler>()>());
+        }
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_SPECULATIVE_DISPATCH_HPP
@@ -0,0 +1,111 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of the string fields using the non-owning and inline
+///     storages of the core string field, which allow decoding of the strings
+///     without dynamic memory allocation.
+
+#ifndef NETWORK_MARSHALLING_STRING_STORAGE_HPP
+#define NETWORK_MARSHALLING_STRING_STORAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include <nil/marshalling/options.hpp>
+#include <nil/marshalling/types/string.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief String field prefixed with its size, which refers to the characters
+        ///     in the input buffer.
+        /// @details Alias to nil::marshalling::types::string with
+        ///     nil::marshalling::option::orig_data_view option, the stored value is the
+        ///     non-owning view of the characters, no copy is performed on read. The read
+        ///     iterator must be a pointer to the single byte type. Suitable for the
+        ///     read-only decode paths, where the message doesn't outlive the input buffer,
+        ///     use @ref string_copy_out() to copy the contents out for persistence.
+        /// @tparam TFieldBase Base class for this field, expected to be a variant of
+        ///     nil::marshalling::field_type.
+        /// @tparam TSizePrefix Type of the field holding the number of the characters,
+        ///     expected to be a variant of nil::marshalling::types::integral.
+        /// @tparam TOptions Extra options of nil::marshalling::types::string.
+        /// @headerfile nil/network/marshalling/string_storage.h
+        template<typename TFieldBase, typename TSizePrefix, typename... TOptions>
+        using view_string_field
+            = nil::marshalling::types::string<TFieldBase,
+                                              nil::marshalling::option::sequence_size_field_prefix<TSizePrefix>,
+                                              nil::marshalling::option::orig_data_view, TOptions...>;
+
+        /// @brief String field prefixed with its size, which stores up to @b TCapacity
+        ///     characters inside the field.
+        /// @details Alias to nil::marshalling::types::string with
+        ///     nil::marshalling::option::fixed_size_storage option, the characters are
+        ///     copied into the field itself, the strings longer than the capacity are rejected.
+        /// @tparam TFieldBase Base class for this field, expected to be a variant of
+        ///     nil::marshalling::field_type.
+        /// @tparam TSizePrefix Type of the field holding the number of the characters,
+        ///     expected to be a variant of nil::marshalling::types::integral.
+        /// @tparam TCapacity Maximal number of the characters.
+        /// @tparam TOptions Extra options of nil::marshalling::types::string.
+        /// @headerfile nil/network/marshalling/string_storage.h
+        template<typename TFieldBase, typename TSizePrefix, std::size_t TCapacity, typename... TOptions>
+        using inline_string_field
+            = nil::marshalling::types::string<TFieldBase,
+                                              nil::marshalling::option::sequence_size_field_prefix<TSizePrefix>,
+                                              nil::marshalling::option::fixed_size_storage<TCapacity>, TOptions...>;
+
+        /// @brief Copy the characters of the string field out into the owning string.
+        /// @details Intended for persisting the value of @ref view_string_field beyond
+        ///     the lifetime of the input buffer, works with any string field.
+        /// @param[in] field String field.
+        /// @headerfile nil/network/marshalling/string_storage.h
+        template<typename TField>
+        std::string string_copy_out(const TField &field) {
+            auto &value = field.value();
+            return std::string(value.begin(), value.end());
+        }
+
+        /// @brief Copy the characters of the string field out into the provided buffer.
+        /// @param[in] field String field.
+        /// @param[out] buf Output buffer.
+        /// @param[in] bufLen Length of the output buffer.
+        /// @return Number of the copied characters, the output is not zero terminated
+        ///     and truncated to the length of the buffer.
+        /// @headerfile nil/network/marshalling/string_storage.h
+        template<typename TField>
+        std::size_t string_copy_out(const TField &field, char *buf, std::size_t bufLen) {
+            auto &value = field.value();
+            auto count = std::min(static_cast<std::size_t>(value.size()), bufLen);
+            std::copy_n(value.begin(), count, buf);
+            return count;
+        }
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_STRING_STORAGE_HPP
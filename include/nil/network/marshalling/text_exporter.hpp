@@ -0,0 +1,801 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of text (CSV/JSON) exporters of the decoded messages.
+
+#ifndef NETWORK_MARSHALLING_TEXT_EXPORTER_HPP
+#define NETWORK_MARSHALLING_TEXT_EXPORTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nil/detail/type_traits.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/processing/tuple.hpp>
+#include <nil/network/marshalling/detail/exact_type.hpp>
+#include <nil/network/marshalling/detail/text_export/format.hpp>
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Reusable output buffer of the text exporters.
+        /// @details Grows geometrically and never shrinks, the @ref clear() member
+        ///     function keeps the allocated capacity, so the same buffer can be
+        ///     reused for the whole capture without any further allocation.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        class text_buffer {
+        public:
+            /// @brief Default initial capacity.
+            static const std::size_t default_capacity = 1024U * 1024U;
+
+            /// @brief Constructor
+            /// @param[in] capacity Initial capacity.
+            explicit text_buffer(std::size_t capacity = default_capacity) : data_(std::max(capacity, std::size_t(64U))) {
+            }
+
+            /// @brief Get pointer to at least @b len writable bytes at the end of the buffer.
+            /// @details Must be followed by @ref commit().
+            char *prepare(std::size_t len) {
+                if ((data_.size() - size_) < len) {
+                    data_.resize(std::max(data_.size() * 2U, size_ + len));
+                }
+                return &data_[size_];
+            }
+
+            /// @brief Commit @b len bytes written to the area returned by @ref prepare().
+            void commit(std::size_t len) {
+                size_ += len;
+            }
+
+            /// @brief Append raw characters.
+            void append(const char *str, std::size_t len) {
+                std::memcpy(prepare(len), str, len);
+                commit(len);
+            }
+
+            /// @brief Append zero terminated string.
+            void append(const char *str) {
+                append(str, std::strlen(str));
+            }
+
+            /// @brief Append single character.
+            void append(char ch) {
+                *prepare(1U) = ch;
+                commit(1U);
+            }
+
+            /// @brief Access to the written data.
+            const char *data() const {
+                return data_.data();
+            }
+
+            /// @brief Number of written bytes.
+            std::size_t size() const {
+                return size_;
+            }
+
+            /// @brief Check whether the buffer is empty.
+            bool empty() const {
+                return size_ == 0U;
+            }
+
+            /// @brief Allocated capacity.
+            std::size_t capacity() const {
+                return data_.size();
+            }
+
+            /// @brief Discard written data, keeping the allocated capacity.
+            void clear() {
+                size_ = 0U;
+            }
+
+        private:
+            std::vector<char> data_;
+            std::size_t size_ = 0U;
+        };
+
+        /// @brief Comma separated values format of the @ref text_exporter.
+        /// @details Every message is written as a single line, starting with the
+        ///     message name followed by the field values. Strings are quoted,
+        ///     collections and bundles are written as space separated quoted lists.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        struct csv_text_format { };
+
+        /// @brief JSON lines format of the @ref text_exporter.
+        /// @details Every message is written as a single line JSON object, containing
+        ///     "msg" member with the message name, followed by the members named after
+        ///     the fields.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        struct json_text_format { };
+
+        namespace detail {
+            namespace text_export {
+
+                template<typename T>
+                class has_value_func {
+                    template<typename U>
+                    static auto test(int) -> decltype(std::declval<const U &>().value(), std::true_type());
+
+                    template<typename>
+                    static std::false_type test(...);
+
+                public:
+                    static const bool value = decltype(test<T>(0))::value;
+                };
+
+                template<typename T>
+                class has_name_func {
+                    template<typename U>
+                    static auto test(int) -> decltype(std::declval<const U &>().eval_name(), std::true_type());
+
+                    template<typename>
+                    static std::false_type test(...);
+
+                public:
+                    static const bool value = decltype(test<T>(0))::value;
+                };
+
+                template<typename T>
+                class has_field_name_func {
+                    template<typename U>
+                    static auto test(int) -> decltype(U::eval_field_name(std::size_t(0)), std::true_type());
+
+                    template<typename>
+                    static std::false_type test(...);
+
+                public:
+                    static const bool value = decltype(test<T>(0))::value;
+                };
+
+                struct bool_tag { };
+                struct integral_tag { };
+                struct floating_point_tag { };
+                struct enum_tag { };
+                struct tuple_tag { };
+                struct string_tag { };
+                struct bytes_tag { };
+                struct list_tag { };
+                struct field_tag { };
+                struct unknown_tag { };
+
+                template<typename T, bool TIsClass = std::is_class<T>::value>
+                struct is_container_helper {
+                    static const bool value = nil::detail::is_container<T>::value;
+                };
+
+                template<typename T>
+                struct is_container_helper<T, false> {
+                    static const bool value = false;
+                };
+
+                template<typename T, bool TIsContainer = is_container_helper<T>::value>
+                struct container_tag_helper {
+                    using type = unknown_tag;
+                };
+
+                template<typename T>
+                struct container_tag_helper<T, true> {
+                    using element_type = typename std::decay<decltype(*std::declval<const T &>().begin())>::type;
+
+                    using type = typename std::conditional<
+                        std::is_same<element_type, char>::value, string_tag,
+                        typename std::conditional<(std::is_integral<element_type>::value
+                                                   && (sizeof(element_type) == 1U)),
+                                                  bytes_tag, list_tag>::type>::type;
+                };
+
+                template<typename T>
+                using value_tag_type = typename std::conditional<
+                    std::is_same<T, bool>::value, bool_tag,
+                    typename std::conditional<
+                        std::is_integral<T>::value, integral_tag,
+                        typename std::conditional<
+                            std::is_floating_point<T>::value, floating_point_tag,
+                            typename std::conditional<
+                                std::is_enum<T>::value, enum_tag,
+                                typename std::conditional<
+                                    nil::detail::is_tuple<T>::value, tuple_tag,
+                                    typename std::conditional<has_value_func<T>::value, field_tag,
+                                                              typename container_tag_helper<T>::type>::type>::
+                                    type>::type>::type>::type>::type;
+
+                template<typename TFormat>
+                struct value_writer;
+
+                template<typename TFormat, typename T>
+                void write_element(const T &value, text_buffer &out, std::true_type) {
+                    value_writer<TFormat>::write_field(value, out);
+                }
+
+                template<typename TFormat, typename T>
+                void write_element(const T &value, text_buffer &out, std::false_type) {
+                    value_writer<TFormat>::write_value(value, out);
+                }
+
+                template<typename TFormat>
+                struct value_writer {
+                    template<typename TField>
+                    static void write_field(const TField &field, text_buffer &out) {
+                        write_value(field.value(), out);
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out) {
+                        write_value(value, out, value_tag_type<T>());
+                    }
+
+                    template<typename T>
+                    static void write_list(const T &value, text_buffer &out) {
+                        list_open(out, TFormat());
+                        bool first = true;
+                        for (auto &elem : value) {
+                            if (!first) {
+                                list_separator(out, TFormat());
+                            }
+                            first = false;
+                            using elem_type = typename std::decay<decltype(elem)>::type;
+                            write_element<TFormat>(elem, out,
+                                                   std::integral_constant<bool, has_value_func<elem_type>::value>());
+                        }
+                        list_close(out, TFormat());
+                    }
+
+                    static void write_string(const char *str, std::size_t len, text_buffer &out) {
+                        write_string(str, len, out, TFormat());
+                    }
+
+                private:
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, bool_tag) {
+                        out.append(value ? "true" : "false");
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, integral_tag) {
+                        out.commit(format_integral(value, out.prepare(max_integral_chars)));
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, floating_point_tag) {
+                        if (!std::isfinite(value)) {
+                            write_non_finite(out, TFormat());
+                            return;
+                        }
+                        out.commit(format_floating_point(value, out.prepare(max_floating_point_chars)));
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, enum_tag) {
+                        using underlying_type = typename std::underlying_type<T>::type;
+                        write_value(static_cast<underlying_type>(value), out, integral_tag());
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, tuple_tag) {
+                        list_open(out, TFormat());
+                        tuple_writer<T, 0U>::write(value, out);
+                        list_close(out, TFormat());
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, string_tag) {
+                        auto len = static_cast<std::size_t>(std::distance(value.begin(), value.end()));
+                        write_string((len == 0U) ? "" : &(*value.begin()), len, out);
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, bytes_tag) {
+                        auto len = static_cast<std::size_t>(std::distance(value.begin(), value.end()));
+                        out.append('"');
+                        auto *pos = out.prepare(len * 2U);
+                        for (auto byte : value) {
+                            auto ch = static_cast<unsigned>(static_cast<std::uint8_t>(byte));
+                            *pos++ = hex_digit(ch >> 4U);
+                            *pos++ = hex_digit(ch);
+                        }
+                        out.commit(len * 2U);
+                        out.append('"');
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, list_tag) {
+                        write_list(value, out);
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &value, text_buffer &out, field_tag) {
+                        write_field(value, out);
+                    }
+
+                    template<typename T>
+                    static void write_value(const T &, text_buffer &out, unknown_tag) {
+                        write_non_finite(out, TFormat());
+                    }
+
+                    template<typename TTuple, std::size_t TIdx, bool TEnd = (std::tuple_size<TTuple>::value <= TIdx)>
+                    struct tuple_writer {
+                        static void write(const TTuple &value, text_buffer &out) {
+                            if (0U < TIdx) {
+                                list_separator(out, TFormat());
+                            }
+                            using elem_type = typename std::tuple_element<TIdx, TTuple>::type;
+                            write_element<TFormat>(std::get<TIdx>(value), out,
+                                                   std::integral_constant<bool, has_value_func<elem_type>::value>());
+                            tuple_writer<TTuple, TIdx + 1U>::write(value, out);
+                        }
+                    };
+
+                    template<typename TTuple, std::size_t TIdx>
+                    struct tuple_writer<TTuple, TIdx, true> {
+                        static void write(const TTuple &, text_buffer &) {
+                        }
+                    };
+
+                    static void list_open(text_buffer &out, csv_text_format) {
+                        out.append('"');
+                    }
+
+                    static void list_open(text_buffer &out, json_text_format) {
+                        out.append('[');
+                    }
+
+                    static void list_separator(text_buffer &out, csv_text_format) {
+                        out.append(' ');
+                    }
+
+                    static void list_separator(text_buffer &out, json_text_format) {
+                        out.append(',');
+                    }
+
+                    static void list_close(text_buffer &out, csv_text_format) {
+                        out.append('"');
+                    }
+
+                    static void list_close(text_buffer &out, json_text_format) {
+                        out.append(']');
+                    }
+
+                    static void write_non_finite(text_buffer &, csv_text_format) {
+                    }
+
+                    static void write_non_finite(text_buffer &out, json_text_format) {
+                        out.append("null", 4U);
+                    }
+
+                    static void write_string(const char *str, std::size_t len, text_buffer &out, csv_text_format) {
+                        out.append('"');
+                        auto *begin = str;
+                        auto *end = str + len;
+                        while (begin != end) {
+                            auto *quote = std::find(begin, end, '"');
+                            out.append(begin, static_cast<std::size_t>(quote - begin));
+                            if (quote == end) {
+                                break;
+                            }
+                            out.append("\"\"", 2U);
+                            begin = quote + 1;
+                        }
+                        out.append('"');
+                    }
+
+                    static void write_string(const char *str, std::size_t len, text_buffer &out, json_text_format) {
+                        out.append('"');
+                        std::size_t plainLen = 0U;
+                        for (std::size_t idx = 0U; idx < len; ++idx) {
+                            auto ch = static_cast<unsigned char>(str[idx]);
+                            if ((0x20U <= ch) && (ch != '"') && (ch != '\\')) {
+                                ++plainLen;
+                                continue;
+                            }
+
+                            out.append(str + idx - plainLen, plainLen);
+                            plainLen = 0U;
+                            char escaped[6] = {'\\', 'u', '0', '0', hex_digit(ch >> 4U), hex_digit(ch)};
+                            if ((ch == '"') || (ch == '\\')) {
+                                escaped[1] = static_cast<char>(ch);
+                                out.append(escaped, 2U);
+                            } else {
+                                out.append(escaped, sizeof(escaped));
+                            }
+                        }
+                        out.append(str + len - plainLen, plainLen);
+                        out.append('"');
+                    }
+                };
+
+                template<typename TMsg>
+                void write_msg_name(const TMsg &msg, text_buffer &out, std::true_type) {
+                    auto *name = msg.eval_name();
+                    value_writer<json_text_format>::write_string(name, std::strlen(name), out);
+                }
+
+                template<typename TMsg>
+                void write_msg_name(const TMsg &, text_buffer &out, std::false_type) {
+                    out.append('"');
+                    value_writer<json_text_format>::write_value(TMsg::eval_get_id(), out);
+                    out.append('"');
+                }
+
+                template<typename TMsg>
+                void write_msg_name(const TMsg &msg, text_buffer &out) {
+                    write_msg_name(msg, out, std::integral_constant<bool, has_name_func<TMsg>::value>());
+                }
+
+                template<typename TMsg>
+                const char *field_name(std::size_t idx, std::true_type) {
+                    return TMsg::eval_field_name(idx);
+                }
+
+                template<typename TMsg>
+                const char *field_name(std::size_t, std::false_type) {
+                    return nullptr;
+                }
+
+                template<typename TMsg>
+                void write_field_name(std::size_t idx, text_buffer &out) {
+                    auto *name = field_name<TMsg>(idx, std::integral_constant<bool, has_field_name_func<TMsg>::value>());
+                    out.append('"');
+                    if (name != nullptr) {
+                        out.append(name);
+                    } else {
+                        out.append("field", 5U);
+                        value_writer<json_text_format>::write_value(idx, out);
+                    }
+                    out.append('"');
+                }
+
+                template<typename TMsg, typename TFormat>
+                class fields_writer {
+                public:
+                    explicit fields_writer(text_buffer &out) : out_(out) {
+                    }
+
+                    template<typename TField>
+                    void operator()(const TField &field) {
+                        write(field, TFormat());
+                        ++idx_;
+                    }
+
+                private:
+                    template<typename TField>
+                    void write(const TField &field, csv_text_format) {
+                        out_.append(',');
+                        value_writer<csv_text_format>::write_field(field, out_);
+                    }
+
+                    template<typename TField>
+                    void write(const TField &field, json_text_format) {
+                        out_.append(',');
+                        write_field_name<TMsg>(idx_, out_);
+                        out_.append(':');
+                        value_writer<json_text_format>::write_field(field, out_);
+                    }
+
+                    text_buffer &out_;
+                    std::size_t idx_ = 0U;
+                };
+
+            }    // namespace text_export
+        }        // namespace detail
+
+        /// @brief Write message contents in CSV format.
+        /// @details The fields are iterated at compile time, the integral values
+        ///     are formatted using lookup table of decimal digits, floating point
+        ///     values use the shortest round trip representation (std::to_chars
+        ///     when available).
+        /// @tparam TMsg Type of the message, must be defined using
+        ///     nil::marshalling::option::fields_impl option.
+        /// @param[in] msg Message object.
+        /// @param[out] out Output buffer.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        template<typename TMsg>
+        void write_text(const TMsg &msg, text_buffer &out, csv_text_format) {
+            detail::text_export::write_msg_name(msg, out);
+            nil::marshalling::processing::tuple_for_each(
+                msg.fields(), detail::text_export::fields_writer<TMsg, csv_text_format>(out));
+            out.append('\n');
+        }
+
+        /// @brief Write message contents in JSON lines format.
+        /// @details The names of the fields are taken from the message's
+        ///     @b eval_field_name() static function generated by
+        ///     @ref MARSHALLING_MSG_FIELDS_ACCESS() macro, in case there is no such,
+        ///     the "field<idx>" names are used.
+        /// @tparam TMsg Type of the message, must be defined using
+        ///     nil::marshalling::option::fields_impl option.
+        /// @param[in] msg Message object.
+        /// @param[out] out Output buffer.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        template<typename TMsg>
+        void write_text(const TMsg &msg, text_buffer &out, json_text_format) {
+            out.append("{\"msg\":", 7U);
+            detail::text_export::write_msg_name(msg, out);
+            nil::marshalling::processing::tuple_for_each(
+                msg.fields(), detail::text_export::fields_writer<TMsg, json_text_format>(out));
+            out.append("}\n", 2U);
+        }
+
+        /// @brief Write CSV header line for the provided message type.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        template<typename TMsg>
+        void write_csv_header(text_buffer &out) {
+            out.append("msg", 3U);
+            using fields_type = typename TMsg::all_fields_type;
+            for (std::size_t idx = 0U; idx < std::tuple_size<fields_type>::value; ++idx) {
+                out.append(',');
+                detail::text_export::write_field_name<TMsg>(idx, out);
+            }
+            out.append('\n');
+        }
+
+        namespace detail {
+            namespace text_export {
+
+                template<typename TAllMessages, typename TMsgBase, typename TFormat>
+                class polymorphic_writers {
+                    using msg_id_type = typename TMsgBase::msg_id_type;
+                    using write_func_type = bool (*)(const TMsgBase &, text_buffer &);
+
+                    struct entry {
+                        msg_id_type id_;
+                        write_func_type func_;
+                    };
+
+                    using table_type = std::array<entry, std::tuple_size<TAllMessages>::value>;
+
+                public:
+                    static bool write(const TMsgBase &msg, text_buffer &out) {
+                        static const table_type Table = make_table();
+                        auto id = msg.get_id();
+                        auto iter = std::lower_bound(Table.begin(), Table.end(), id,
+                                                     [](const entry &elem, msg_id_type value) -> bool {
+                                                         return elem.id_ < value;
+                                                     });
+
+                        for (; (iter != Table.end()) && (!(id < iter->id_)); ++iter) {
+                            if (iter->func_(msg, out)) {
+                                return true;
+                            }
+                        }
+
+                        return false;
+                    }
+
+                private:
+                    class table_filler {
+                    public:
+                        explicit table_filler(table_type &table) : table_(table) {
+                        }
+
+                        template<typename TMsg>
+                        void operator()() {
+                            table_[idx_].id_ = static_cast<msg_id_type>(TMsg::eval_get_id());
+                            table_[idx_].func_ = &write_exact<TMsg>;
+                            ++idx_;
+                        }
+
+                    private:
+                        table_type &table_;
+                        std::size_t idx_ = 0U;
+                    };
+
+                    static table_type make_table() {
+                        table_type table;
+                        table_filler filler(table);
+                        nil::marshalling::processing::tuple_for_each_type<TAllMessages>(filler);
+                        std::stable_sort(table.begin(), table.end(),
+                                         [](const entry &first, const entry &second) -> bool {
+                                             return first.id_ < second.id_;
+                                         });
+                        return table;
+                    }
+
+                    template<typename TMsg>
+                    static bool write_exact(const TMsgBase &msg, text_buffer &out) {
+                        if (!exact_type_checker<TMsg>::check(msg)) {
+                            return false;
+                        }
+
+                        nil::marshalling::write_text(static_cast<const TMsg &>(msg), out, TFormat());
+                        return true;
+                    }
+                };
+
+            }    // namespace text_export
+        }        // namespace detail
+
+        /// @brief Write message held by the reference to its interface class.
+        /// @details The candidate types are looked up by the message ID in the table
+        ///     of the types listed in @b TAllMessages sorted by their static IDs, built
+        ///     once per instantiation. The message is written as the candidate, which is
+        ///     exactly its dynamic type (verified using RTTI), so the messages of the
+        ///     types not listed in @b TAllMessages (e.g. generic or dynamic ones) are
+        ///     not written even when their ID matches. Requires RTTI to be enabled.
+        /// @tparam TAllMessages All the message types bundled in std::tuple, must be
+        ///     defined using nil::marshalling::option::static_num_id_impl option.
+        /// @return @b true in case the message has been written, @b false if its type is unknown.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        template<typename TAllMessages, typename TMsgBase, typename TFormat>
+        bool write_text_polymorphic(const TMsgBase &msg, text_buffer &out, TFormat format) {
+            static_assert(detail::exact_type_checker<TMsgBase>::supported(),
+                          "Writing the message via its interface requires RTTI to verify the actual type "
+                          "of the message");
+            static_cast<void>(format);
+            return detail::text_export::polymorphic_writers<TAllMessages, TMsgBase, TFormat>::write(msg, out);
+        }
+
+        /// @brief Statistics of the @ref parallel_text_exporter run.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        struct text_export_statistics {
+            std::size_t bytes = 0U;       ///< Number of consumed input bytes.
+            std::size_t messages = 0U;    ///< Number of exported messages.
+            std::size_t unknown = 0U;     ///< Number of decoded messages of unknown type.
+            std::size_t errors = 0U;      ///< Number of bytes skipped due to protocol errors.
+        };
+
+        /// @brief Multithreaded exporter of the captured binary data into text.
+        /// @details The input is provided as a list of chunks, each chunk must start
+        ///     at the frame boundary. The chunks are distributed among the worker
+        ///     threads, each of which decodes its chunks using its own instance of
+        ///     the protocol stack and writes the text into the output buffer
+        ///     dedicated to the chunk. The output buffers are kept between the runs,
+        ///     concatenation of them in the chunk order produces the same text as
+        ///     the single threaded export.@n
+        ///     Frames that fail to be decoded are skipped byte by byte until the
+        ///     next valid frame is found, incomplete frame at the end of the chunk is ignored.
+        /// @tparam TStack Type of the protocol stack, must be default constructible.
+        /// @tparam TFormat Output format, either @ref csv_text_format or @ref json_text_format.
+        /// @headerfile nil/network/marshalling/text_exporter.h
+        template<typename TStack, typename TFormat>
+        class parallel_text_exporter {
+        public:
+            /// @brief Type of the protocol stack.
+            using stack_type = TStack;
+
+            /// @brief Type of the output format.
+            using format_type = TFormat;
+
+            /// @brief All the messages supported by the protocol stack.
+            using all_messages_type = typename stack_type::all_messages_type;
+
+            /// @brief Constructor
+            /// @param[in] threads Number of worker threads, hardware concurrency is used when 0.
+            /// @param[in] bufferCapacity Initial capacity of every output buffer.
+            explicit parallel_text_exporter(std::size_t threads = 0U,
+                                            std::size_t bufferCapacity = text_buffer::default_capacity) :
+                threads_((threads == 0U) ? std::max(1U, std::thread::hardware_concurrency()) : threads),
+                bufferCapacity_(bufferCapacity), stacks_(threads_) {
+            }
+
+            /// @brief Number of worker threads.
+            std::size_t threads() const {
+                return threads_;
+            }
+
+            /// @brief Export the chunks of input data.
+            /// @tparam TIter Random access iterator type accepted by the protocol stack.
+            /// @param[in] chunks List of pairs of the chunk beginning and the chunk size.
+            /// @return Accumulated statistics of the run.
+            template<typename TIter>
+            text_export_statistics run(const std::vector<std::pair<TIter, std::size_t>> &chunks) {
+                while (outputs_.size() < chunks.size()) {
+                    outputs_.emplace_back(bufferCapacity_);
+                }
+
+                std::atomic<std::size_t> nextChunk(0U);
+                std::vector<text_export_statistics> stats(threads_);
+                auto workersCount = std::min(threads_, chunks.size());
+                std::vector<std::thread> workers;
+                workers.reserve(workersCount);
+                for (std::size_t idx = 0U; idx < workersCount; ++idx) {
+                    workers.emplace_back([this, idx, &chunks, &nextChunk, &stats]() {
+                        while (true) {
+                            auto chunkIdx = nextChunk.fetch_add(1U, std::memory_order_relaxed);
+                            if (chunks.size() <= chunkIdx) {
+                                break;
+                            }
+
+                            export_chunk(stacks_[idx], chunks[chunkIdx].first, chunks[chunkIdx].second,
+                                         outputs_[chunkIdx], stats[idx]);
+                        }
+                    });
+                }
+
+                for (auto &w : workers) {
+                    w.join();
+                }
+
+                text_export_statistics result;
+                for (auto &s : stats) {
+                    result.bytes += s.bytes;
+                    result.messages += s.messages;
+                    result.unknown += s.unknown;
+                    result.errors += s.errors;
+                }
+                return result;
+            }
+
+            /// @brief Access to the output of the chunk produced by the last @ref run().
+            const text_buffer &output(std::size_t chunkIdx) const {
+                return outputs_[chunkIdx];
+            }
+
+            /// @brief Export single chunk in the calling thread.
+            template<typename TIter>
+            static void export_chunk(stack_type &stack, TIter iter, std::size_t size, text_buffer &out,
+                                     text_export_statistics &stats) {
+                out.clear();
+                auto remaining = size;
+                while (0U < remaining) {
+                    typename stack_type::msg_ptr_type msg;
+                    auto frameBegin = iter;
+                    auto es = stack.read(msg, iter, remaining);
+                    if (es == nil::marshalling::status_type::not_enough_data) {
+                        iter = frameBegin;
+                        break;
+                    }
+
+                    if (es != nil::marshalling::status_type::success) {
+                        iter = frameBegin;
+                        ++iter;
+                        --remaining;
+                        ++stats.errors;
+                        continue;
+                    }
+
+                    remaining -= static_cast<std::size_t>(std::distance(frameBegin, iter));
+                    if (write_text_polymorphic<all_messages_type>(*msg, out, format_type())) {
+                        ++stats.messages;
+                    } else {
+                        ++stats.unknown;
+                    }
+                }
+                stats.bytes += (size - remaining);
+            }
+
+        private:
+            std::size_t threads_;
+            std::size_t bufferCapacity_;
+            std::vector<stack_type> stacks_;
+            std::vector<text_buffer> outputs_;
+        };
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_TEXT_EXPORTER_HPP
@@ -0,0 +1,335 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of the optional tracing of the read, write and dispatch paths.
+
+#ifndef NETWORK_MARSHALLING_TRACE_HPP
+#define NETWORK_MARSHALLING_TRACE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#ifndef MARSHALLING_TRACE_RING_CAPACITY
+/// @brief Number of the spans retained per thread.
+#define MARSHALLING_TRACE_RING_CAPACITY 16384
+#endif
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Recorded span.
+        /// @headerfile nil/network/marshalling/trace.h
+        struct trace_event {
+            const char *name;       ///< Name of the span, must be a string literal.
+            std::uint64_t begin;    ///< Start time, nanoseconds of steady clock.
+            std::uint64_t end;      ///< End time, nanoseconds of steady clock.
+        };
+
+        /// @brief Per-thread ring of the recorded spans.
+        /// @details Written only by the owning thread, can be read concurrently
+        ///     by any other thread. Neither reading nor writing takes a lock,
+        ///     the oldest spans are overwritten when the ring is full. Every slot
+        ///     carries a sequence number, which is odd while the slot is being
+        ///     written, the reader drops the slots, which sequence number changed
+        ///     during the copy or doesn't match the expected span.
+        /// @tparam TCapacity Number of the retained spans.
+        /// @headerfile nil/network/marshalling/trace.h
+        template<std::size_t TCapacity>
+        class trace_ring {
+            static_assert(0U < TCapacity, "Capacity must be positive");
+
+        public:
+            /// @brief Constructor
+            /// @param[in] id Identifier of the owning thread reported in the dump.
+            explicit trace_ring(std::uint32_t id) : id_(id) {
+                for (auto &entry : slots_) {
+                    entry.seq_.store(0U, std::memory_order_relaxed);
+                }
+            }
+
+            /// @brief Identifier of the owning thread.
+            std::uint32_t id() const {
+                return id_;
+            }
+
+            /// @brief Record the span, must be called by the owning thread only.
+            void push(const char *name, std::uint64_t begin, std::uint64_t end) {
+                auto head = head_.load(std::memory_order_relaxed);
+                auto &entry = slots_[static_cast<std::size_t>(head % TCapacity)];
+                auto seq = complete_seq(head);
+                entry.seq_.store(seq - 1U, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                entry.name_.store(name, std::memory_order_relaxed);
+                entry.begin_.store(begin, std::memory_order_relaxed);
+                entry.end_.store(end, std::memory_order_relaxed);
+                entry.seq_.store(seq, std::memory_order_release);
+                head_.store(head + 1U, std::memory_order_release);
+            }
+
+            /// @brief Copy the retained spans, can be called by any thread.
+            /// @details The spans overwritten by the owning thread during the
+            ///     copy are dropped.
+            void collect(std::vector<trace_event> &events) const {
+                auto head = head_.load(std::memory_order_acquire);
+                for (auto idx = first_index(head); idx < head; ++idx) {
+                    auto &entry = slots_[static_cast<std::size_t>(idx % TCapacity)];
+                    auto seq = entry.seq_.load(std::memory_order_acquire);
+                    trace_event event = {entry.name_.load(std::memory_order_relaxed),
+                                         entry.begin_.load(std::memory_order_relaxed),
+                                         entry.end_.load(std::memory_order_relaxed)};
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if ((seq != complete_seq(idx)) || (entry.seq_.load(std::memory_order_relaxed) != seq)) {
+                        continue;
+                    }
+
+                    events.push_back(event);
+                }
+            }
+
+            /// @brief Drop all the recorded spans, can be called by any thread.
+            void clear() {
+                cleared_.store(head_.load(std::memory_order_acquire), std::memory_order_relaxed);
+            }
+
+        private:
+            struct slot {
+                std::atomic<std::uint64_t> seq_;
+                std::atomic<const char *> name_;
+                std::atomic<std::uint64_t> begin_;
+                std::atomic<std::uint64_t> end_;
+            };
+
+            static std::uint64_t complete_seq(std::uint64_t idx) {
+                return (idx + 1U) * 2U;
+            }
+
+            std::uint64_t first_index(std::uint64_t head) const {
+                auto first = (TCapacity < head) ? (head - TCapacity) : 0U;
+                auto cleared = cleared_.load(std::memory_order_relaxed);
+                return (first < cleared) ? cleared : first;
+            }
+
+            std::array<slot, TCapacity> slots_;
+            std::atomic<std::uint64_t> head_ {0U};
+            std::atomic<std::uint64_t> cleared_ {0U};
+            std::uint32_t id_;
+        };
+
+        /// @brief Registry of the per-thread rings.
+        /// @details The rings are registered lock-free on the first span recorded by
+        ///     the thread. The ownership of the ring is shared by the registry and
+        ///     the thread, so the spans of the finished threads are still reported
+        ///     by the dump, while the threads still running at the destruction of
+        ///     the registry keep recording into their rings.
+        /// @headerfile nil/network/marshalling/trace.h
+        class trace_registry {
+        public:
+            /// @brief Type of the per-thread ring.
+            using ring_type = trace_ring<MARSHALLING_TRACE_RING_CAPACITY>;
+
+            /// @brief Shared pointer to the per-thread ring.
+            using ring_ptr_type = std::shared_ptr<ring_type>;
+
+            /// @brief Destructor, releases the registry's ownership of the rings.
+            ~trace_registry() {
+                auto *node = head_.load(std::memory_order_acquire);
+                while (node != nullptr) {
+                    auto *next = node->next_;
+                    delete node;
+                    node = next;
+                }
+            }
+
+            /// @brief Access the global registry.
+            static trace_registry &instance() {
+                static trace_registry registry;
+                return registry;
+            }
+
+            /// @brief Access the ring of the calling thread.
+            static ring_type &thread_ring() {
+                static thread_local ring_ptr_type ring = instance().create_ring();
+                return *ring;
+            }
+
+            /// @brief Check whether the recording is enabled.
+            bool is_enabled() const {
+                return enabled_.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Enable or disable the recording at runtime.
+            void enable(bool value = true) {
+                enabled_.store(value, std::memory_order_relaxed);
+            }
+
+            /// @brief Drop all the recorded spans.
+            void clear() {
+                for (auto *node = head_.load(std::memory_order_acquire); node != nullptr; node = node->next_) {
+                    node->ring_->clear();
+                }
+            }
+
+            /// @brief Dump all the recorded spans as Chrome trace JSON.
+            /// @details The output can be loaded by @b chrome://tracing or @b Perfetto UI.
+            void write_chrome_trace(std::ostream &out) const {
+                out << "{\"traceEvents\":[";
+                bool first = true;
+                std::vector<trace_event> events;
+                for (auto *node = head_.load(std::memory_order_acquire); node != nullptr; node = node->next_) {
+                    auto &ring = *node->ring_;
+                    events.clear();
+                    ring.collect(events);
+                    for (auto &event : events) {
+                        if (!first) {
+                            out << ',';
+                        }
+                        first = false;
+                        out << "\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring.id()
+                            << ",\"ts\":";
+                        write_micros(out, event.begin);
+                        out << ",\"dur\":";
+                        write_micros(out, event.end - event.begin);
+                        out << '}';
+                    }
+                }
+                out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+            }
+
+            /// @brief Current time used for the spans, nanoseconds of steady clock.
+            static std::uint64_t now() {
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                      std::chrono::steady_clock::now().time_since_epoch())
+                                                      .count());
+            }
+
+        private:
+            trace_registry() = default;
+
+            struct ring_node {
+                ring_ptr_type ring_;
+                ring_node *next_;
+            };
+
+            ring_ptr_type create_ring() {
+                auto ring = std::make_shared<ring_type>(nextId_.fetch_add(1U, std::memory_order_relaxed));
+                auto *node = new ring_node {ring, head_.load(std::memory_order_relaxed)};
+                while (!head_.compare_exchange_weak(node->next_, node, std::memory_order_release,
+                                                    std::memory_order_relaxed)) {
+                }
+                return ring;
+            }
+
+            static void write_micros(std::ostream &out, std::uint64_t nanos) {
+                auto fraction = static_cast<unsigned>(nanos % 1000U);
+                out << (nanos / 1000U) << '.' << static_cast<char>('0' + (fraction / 100U))
+                    << static_cast<char>('0' + ((fraction / 10U) % 10U)) << static_cast<char>('0' + (fraction % 10U));
+            }
+
+            std::atomic<ring_node *> head_ {nullptr};
+            std::atomic<std::uint32_t> nextId_ {1U};
+            std::atomic<bool> enabled_ {true};
+        };
+
+        /// @brief RAII span recorder.
+        /// @details Records the span from construction till destruction into the
+        ///     ring of the calling thread, unless the recording is disabled at runtime.
+        ///     The ring is acquired by the constructor, so the destructor never allocates.
+        ///     Normally used via MARSHALLING_TRACE_SPAN() macro.
+        /// @headerfile nil/network/marshalling/trace.h
+        class trace_span {
+        public:
+            /// @brief Constructor
+            /// @param[in] name Name of the span, must be a string literal.
+            explicit trace_span(const char *name) :
+                ring_(trace_registry::instance().is_enabled() ? &trace_registry::thread_ring() : nullptr),
+                name_(name), begin_((ring_ != nullptr) ? trace_registry::now() : 0U) {
+            }
+
+            /// @brief Copy constructor is deleted.
+            trace_span(const trace_span &) = delete;
+
+            /// @brief Destructor, records the span.
+            ~trace_span() noexcept {
+                if (ring_ != nullptr) {
+                    ring_->push(name_, begin_, trace_registry::now());
+                }
+            }
+
+        private:
+            trace_registry::ring_type *ring_;
+            const char *name_;
+            std::uint64_t begin_;
+        };
+
+        namespace detail {
+
+            template<typename T, typename = void>
+            struct has_trace_name : public std::false_type { };
+
+            template<typename T>
+            struct has_trace_name<T, typename std::conditional<false, decltype(T::trace_name()), void>::type>
+                : public std::true_type { };
+
+            template<typename T>
+            constexpr const char *trace_name_internal(std::true_type) {
+                return T::trace_name();
+            }
+
+            template<typename T>
+            constexpr const char *trace_name_internal(std::false_type) {
+                return "protocol_layer";
+            }
+
+        }    // namespace detail
+
+        /// @brief Name of the span recorded for the object of the provided type.
+        /// @details Returns @b T::trace_name() if such static function exists,
+        ///     "protocol_layer" otherwise.
+        /// @headerfile nil/network/marshalling/trace.h
+        template<typename T>
+        constexpr const char *trace_name() {
+            return detail::trace_name_internal<T>(detail::has_trace_name<T>());
+        }
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#ifdef MARSHALLING_TRACING
+/// @brief Record the span till the end of the current scope.
+/// @details Compiled out unless MARSHALLING_TRACING is defined.
+#define MARSHALLING_TRACE_SPAN(name_) nil::marshalling::trace_span marshallingTraceSpan_(name_)
+#else
+#define MARSHALLING_TRACE_SPAN(name_)
+#endif
+
+#endif    // NETWORK_MARSHALLING_TRACE_HPP
@@ -0,0 +1,769 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+/// @file
+/// Contains definition of the traffic generation and replay facilities used
+///     to load test the consumers of the protocol.
+
+#ifndef NETWORK_MARSHALLING_TRAFFIC_HPP
+#define NETWORK_MARSHALLING_TRAFFIC_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <new>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/processing/tuple.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MARSHALLING_TRAFFIC_HAS_POSIX 1
+#else
+#define MARSHALLING_TRAFFIC_HAS_POSIX 0
+#endif
+
+namespace nil {
+    namespace marshalling {
+
+        /// @brief Fast pseudo random generator (xorshift64*) used to synthesise the traffic.
+        /// @headerfile nil/network/marshalling/traffic.h
+        class traffic_random {
+        public:
+            /// @brief Constructor
+            /// @param[in] seed Non-zero seed value.
+            explicit traffic_random(std::uint64_t seed = 0x9e3779b97f4a7c15ULL) : state_(seed != 0U ? seed : 1U) {
+            }
+
+            /// @brief Generate next value.
+            std::uint64_t operator()() {
+                state_ ^= state_ >> 12U;
+                state_ ^= state_ << 25U;
+                state_ ^= state_ >> 27U;
+                return state_ * 0x2545f4914f6cdd1dULL;
+            }
+
+            /// @brief Generate value in [0, 1) range.
+            double uniform() {
+                return static_cast<double>((*this)() >> 11U) * (1.0 / 9007199254740992.0);
+            }
+
+        private:
+            std::uint64_t state_;
+        };
+
+        namespace detail {
+
+            namespace traffic {
+
+                template<typename T, typename = void>
+                struct has_value_type : public std::false_type { };
+
+                template<typename T>
+                struct has_value_type<T, typename std::conditional<false, typename T::value_type, void>::type>
+                    : public std::true_type { };
+
+                template<typename TField, bool THasValueType = has_value_type<TField>::value>
+                struct field_value_kind {
+                    using value_type = void;
+                };
+
+                template<typename TField>
+                struct field_value_kind<TField, true> {
+                    using value_type = typename TField::value_type;
+                };
+
+                struct integral_value_tag { };
+                struct floating_value_tag { };
+                struct other_value_tag { };
+
+                template<typename TField>
+                using field_value_tag = typename std::conditional<
+                    std::is_integral<typename field_value_kind<TField>::value_type>::value
+                        && (!std::is_same<typename field_value_kind<TField>::value_type, bool>::value),
+                    integral_value_tag,
+                    typename std::conditional<
+                        std::is_floating_point<typename field_value_kind<TField>::value_type>::value,
+                        floating_value_tag, other_value_tag>::type>::type;
+
+                class field_randomizer {
+                public:
+                    explicit field_randomizer(traffic_random &rand) : rand_(rand) {
+                    }
+
+                    template<typename TField>
+                    void operator()(TField &field) const {
+                        randomize(field, field_value_tag<TField>());
+                    }
+
+                private:
+                    template<typename TField>
+                    void randomize(TField &field, integral_value_tag) const {
+                        using value_type = typename TField::value_type;
+                        field.value() = static_cast<value_type>(rand_());
+                    }
+
+                    template<typename TField>
+                    void randomize(TField &field, floating_value_tag) const {
+                        using value_type = typename TField::value_type;
+                        field.value() = static_cast<value_type>(rand_.uniform() * 1000000.0);
+                    }
+
+                    template<typename TField>
+                    void randomize(TField &field, other_value_tag) const {
+                        static_cast<void>(field);
+                    }
+
+                    traffic_random &rand_;
+                };
+
+                template<typename TAllMessages, std::size_t TIdx = 0U,
+                         bool TEnd = (TIdx == std::tuple_size<TAllMessages>::value)>
+                struct mix_writer {
+                    template<typename TStack, typename TPool>
+                    static status_type write(std::size_t idx, TStack &stack, TPool &pool, traffic_random &rand) {
+                        if (idx != TIdx) {
+                            return mix_writer<TAllMessages, TIdx + 1U>::write(idx, stack, pool, rand);
+                        }
+
+                        typename std::tuple_element<TIdx, TAllMessages>::type msg;
+                        randomize_fields(msg, rand);
+                        return pool.append(stack, msg);
+                    }
+                };
+
+                template<typename TAllMessages, std::size_t TIdx>
+                struct mix_writer<TAllMessages, TIdx, true> {
+                    template<typename TStack, typename TPool>
+                    static status_type write(std::size_t, TStack &, TPool &, traffic_random &) {
+                        return status_type::invalid_msg_id;
+                    }
+                };
+
+                inline std::uint64_t now_ns() {
+                    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                          std::chrono::steady_clock::now().time_since_epoch())
+                                                          .count());
+                }
+
+            }    // namespace traffic
+
+        }    // namespace detail
+
+        /// @brief Assign random values to the integral and floating point fields of the message.
+        /// @details Other fields (enums, strings, lists, bundles, etc...) keep their
+        ///     default values. The values may violate the valid ranges of the fields.
+        /// @headerfile nil/network/marshalling/traffic.h
+        template<typename TMsg>
+        void randomize_fields(TMsg &msg, traffic_random &rand) {
+            processing::tuple_for_each(msg.fields(), detail::traffic::field_randomizer(rand));
+        }
+
+        /// @brief Contiguous storage of the pre-encoded frames.
+        /// @details The frames are serialized once, prior to the timed run, so the
+        ///     encoding cost does not affect the generated traffic.
+        /// @headerfile nil/network/marshalling/traffic.h
+        class frame_pool {
+        public:
+            /// @brief Serialize the message using the protocol stack and append the frame.
+            /// @details The write iterator of the message interface must be a pointer to byte.
+            template<typename TStack, typename TMsg>
+            status_type append(TStack &stack, const TMsg &msg) {
+                using iter_type = typename TMsg::write_iterator;
+                static_assert(std::is_pointer<iter_type>::value
+                                  && (sizeof(typename std::remove_pointer<iter_type>::type) == sizeof(std::uint8_t)),
+                              "Write iterator must be a pointer to byte");
+
+                auto len = stack.length(msg);
+                auto offset = data_.size();
+                data_.resize(offset + len);
+                auto iter = reinterpret_cast<iter_type>(&data_[offset]);
+                auto es = stack.write(msg, iter, len);
+                if (es != status_type::success) {
+                    data_.resize(offset);
+                    return es;
+                }
+
+                auto written = static_cast<std::size_t>(iter - reinterpret_cast<iter_type>(&data_[offset]));
+                data_.resize(offset + written);
+                offsets_.push_back(offset);
+                return status_type::success;
+            }
+
+            /// @brief Append raw frame.
+            void append(const std::uint8_t *data, std::size_t len) {
+                offsets_.push_back(data_.size());
+                data_.insert(data_.end(), data, data + len);
+            }
+
+            /// @brief Number of frames.
+            std::size_t size() const {
+                return offsets_.size();
+            }
+
+            /// @brief Check whether the pool is empty.
+            bool empty() const {
+                return offsets_.empty();
+            }
+
+            /// @brief Access the frame contents.
+            const std::uint8_t *data(std::size_t idx) const {
+                return data_.data() + offsets_[idx];
+            }
+
+            /// @brief Length of the frame.
+            std::size_t length(std::size_t idx) const {
+                auto end = ((idx + 1U) < offsets_.size()) ? offsets_[idx + 1U] : data_.size();
+                return end - offsets_[idx];
+            }
+
+            /// @brief Total length of all the frames.
+            std::size_t total_length() const {
+                return data_.size();
+            }
+
+            /// @brief Remove all the frames.
+            void clear() {
+                data_.clear();
+                offsets_.clear();
+            }
+
+        private:
+            std::vector<std::uint8_t> data_;
+            std::vector<std::size_t> offsets_;
+        };
+
+        /// @brief Synthesise the frames of the configurable message mix.
+        /// @details Every frame contains the message randomly selected according to
+        ///     the weights, with randomized field values (see @ref randomize_fields()).
+        /// @tparam TAllMessages All the message types in std::tuple.
+        /// @param[in] stack Protocol stack used to serialize the messages.
+        /// @param[out] pool Pool to append the frames to.
+        /// @param[in] count Number of frames to synthesise.
+        /// @param[in] weights Relative weights of the message types, in the order of
+        ///     @b TAllMessages, empty means equal weights.
+        /// @param[in] rand Random generator.
+        /// @return Status of the first failed write, success if all the frames are written.
+        /// @headerfile nil/network/marshalling/traffic.h
+        template<typename TAllMessages, typename TStack>
+        status_type synthesise_frames(TStack &stack, frame_pool &pool, std::size_t count,
+                                      const std::vector<double> &weights, traffic_random &rand) {
+            static const std::size_t MessagesCount = std::tuple_size<TAllMessages>::value;
+            std::array<double, MessagesCount> cumulative;
+            double total = 0.0;
+            for (std::size_t idx = 0U; idx < MessagesCount; ++idx) {
+                total += weights.empty() ? 1.0 : ((idx < weights.size()) ? weights[idx] : 0.0);
+                cumulative[idx] = total;
+            }
+
+            if (total <= 0.0) {
+                return status_type::protocol_error;
+            }
+
+            for (std::size_t frame = 0U; frame < count; ++frame) {
+                auto point = rand.uniform() * total;
+                auto msgIdx = static_cast<std::size_t>(
+                    std::distance(cumulative.begin(), std::upper_bound(cumulative.begin(), cumulative.end(), point)));
+                msgIdx = std::min(msgIdx, MessagesCount - 1U);
+                auto es = detail::traffic::mix_writer<TAllMessages>::write(msgIdx, stack, pool, rand);
+                if (es != status_type::success) {
+                    return es;
+                }
+            }
+
+            return status_type::success;
+        }
+
+        /// @brief Recorded frames with their capture timestamps.
+        /// @details Serialized as a sequence of records, each containing 8 bytes
+        ///     timestamp (nanoseconds), 4 bytes length (both little endian)
+        ///     and the frame contents.
+        /// @headerfile nil/network/marshalling/traffic.h
+        struct frame_capture {
+            frame_pool frames;                     ///< Captured frames.
+            std::vector<std::uint64_t> times;    ///< Capture timestamps in nanoseconds.
+
+            /// @brief Append the frame.
+            void append(std::uint64_t time, const std::uint8_t *data, std::size_t len) {
+                frames.append(data, len);
+                times.push_back(time);
+            }
+
+            /// @brief Write all the frames to the stream.
+            void save(std::ostream &out) const {
+                for (std::size_t idx = 0U; idx < frames.size(); ++idx) {
+                    std::uint8_t hdr[12];
+                    put_le(&hdr[0], times[idx], 8U);
+                    put_le(&hdr[8], frames.length(idx), 4U);
+                    out.write(reinterpret_cast<const char *>(&hdr[0]), sizeof(hdr));
+                    out.write(reinterpret_cast<const char *>(frames.data(idx)),
+                              static_cast<std::streamsize>(frames.length(idx)));
+                }
+            }
+
+            /// @brief Read the frames from the stream and append them.
+            /// @return false if the stream contains truncated record.
+            bool load(std::istream &in) {
+                std::vector<std::uint8_t> frame;
+                while (true) {
+                    std::uint8_t hdr[12];
+                    in.read(reinterpret_cast<char *>(&hdr[0]), sizeof(hdr));
+                    if (in.gcount() == 0) {
+                        return true;
+                    }
+
+                    if (in.gcount() != static_cast<std::streamsize>(sizeof(hdr))) {
+                        return false;
+                    }
+
+                    auto len = static_cast<std::size_t>(get_le(&hdr[8], 4U));
+                    frame.resize(len);
+                    in.read(reinterpret_cast<char *>(frame.data()), static_cast<std::streamsize>(len));
+                    if (in.gcount() != static_cast<std::streamsize>(len)) {
+                        return false;
+                    }
+
+                    append(get_le(&hdr[0], 8U), frame.data(), len);
+                }
+            }
+
+        private:
+            static void put_le(std::uint8_t *out, std::uint64_t value, std::size_t len) {
+                for (std::size_t idx = 0U; idx < len; ++idx) {
+                    out[idx] = static_cast<std::uint8_t>(value >> (8U * idx));
+                }
+            }
+
+            static std::uint64_t get_le(const std::uint8_t *in, std::size_t len) {
+                std::uint64_t value = 0U;
+                for (std::size_t idx = 0U; idx < len; ++idx) {
+                    value |= static_cast<std::uint64_t>(in[idx]) << (8U * idx);
+                }
+                return value;
+            }
+        };
+
+        /// @brief Single producer single consumer ring of frames residing in the
+        ///     externally provided memory, such as shared memory region.
+        /// @details Every frame occupies 8 bytes header and its contents padded to
+        ///     8 bytes. The memory must be 64 bytes aligned.
+        /// @headerfile nil/network/marshalling/traffic.h
+        class spsc_frame_ring {
+            struct header_type {
+                std::atomic<std::uint64_t> head_;
+                char headPad_[64U - sizeof(std::atomic<std::uint64_t>)];
+                std::atomic<std::uint64_t> tail_;
+                char tailPad_[64U - sizeof(std::atomic<std::uint64_t>)];
+                std::uint64_t capacity_;
+            };
+
+            static const std::uint32_t WrapMarker = 0xffffffffU;
+            static const std::size_t RecordHeaderLength = 8U;
+
+        public:
+            /// @brief Length of the ring control header.
+            static constexpr std::size_t header_length() {
+                return (sizeof(header_type) + 63U) & ~static_cast<std::size_t>(63U);
+            }
+
+            /// @brief Initialize new ring in the provided memory.
+            /// @param[in] mem Memory region.
+            /// @param[in] len Length of the memory region.
+            static spsc_frame_ring create(void *mem, std::size_t len) {
+                auto *hdr = new (mem) header_type;
+                hdr->head_.store(0U, std::memory_order_relaxed);
+                hdr->tail_.store(0U, std::memory_order_relaxed);
+                hdr->capacity_ = (len - header_length()) & ~static_cast<std::uint64_t>(7U);
+                return spsc_frame_ring(mem);
+            }
+
+            /// @brief Attach to the ring previously initialized by @ref create().
+            static spsc_frame_ring attach(void *mem) {
+                return spsc_frame_ring(mem);
+            }
+
+            /// @brief Capacity of the ring in bytes.
+            std::size_t capacity() const {
+                return static_cast<std::size_t>(hdr_->capacity_);
+            }
+
+            /// @brief Maximal length of the frame accepted by @ref try_push().
+            /// @details The record of such frame takes at most half of the ring.
+            ///     Together with the padding skipped when wrapping around, it always fits
+            ///     into the empty ring, whatever the current position is.
+            std::size_t max_frame_length() const {
+                auto half = (hdr_->capacity_ / 2U) & ~static_cast<std::uint64_t>(7U);
+                if (half <= RecordHeaderLength) {
+                    return 0U;
+                }
+                return static_cast<std::size_t>(half - RecordHeaderLength);
+            }
+
+            /// @brief Try to push the frame, producer side.
+            /// @return false if there is not enough space or the frame is longer than
+            ///     @ref max_frame_length().
+            bool try_push(const std::uint8_t *data, std::size_t len) {
+                if (max_frame_length() < len) {
+                    return false;
+                }
+
+                auto capacity = hdr_->capacity_;
+                auto recLen = record_length(len);
+                auto head = hdr_->head_.load(std::memory_order_relaxed);
+                auto tail = hdr_->tail_.load(std::memory_order_acquire);
+                auto offset = head % capacity;
+                auto pad = ((offset + recLen) <= capacity) ? 0U : (capacity - offset);
+                if ((capacity - (head - tail)) < (pad + recLen)) {
+                    return false;
+                }
+
+                if (pad != 0U) {
+                    put_length(offset, WrapMarker);
+                    head += pad;
+                    offset = 0U;
+                }
+
+                put_length(offset, static_cast<std::uint32_t>(len));
+                std::memcpy(data_ + offset + RecordHeaderLength, data, len);
+                hdr_->head_.store(head + recLen, std::memory_order_release);
+                return true;
+            }
+
+            /// @brief Try to pop the frame, consumer side.
+            /// @details The functor is invoked with (const std::uint8_t* data, std::size_t len)
+            ///     parameters, the data is valid only during the call.
+            /// @return false if the ring is empty.
+            template<typename TFunc>
+            bool try_pop(TFunc &&func) {
+                auto capacity = hdr_->capacity_;
+                auto tail = hdr_->tail_.load(std::memory_order_relaxed);
+                auto head = hdr_->head_.load(std::memory_order_acquire);
+                if (tail == head) {
+                    return false;
+                }
+
+                auto offset = tail % capacity;
+                auto len = get_length(offset);
+                if (len == WrapMarker) {
+                    tail += capacity - offset;
+                    offset = 0U;
+                    len = get_length(offset);
+                }
+
+                func(static_cast<const std::uint8_t *>(data_ + offset + RecordHeaderLength),
+                     static_cast<std::size_t>(len));
+                hdr_->tail_.store(tail + record_length(len), std::memory_order_release);
+                return true;
+            }
+
+        private:
+            explicit spsc_frame_ring(void *mem) :
+                hdr_(static_cast<header_type *>(mem)), data_(static_cast<std::uint8_t *>(mem) + header_length()) {
+            }
+
+            static std::uint64_t record_length(std::size_t len) {
+                return (RecordHeaderLength + len + 7U) & ~static_cast<std::uint64_t>(7U);
+            }
+
+            void put_length(std::uint64_t offset, std::uint32_t len) {
+                std::memcpy(data_ + offset, &len, sizeof(len));
+            }
+
+            std::uint32_t get_length(std::uint64_t offset) const {
+                std::uint32_t len = 0U;
+                std::memcpy(&len, data_ + offset, sizeof(len));
+                return len;
+            }
+
+            header_type *hdr_;
+            std::uint8_t *data_;
+        };
+
+        /// @brief Sink writing the frames into @ref spsc_frame_ring.
+        /// @details Spins while the ring is full, the number of such spins is reported.
+        /// @headerfile nil/network/marshalling/traffic.h
+        class ring_sink {
+        public:
+            /// @brief Constructor
+            explicit ring_sink(spsc_frame_ring ring) : ring_(ring) {
+            }
+
+            /// @brief Write the frame.
+            /// @return false if the frame is longer than @ref spsc_frame_ring::max_frame_length().
+            bool write(const std::uint8_t *data, std::size_t len) {
+                if (ring_.max_frame_length() < len) {
+                    return false;
+                }
+
+                while (!ring_.try_push(data, len)) {
+                    ++stalls_;
+                }
+                return true;
+            }
+
+            /// @brief Number of spins due to the full ring.
+            std::uint64_t stalls() const {
+                return stalls_;
+            }
+
+        private:
+            spsc_frame_ring ring_;
+            std::uint64_t stalls_ = 0U;
+        };
+
+#if MARSHALLING_TRAFFIC_HAS_POSIX
+
+        /// @brief Sink writing the frames into file descriptor, such as pipe,
+        ///     socket (pair) or regular file.
+        /// @headerfile nil/network/marshalling/traffic.h
+        class fd_sink {
+        public:
+            /// @brief Constructor
+            /// @param[in] fd File descriptor, not owned by the sink.
+            explicit fd_sink(int fd) : fd_(fd) {
+            }
+
+            /// @brief Write the frame, retrying on partial writes.
+            bool write(const std::uint8_t *data, std::size_t len) {
+                while (0U < len) {
+                    auto result = ::write(fd_, data, len);
+                    if (result < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        return false;
+                    }
+
+                    data += result;
+                    len -= static_cast<std::size_t>(result);
+                }
+                return true;
+            }
+
+        private:
+            int fd_;
+        };
+
+        /// @brief POSIX shared memory region (@b shm_open() + @b mmap()).
+        /// @headerfile nil/network/marshalling/traffic.h
+        class shared_memory_region {
+        public:
+            /// @brief Constructor, creates or opens the named region.
+            /// @param[in] name Name of the region (starting with '/').
+            /// @param[in] len Length of the region.
+            /// @param[in] create Create the region (and unlink it on destruction)
+            ///     or open the existing one.
+            shared_memory_region(const std::string &name, std::size_t len, bool create) :
+                name_(name), len_(len), owner_(create) {
+                auto fd = ::shm_open(name.c_str(), create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+                if (fd < 0) {
+                    return;
+                }
+
+                if (create && (::ftruncate(fd, static_cast<off_t>(len)) != 0)) {
+                    ::close(fd);
+                    return;
+                }
+
+                auto *mem = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (mem != MAP_FAILED) {
+                    mem_ = mem;
+                }
+            }
+
+            /// @brief Copy constructor is deleted.
+            shared_memory_region(const shared_memory_region &) = delete;
+
+            /// @brief Copy assignment is deleted.
+            shared_memory_region &operator=(const shared_memory_region &) = delete;
+
+            /// @brief Destructor
+            ~shared_memory_region() noexcept {
+                if (mem_ != nullptr) {
+                    ::munmap(mem_, len_);
+                }
+
+                if (owner_) {
+                    ::shm_unlink(name_.c_str());
+                }
+            }
+
+            /// @brief Check whether the region has been successfully mapped.
+            bool valid() const {
+                return mem_ != nullptr;
+            }
+
+            /// @brief Access the mapped memory.
+            void *data() const {
+                return mem_;
+            }
+
+            /// @brief Length of the region.
+            std::size_t length() const {
+                return len_;
+            }
+
+        private:
+            std::string name_;
+            std::size_t len_;
+            void *mem_ = nullptr;
+            bool owner_;
+        };
+
+#endif    // #if MARSHALLING_TRAFFIC_HAS_POSIX
+
+        /// @brief Report of the generated traffic.
+        /// @headerfile nil/network/marshalling/traffic.h
+        struct traffic_report {
+            std::uint64_t frames = 0;           ///< Number of written frames.
+            std::uint64_t bytes = 0;            ///< Number of written bytes.
+            std::uint64_t failures = 0;         ///< Number of failed writes.
+            double seconds = 0.0;               ///< Duration of the run.
+            double rate = 0.0;                  ///< Achieved rate, frames per second.
+            double mean_lateness_ns = 0.0;      ///< Mean delay of the frames past their schedule.
+            double max_lateness_ns = 0.0;       ///< Max delay of the frames past their schedule.
+            double jitter_ns = 0.0;             ///< Standard deviation of the inter-frame intervals.
+        };
+
+        /// @brief Paced writer of the pre-encoded frames into the sink.
+        /// @details The frames are written according to their schedule, busy
+        ///     waiting for the scheduled time, which gives precise pacing at the
+        ///     cost of the occupied CPU core. When the writer falls behind, the
+        ///     frames are written back to back until it catches up. The sink must
+        ///     define @code bool write(const std::uint8_t* data, std::size_t len); @endcode
+        /// @headerfile nil/network/marshalling/traffic.h
+        class traffic_generator {
+        public:
+            /// @brief Write @b count frames at the fixed rate, cycling over the pool.
+            /// @param[in] pool Pre-encoded frames.
+            /// @param[in] sink Sink object.
+            /// @param[in] rate Target rate in frames per second, 0 means as fast as possible.
+            /// @param[in] count Number of frames to write.
+            template<typename TSink>
+            static traffic_report run(const frame_pool &pool, TSink &sink, double rate, std::size_t count) {
+                auto period = (0.0 < rate) ? (1.0e9 / rate) : 0.0;
+                return run_internal(pool, sink, count, [period](std::size_t idx) -> double {
+                    return period * static_cast<double>(idx);
+                });
+            }
+
+            /// @brief Replay the captured frames preserving their relative timing.
+            /// @param[in] capture Captured frames.
+            /// @param[in] sink Sink object.
+            /// @param[in] speed Replay speed factor, 2.0 replays twice as fast,
+            ///     0 means as fast as possible.
+            template<typename TSink>
+            static traffic_report replay(const frame_capture &capture, TSink &sink, double speed = 1.0) {
+                if (capture.times.empty()) {
+                    return traffic_report();
+                }
+
+                auto first = capture.times.front();
+                auto &times = capture.times;
+                return run_internal(capture.frames, sink, capture.frames.size(),
+                                    [first, speed, &times](std::size_t idx) -> double {
+                                        if (speed <= 0.0) {
+                                            return 0.0;
+                                        }
+                                        auto offset = (first <= times[idx]) ? (times[idx] - first) : 0U;
+                                        return static_cast<double>(offset) / speed;
+                                    });
+            }
+
+        private:
+            template<typename TSink, typename TSchedule>
+            static traffic_report run_internal(const frame_pool &pool, TSink &sink, std::size_t count,
+                                               TSchedule &&schedule) {
+                traffic_report report;
+                if (pool.empty() || (count == 0U)) {
+                    return report;
+                }
+
+                double latenessSum = 0.0;
+                double intervalSum = 0.0;
+                double intervalSqSum = 0.0;
+                std::uint64_t prevTime = 0U;
+                auto start = detail::traffic::now_ns();
+                for (std::size_t idx = 0U; idx < count; ++idx) {
+                    auto due = start + static_cast<std::uint64_t>(schedule(idx));
+                    auto now = detail::traffic::now_ns();
+                    while (now < due) {
+                        now = detail::traffic::now_ns();
+                    }
+
+                    auto frameIdx = idx % pool.size();
+                    auto len = pool.length(frameIdx);
+                    if (sink.write(pool.data(frameIdx), len)) {
+                        ++report.frames;
+                        report.bytes += len;
+                    } else {
+                        ++report.failures;
+                    }
+
+                    auto lateness = static_cast<double>(now - due);
+                    latenessSum += lateness;
+                    report.max_lateness_ns = std::max(report.max_lateness_ns, lateness);
+                    if (idx != 0U) {
+                        auto interval = static_cast<double>(now - prevTime);
+                        intervalSum += interval;
+                        intervalSqSum += interval * interval;
+                    }
+                    prevTime = now;
+                }
+
+                auto elapsed = detail::traffic::now_ns() - start;
+                report.seconds = static_cast<double>(elapsed) / 1.0e9;
+                report.rate = (0.0 < report.seconds) ? (static_cast<double>(count) / report.seconds) : 0.0;
+                report.mean_lateness_ns = latenessSum / static_cast<double>(count);
+                if (1U < count) {
+                    auto intervals = static_cast<double>(count - 1U);
+                    auto mean = intervalSum / intervals;
+                    report.jitter_ns = std::sqrt(std::max(0.0, (intervalSqSum / intervals) - (mean * mean)));
+                }
+                return report;
+            }
+        };
+
+    }    // namespace marshalling
+}    // namespace nil
+
+#endif    // NETWORK_MARSHALLING_TRAFFIC_HPP
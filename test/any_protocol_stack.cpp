@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_any_protocol_stack_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/protocol/any_protocol_stack.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/sync_prefix_layer.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+
+typedef nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>,
+                                          nil::marshalling::option::default_num_value<0xabcd>>
+    SyncField;
+
+template<std::size_t TLen>
+using SizeField = nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<TLen>>;
+
+typedef nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>
+    IdField;
+
+template<std::size_t TSizeLen>
+using PlainStack = nil::marshalling::protocol::msg_size_layer<
+    SizeField<TSizeLen>, nil::marshalling::protocol::msg_id_layer<IdField, BeMsgBase, all_messages_type<BeMsgBase>,
+                                                                  nil::marshalling::protocol::msg_data_layer<>>>;
+
+typedef nil::marshalling::protocol::sync_prefix_layer<SyncField, PlainStack<2>> SyncStack;
+
+typedef nil::marshalling::protocol::any_protocol_stack<BeMsgBase> AnyStack;
+
+namespace {
+
+    AnyStack select_stack(const std::string &config) {
+        if (config == "sync") {
+            return nil::marshalling::protocol::make_any_protocol_stack<BeMsgBase, SyncStack>();
+        }
+
+        if (config == "size3") {
+            return nil::marshalling::protocol::make_any_protocol_stack<BeMsgBase, PlainStack<3>>();
+        }
+
+        return nil::marshalling::protocol::make_any_protocol_stack<BeMsgBase, PlainStack<2>>();
+    }
+
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(any_protocol_stack_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const char Buf[] = {static_cast<char>(0xab), static_cast<char>(0xcd), 0x0, 0x3, MessageType1, 0x01, 0x02};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    auto stack = select_stack("sync");
+    BOOST_REQUIRE(stack);
+    BOOST_CHECK_EQUAL(stack.length(), 5U);
+
+    AnyStack::msg_ptr_type msg;
+    AnyStack::read_iterator readIter = &Buf[0];
+    auto es = stack.read(msg, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK(msg->get_id() == MessageType1);
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(readIter - &Buf[0]), BufSize);
+    BOOST_CHECK_EQUAL(std::get<0>(dynamic_cast<BeMsg1 &>(*msg).fields()).value(), 0x0102);
+
+    BOOST_CHECK_EQUAL(stack.length(*msg), BufSize);
+    std::vector<char> out(BufSize);
+    AnyStack::write_iterator writeIter = &out[0];
+    es = stack.write(*msg, writeIter, out.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(std::equal(out.begin(), out.end(), &Buf[0]));
+
+    std::size_t missingSize = 0U;
+    readIter = &Buf[0];
+    es = stack.read(msg, readIter, BufSize - 1U, &missingSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK_EQUAL(missingSize, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    BeMsg1 msg;
+    std::get<0>(msg.fields()).value() = 0x0102;
+
+    auto stack = select_stack("size3");
+    BOOST_CHECK_EQUAL(stack.length(msg), 6U);
+
+    std::vector<char> out(stack.length(msg));
+    AnyStack::write_iterator writeIter = &out[0];
+    auto es = stack.write(msg, writeIter, out.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+
+    static const char Expected[] = {0x0, 0x0, 0x3, MessageType1, 0x01, 0x02};
+    BOOST_CHECK(std::equal(out.begin(), out.end(), &Expected[0]));
+
+    stack = select_stack("size2");
+    BOOST_CHECK_EQUAL(stack.length(msg), 5U);
+
+    AnyStack::msg_ptr_type readMsg;
+    AnyStack::read_iterator readIter = &Expected[1];
+    es = stack.read(readMsg, readIter, 5U);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE(readMsg);
+    BOOST_CHECK(readMsg->get_id() == MessageType1);
+
+    auto &concrete = stack.stack<PlainStack<2>>();
+    BOOST_CHECK_EQUAL(concrete.length(msg), 5U);
+
+    stack.reset();
+    BOOST_CHECK(!stack.valid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
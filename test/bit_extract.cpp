@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_bit_extract_test
+
+#include "test_common.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <nil/marshalling/types/bitfield.hpp>
+#include <nil/marshalling/types/bitmask_value.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/bit_extract.hpp>
+
+typedef nil::marshalling::field_type<nil::marshalling::option::big_endian> BeField;
+
+using StatusLayout = nil::marshalling::bitfield_layout<1, 1, 2, 3, 1, 1, 1, 4, 1, 1, 8, 2, 1, 1, 5, 3, 1, 1, 6, 12>;
+using FlagsLayout = nil::marshalling::bitmask_layout<0, 2, 3, 7, 9, 10, 11, 12, 30, 63>;
+using WideLayout = nil::marshalling::bitfield_layout<12, 20, 32>;
+using SplitLayout = nil::marshalling::bitfield_layout<24, 40>;
+
+template<typename TLayout>
+void check_word(std::uint64_t word) {
+    std::array<typename TLayout::lane_type, TLayout::members_count> bulk;
+    std::array<typename TLayout::lane_type, TLayout::members_count> each;
+    TLayout::extract(word, &bulk[0]);
+    TLayout::extract_each(word, &each[0]);
+    BOOST_CHECK(bulk == each);
+    BOOST_CHECK_EQUAL(TLayout::deposit(&bulk[0], word), word);
+    BOOST_CHECK_EQUAL(TLayout::deposit(&bulk[0], ~word), TLayout::deposit_each(&each[0], ~word));
+    BOOST_CHECK_EQUAL(TLayout::deposit(&bulk[0]), word & TLayout::mask());
+}
+
+BOOST_AUTO_TEST_SUITE(bit_extract_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static_assert(StatusLayout::members_count == 20U, "Invalid members count");
+    static_assert(sizeof(StatusLayout::lane_type) == sizeof(std::uint16_t), "Invalid lane type");
+    static_assert(StatusLayout::groups_count == 5U, "Invalid groups count");
+    static_assert(StatusLayout::mask() == 0xffffffffffffffULL, "Invalid mask");
+    static_assert(StatusLayout::member_type<10>::offset == 16U, "Invalid offset");
+    static_assert(StatusLayout::group_mask<0>() == 0x7fULL, "Invalid group mask");
+    static_assert(StatusLayout::group_lanes_mask<0>() == 0x0007000300010001ULL, "Invalid lanes mask");
+
+    std::uint64_t word = 0x0123456789abcdefULL;
+    BOOST_CHECK_EQUAL(StatusLayout::get<0>(word), 1U);
+    BOOST_CHECK_EQUAL(StatusLayout::get<2>(word), 3U);
+    BOOST_CHECK_EQUAL(StatusLayout::get<10>(word), 0xabU);
+    BOOST_CHECK_EQUAL(StatusLayout::get<19>(word), 0x234U);
+    BOOST_CHECK_EQUAL(StatusLayout::set<10>(word, 0x1ff), 0x0123456789ffcdefULL);
+
+    for (std::uint64_t idx = 0U; idx < 1000U; ++idx) {
+        word = word * 6364136223846793005ULL + 1442695040888963407ULL;
+        check_word<StatusLayout>(word);
+        check_word<FlagsLayout>(word);
+        check_word<WideLayout>(word);
+        check_word<SplitLayout>(word);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    static_assert(sizeof(FlagsLayout::lane_type) == sizeof(std::uint8_t), "Invalid lane type");
+    static_assert(FlagsLayout::groups_count == 2U, "Invalid groups count");
+
+    std::array<std::uint8_t, FlagsLayout::members_count> bits;
+    FlagsLayout::extract(0x8000000000000a05ULL, &bits[0]);
+    static const std::array<std::uint8_t, FlagsLayout::members_count> expected = {{1, 1, 0, 0, 1, 0, 1, 0, 0, 1}};
+    BOOST_CHECK(bits == expected);
+
+    BOOST_CHECK_EQUAL(nil::marshalling::bits_extract(0xf0f0U, 0xff00U), 0xf0U);
+    BOOST_CHECK_EQUAL(nil::marshalling::bits_deposit(0xf0U, 0xff00U), 0xf000U);
+
+    static_assert(sizeof(SplitLayout::lane_type) == sizeof(std::uint64_t), "Invalid lane type");
+    static_assert(SplitLayout::group_lanes_mask<1>() == 0xffffffffffULL, "Invalid lanes mask");
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    typedef nil::marshalling::types::bitmask_value<BeField, nil::marshalling::option::fixed_length<2>> Mask;
+    using MaskLayout = nil::marshalling::bitmask_layout_of<Mask>;
+    static_assert(MaskLayout::members_count == 16U, "Invalid members count");
+
+    Mask field;
+    field.value() = 0x8021;
+
+    std::array<std::uint8_t, MaskLayout::members_count> bits;
+    MaskLayout::extract(field.value(), &bits[0]);
+    BOOST_CHECK_EQUAL(bits[0], 1U);
+    BOOST_CHECK_EQUAL(bits[1], 0U);
+    BOOST_CHECK_EQUAL(bits[5], 1U);
+    BOOST_CHECK_EQUAL(bits[15], 1U);
+
+    bits[1] = 1U;
+    bits[15] = 0U;
+    field.value() = static_cast<Mask::value_type>(MaskLayout::deposit(&bits[0], field.value()));
+    BOOST_CHECK_EQUAL(field.value(), 0x23U);
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    typedef nil::marshalling::types::integral<BeField, std::uint8_t, nil::marshalling::option::fixed_bit_length<4>>
+        Member1;
+    typedef nil::marshalling::types::integral<BeField, std::uint8_t, nil::marshalling::option::fixed_bit_length<3>>
+        Member2;
+    typedef nil::marshalling::types::integral<BeField, std::uint16_t, nil::marshalling::option::fixed_bit_length<9>>
+        Member3;
+    typedef nil::marshalling::types::bitfield<BeField, std::tuple<Member1, Member2, Member3>> Field;
+    using FieldLayout = nil::marshalling::bitfield_layout_of<Field>;
+    static_assert(FieldLayout::members_count == 3U, "Invalid members count");
+    static_assert(FieldLayout::mask() == 0xffffULL, "Invalid mask");
+
+    Field field;
+    std::get<0>(field.value()).value() = 0x5;
+    std::get<1>(field.value()).value() = 0x6;
+    std::get<2>(field.value()).value() = 0x1a3;
+
+    std::array<std::uint8_t, 2> buf;
+    auto writeIter = &buf[0];
+    BOOST_REQUIRE(field.write(writeIter, buf.size()) == nil::marshalling::status_type::success);
+    std::uint64_t word = (static_cast<std::uint64_t>(buf[0]) << 8U) | buf[1];
+
+    std::array<FieldLayout::lane_type, FieldLayout::members_count> members;
+    FieldLayout::extract(word, &members[0]);
+    BOOST_CHECK_EQUAL(members[0], 0x5U);
+    BOOST_CHECK_EQUAL(members[1], 0x6U);
+    BOOST_CHECK_EQUAL(members[2], 0x1a3U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
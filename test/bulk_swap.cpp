@@ -0,0 +1,207 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_bulk_swap_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <nil/marshalling/types/array_list.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/bulk_swap.hpp>
+
+typedef nil::marshalling::field_type<nil::marshalling::option::big_endian> BeField;
+typedef nil::marshalling::field_type<nil::marshalling::option::little_endian> LeField;
+
+typedef nil::marshalling::types::array_list<BeField, std::uint16_t> BeSamples16;
+typedef nil::marshalling::types::array_list<BeField, std::int32_t> BeSamples32;
+typedef nil::marshalling::types::array_list<LeField, std::uint16_t> LeSamples16;
+
+typedef nil::marshalling::types::integral<BeField, std::uint8_t> BeSizePrefix;
+
+typedef nil::marshalling::types::array_list<BeField, std::uint16_t,
+                                            nil::marshalling::option::sequence_size_field_prefix<BeSizePrefix>>
+    BePrefixedSamples16;
+
+typedef nil::marshalling::types::array_list<BeField, std::uint16_t, nil::marshalling::option::sequence_fixed_size<2>>
+    BeFixedSamples16;
+
+class BePrefixedSamples
+    : public nil::marshalling::types::array_list<BeField, std::uint16_t, nil::marshalling::option::has_custom_read,
+                                                 nil::marshalling::option::sequence_size_field_prefix<BeSizePrefix>> {
+    using base_type
+        = nil::marshalling::types::array_list<BeField, std::uint16_t, nil::marshalling::option::has_custom_read,
+                                              nil::marshalling::option::sequence_size_field_prefix<BeSizePrefix>>;
+
+public:
+    MARSHALLING_ARRAY_LIST_BULK_ACCESS(base_type);
+};
+
+class BeSamples : public nil::marshalling::types::array_list<BeField, std::uint16_t,
+                                                             nil::marshalling::option::has_custom_read> {
+    using base_type
+        = nil::marshalling::types::array_list<BeField, std::uint16_t, nil::marshalling::option::has_custom_read>;
+
+public:
+    MARSHALLING_ARRAY_LIST_BULK_ACCESS(base_type);
+};
+
+BOOST_AUTO_TEST_SUITE(bulk_swap_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const char Buf[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    static_assert(nil::marshalling::is_bulk_array_list<BeSamples16, const char *>::value, "Bulk read expected");
+    typedef std::back_insert_iterator<std::vector<char>> BackInsertIter;
+    static_assert(!nil::marshalling::is_bulk_array_list<BeSamples16, BackInsertIter>::value,
+                  "Bulk write is not expected");
+
+    BeSamples16 field;
+    const char *readIter = &Buf[0];
+    auto es = nil::marshalling::array_list_bulk_read(field, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(readIter, &Buf[BufSize]);
+    BOOST_REQUIRE_EQUAL(field.value().size(), 5U);
+    BOOST_CHECK_EQUAL(field.value()[0], 0x0102);
+    BOOST_CHECK_EQUAL(field.value()[4], 0x090a);
+
+    LeSamples16 leField;
+    readIter = &Buf[0];
+    es = nil::marshalling::array_list_bulk_read(leField, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE_EQUAL(leField.value().size(), 5U);
+    BOOST_CHECK_EQUAL(leField.value()[0], 0x0201);
+
+    std::vector<char> outBuf(BufSize);
+    char *writeIter = &outBuf[0];
+    es = nil::marshalling::array_list_bulk_write(field, writeIter, outBuf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(std::equal(outBuf.begin(), outBuf.end(), &Buf[0]));
+
+    writeIter = &outBuf[0];
+    es = nil::marshalling::array_list_bulk_write(field, writeIter, outBuf.size() - 1U);
+    BOOST_CHECK(es == nil::marshalling::status_type::buffer_overflow);
+
+    readIter = &Buf[0];
+    es = nil::marshalling::array_list_bulk_read(field, readIter, BufSize - 1U);
+    BOOST_CHECK(es == nil::marshalling::status_type::invalid_msg_data);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    // Long enough to cover the vectorised and the scalar tail parts.
+    static const std::size_t Count = 1027U;
+
+    BeSamples32 field;
+    for (std::size_t idx = 0U; idx < Count; ++idx) {
+        field.value().push_back(static_cast<std::int32_t>(idx * 0x01020304U));
+    }
+
+    std::vector<char> outBuf(Count * sizeof(std::int32_t));
+    char *writeIter = &outBuf[0];
+    auto es = nil::marshalling::array_list_bulk_write(field, writeIter, outBuf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+
+    // Must match the element by element serialisation.
+    std::vector<char> expBuf(outBuf.size());
+    writeIter = &expBuf[0];
+    es = field.write(writeIter, expBuf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(outBuf == expBuf);
+
+    BeSamples32 readField;
+    const char *readIter = &outBuf[0];
+    es = nil::marshalling::array_list_bulk_read_n(readField, readIter, outBuf.size(), Count);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(readField.value() == field.value());
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const char Buf[] = {0x01, 0x02, 0x03, 0x04};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    BeSamples field;
+    const char *readIter = &Buf[0];
+    auto es = field.read(readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE_EQUAL(field.value().size(), 2U);
+    BOOST_CHECK_EQUAL(field.value()[1], 0x0304);
+
+    // Non-pointer iterator falls back to the element by element write.
+    std::vector<char> outBuf;
+    auto writeIter = std::back_inserter(outBuf);
+    es = field.write(writeIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(outBuf.size(), BufSize);
+    BOOST_CHECK(std::equal(outBuf.begin(), outBuf.end(), &Buf[0]));
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    static const char Buf[] = {0x02, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    static_assert(!nil::marshalling::is_bulk_array_list<BePrefixedSamples16, const char *>::value,
+                  "Bulk read of prefixed array is not expected");
+    static_assert(!nil::marshalling::is_bulk_array_list<BeFixedSamples16, const char *>::value,
+                  "Bulk read of fixed size array is not expected");
+
+    // The prefix must be honoured, the remaining bytes are not consumed.
+    BePrefixedSamples16 field;
+    const char *readIter = &Buf[0];
+    auto es = nil::marshalling::array_list_bulk_read(field, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(readIter, &Buf[5]);
+    BOOST_REQUIRE_EQUAL(field.value().size(), 2U);
+    BOOST_CHECK_EQUAL(field.value()[0], 0x0102);
+    BOOST_CHECK_EQUAL(field.value()[1], 0x0304);
+
+    std::vector<char> outBuf(BufSize);
+    char *writeIter = &outBuf[0];
+    es = nil::marshalling::array_list_bulk_write(field, writeIter, outBuf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(writeIter, &outBuf[5]);
+    BOOST_CHECK(std::equal(&outBuf[0], writeIter, &Buf[0]));
+
+    BePrefixedSamples customField;
+    readIter = &Buf[0];
+    es = customField.read(readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(customField.value() == field.value());
+
+    BeFixedSamples16 fixedField;
+    readIter = &Buf[1];
+    es = nil::marshalling::array_list_bulk_read(fixedField, readIter, BufSize - 1U);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(readIter, &Buf[5]);
+    BOOST_CHECK(fixedField.value() == field.value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
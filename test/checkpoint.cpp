@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_checkpoint_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/checkpoint.hpp>
+#include <nil/network/marshalling/feed_arbitrator.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+
+typedef nil::marshalling::protocol::msg_size_layer<
+    nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>>,
+    nil::marshalling::protocol::msg_id_layer<
+        nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>,
+        BeMsgBase, all_messages_type<BeMsgBase>, nil::marshalling::protocol::msg_data_layer<>>>
+    ProtocolStack;
+
+using SeqPeek = nil::marshalling::sequence_field_peek<nil::marshalling::types::integral<BeField, std::uint16_t>, 3>;
+
+using Arbitrator = nil::marshalling::feed_arbitrator<SeqPeek, 64>;
+
+struct StreamRecord {
+    nil::marshalling::stream_checkpoint<16, 2> stream;
+    Arbitrator::state_type arbitration;
+};
+
+typedef nil::marshalling::checkpoint_file<StreamRecord> CheckpointFile;
+
+static const char *CheckpointPath = "marshalling_checkpoint_test.bin";
+static const std::uint32_t LayoutVersion = 1U;
+
+using nil::marshalling::feed_arbitration_result;
+using nil::marshalling::feed_line;
+
+BOOST_AUTO_TEST_SUITE(checkpoint_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x00, 0x10};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+    static const std::size_t PartialSize = 3U;
+
+    ProtocolStack stack;
+    Arbitrator arbitrator;
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 0x10) == feed_arbitration_result::delivered);
+
+    // The frame is received only partially prior to the restart.
+    ProtocolStack::msg_ptr_type msg;
+    const char *readIter = &Buf[0];
+    std::size_t missingSize = 0U;
+    auto es = stack.read(msg, readIter, PartialSize, &missingSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK_EQUAL(missingSize, BufSize - PartialSize);
+
+    {
+        CheckpointFile file;
+        BOOST_REQUIRE(file.create(CheckpointPath, 4U, LayoutVersion));
+        BOOST_CHECK_EQUAL(file.capacity(), 4U);
+
+        auto *rec = file.append();
+        BOOST_REQUIRE(rec != nullptr);
+        rec->stream.clear();
+        rec->stream.stream_id = 5U;
+        rec->stream.fields[0] = 0xabcd;
+        rec->stream.set_sequence(0x10);
+        es = rec->stream.set_partial(reinterpret_cast<const std::uint8_t *>(&Buf[0]), PartialSize, missingSize);
+        BOOST_CHECK(es == nil::marshalling::status_type::success);
+        rec->arbitration = arbitrator.state();
+
+        CheckpointFile other;
+        BOOST_CHECK(!other.open(CheckpointPath, LayoutVersion));    // Not committed yet
+        BOOST_CHECK(file.commit());
+        BOOST_CHECK_EQUAL(file.generation(), 1U);
+    }
+
+    CheckpointFile file;
+    BOOST_CHECK(!file.open(CheckpointPath, LayoutVersion + 1U));
+    BOOST_REQUIRE(file.open(CheckpointPath, LayoutVersion));
+    BOOST_REQUIRE_EQUAL(file.size(), 1U);
+
+    auto &rec = file[0];
+    BOOST_CHECK_EQUAL(rec.stream.stream_id, 5U);
+    BOOST_CHECK_EQUAL(rec.stream.fields[0], 0xabcd);
+    BOOST_CHECK(rec.stream.sequence_valid != 0U);
+    BOOST_CHECK_EQUAL(rec.stream.sequence, 0x10);
+    BOOST_CHECK_EQUAL(rec.stream.missing_size, BufSize - PartialSize);
+    BOOST_REQUIRE_EQUAL(rec.stream.partial_size(), PartialSize);
+
+    // The restarted process completes the frame with the rest of the bytes.
+    std::vector<char> frame(rec.stream.partial_data(), rec.stream.partial_data() + rec.stream.partial_size());
+    frame.insert(frame.end(), &Buf[PartialSize], &Buf[BufSize]);
+    readIter = &frame[0];
+    es = stack.read(msg, readIter, frame.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK_EQUAL(msg->get_id(), MessageType1);
+
+    Arbitrator restored;
+    restored.restore(rec.arbitration);
+    BOOST_CHECK(restored.arbitrate(feed_line::b, 0x10) == feed_arbitration_result::duplicate);
+    BOOST_CHECK_EQUAL(restored.line_statistics(feed_line::a).delivered, 1U);
+    BOOST_CHECK_EQUAL(restored.highest(), 0x10);
+
+    file.close();
+    std::remove(CheckpointPath);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    nil::marshalling::stream_checkpoint<4, 1> stream;
+    stream.clear();
+
+    static const std::uint8_t Buf[] = {0x1, 0x2, 0x3, 0x4, 0x5};
+    BOOST_CHECK(stream.set_partial(&Buf[0], 5U) == nil::marshalling::status_type::buffer_overflow);
+    BOOST_CHECK_EQUAL(stream.partial_size(), 0U);
+    BOOST_CHECK(stream.set_partial(&Buf[0], 4U) == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(stream.partial_size(), 4U);
+
+    CheckpointFile file;
+    BOOST_REQUIRE(file.create(CheckpointPath, 1U));
+    BOOST_CHECK(file.append() != nullptr);
+    BOOST_CHECK(file.append() == nullptr);
+    BOOST_CHECK(file.commit(false));
+
+    file.clear();
+    BOOST_CHECK(file.empty());
+    CheckpointFile other;
+    BOOST_CHECK(!other.open(CheckpointPath));
+
+    file.close();
+    std::remove(CheckpointPath);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_checksum_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include <nil/network/marshalling/protocol/checksum/adler.hpp>
+#include <nil/network/marshalling/protocol/checksum/basic_sum.hpp>
+#include <nil/network/marshalling/protocol/checksum/fletcher.hpp>
+#include <nil/network/marshalling/protocol/checksum/xxhash.hpp>
+
+namespace checksum = nil::marshalling::protocol::checksum;
+
+template<typename TCalc>
+std::uint64_t calc_str(const char *str) {
+    auto *iter = reinterpret_cast<const std::uint8_t *>(str);
+    return TCalc()(iter, std::strlen(str));
+}
+
+std::vector<std::uint8_t> make_data(std::size_t size) {
+    std::vector<std::uint8_t> data(size);
+    std::uint32_t state = 7U;
+    for (auto &byte : data) {
+        state = state * 1103515245U + 12345U;
+        byte = static_cast<std::uint8_t>(state >> 24U);
+    }
+    return data;
+}
+
+// Compares the wide pointer path against the byte-wise generic iterator
+// path and the incremental interface.
+template<typename TCalc>
+void check_paths(const std::vector<std::uint8_t> &data, std::size_t len) {
+    BOOST_REQUIRE(len <= data.size());
+    auto *ptrIter = data.data();
+    auto ptrValue = TCalc()(ptrIter, len);
+    BOOST_CHECK(ptrIter == data.data() + len);
+
+    std::list<std::uint8_t> list(data.begin(), data.begin() + len);
+    auto listIter = list.cbegin();
+    auto listValue = TCalc()(listIter, len);
+    BOOST_CHECK(listIter == list.cend());
+    BOOST_CHECK_EQUAL(ptrValue, listValue);
+
+    auto state = TCalc::init();
+    for (std::size_t idx = 0U; idx < len; ++idx) {
+        state = TCalc::update(state, data[idx]);
+    }
+    BOOST_CHECK_EQUAL(ptrValue, TCalc::finalize(state));
+}
+
+template<typename TCalc>
+void check_all_paths() {
+    static const std::size_t Sizes[] = {0U,  1U,  3U,   7U,   15U,   16U,   17U,   31U,   32U,
+                                        33U, 63U, 100U, 255U, 1024U, 5552U, 5553U, 5803U, 70000U};
+    auto data = make_data(70000U);
+    for (auto size : Sizes) {
+        check_paths<TCalc>(data, size);
+    }
+
+    std::vector<std::uint8_t> ones(70000U, 0xffU);
+    check_paths<TCalc>(ones, ones.size());
+}
+
+BOOST_AUTO_TEST_SUITE(checksum_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    BOOST_CHECK_EQUAL(calc_str<checksum::fletcher16>("abcde"), 0xc8f0U);
+    BOOST_CHECK_EQUAL(calc_str<checksum::fletcher16>("abcdef"), 0x2057U);
+    BOOST_CHECK_EQUAL(calc_str<checksum::fletcher32>("abcde"), 0xf04fc729U);
+    BOOST_CHECK_EQUAL(calc_str<checksum::fletcher32>("abcdef"), 0x56502d2aU);
+    BOOST_CHECK_EQUAL(calc_str<checksum::adler32>("Wikipedia"), 0x11e60398U);
+    BOOST_CHECK_EQUAL(calc_str<checksum::adler32>(""), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    BOOST_CHECK_EQUAL(calc_str<checksum::xxhash32<>>(""), 0x02cc5d05U);
+    BOOST_CHECK_EQUAL(calc_str<checksum::xxhash32<>>("abc"), 0x32d153ffU);
+    BOOST_CHECK_EQUAL(calc_str<checksum::xxhash64<>>(""), 0xef46db3751d8e999ULL);
+    BOOST_CHECK_EQUAL(calc_str<checksum::xxhash64<>>("abc"), 0x44bc2cf5ad770999ULL);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    check_all_paths<checksum::basic_sum<std::uint8_t>>();
+    check_all_paths<checksum::basic_sum<std::uint16_t>>();
+    check_all_paths<checksum::basic_sum<std::uint32_t>>();
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    check_all_paths<checksum::fletcher16>();
+    check_all_paths<checksum::fletcher32>();
+    check_all_paths<checksum::adler32>();
+    check_all_paths<checksum::xxhash32<>>();
+    check_all_paths<checksum::xxhash64<0x1234U>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -44,6 +44,8 @@
 #include <nil/network/marshalling/protocol/checksum/crc.hpp>
 #include <nil/network/marshalling/protocol/msg_data_layer.hpp>
 #include <nil/network/marshalling/protocol/checksum_prefix_layer.hpp>
+#include <nil/network/marshalling/protocol/checksum/checksum_iterator.hpp>
+#include <nil/network/marshalling/protocol/checksum/parallel_crc.hpp>
 
 typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
                    nil::marshalling::option::big_endian, nil::marshalling::option::read_iterator<const char *>,
@@ -172,6 +174,16 @@ using ProtocolStackVerifyBefore = nil::marshalling::protocol::sync_prefix_layer<
                                                                  nil::marshalling::protocol::msg_data_layer<>>>,
         nil::marshalling::option::checksum_layer_verify_before_read>>;
 
+template<typename TSyncField, typename TChecksumField, typename TSizeField, typename TIdField, typename TMessage>
+using ProtocolStackFused = nil::marshalling::protocol::sync_prefix_layer<
+    TSyncField,
+    nil::marshalling::protocol::checksum_layer<
+        TChecksumField, nil::marshalling::protocol::checksum::basic_sum<>,
+        nil::marshalling::protocol::msg_size_layer<
+            TSizeField, nil::marshalling::protocol::msg_id_layer<TIdField, TMessage, all_messages_type<TMessage>,
+                                                                 nil::marshalling::protocol::msg_data_layer<>>>,
+        nil::marshalling::option::checksum_layer_fused_read>>;
+
 template<typename TSyncField, typename TChecksumField, typename TSizeField, typename TIdField, typename TMessage>
 class ProtocolPrefixStack
     : public nil::marshalling::protocol::sync_prefix_layer<
@@ -424,4 +436,129 @@ BOOST_AUTO_TEST_CASE(test10) {
     BOOST_CHECK(std::get<3>(fields2).value() == MessageType1);
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(test11) {
+    static const char Buf[]
+        = {(char)0xab, (char)0xcd, 0x0, 0x3, MessageType1, 0x01, 0x02, 0x06, static_cast<char>(0x3f)};
+
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    typedef ProtocolStackFused<BeSyncField2, BeChecksumField1, BeSizeField20, BeIdField1, BeMsgBase> Stack;
+
+    Stack stack;
+
+    auto msgPtr = common_read_write_msg_test(stack, &Buf[0], BufSize);
+    BOOST_CHECK(msgPtr);
+    BOOST_CHECK(msgPtr->get_id() == MessageType1);
+    auto &msg1 = dynamic_cast<BeMsg1 &>(*msgPtr);
+    BOOST_CHECK(std::get<0>(msg1.fields()).value() == 0x0102);
+}
+
+BOOST_AUTO_TEST_CASE(test12) {
+    static const char Buf[]
+        = {(char)0xab, (char)0xcd, 0x0, 0x3, MessageType1, 0x01, 0x02, 0x07, static_cast<char>(0x3f)};
+
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    typedef ProtocolStackFused<BeSyncField2, BeChecksumField1, BeSizeField20, BeIdField1, BeMsgBase> Stack;
+
+    Stack stack;
+
+    auto msgPtr = common_read_write_msg_test(stack, &Buf[0], BufSize, nil::marshalling::status_type::protocol_error);
+    BOOST_CHECK(!msgPtr);
+
+    static const char ShortBuf[] = {(char)0xab, (char)0xcd, 0x0, 0x3, MessageType1, 0x01, 0x02};
+    static const std::size_t ShortBufSize = std::extent<decltype(ShortBuf)>::value;
+    msgPtr = common_read_write_msg_test(stack, &ShortBuf[0], ShortBufSize,
+                                        nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK(!msgPtr);
+}
+
+BOOST_AUTO_TEST_CASE(test13) {
+    static const char Buf[]
+        = {(char)0xab, (char)0xcd, 0x0, 0x3, MessageType1, 0x01, 0x02, 0x06, static_cast<char>(0x3f)};
+
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    typedef ProtocolStackFused<BeSyncField2, BeChecksumField1, BeSizeField20, BeIdField1, BeNonPolymorphicMessageBase>
+        Stack;
+
+    Stack stack;
+    NonPolymorphicBeMsg1 msg;
+    common_read_write_msg_direct_test(stack, msg, &Buf[0], BufSize);
+    BOOST_CHECK(msg.field_value1().value() == 0x0102);
+
+    Stack::all_fields_type fields;
+    common_read_write_msg_direct_test(stack, fields, msg, &Buf[0], BufSize);
+    BOOST_CHECK(std::get<1>(fields).value() == 6U);    // checksum
+    BOOST_CHECK(std::get<4>(fields).value() == std::vector<std::uint8_t>(Buf + 5, Buf + 7));
+}
+
+BOOST_AUTO_TEST_CASE(test14) {
+    typedef nil::marshalling::protocol::checksum::crc_32 Calc;
+    typedef const std::uint8_t *IterType;
+
+    static const std::vector<std::uint8_t> Data = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    IterType begin = &Data[0];
+    nil::marshalling::protocol::checksum::checksum_accumulator<IterType, Calc> accumulator(begin);
+    nil::marshalling::protocol::checksum::checksum_iterator<IterType, Calc> iter(begin, accumulator);
+
+    std::uint8_t firstBytes[4] = {0};
+    std::copy_n(iter, 4U, &firstBytes[0]);
+    iter += 4;
+    ++iter;
+    iter = iter + 4;
+    BOOST_CHECK(accumulator.value(iter.base()) == 0xcbf43926);
+
+    auto shortIter = begin;
+    auto expected = Calc()(shortIter, 5U);
+    BOOST_CHECK(accumulator.value(begin + 5) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test15) {
+    std::vector<std::uint8_t> data(1024U * 1024U + 3U);
+    std::uint32_t state = 1U;
+    for (auto &byte : data) {
+        state = state * 1103515245U + 12345U;
+        byte = static_cast<std::uint8_t>(state >> 24U);
+    }
+
+    typedef nil::marshalling::protocol::checksum::crc_32 Crc32;
+    typedef nil::marshalling::protocol::checksum::crc_16 Crc16;
+    typedef nil::marshalling::protocol::checksum::crc<std::uint32_t, 0x1edc6f41, 0xffffffff, 0xffffffff, true, true>
+        Crc32c;
+
+    {
+        // CRC-32C has no precomputed table, it is built on the first use by the worker threads.
+        auto parallelIter = &data[0];
+        auto parallel
+            = nil::marshalling::protocol::checksum::parallel_crc<Crc32c, 4, 1024>()(parallelIter, data.size());
+        auto serialIter = &data[0];
+        BOOST_CHECK_EQUAL(Crc32c()(serialIter, data.size()), parallel);
+    }
+
+    {
+        auto prefixIter = &data[0];
+        auto prefixState = Crc32::update(Crc32::init(), prefixIter, 1000U);
+        auto suffixState = Crc32::update(Crc32::state_type(0U), prefixIter, 5000U);
+        auto iter = &data[0];
+        BOOST_CHECK(Crc32::combine(prefixState, suffixState, 5000U) == Crc32::update(Crc32::init(), iter, 6000U));
+    }
+
+    for (auto len : {std::size_t(0U), std::size_t(1000U), std::size_t(100003U), data.size()}) {
+        auto serialIter = &data[0];
+        auto parallelIter = &data[0];
+        auto serial = Crc32()(serialIter, len);
+        auto parallel = nil::marshalling::protocol::checksum::parallel_crc<Crc32, 4, 1024>()(parallelIter, len);
+        BOOST_CHECK_EQUAL(serial, parallel);
+        BOOST_CHECK(serialIter == parallelIter);
+
+        serialIter = &data[0];
+        parallelIter = &data[0];
+        auto serial16 = Crc16()(serialIter, len);
+        auto parallel16 = nil::marshalling::protocol::checksum::parallel_crc<Crc16, 3, 1024>()(parallelIter, len);
+        BOOST_CHECK_EQUAL(serial16, parallel16);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
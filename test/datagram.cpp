@@ -0,0 +1,295 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_datagram_test
+
+#include "test_common.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/datagram.hpp>
+#include <nil/network/marshalling/generic_handler.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+
+class TestHandler;
+
+typedef nil::marshalling::message<
+    nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::handler<TestHandler>,
+    nil::marshalling::option::id_info_interface, nil::marshalling::option::big_endian,
+    nil::marshalling::option::read_iterator<const char *>, nil::marshalling::option::write_iterator<char *>,
+    nil::marshalling::option::length_info_interface>
+    HandlerMsgBase;
+
+typedef HandlerMsgBase::field_type BeField;
+
+typedef Message1<HandlerMsgBase> HandlerMsg1;
+typedef Message2<HandlerMsgBase> HandlerMsg2;
+typedef Message3<HandlerMsgBase> HandlerMsg3;
+
+typedef std::tuple<HandlerMsg1, HandlerMsg2, HandlerMsg3> HandlerAllMessages;
+
+class TestHandler : public nil::marshalling::generic_handler<HandlerMsgBase, HandlerAllMessages> {
+    using Base = nil::marshalling::generic_handler<HandlerMsgBase, HandlerAllMessages>;
+
+public:
+    using Base::handle;
+
+    virtual void handle(HandlerMsg1 &msg) override {
+        sum_ += std::get<0>(msg.fields()).value();
+        ++handled_;
+    }
+
+    virtual void handle(HandlerMsgBase &msg) override {
+        static_cast<void>(msg);
+        ++handled_;
+    }
+
+    std::size_t handled_ = 0U;
+    std::size_t sum_ = 0U;
+};
+
+class TimestampHandler : public TestHandler {
+public:
+    using frame_context_tag = void;
+
+    void frame_context(const nil::marshalling::datagram_frame_context &context) {
+        if (context.timestamp.time_since_epoch().count() != 0) {
+            ++stamped_;
+        }
+        lastIndex_ = context.index;
+    }
+
+    std::size_t stamped_ = 0U;
+    std::size_t lastIndex_ = 0U;
+};
+
+using SizeField = nil::marshalling::types::integral<BeField, std::uint16_t>;
+
+using IdField = nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<2>>;
+
+using Stack = nil::marshalling::protocol::msg_size_layer<
+    SizeField, nil::marshalling::protocol::msg_id_layer<IdField, HandlerMsgBase, HandlerAllMessages,
+                                                        nil::marshalling::protocol::msg_data_layer<>>>;
+
+struct LoopbackSocket {
+    LoopbackSocket() {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+        std::memset(&addr_, 0, sizeof(addr_));
+        addr_.sin_family = AF_INET;
+        addr_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr_.sin_port = 0;
+        ::bind(fd_, reinterpret_cast<const sockaddr *>(&addr_), sizeof(addr_));
+        socklen_t addrLen = sizeof(addr_);
+        ::getsockname(fd_, reinterpret_cast<sockaddr *>(&addr_), &addrLen);
+    }
+
+    ~LoopbackSocket() {
+        if (0 <= fd_) {
+            ::close(fd_);
+        }
+    }
+
+    const sockaddr *addr() const {
+        return reinterpret_cast<const sockaddr *>(&addr_);
+    }
+
+    int fd_ = -1;
+    sockaddr_in addr_;
+};
+
+template<typename TReader, typename THandler>
+std::size_t receive_all(TReader &reader, int fd, std::size_t expected, Stack &stack, THandler &handler) {
+    std::size_t dispatched = 0U;
+    std::size_t received = 0U;
+    while (received < expected) {
+        auto count = reader.receive(fd);
+        BOOST_REQUIRE(count != 0U);
+        received += count;
+        dispatched += reader.process(stack, handler);
+    }
+    return dispatched;
+}
+
+BOOST_AUTO_TEST_SUITE(datagram_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const char Buf[] = {0x0, 0x4, 0x0, MessageType1, 0x01, 0x02, 0x0, 0x4,
+                               0x0, MessageType1, 0x00, 0x03, 0x0, 0x4, 0x0, MessageType1};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    Stack stack;
+    TestHandler handler;
+    BOOST_CHECK_EQUAL(nil::marshalling::dispatch_datagram(stack, &Buf[0], BufSize, handler), 2U);
+    BOOST_CHECK_EQUAL(handler.handled_, 2U);
+    BOOST_CHECK_EQUAL(handler.sum_, 0x0105U);
+
+    BOOST_CHECK_EQUAL(nil::marshalling::dispatch_datagram(stack, &Buf[0], BufSize, handler, 1U), 1U);
+    BOOST_CHECK_EQUAL(handler.handled_, 3U);
+
+    Stack::msg_ptr_type msg;
+    auto iter = &Buf[12];
+    auto es = nil::marshalling::complete_frame_read(stack, msg, iter, BufSize - 12U);
+    BOOST_CHECK(es == nil::marshalling::status_type::protocol_error);
+    BOOST_CHECK(!msg);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    LoopbackSocket sender;
+    LoopbackSocket receiver;
+    BOOST_REQUIRE(0 <= sender.fd_);
+    BOOST_REQUIRE(0 <= receiver.fd_);
+
+    Stack stack;
+    nil::marshalling::datagram_writer<4U, 64U, char> writer;
+    for (std::uint16_t idx = 1U; idx <= 4U; ++idx) {
+        HandlerMsg1 msg;
+        std::get<0>(msg.fields()).value() = idx;
+        auto es = writer.append(stack, msg, receiver.addr(), sizeof(receiver.addr_));
+        BOOST_CHECK(es == nil::marshalling::status_type::success);
+    }
+
+    HandlerMsg2 extraMsg;
+    BOOST_CHECK(writer.append(stack, extraMsg, receiver.addr(), sizeof(receiver.addr_))
+                == nil::marshalling::status_type::buffer_overflow);
+    BOOST_CHECK_EQUAL(writer.pending(), 4U);
+    BOOST_CHECK_EQUAL(writer.flush(sender.fd_), 4U);
+    BOOST_CHECK_EQUAL(writer.pending(), 0U);
+
+    nil::marshalling::datagram_reader<8U, 64U, char> reader;
+    TestHandler handler;
+    BOOST_CHECK_EQUAL(receive_all(reader, receiver.fd_, 4U, stack, handler), 4U);
+    BOOST_CHECK_EQUAL(handler.handled_, 4U);
+    BOOST_CHECK_EQUAL(handler.sum_, 10U);
+    BOOST_CHECK_EQUAL(reader.statistics().datagrams, 4U);
+    BOOST_CHECK_EQUAL(reader.statistics().messages, 4U);
+    BOOST_CHECK_EQUAL(reader.statistics().malformed, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const char Truncated[] = {0x0, 0x4, 0x0, MessageType1, 0x01, 0x02, 0x03, 0x04};
+    static const char Malformed[] = {0x0, 0x8, 0x0, MessageType1, 0x01, 0x02};
+
+    LoopbackSocket sender;
+    LoopbackSocket receiver;
+    BOOST_REQUIRE(0 <= sender.fd_);
+    BOOST_REQUIRE(0 <= receiver.fd_);
+
+    ::sendto(sender.fd_, Truncated, sizeof(Truncated), 0, receiver.addr(), sizeof(receiver.addr_));
+    ::sendto(sender.fd_, Malformed, 4U, 0, receiver.addr(), sizeof(receiver.addr_));
+
+    Stack stack;
+    nil::marshalling::datagram_reader<2U, 6U, char> reader;
+    TestHandler handler;
+    BOOST_CHECK_EQUAL(receive_all(reader, receiver.fd_, 2U, stack, handler), 0U);
+    BOOST_CHECK_EQUAL(handler.handled_, 0U);
+    BOOST_CHECK_EQUAL(reader.statistics().datagrams, 2U);
+    BOOST_CHECK_EQUAL(reader.statistics().truncated, 1U);
+    BOOST_CHECK_EQUAL(reader.statistics().malformed, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    static const char Buf[] = {0x0, 0x4, 0x0, MessageType1, 0x01, 0x02, 0x0, 0x4, 0x0, MessageType1, 0x00, 0x03};
+
+    LoopbackSocket sender;
+    LoopbackSocket receiver;
+    BOOST_REQUIRE(0 <= sender.fd_);
+    BOOST_REQUIRE(0 <= receiver.fd_);
+    BOOST_REQUIRE(nil::marshalling::enable_receive_timestamps(receiver.fd_));
+
+    auto sendTime = std::chrono::system_clock::now();
+    ::sendto(sender.fd_, Buf, sizeof(Buf), 0, receiver.addr(), sizeof(receiver.addr_));
+    ::sendto(sender.fd_, Buf, 6U, 0, receiver.addr(), sizeof(receiver.addr_));
+
+    static_assert(nil::marshalling::is_frame_context_handler<TimestampHandler>(), "Invalid handler detection");
+    static_assert(!nil::marshalling::is_frame_context_handler<TestHandler>(), "Invalid handler detection");
+
+    Stack stack;
+    nil::marshalling::datagram_reader<4U, 64U, char> reader;
+    TimestampHandler handler;
+    BOOST_CHECK_EQUAL(receive_all(reader, receiver.fd_, 2U, stack, handler), 3U);
+    BOOST_CHECK_EQUAL(handler.stamped_, 3U);
+    BOOST_CHECK_EQUAL(handler.lastIndex_, reader.count() - 1U);
+
+    auto lastIdx = reader.count() - 1U;
+    BOOST_CHECK(sendTime - std::chrono::seconds(1) <= reader.timestamp(lastIdx));
+    BOOST_CHECK(reader.timestamp(lastIdx) <= std::chrono::system_clock::now());
+    BOOST_CHECK_EQUAL(reader.hardware_timestamp(lastIdx).count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test5) {
+    LoopbackSocket receiver;
+    BOOST_REQUIRE(0 <= receiver.fd_);
+
+    Stack stack;
+    nil::marshalling::datagram_writer<2U, 64U, char> writer;
+    HandlerMsg1 msg;
+    auto es = writer.append(stack, msg, receiver.addr(), sizeof(sockaddr_storage) + 1U);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_supported);
+    BOOST_CHECK_EQUAL(writer.pending(), 0U);
+
+    es = writer.append(stack, msg, receiver.addr(), sizeof(receiver.addr_));
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(writer.pending(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test6) {
+    static const char Buf[] = {0x0, 0x4, 0x0, MessageType1, 0x01, 0x02};
+
+    LoopbackSocket sender;
+    LoopbackSocket receiver;
+    BOOST_REQUIRE(0 <= sender.fd_);
+    BOOST_REQUIRE(0 <= receiver.fd_);
+    BOOST_REQUIRE(nil::marshalling::enable_receive_timestamps(receiver.fd_, true));
+
+    auto sendTime = std::chrono::system_clock::now();
+    ::sendto(sender.fd_, Buf, sizeof(Buf), 0, receiver.addr(), sizeof(receiver.addr_));
+
+    Stack stack;
+    nil::marshalling::datagram_reader<4U, 64U, char> reader;
+    TimestampHandler handler;
+    BOOST_CHECK_EQUAL(receive_all(reader, receiver.fd_, 1U, stack, handler), 1U);
+    BOOST_CHECK_EQUAL(handler.stamped_, 1U);
+
+    // The software timestamp (CLOCK_REALTIME) is reported even when the hardware
+    // ones are requested, the loopback doesn't provide the hardware timestamps.
+    BOOST_CHECK(sendTime - std::chrono::seconds(1) <= reader.timestamp(0U));
+    BOOST_CHECK(reader.timestamp(0U) <= std::chrono::system_clock::now());
+    BOOST_CHECK_EQUAL(reader.hardware_timestamp(0U).count(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
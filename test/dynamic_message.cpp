@@ -0,0 +1,171 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_dynamic_message_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/dynamic_message.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+typedef nil::marshalling::dynamic_message<BeMsgBase> DynamicMsg;
+
+typedef nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>> SizeField;
+typedef nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>
+    IdField;
+
+typedef nil::marshalling::protocol::msg_size_layer<
+    SizeField, nil::marshalling::protocol::msg_id_layer<IdField, BeMsgBase, all_messages_type<BeMsgBase>,
+                                                        nil::marshalling::protocol::msg_data_layer<>,
+                                                        nil::marshalling::option::support_generic_message<DynamicMsg>>>
+    ProtocolStack;
+
+namespace {
+
+    const char *const Schema = "# partner messages\n"
+                               "message 1 PartnerQuote\n"
+                               "    u8 flags\n"
+                               "    i16le delta\n"
+                               "    u24 qty\n"
+                               "    optional flags 0x1 u32 extra\n"
+                               "    optional flags 0x2 list u8 legs\n"
+                               "        u16 id\n"
+                               "        i8 adj\n"
+                               "    end\n"
+                               "end\n";
+
+    const nil::marshalling::dynamic_schema_set &schemas() {
+        static nil::marshalling::dynamic_schema_set set;
+        if (set.size() == 0U) {
+            std::istringstream stream(Schema);
+            BOOST_CHECK(set.load(stream));
+            DynamicMsg::set_schemas(&set);
+        }
+        return set;
+    }
+
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(dynamic_message_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    auto *plan = schemas().find(UnusedValue1);
+    BOOST_REQUIRE(plan != nullptr);
+    BOOST_CHECK_EQUAL(plan->name(), "PartnerQuote");
+    BOOST_CHECK_EQUAL(plan->slots(), 5U);
+    BOOST_CHECK_EQUAL(plan->field_index("qty"), 2U);
+    BOOST_CHECK_EQUAL(plan->field_index("unknown"), plan->slots());
+    BOOST_CHECK_EQUAL(plan->element_index(4U, "adj"), 1U);
+
+    static const char Buf[] = {0x0,  0x12, UnusedValue1, 0x03, static_cast<char>(0xfe), static_cast<char>(0xff),
+                               0x0,  0x1,  0x2,          0x0,  0x0,  0x1,  0x0,  0x2,  0x0, 0x5,
+                               static_cast<char>(0xff), 0x0, 0x6, 0x1};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    ProtocolStack stack;
+    auto msgPtr = common_read_write_msg_test(stack, &Buf[0], BufSize);
+    BOOST_REQUIRE(msgPtr);
+    BOOST_CHECK(msgPtr->get_id() == UnusedValue1);
+
+    auto &msg = dynamic_cast<DynamicMsg &>(*msgPtr);
+    BOOST_REQUIRE(msg.plan() == plan);
+    BOOST_CHECK_EQUAL(msg.value(0U), 3U);
+    BOOST_CHECK_EQUAL(msg.signed_value(1U), -2);
+    BOOST_CHECK_EQUAL(msg.value(2U), 0x102U);
+    BOOST_CHECK(msg.is_present(3U));
+    BOOST_CHECK_EQUAL(msg.value(3U), 0x100U);
+    BOOST_REQUIRE_EQUAL(msg.list_size(4U), 2U);
+    BOOST_CHECK_EQUAL(msg.element_value(4U, 0U, 0U), 5U);
+    BOOST_CHECK_EQUAL(static_cast<std::int64_t>(msg.element_value(4U, 0U, 1U)), -1);
+    BOOST_CHECK_EQUAL(msg.element_value(4U, 1U, 0U), 6U);
+    BOOST_CHECK_EQUAL(msg.element_value(4U, 1U, 1U), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    schemas();
+    DynamicMsg msg(UnusedValue1);
+    BOOST_REQUIRE(msg.plan() != nullptr);
+    msg.set_value(0U, 0x2);
+    msg.set_value(2U, 0x30405);
+    msg.resize_list(4U, 1U);
+    msg.set_element_value(4U, 0U, 0U, 0x0a0b);
+    BOOST_CHECK(!msg.is_present(3U));
+
+    ProtocolStack stack;
+    std::vector<char> buf(stack.length(msg));
+    BOOST_REQUIRE_EQUAL(buf.size(), 13U);
+    auto writeIter = &buf[0];
+    auto es = stack.write(msg, writeIter, buf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+
+    static const char Expected[] = {0x0, 0xb, UnusedValue1, 0x2, 0x0, 0x0, 0x3, 0x4, 0x5, 0x1, 0x0a, 0x0b, 0x0};
+    BOOST_CHECK(std::equal(buf.begin(), buf.end(), &Expected[0]));
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    schemas();
+    static const char Buf[] = {0x0, 0x3, UnusedValue2, 0x01, 0x02};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    ProtocolStack stack;
+    auto msgPtr = common_read_write_msg_test(stack, &Buf[0], BufSize);
+    BOOST_REQUIRE(msgPtr);
+    auto &msg = dynamic_cast<DynamicMsg &>(*msgPtr);
+    BOOST_CHECK(msg.plan() == nullptr);
+    BOOST_CHECK_EQUAL(msg.raw().size(), 2U);
+    BOOST_CHECK_EQUAL(msg.raw()[1], 0x02);
+
+    static const char Truncated[] = {0x0, 0x4, UnusedValue1, 0x03, 0x00, 0x00};
+    msgPtr.reset();
+    auto readIter = &Truncated[0];
+    auto es = stack.read(msgPtr, readIter, std::extent<decltype(Truncated)>::value);
+    BOOST_CHECK(es != nil::marshalling::status_type::success);
+
+    static const char Known[] = {0x0, 0x3, MessageType1, 0x01, 0x02};
+    auto knownPtr = common_read_write_msg_test(stack, &Known[0], std::extent<decltype(Known)>::value);
+    BOOST_REQUIRE(knownPtr);
+    BOOST_CHECK(dynamic_cast<BeMsg1 *>(knownPtr.get()) != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,155 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_feed_arbitrator_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/feed_arbitrator.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::valid_check_interface, nil::marshalling::option::length_info_interface>
+    common_options;
+
+typedef std::tuple<nil::marshalling::option::big_endian, nil::marshalling::option::write_iterator<char *>,
+                   common_options>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+
+using BeSizeField
+    = nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>>;
+using BeIdField
+    = nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>;
+
+using ProtocolStack = nil::marshalling::protocol::msg_size_layer<
+    BeSizeField, nil::marshalling::protocol::msg_id_layer<BeIdField, BeMsgBase, all_messages_type<BeMsgBase>,
+                                                          nil::marshalling::protocol::msg_data_layer<>>>;
+
+// Sequence number is the value of Message1 located right after size and id
+using SeqPeek = nil::marshalling::sequence_field_peek<nil::marshalling::types::integral<BeField, std::uint16_t>, 3>;
+
+using Arbitrator = nil::marshalling::feed_arbitrator<SeqPeek, 64>;
+
+using nil::marshalling::feed_arbitration_result;
+using nil::marshalling::feed_line;
+
+BOOST_AUTO_TEST_SUITE(feed_arbitrator_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x00, 0x10};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    ProtocolStack stack;
+    Arbitrator arbitrator;
+
+    ProtocolStack::msg_ptr_type msg;
+    feed_arbitration_result result = feed_arbitration_result::stale;
+    const char *readIter = &Buf[0];
+    auto es = arbitrator.read(feed_line::a, stack, msg, readIter, BufSize, &result);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(result == feed_arbitration_result::delivered);
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK_EQUAL(msg->get_id(), MessageType1);
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(std::distance(&Buf[0], readIter)), BufSize);
+
+    msg.reset();
+    readIter = &Buf[0];
+    es = arbitrator.read(feed_line::b, stack, msg, readIter, BufSize, &result);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(result == feed_arbitration_result::duplicate);
+    BOOST_CHECK(!msg);
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(std::distance(&Buf[0], readIter)), BufSize);
+
+    BOOST_CHECK_EQUAL(arbitrator.line_statistics(feed_line::a).delivered, 1U);
+    BOOST_CHECK_EQUAL(arbitrator.line_statistics(feed_line::b).duplicates, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    Arbitrator arbitrator;
+
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 10U) == feed_arbitration_result::delivered);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 12U) == feed_arbitration_result::delivered);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::b, 10U) == feed_arbitration_result::duplicate);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::b, 11U) == feed_arbitration_result::delivered);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::b, 12U) == feed_arbitration_result::duplicate);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 11U) == feed_arbitration_result::duplicate);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 9U) == feed_arbitration_result::stale);
+
+    auto &statsA = arbitrator.line_statistics(feed_line::a);
+    auto &statsB = arbitrator.line_statistics(feed_line::b);
+    BOOST_CHECK_EQUAL(statsA.received, 4U);
+    BOOST_CHECK_EQUAL(statsA.delivered, 2U);
+    BOOST_CHECK_EQUAL(statsA.gaps, 1U);
+    BOOST_CHECK_EQUAL(statsA.stale, 1U);
+    BOOST_CHECK_EQUAL(statsB.delivered, 1U);
+    BOOST_CHECK_EQUAL(statsB.duplicates, 2U);
+    BOOST_CHECK_EQUAL(statsB.gaps, 0U);
+    BOOST_CHECK_EQUAL(arbitrator.pending_gaps(), 0U);
+    BOOST_CHECK_EQUAL(arbitrator.unrecovered(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    Arbitrator arbitrator;
+
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 100U) == feed_arbitration_result::delivered);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 103U) == feed_arbitration_result::delivered);
+    BOOST_CHECK_EQUAL(arbitrator.pending_gaps(), 2U);
+
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::b, 101U) == feed_arbitration_result::delivered);
+    BOOST_CHECK_EQUAL(arbitrator.pending_gaps(), 1U);
+
+    // Move the window far enough for 102 to be evicted without delivery
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::a, 170U) == feed_arbitration_result::delivered);
+    BOOST_CHECK_EQUAL(arbitrator.unrecovered(), 4U);
+    BOOST_CHECK(arbitrator.arbitrate(feed_line::b, 102U) == feed_arbitration_result::stale);
+    BOOST_CHECK_EQUAL(arbitrator.highest(), 170U);
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x00};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    ProtocolStack stack;
+    Arbitrator arbitrator;
+    ProtocolStack::msg_ptr_type msg;
+    const char *readIter = &Buf[0];
+    auto es = arbitrator.read(feed_line::a, stack, msg, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK_EQUAL(arbitrator.line_statistics(feed_line::a).received, 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_frame_size_test
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/sync_prefix_layer.hpp>
+#include <nil/network/marshalling/protocol/checksum_layer.hpp>
+#include <nil/network/marshalling/protocol/checksum/basic_sum.hpp>
+#include <nil/network/marshalling/protocol/frame_size.hpp>
+#include <nil/network/marshalling/alloc.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::valid_check_interface, nil::marshalling::option::length_info_interface>
+    common_options;
+
+typedef std::tuple<nil::marshalling::option::big_endian, nil::marshalling::option::write_iterator<char *>,
+                   common_options>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+
+typedef Message1<BeMsgBase> BeMsg1;
+typedef Message2<BeMsgBase> BeMsg2;
+typedef Message3<BeMsgBase> BeMsg3;
+
+template<typename TField, std::size_t TSize>
+using SizeField = nil::marshalling::types::integral<TField, unsigned, nil::marshalling::option::fixed_length<TSize>>;
+
+template<typename TField, std::size_t TLen>
+using IdField = nil::marshalling::types::enumeration<TField, message_type, nil::marshalling::option::fixed_length<TLen>>;
+
+template<typename TField>
+using SyncField = nil::marshalling::types::integral<TField, std::uint16_t,
+                                                    nil::marshalling::option::default_num_value<0xabcd>>;
+
+template<typename TField>
+using ChecksumField = nil::marshalling::types::integral<TField, std::uint8_t>;
+
+template<typename TSizeField, typename TIdField, typename TMessage>
+using ProtocolStack = nil::marshalling::protocol::msg_size_layer<
+    TSizeField, nil::marshalling::protocol::msg_id_layer<TIdField, TMessage, all_messages_type<TMessage>,
+                                                         nil::marshalling::protocol::msg_data_layer<>>>;
+
+template<typename TSyncField, typename TChecksumField, typename TSizeField, typename TIdField, typename TMessage>
+using FullProtocolStack = nil::marshalling::protocol::sync_prefix_layer<
+    TSyncField,
+    nil::marshalling::protocol::checksum_layer<
+        TChecksumField, nil::marshalling::protocol::checksum::basic_sum<std::uint8_t>,
+        nil::marshalling::protocol::msg_size_layer<
+            TSizeField, nil::marshalling::protocol::msg_id_layer<TIdField, TMessage, all_messages_type<TMessage>,
+                                                                 nil::marshalling::protocol::msg_data_layer<>>>>>;
+
+using BeStack = ProtocolStack<SizeField<BeField, 2>, IdField<BeField, 1>, BeMsgBase>;
+using BeFullStack
+    = FullProtocolStack<SyncField<BeField>, ChecksumField<BeField>, SizeField<BeField, 2>, IdField<BeField, 2>, BeMsgBase>;
+
+BOOST_AUTO_TEST_SUITE(frame_size_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static_assert(nil::marshalling::protocol::transport_min_length<BeStack>() == 3U, "Invalid transport length");
+    static_assert(nil::marshalling::protocol::transport_max_length<BeStack>() == 3U, "Invalid transport length");
+    static_assert(nil::marshalling::protocol::frame_min_length<BeStack, BeMsg1>() == 5U, "Invalid frame length");
+    static_assert(nil::marshalling::protocol::frame_max_length<BeStack, BeMsg1>() == 5U, "Invalid frame length");
+    static_assert(nil::marshalling::protocol::frame_min_length<BeStack, BeMsg2>() == 3U, "Invalid frame length");
+    static_assert(nil::marshalling::protocol::frame_max_length<BeStack, BeMsg3>() == 13U, "Invalid frame length");
+    static_assert(nil::marshalling::protocol::min_frame_length<BeStack>() == 3U, "Invalid frame length");
+    static_assert(nil::marshalling::protocol::max_frame_length<BeStack>() == 13U, "Invalid frame length");
+    static_assert(nil::marshalling::protocol::is_frame_length_bounded<BeStack>(), "Frame must be bounded");
+
+    std::array<char, nil::marshalling::protocol::max_frame_length<BeStack>()> buf;
+    BeMsg3 msg;
+    BeStack stack;
+    BOOST_CHECK_EQUAL(stack.length(msg), buf.size());
+
+    auto *writeIter = &buf[0];
+    auto es = stack.write(msg, writeIter, buf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    static_assert(nil::marshalling::protocol::transport_min_length<BeFullStack>() == 7U, "Invalid transport length");
+    static_assert(nil::marshalling::protocol::min_frame_length<BeFullStack>() == 7U, "Invalid frame length");
+    static_assert(nil::marshalling::protocol::max_frame_length<BeFullStack>() == 17U, "Invalid frame length");
+
+    using restricted_messages_type = std::tuple<BeMsg1, BeMsg2>;
+    static_assert(nil::marshalling::protocol::max_frame_length<BeFullStack, restricted_messages_type>() == 9U,
+                  "Invalid frame length");
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    using all_messages = all_messages_type<BeMsgBase>;
+    static const std::size_t MaxSize = nil::marshalling::protocol::max_msg_object_size<all_messages>();
+    static const std::size_t MaxAlign = nil::marshalling::protocol::max_msg_object_alignment<all_messages>();
+
+    BOOST_CHECK_EQUAL(MaxSize, std::max(sizeof(BeMsg1), std::max(sizeof(BeMsg2), sizeof(BeMsg3))));
+    BOOST_CHECK_EQUAL(MaxAlign, std::max(alignof(BeMsg1), std::max(alignof(BeMsg2), alignof(BeMsg3))));
+
+    nil::marshalling::processing::alloc::in_place_single<BeMsgBase, all_messages> alloc;
+    static_assert(MaxSize <= sizeof(alloc), "In-place allocator must fit the largest message");
+    auto ptr = alloc.template alloc<BeMsg3>();
+    BOOST_CHECK(ptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
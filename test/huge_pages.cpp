@@ -0,0 +1,145 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_huge_pages_test
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/alloc.hpp>
+#include <nil/network/marshalling/huge_pages.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+typedef Message2<BeMsgBase> BeMsg2;
+
+typedef nil::marshalling::protocol::msg_size_layer<
+    nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>>,
+    nil::marshalling::protocol::msg_id_layer<
+        nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>,
+        BeMsgBase, all_messages_type<BeMsgBase>, nil::marshalling::protocol::msg_data_layer<>>>
+    ProtocolStack;
+
+BOOST_AUTO_TEST_SUITE(huge_pages_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const std::size_t Len = 3 * 1024 * 1024 + 10;
+
+    nil::marshalling::huge_page_region region(Len);
+    BOOST_REQUIRE(region.valid());
+    BOOST_CHECK(Len <= region.size());
+    BOOST_CHECK(region.backing() != nil::marshalling::huge_page_backing::none);
+
+    auto *bytes = static_cast<std::uint8_t *>(region.data());
+    BOOST_CHECK(std::all_of(bytes, bytes + Len, [](std::uint8_t b) { return b == 0U; }));
+    bytes[0] = 0x1;
+    bytes[Len - 1] = 0x2;
+
+    if (region.huge()) {
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(bytes) % nil::marshalling::huge_page_size, 0U);
+    }
+
+    nil::marshalling::huge_page_region other(std::move(region));
+    BOOST_CHECK(!region.valid());
+    BOOST_CHECK(region.backing() == nil::marshalling::huge_page_backing::none);
+    BOOST_REQUIRE(other.valid());
+    BOOST_CHECK_EQUAL(static_cast<std::uint8_t *>(other.data())[Len - 1], 0x2);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    nil::marshalling::huge_page_region region(100, nil::marshalling::huge_page_policy::none, false);
+    BOOST_REQUIRE(region.valid());
+    BOOST_CHECK(100U <= region.size());
+    BOOST_CHECK(region.backing() == nil::marshalling::huge_page_backing::regular);
+    BOOST_CHECK(!region.huge());
+
+    nil::marshalling::huge_page_region empty(0U);
+    BOOST_CHECK(!empty.valid());
+    BOOST_CHECK_EQUAL(empty.size(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    nil::marshalling::huge_page_buffer<char> buf(64 * 1024);
+    BOOST_REQUIRE(64U * 1024U <= buf.capacity());
+    std::copy_n(&Buf[0], BufSize, buf.begin());
+
+    ProtocolStack stack;
+    ProtocolStack::msg_ptr_type msg;
+    const char *readIter = buf.data();
+    auto es = stack.read(msg, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK(msg->get_id() == MessageType1);
+
+    char *writeIter = buf.data() + BufSize;
+    es = stack.write(*msg, writeIter, buf.capacity() - BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(std::equal(&Buf[0], &Buf[0] + BufSize, buf.data() + BufSize));
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    typedef nil::marshalling::processing::alloc::huge_page_pool<BeMsgBase, 3, all_messages_type<BeMsgBase>> Pool;
+
+    Pool pool;
+    BOOST_CHECK(pool.backing() != nil::marshalling::huge_page_backing::none);
+
+    auto msg1 = pool.alloc<BeMsg1>();
+    auto msg2 = pool.alloc<BeMsg2>();
+    auto msg3 = pool.alloc<BeMsg1>();
+    BOOST_REQUIRE(msg1);
+    BOOST_REQUIRE(msg2);
+    BOOST_REQUIRE(msg3);
+    BOOST_CHECK(msg2->get_id() == MessageType2);
+    BOOST_CHECK(!pool.alloc<BeMsg2>());
+
+    msg2.reset();
+    auto msg4 = pool.alloc<BeMsg2>();
+    BOOST_REQUIRE(msg4);
+
+    BeMsg1 foreign;
+    BOOST_CHECK(!pool.wrap(&foreign));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_instantiation_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/instantiation.hpp>
+#include <nil/network/marshalling/msg_factory.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+
+typedef nil::marshalling::protocol::msg_size_layer<
+    nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>>,
+    nil::marshalling::protocol::msg_id_layer<
+        nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>,
+        BeMsgBase, all_messages_type<BeMsgBase>, nil::marshalling::protocol::msg_data_layer<>>>
+    ProtocolStack;
+
+typedef nil::marshalling::msg_factory<BeMsgBase, all_messages_type<BeMsgBase>> Factory;
+
+// Normally placed in the common header.
+MARSHALLING_EXTERN_PROTOCOL_STACK(ProtocolStack);
+MARSHALLING_EXTERN_MSG_FACTORY(Factory);
+
+// Normally placed in the single source file.
+MARSHALLING_INSTANTIATE_PROTOCOL_STACK(ProtocolStack);
+MARSHALLING_INSTANTIATE_MSG_FACTORY(Factory);
+
+BOOST_AUTO_TEST_SUITE(instantiation_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    typedef nil::marshalling::stack_instantiation<ProtocolStack> Instantiation;
+
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    ProtocolStack stack;
+    Instantiation::msg_ptr_type msg;
+    Instantiation::read_iterator readIter = &Buf[0];
+    auto es = Instantiation::read(stack, msg, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK(msg->get_id() == MessageType1);
+    BOOST_CHECK_EQUAL(Instantiation::length(stack, *msg), BufSize);
+
+    std::vector<char> out(BufSize);
+    Instantiation::write_iterator writeIter = &out[0];
+    es = Instantiation::write(stack, *msg, writeIter, out.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(std::equal(out.begin(), out.end(), &Buf[0]));
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    typedef nil::marshalling::msg_factory_instantiation<Factory> Instantiation;
+
+    Factory factory;
+    auto msg = Instantiation::create_msg(factory, MessageType1);
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK(dynamic_cast<BeMsg1 *>(msg.get()) != nullptr);
+    BOOST_CHECK_EQUAL(Instantiation::msg_count(factory, MessageType1), 1U);
+    BOOST_CHECK_EQUAL(Instantiation::msg_count(factory, UnusedValue1), 0U);
+    BOOST_CHECK(!Instantiation::create_msg(factory, UnusedValue1));
+    BOOST_CHECK(!Instantiation::create_generic_msg(factory, UnusedValue1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
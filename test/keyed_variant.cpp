@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_keyed_variant_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <nil/marshalling/types/bundle.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/marshalling/types/variant.hpp>
+#include <nil/network/marshalling/keyed_variant.hpp>
+
+typedef nil::marshalling::field_type<nil::marshalling::option::big_endian> BeField;
+
+typedef nil::marshalling::types::integral<BeField, std::uint8_t> PropKey;
+
+template<std::uint8_t TKey>
+using PropKeyValue
+    = nil::marshalling::types::integral<BeField, std::uint8_t, nil::marshalling::option::default_num_value<TKey>,
+                                        nil::marshalling::option::valid_num_value_range<TKey, TKey>,
+                                        nil::marshalling::option::fail_on_invalid<>>;
+
+template<std::uint8_t TKey, typename TValue>
+using Prop = nil::marshalling::types::bundle<BeField, std::tuple<PropKeyValue<TKey>, TValue>>;
+
+typedef Prop<1, nil::marshalling::types::integral<BeField, std::uint16_t>> Prop1;
+typedef Prop<7, nil::marshalling::types::integral<BeField, std::uint32_t>> Prop2;
+typedef Prop<4, nil::marshalling::types::integral<BeField, std::uint8_t>> Prop3;
+typedef nil::marshalling::types::bundle<BeField, std::tuple<PropKey, nil::marshalling::types::integral<BeField, std::uint8_t>>>
+    UnknownProp;
+
+typedef std::tuple<Prop1, Prop2, Prop3, UnknownProp> PropMembers;
+
+class Property : public nil::marshalling::types::variant<BeField, PropMembers, nil::marshalling::option::has_custom_read> {
+    using Base = nil::marshalling::types::variant<BeField, PropMembers, nil::marshalling::option::has_custom_read>;
+
+public:
+    MARSHALLING_VARIANT_MEMBERS_ACCESS(prop1, prop2, prop3, unknown);
+    MARSHALLING_VARIANT_KEYED_READ(PropKey);
+};
+
+typedef nil::marshalling::types::variant<BeField, PropMembers> PlainProperty;
+
+template<typename TField>
+TField read_property(const char *buf, std::size_t size, std::size_t expectedLen) {
+    TField field;
+    const char *readIter = buf;
+    auto es = field.read(readIter, size);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(std::distance(buf, readIter)), expectedLen);
+    return field;
+}
+
+BOOST_AUTO_TEST_SUITE(keyed_variant_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    typedef nil::marshalling::keyed_variant_table<PropKey, PlainProperty> Table;
+    static_assert(Table::alternatives_count == 4U, "Invalid alternatives count");
+
+    auto &table = Table::instance();
+    BOOST_CHECK_EQUAL(table.keys_count(), 4U);
+    BOOST_CHECK_EQUAL(table.find(1), 0U);
+    BOOST_CHECK_EQUAL(table.find(7), 1U);
+    BOOST_CHECK_EQUAL(table.find(4), 2U);
+    BOOST_CHECK_EQUAL(table.find(0), 3U);
+    BOOST_CHECK_EQUAL(table.find(5), Table::alternatives_count);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    static const char Buf[] = {7, 0x01, 0x02, 0x03, 0x04};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    auto keyed = read_property<Property>(&Buf[0], BufSize, 5U);
+    auto plain = read_property<PlainProperty>(&Buf[0], BufSize, 5U);
+    BOOST_CHECK_EQUAL(keyed.current_field(), 1U);
+    BOOST_CHECK_EQUAL(plain.current_field(), 1U);
+    BOOST_CHECK_EQUAL(std::get<1>(keyed.access_field<1>().value()).value(), 0x01020304U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const char Buf[] = {5, 0x11};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    auto keyed = read_property<Property>(&Buf[0], BufSize, 2U);
+    BOOST_CHECK_EQUAL(keyed.current_field(), 3U);
+    BOOST_CHECK_EQUAL(std::get<1>(keyed.access_field<3>().value()).value(), 0x11U);
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    static const char Buf[] = {1, 0x01};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    // The key is known, the failure of its alternative is reported as is.
+    Property field;
+    const char *readIter = &Buf[0];
+    auto es = field.read(readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK(readIter == &Buf[0]);
+    BOOST_CHECK_EQUAL(field.current_field(), std::tuple_size<PropMembers>::value);
+
+    readIter = &Buf[0];
+    es = field.read(readIter, 1U);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_enough_data);
+
+    // The plain variant falls through to the "catch all" alternative.
+    auto plain = read_property<PlainProperty>(&Buf[0], BufSize, 2U);
+    BOOST_CHECK_EQUAL(plain.current_field(), 3U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,202 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_msg_budget_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/msg_budget.hpp>
+#include <nil/network/marshalling/msg_factory.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+typedef Message2<BeMsgBase> BeMsg2;
+
+struct StackBudgetTag { };
+struct FactoryBudgetTag { };
+struct AllocBudgetTag { };
+
+struct AllocInterface {
+    virtual ~AllocInterface() noexcept = default;
+};
+
+struct ThrowingObject : public AllocInterface {
+    explicit ThrowingObject(bool mustThrow) {
+        if (mustThrow) {
+            throw std::runtime_error("construction failure");
+        }
+    }
+};
+
+typedef nil::marshalling::protocol::msg_size_layer<
+    nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>>,
+    nil::marshalling::protocol::msg_id_layer<
+        nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>,
+        BeMsgBase, all_messages_type<BeMsgBase>, nil::marshalling::protocol::msg_data_layer<>,
+        nil::marshalling::option::budgeted_allocation<StackBudgetTag>>>
+    ProtocolStack;
+
+typedef nil::marshalling::msg_factory<BeMsgBase, all_messages_type<BeMsgBase>,
+                                      nil::marshalling::option::budgeted_allocation<FactoryBudgetTag>>
+    Factory;
+
+BOOST_AUTO_TEST_SUITE(msg_budget_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    auto &budget = nil::marshalling::global_msg_memory_budget<FactoryBudgetTag>();
+    budget.set_limits(0U, 2U);
+
+    Factory factory;
+    auto msg1 = factory.create_msg(MessageType1);
+    auto msg2 = factory.create_msg(MessageType2);
+    BOOST_REQUIRE(msg1);
+    BOOST_REQUIRE(msg2);
+    BOOST_CHECK(!factory.create_msg(MessageType1));
+    BOOST_CHECK_EQUAL(budget.in_flight_msgs(), 2U);
+    BOOST_CHECK_EQUAL(budget.in_flight_bytes(), sizeof(BeMsg1) + sizeof(BeMsg2));
+
+    msg1.reset();
+    BOOST_CHECK_EQUAL(budget.in_flight_bytes(), sizeof(BeMsg2));
+    msg1 = factory.create_msg(MessageType1);
+    BOOST_CHECK(msg1);
+
+    msg1.reset();
+    msg2.reset();
+    budget.set_limits(sizeof(BeMsg1) - 1U, 0U);
+    BOOST_CHECK(!factory.create_msg(MessageType1));
+
+    auto stats = budget.statistics();
+    BOOST_CHECK_EQUAL(stats.in_flight_msgs, 0U);
+    BOOST_CHECK_EQUAL(stats.in_flight_bytes, 0U);
+    BOOST_CHECK_EQUAL(stats.high_water_msgs, 2U);
+    BOOST_CHECK_EQUAL(stats.high_water_bytes, sizeof(BeMsg1) + sizeof(BeMsg2));
+    BOOST_CHECK_EQUAL(stats.admitted, 3U);
+    BOOST_CHECK_EQUAL(stats.rejected, 2U);
+
+    budget.reset_statistics();
+    stats = budget.statistics();
+    BOOST_CHECK_EQUAL(stats.high_water_msgs, 0U);
+    BOOST_CHECK_EQUAL(stats.rejected, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02, 0x0, 0x1, MessageType2};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+    static const std::size_t Frame1Size = 5U;
+
+    auto &budget = nil::marshalling::global_msg_memory_budget<StackBudgetTag>();
+    budget.set_limits(0U, 1U);
+
+    ProtocolStack stack;
+    ProtocolStack::msg_ptr_type held;
+    const char *readIter = &Buf[0];
+    auto es = stack.read(held, readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE(held);
+
+    // The budget is exhausted, the frame is postponed.
+    nil::marshalling::deferred_frame_queue deferred(64U);
+    ProtocolStack::msg_ptr_type msg;
+    auto *frameStart = readIter;
+    es = stack.read(msg, readIter, BufSize - Frame1Size);
+    BOOST_CHECK(es == nil::marshalling::status_type::msg_alloc_failure);
+    BOOST_CHECK(!msg);
+    BOOST_CHECK_EQUAL(readIter, &Buf[BufSize]);
+    auto frameLen = static_cast<std::size_t>(std::distance(frameStart, readIter));
+    BOOST_CHECK(deferred.push(reinterpret_cast<const std::uint8_t *>(frameStart), frameLen));
+    BOOST_CHECK_EQUAL(deferred.size(), 1U);
+
+    held.reset();
+    std::vector<std::uint8_t> frame(deferred.front_length());
+    BOOST_CHECK_EQUAL(deferred.pop(&frame[0]), frameLen);
+    BOOST_CHECK(deferred.empty());
+
+    readIter = reinterpret_cast<const char *>(&frame[0]);
+    es = stack.read(msg, readIter, frame.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK_EQUAL(msg->get_id(), MessageType2);
+    BOOST_CHECK_EQUAL(budget.statistics().rejected, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    nil::marshalling::deferred_frame_queue deferred(16U);
+    static const std::uint8_t Frame[] = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6};
+
+    BOOST_CHECK(deferred.push(&Frame[0], 6U));
+    BOOST_CHECK(!deferred.push(&Frame[0], 6U));
+    BOOST_CHECK_EQUAL(deferred.occupied(), 10U);
+
+    std::uint8_t out[8] = {0};
+    BOOST_CHECK_EQUAL(deferred.pop(&out[0]), 6U);
+    BOOST_CHECK(std::equal(&Frame[0], &Frame[6], &out[0]));
+
+    // Wraps around the end of the storage.
+    BOOST_CHECK(deferred.push(&Frame[0], 6U));
+    BOOST_CHECK(deferred.push(&Frame[0], 2U));
+    BOOST_CHECK_EQUAL(deferred.pop(&out[0]), 6U);
+    BOOST_CHECK(std::equal(&Frame[0], &Frame[6], &out[0]));
+    BOOST_CHECK_EQUAL(deferred.pop(&out[0]), 2U);
+    BOOST_CHECK(deferred.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    typedef nil::marshalling::processing::alloc::budgeted_dyn_memory<AllocInterface, AllocBudgetTag> Allocator;
+    auto &budget = Allocator::budget();
+    budget.set_limits(0U, 1U);
+
+    // The budget acquired for the failed construction is released.
+    BOOST_CHECK_THROW(Allocator::alloc<ThrowingObject>(true), std::runtime_error);
+    BOOST_CHECK_THROW(Allocator::alloc<ThrowingObject>(true), std::runtime_error);
+    BOOST_CHECK_EQUAL(budget.in_flight_msgs(), 0U);
+    BOOST_CHECK_EQUAL(budget.in_flight_bytes(), 0U);
+
+    auto obj = Allocator::alloc<ThrowingObject>(false);
+    BOOST_CHECK(obj);
+    BOOST_CHECK_EQUAL(budget.in_flight_bytes(), sizeof(ThrowingObject));
+    obj.reset();
+    BOOST_CHECK_EQUAL(budget.in_flight_msgs(), 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
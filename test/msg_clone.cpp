@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_msg_clone_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+#include <nil/network/marshalling/msg_budget.hpp>
+#include <nil/network/marshalling/msg_factory.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef Message1<BeMsgBase> BeMsg1;
+typedef Message2<BeMsgBase> BeMsg2;
+typedef Message3<BeMsgBase> BeMsg3;
+
+class DerivedMsg1 : public BeMsg1 { };
+
+struct CloneBudgetTag { };
+
+typedef nil::marshalling::msg_factory<BeMsgBase, all_messages_type<BeMsgBase>> Factory;
+
+typedef nil::marshalling::msg_factory<BeMsgBase, all_messages_type<BeMsgBase>,
+                                      nil::marshalling::option::budgeted_allocation<CloneBudgetTag>>
+    BudgetedFactory;
+
+typedef nil::marshalling::msg_factory<BeMsgBase, all_messages_type<BeMsgBase>,
+                                      nil::marshalling::option::in_place_pool_allocation<2>>
+    PoolFactory;
+
+BOOST_AUTO_TEST_SUITE(msg_clone_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    Factory factory;
+    BeMsg1 msg;
+    std::get<0>(msg.fields()).value() = 0x0102;
+
+    auto clone = factory.clone(msg);
+    BOOST_REQUIRE(clone);
+    BOOST_CHECK_EQUAL(clone->get_id(), MessageType1);
+    auto &clonedMsg = static_cast<BeMsg1 &>(*clone);
+    BOOST_CHECK_EQUAL(std::get<0>(clonedMsg.fields()).value(), 0x0102);
+
+    std::get<0>(msg.fields()).value() = 0x0304;
+    BOOST_CHECK_EQUAL(std::get<0>(clonedMsg.fields()).value(), 0x0102);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    Factory factory;
+    auto msg = factory.create_msg(MessageType3);
+    BOOST_REQUIRE(msg);
+    auto &msg3 = static_cast<BeMsg3 &>(*msg);
+    std::get<0>(msg3.fields()).value() = 0x01020304;
+    std::get<1>(msg3.fields()).value() = 5;
+
+    const BeMsgBase &base = *msg;
+    auto clone = factory.clone(base);
+    BOOST_REQUIRE(clone);
+    BOOST_CHECK_EQUAL(clone->get_id(), MessageType3);
+    auto &clonedMsg = static_cast<BeMsg3 &>(*clone);
+    BOOST_CHECK_EQUAL(std::get<0>(clonedMsg.fields()).value(), 0x01020304U);
+    BOOST_CHECK_EQUAL(std::get<1>(clonedMsg.fields()).value(), 5);
+
+    BOOST_CHECK(!factory.clone(base, 1U));
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    Factory factory;
+    DerivedMsg1 msg;
+    std::get<0>(msg.fields()).value() = 0x0a0b;
+
+    // Reports the ID of BeMsg1, but is not BeMsg1 itself.
+    const BeMsgBase &base = msg;
+    BOOST_CHECK(!factory.clone(base));
+
+    BeMsg1 exactMsg(msg);
+    auto clone = factory.clone(static_cast<const BeMsgBase &>(exactMsg));
+    BOOST_REQUIRE(clone);
+    BOOST_CHECK_EQUAL(std::get<0>(static_cast<BeMsg1 &>(*clone).fields()).value(), 0x0a0b);
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    auto &budget = nil::marshalling::global_msg_memory_budget<CloneBudgetTag>();
+    budget.set_limits(0U, 2U);
+
+    BudgetedFactory factory;
+    auto msg = factory.create_msg(MessageType2);
+    BOOST_REQUIRE(msg);
+
+    auto clone = factory.clone(static_cast<const BeMsgBase &>(*msg));
+    BOOST_REQUIRE(clone);
+    BOOST_CHECK_EQUAL(budget.in_flight_msgs(), 2U);
+    BOOST_CHECK_EQUAL(budget.in_flight_bytes(), 2U * sizeof(BeMsg2));
+
+    // The clones are subject to the same budget.
+    BOOST_CHECK(!factory.clone(static_cast<const BeMsg2 &>(*msg)));
+
+    clone.reset();
+    msg.reset();
+    BOOST_CHECK_EQUAL(budget.in_flight_msgs(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test5) {
+    PoolFactory factory;
+    auto msg = factory.create_msg(MessageType1);
+    BOOST_REQUIRE(msg);
+    std::get<0>(static_cast<BeMsg1 &>(*msg).fields()).value() = 0x0506;
+
+    auto clone = factory.clone(static_cast<const BeMsgBase &>(*msg));
+    BOOST_REQUIRE(clone);
+    BOOST_CHECK(clone.get() != msg.get());
+    BOOST_CHECK_EQUAL(std::get<0>(static_cast<BeMsg1 &>(*clone).fields()).value(), 0x0506);
+
+    // Both pool elements are occupied.
+    BOOST_CHECK(!factory.clone(static_cast<const BeMsg1 &>(*msg)));
+    BOOST_CHECK(!factory.create_msg(MessageType2));
+
+    auto *released = clone.get();
+    clone.reset();
+    auto otherClone = factory.clone(static_cast<const BeMsg1 &>(*msg));
+    BOOST_REQUIRE(otherClone);
+    BOOST_CHECK(otherClone.get() == released);
+    BOOST_CHECK_EQUAL(std::get<0>(static_cast<BeMsg1 &>(*otherClone).fields()).value(), 0x0506);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_priority_dispatch_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/generic_handler.hpp>
+#include <nil/network/marshalling/priority_dispatch.hpp>
+
+class TestHandler;
+
+typedef nil::marshalling::message<nil::marshalling::option::msg_id_type<message_type>,
+                                  nil::marshalling::option::handler<TestHandler>,
+                                  nil::marshalling::option::id_info_interface, nil::marshalling::option::big_endian>
+    HandlerMsgBase;
+
+typedef HandlerMsgBase::field_type BeField;
+
+template<typename TField>
+using KeyedFields = std::tuple<nil::marshalling::types::integral<TField, std::uint16_t>>;
+
+template<typename TMessage>
+class SnapshotMsg
+    : public nil::marshalling::message_base<TMessage, nil::marshalling::option::static_num_id_impl<MessageType1>,
+                                            nil::marshalling::option::fields_impl<KeyedFields<BeField>>,
+                                            nil::marshalling::option::msg_type<SnapshotMsg<TMessage>>> { };
+
+template<typename TMessage>
+class CancelMsg
+    : public nil::marshalling::message_base<TMessage, nil::marshalling::option::static_num_id_impl<MessageType2>,
+                                            nil::marshalling::option::fields_impl<KeyedFields<BeField>>,
+                                            nil::marshalling::option::msg_type<CancelMsg<TMessage>>,
+                                            nil::marshalling::option::dispatch_priority<10>> { };
+
+template<typename TMessage>
+class RiskMsg
+    : public nil::marshalling::message_base<TMessage, nil::marshalling::option::static_num_id_impl<MessageType3>,
+                                            nil::marshalling::option::zero_fields_impl,
+                                            nil::marshalling::option::msg_type<RiskMsg<TMessage>>,
+                                            nil::marshalling::option::dispatch_priority<5>> { };
+
+typedef SnapshotMsg<HandlerMsgBase> Snapshot;
+typedef CancelMsg<HandlerMsgBase> Cancel;
+typedef RiskMsg<HandlerMsgBase> Risk;
+
+typedef std::tuple<Snapshot, Cancel, Risk> AllMessages;
+
+class TestHandler : public nil::marshalling::generic_handler<HandlerMsgBase, AllMessages> {
+public:
+    virtual void handle(Snapshot &msg) override {
+        order_ += 'S';
+        order_ += static_cast<char>('0' + std::get<0>(msg.fields()).value());
+    }
+
+    virtual void handle(Cancel &msg) override {
+        order_ += 'C';
+        order_ += static_cast<char>('0' + std::get<0>(msg.fields()).value());
+    }
+
+    virtual void handle(Risk &msg) override {
+        static_cast<void>(msg);
+        order_ += 'R';
+    }
+
+    std::string order_;
+};
+
+struct KeyOf {
+    using key_type = std::uint16_t;
+
+    bool operator()(const HandlerMsgBase &msg, key_type &key) const {
+        if (msg.get_id() == MessageType1) {
+            key = std::get<0>(static_cast<const Snapshot &>(msg).fields()).value();
+            return true;
+        }
+
+        if (msg.get_id() == MessageType2) {
+            key = std::get<0>(static_cast<const Cancel &>(msg).fields()).value();
+            return true;
+        }
+
+        return false;
+    }
+};
+
+using MsgPtr = std::unique_ptr<HandlerMsgBase>;
+
+template<typename TMsg>
+MsgPtr make_msg(std::uint16_t key = 0U) {
+    std::unique_ptr<TMsg> msg(new TMsg);
+    std::get<0>(msg->fields()).value() = key;
+    return MsgPtr(std::move(msg));
+}
+
+template<>
+MsgPtr make_msg<Risk>(std::uint16_t) {
+    return MsgPtr(new Risk);
+}
+
+BOOST_AUTO_TEST_SUITE(priority_dispatch_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static_assert(nil::marshalling::message_dispatch_priority<Snapshot>() == 0, "Invalid priority");
+    static_assert(nil::marshalling::message_dispatch_priority<Cancel>() == 10, "Invalid priority");
+    static_assert(nil::marshalling::message_dispatch_priority<Risk>() == 5, "Invalid priority");
+
+    using Dispatcher = nil::marshalling::priority_batch_dispatcher<MsgPtr, AllMessages>;
+    BOOST_CHECK_EQUAL(Dispatcher::priority(Cancel()), 10);
+    BOOST_CHECK_EQUAL(Dispatcher::priority(Snapshot()), 0);
+
+    Dispatcher dispatcher;
+    dispatcher.push(make_msg<Snapshot>(1U));
+    dispatcher.push(make_msg<Snapshot>(2U));
+    dispatcher.push(make_msg<Cancel>(3U));
+    dispatcher.push(make_msg<Risk>());
+    dispatcher.push(make_msg<Cancel>(4U));
+    dispatcher.push(MsgPtr());
+    BOOST_CHECK_EQUAL(dispatcher.size(), 5U);
+
+    TestHandler handler;
+    BOOST_CHECK_EQUAL(dispatcher.dispatch(handler), 5U);
+    BOOST_CHECK_EQUAL(handler.order_, "C3C4RS1S2");
+    BOOST_CHECK(dispatcher.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    nil::marshalling::priority_batch_dispatcher<MsgPtr, AllMessages, KeyOf> dispatcher;
+    dispatcher.push(make_msg<Snapshot>(1U));
+    dispatcher.push(make_msg<Snapshot>(2U));
+    dispatcher.push(make_msg<Risk>());
+    dispatcher.push(make_msg<Cancel>(1U));
+    dispatcher.push(make_msg<Snapshot>(1U));
+
+    TestHandler handler;
+    dispatcher.dispatch(handler);
+    BOOST_CHECK_EQUAL(handler.order_, "S1C1RS2S1");
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    nil::marshalling::priority_batch_dispatcher<MsgPtr, AllMessages> dispatcher;
+    dispatcher.push(make_msg<Snapshot>(1U));
+    dispatcher.push(make_msg<Cancel>(2U));
+
+    std::vector<MsgPtr> drained;
+    BOOST_CHECK_EQUAL(dispatcher.drain([&drained](MsgPtr &&msg) { drained.push_back(std::move(msg)); }), 2U);
+    BOOST_REQUIRE_EQUAL(drained.size(), 2U);
+    BOOST_CHECK(drained[0]->get_id() == MessageType2);
+    BOOST_CHECK(drained[1]->get_id() == MessageType1);
+    BOOST_CHECK(dispatcher.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,200 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_speculative_dispatch_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/generic_handler.hpp>
+#include <nil/network/marshalling/protocol/checksum_layer.hpp>
+#include <nil/network/marshalling/protocol/checksum/basic_sum.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/speculative_dispatch.hpp>
+
+class TestHandler;
+
+typedef nil::marshalling::message<nil::marshalling::option::msg_id_type<message_type>,
+                                  nil::marshalling::option::handler<TestHandler>,
+                                  nil::marshalling::option::id_info_interface, nil::marshalling::option::big_endian,
+                                  nil::marshalling::option::read_iterator<const char *>,
+                                  nil::marshalling::option::length_info_interface>
+    HandlerMsgBase;
+
+typedef HandlerMsgBase::field_type BeField;
+
+typedef Message1<HandlerMsgBase> HandlerMsg1;
+typedef Message2<HandlerMsgBase> HandlerMsg2;
+typedef Message3<HandlerMsgBase> HandlerMsg3;
+
+typedef std::tuple<HandlerMsg1, HandlerMsg2, HandlerMsg3> HandlerAllMessages;
+
+class TestHandler : public nil::marshalling::generic_handler<HandlerMsgBase, HandlerAllMessages> {
+    using Base = nil::marshalling::generic_handler<HandlerMsgBase, HandlerAllMessages>;
+
+public:
+    using Base::handle;
+
+    virtual void handle(HandlerMsgBase &msg) override {
+        static_cast<void>(msg);
+        ++handled_;
+    }
+
+    std::size_t handled_ = 0U;
+};
+
+class SpeculativeHandler : public TestHandler {
+public:
+    using speculative_tag = void;
+
+    void confirm(HandlerMsgBase &msg) {
+        static_cast<void>(msg);
+        ++confirmed_;
+    }
+
+    void retract(HandlerMsgBase &msg) {
+        static_cast<void>(msg);
+        ++retracted_;
+    }
+
+    std::size_t confirmed_ = 0U;
+    std::size_t retracted_ = 0U;
+};
+
+static_assert(nil::marshalling::is_speculative_handler<SpeculativeHandler>(), "Invalid handler");
+static_assert(!nil::marshalling::is_speculative_handler<TestHandler>(), "Invalid handler");
+
+typedef nil::marshalling::types::integral<BeField, std::uint8_t> ChecksumField;
+typedef nil::marshalling::types::integral<BeField, std::uint16_t> SizeField;
+typedef nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>> IdField;
+
+typedef nil::marshalling::protocol::checksum_layer<
+    ChecksumField, nil::marshalling::protocol::checksum::basic_sum<>,
+    nil::marshalling::protocol::msg_size_layer<
+        SizeField, nil::marshalling::protocol::msg_id_layer<IdField, HandlerMsgBase, HandlerAllMessages,
+                                                            nil::marshalling::protocol::msg_data_layer<>>>,
+    nil::marshalling::option::checksum_layer_speculative_read>
+    Stack;
+
+typedef nil::marshalling::protocol::checksum_layer<
+    ChecksumField, nil::marshalling::protocol::checksum::basic_sum<>,
+    nil::marshalling::protocol::msg_size_layer<
+        SizeField, nil::marshalling::protocol::msg_id_layer<IdField, HandlerMsgBase, HandlerAllMessages,
+                                                            nil::marshalling::protocol::msg_data_layer<>>>>
+    PlainStack;
+
+static_assert(sizeof(PlainStack) < sizeof(Stack), "The pending verification state must be stored only when used");
+
+BOOST_AUTO_TEST_SUITE(speculative_dispatch_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02, 0x06};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    Stack stack;
+    Stack::msg_ptr_type msg;
+    SpeculativeHandler handler;
+    const char *readIter = &Buf[0];
+    auto es = nil::marshalling::speculative_dispatch(stack, stack, msg, readIter, BufSize, handler);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(msg);
+    BOOST_CHECK_EQUAL(handler.handled_, 1U);
+    BOOST_CHECK_EQUAL(handler.confirmed_, 1U);
+    BOOST_CHECK_EQUAL(handler.retracted_, 0U);
+    BOOST_CHECK(!stack.is_verification_pending());
+    BOOST_CHECK(readIter == &Buf[0] + BufSize);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02, 0x07};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    Stack stack;
+    Stack::msg_ptr_type msg;
+    SpeculativeHandler handler;
+    const char *readIter = &Buf[0];
+    auto es = nil::marshalling::speculative_dispatch(stack, stack, msg, readIter, BufSize, handler);
+    BOOST_CHECK(es == nil::marshalling::status_type::protocol_error);
+    BOOST_CHECK(!msg);
+    BOOST_CHECK_EQUAL(handler.handled_, 1U);
+    BOOST_CHECK_EQUAL(handler.confirmed_, 0U);
+    BOOST_CHECK_EQUAL(handler.retracted_, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02, 0x07};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    Stack stack;
+    Stack::msg_ptr_type msg;
+    TestHandler handler;
+    const char *readIter = &Buf[0];
+    auto es = nil::marshalling::speculative_dispatch(stack, stack, msg, readIter, BufSize, handler);
+    BOOST_CHECK(es == nil::marshalling::status_type::protocol_error);
+    BOOST_CHECK(!msg);
+    BOOST_CHECK_EQUAL(handler.handled_, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    Stack stack;
+    Stack::msg_ptr_type msg;
+    SpeculativeHandler handler;
+    const char *readIter = &Buf[0];
+    auto es = nil::marshalling::speculative_dispatch(stack, stack, msg, readIter, BufSize, handler);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK_EQUAL(handler.handled_, 0U);
+    BOOST_CHECK(!stack.is_verification_pending());
+}
+
+BOOST_AUTO_TEST_CASE(test5) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02, 0x07, 0x0, 0x3, MessageType1, 0x01, 0x02, 0x06};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+    static const std::size_t FrameSize = BufSize / 2U;
+
+    Stack stack;
+    Stack::msg_ptr_type msg;
+    const char *readIter = &Buf[0];
+    auto es = stack.read(msg, readIter, FrameSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(stack.is_verification_pending());
+
+    // The next read discards the pending verification of the previous one.
+    es = stack.read(msg, readIter, FrameSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(stack.is_verification_pending());
+    BOOST_CHECK(stack.verify_pending());
+    BOOST_CHECK(!stack.is_verification_pending());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
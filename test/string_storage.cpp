@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_string_storage_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/marshalling/types/string.hpp>
+#include <nil/network/marshalling/string_storage.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+
+typedef nil::marshalling::types::integral<BeField, std::uint8_t> SizePrefix;
+typedef nil::marshalling::view_string_field<BeField, SizePrefix> ViewString;
+typedef nil::marshalling::inline_string_field<BeField, SizePrefix, 8U> InlineString;
+typedef nil::marshalling::types::string<BeField, nil::marshalling::option::sequence_size_field_prefix<SizePrefix>>
+    OwningString;
+
+template<typename TMessage>
+class StringsMessage
+    : public nil::marshalling::message_base<TMessage, nil::marshalling::option::static_num_id_impl<MessageType1>,
+                                            nil::marshalling::option::fields_impl<std::tuple<ViewString, InlineString>>,
+                                            nil::marshalling::option::msg_type<StringsMessage<TMessage>>> {
+
+    using Base
+        = nil::marshalling::message_base<TMessage, nil::marshalling::option::static_num_id_impl<MessageType1>,
+                                         nil::marshalling::option::fields_impl<std::tuple<ViewString, InlineString>>,
+                                         nil::marshalling::option::msg_type<StringsMessage<TMessage>>>;
+
+public:
+    MARSHALLING_MSG_FIELDS_ACCESS(symbol, account);
+
+    static const std::size_t MsgMinLen = Base::eval_min_length();
+    static_assert(MsgMinLen == 2U, "Wrong serialization length");
+};
+
+typedef StringsMessage<BeMsgBase> BeStringsMsg;
+
+BOOST_AUTO_TEST_SUITE(string_storage_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static const char Buf[] = {0x3, 'a', 'b', 'c', 0x2, 'x', 'y'};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    ViewString field;
+    const char *readIter = &Buf[0];
+    auto es = field.read(readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(field.length(), 4U);
+    BOOST_CHECK_EQUAL(field.value().size(), 3U);
+    BOOST_CHECK(&(*field.value().begin()) == &Buf[1]);    // Refers to the input buffer
+    BOOST_CHECK_EQUAL(readIter, &Buf[4]);
+
+    std::string copy = nil::marshalling::string_copy_out(field);
+    BOOST_CHECK_EQUAL(copy, "abc");
+
+    char copyBuf[2] = {0};
+    BOOST_CHECK_EQUAL(nil::marshalling::string_copy_out(field, &copyBuf[0], sizeof(copyBuf)), 2U);
+    BOOST_CHECK(std::equal(&copyBuf[0], &copyBuf[2], "ab"));
+
+    std::vector<char> outBuf(field.length());
+    char *writeIter = &outBuf[0];
+    es = field.write(writeIter, outBuf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(std::equal(outBuf.begin(), outBuf.end(), &Buf[0]));
+
+    readIter = &Buf[0];
+    es = field.read(readIter, 3U);
+    BOOST_CHECK(es == nil::marshalling::status_type::not_enough_data);
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    static const char Buf[] = {0x9, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 0x2, 'x', 'y'};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    InlineString field;
+    const char *readIter = &Buf[0];
+    auto es = field.read(readIter, BufSize);
+    BOOST_CHECK(es != nil::marshalling::status_type::success);
+
+    readIter = &Buf[10];
+    es = field.read(readIter, 3U);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(nil::marshalling::string_copy_out(field), "xy");
+    BOOST_CHECK(&(*field.value().begin()) != &Buf[11]);    // Copied into the field
+
+    OwningString owning;
+    readIter = &Buf[10];
+    es = owning.read(readIter, 3U);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(nil::marshalling::string_copy_out(owning), "xy");
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const char Buf[] = {0x4, 'A', 'A', 'P', 'L', 0x3, 'a', 'c', '1'};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    BeStringsMsg msg;
+    const char *readIter = &Buf[0];
+    auto es = msg.read(readIter, BufSize);
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(nil::marshalling::string_copy_out(msg.field_symbol()), "AAPL");
+    BOOST_CHECK_EQUAL(nil::marshalling::string_copy_out(msg.field_account()), "ac1");
+    BOOST_CHECK_EQUAL(msg.length(), BufSize);
+
+    std::vector<char> outBuf(msg.length());
+    char *writeIter = &outBuf[0];
+    es = msg.write(writeIter, outBuf.size());
+    BOOST_CHECK(es == nil::marshalling::status_type::success);
+    BOOST_CHECK(std::equal(outBuf.begin(), outBuf.end(), &Buf[0]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
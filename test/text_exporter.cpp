@@ -0,0 +1,147 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_text_exporter_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/text_exporter.hpp>
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::valid_check_interface, nil::marshalling::option::length_info_interface>
+    common_options;
+
+typedef std::tuple<nil::marshalling::option::big_endian, nil::marshalling::option::write_iterator<char *>,
+                   common_options>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+typedef Message3<BeMsgBase> BeMsg3;
+
+class DerivedMsg3 : public BeMsg3 { };
+
+using BeSizeField
+    = nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>>;
+using BeIdField
+    = nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>;
+
+using ProtocolStack = nil::marshalling::protocol::msg_size_layer<
+    BeSizeField, nil::marshalling::protocol::msg_id_layer<BeIdField, BeMsgBase, all_messages_type<BeMsgBase>,
+                                                          nil::marshalling::protocol::msg_data_layer<>>>;
+
+static std::string to_string(const nil::marshalling::text_buffer &buf) {
+    return std::string(buf.data(), buf.size());
+}
+
+BOOST_AUTO_TEST_SUITE(text_exporter_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    BeMsg1 msg;
+    msg.field_value1().value() = 0x0102;
+
+    nil::marshalling::text_buffer buf(16);
+    nil::marshalling::write_csv_header<BeMsg1>(buf);
+    nil::marshalling::write_text(msg, buf, nil::marshalling::csv_text_format());
+    BOOST_CHECK_EQUAL(to_string(buf), "msg,\"value1\"\n\"Message1\",258\n");
+
+    buf.clear();
+    nil::marshalling::write_text(msg, buf, nil::marshalling::json_text_format());
+    BOOST_CHECK_EQUAL(to_string(buf), "{\"msg\":\"Message1\",\"value1\":258}\n");
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    BeMsg3 msg;
+    msg.field_value1().value() = 0xffffffff;
+    msg.field_value2().value() = -100;
+    msg.field_value3().value() = 0;
+    msg.field_value4().value() = 7;
+
+    nil::marshalling::text_buffer buf(8);
+    const BeMsgBase &msgBase = msg;
+    bool written = nil::marshalling::write_text_polymorphic<all_messages_type<BeMsgBase>>(
+        msgBase, buf, nil::marshalling::json_text_format());
+    BOOST_CHECK(written);
+    BOOST_CHECK_EQUAL(to_string(buf),
+                      "{\"msg\":\"Message3\",\"value1\":4294967295,\"value2\":-100,\"value3\":0,\"value4\":7}\n");
+    BOOST_CHECK_LE(buf.size(), buf.capacity());
+
+    // Reports the ID of Message3, but is not of any listed type.
+    DerivedMsg3 derivedMsg;
+    buf.clear();
+    written = nil::marshalling::write_text_polymorphic<all_messages_type<BeMsgBase>>(
+        static_cast<const BeMsgBase &>(derivedMsg), buf, nil::marshalling::json_text_format());
+    BOOST_CHECK(!written);
+    BOOST_CHECK_EQUAL(buf.size(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02,                                      // frame 1
+                               0x0, 0x3, MessageType1, 0x00, 0x05,                                      // frame 2
+                               0x0, 0x1, MessageType2,                                                  // frame 3
+                               0x0, 0xb, MessageType3, 0x0, 0x0, 0x0, 0x1, 0x2, 0x0, 0x3, 0x0, 0x0, 0x4};    // frame 4
+
+    std::vector<std::pair<const char *, std::size_t>> chunks
+        = {std::make_pair(&Buf[0], std::size_t(10)), std::make_pair(&Buf[10], sizeof(Buf) - 10)};
+
+    nil::marshalling::parallel_text_exporter<ProtocolStack, nil::marshalling::csv_text_format> exporter(2);
+    auto stats = exporter.run(chunks);
+    BOOST_CHECK_EQUAL(stats.bytes, sizeof(Buf));
+    BOOST_CHECK_EQUAL(stats.messages, 4U);
+    BOOST_CHECK_EQUAL(stats.errors, 0U);
+    BOOST_CHECK_EQUAL(to_string(exporter.output(0)), "\"Message1\",258\n\"Message1\",5\n");
+    BOOST_CHECK_EQUAL(to_string(exporter.output(1)), "\"Message2\"\n\"Message3\",1,2,3,4\n");
+
+    // Outputs are reused between runs
+    stats = exporter.run(chunks);
+    BOOST_CHECK_EQUAL(stats.messages, 4U);
+    BOOST_CHECK_EQUAL(to_string(exporter.output(0)), "\"Message1\",258\n\"Message1\",5\n");
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    static const char Buf[] = {0x0, 0x3, MessageType1, 0x01, 0x02, 0x0, 0x3, MessageType1, 0x00};
+
+    std::vector<std::pair<const char *, std::size_t>> chunks = {std::make_pair(&Buf[0], sizeof(Buf))};
+
+    nil::marshalling::parallel_text_exporter<ProtocolStack, nil::marshalling::json_text_format> exporter(1);
+    auto stats = exporter.run(chunks);
+    BOOST_CHECK_EQUAL(stats.bytes, 5U);
+    BOOST_CHECK_EQUAL(stats.messages, 1U);
+    BOOST_CHECK_EQUAL(to_string(exporter.output(0)), "{\"msg\":\"Message1\",\"value1\":258}\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,204 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_trace_test
+
+#define MARSHALLING_TRACING
+
+#include "test_common.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/generic_handler.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/trace.hpp>
+
+class TestHandler;
+
+typedef nil::marshalling::message<nil::marshalling::option::msg_id_type<message_type>,
+                                  nil::marshalling::option::handler<TestHandler>,
+                                  nil::marshalling::option::id_info_interface, nil::marshalling::option::big_endian,
+                                  nil::marshalling::option::read_iterator<const char *>,
+                                  nil::marshalling::option::length_info_interface>
+    HandlerMsgBase;
+
+typedef HandlerMsgBase::field_type BeField;
+
+typedef std::tuple<Message1<HandlerMsgBase>, Message2<HandlerMsgBase>, Message3<HandlerMsgBase>> HandlerAllMessages;
+
+class TestHandler : public nil::marshalling::generic_handler<HandlerMsgBase, HandlerAllMessages> {
+    using Base = nil::marshalling::generic_handler<HandlerMsgBase, HandlerAllMessages>;
+
+public:
+    using Base::handle;
+
+    virtual void handle(HandlerMsgBase &msg) override {
+        static_cast<void>(msg);
+        ++handled_;
+    }
+
+    std::size_t handled_ = 0U;
+};
+
+using SizeField = nil::marshalling::types::integral<BeField, std::uint16_t>;
+
+using IdField = nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<2>>;
+
+using Stack = nil::marshalling::protocol::msg_size_layer<
+    SizeField, nil::marshalling::protocol::msg_id_layer<IdField, HandlerMsgBase, HandlerAllMessages,
+                                                        nil::marshalling::protocol::msg_data_layer<>>>;
+
+std::size_t count_spans(const std::string &trace, const std::string &name) {
+    auto pattern = "\"name\":\"" + name + "\"";
+    std::size_t count = 0U;
+    for (auto pos = trace.find(pattern); pos != std::string::npos; pos = trace.find(pattern, pos + 1U)) {
+        ++count;
+    }
+    return count;
+}
+
+std::string dump_trace() {
+    std::ostringstream stream;
+    nil::marshalling::trace_registry::instance().write_chrome_trace(stream);
+    return stream.str();
+}
+
+BOOST_AUTO_TEST_SUITE(trace_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    static_assert(std::is_same<decltype(nil::marshalling::trace_name<Stack>()), const char *>::value,
+                  "Invalid trace name type");
+    BOOST_CHECK_EQUAL(std::string(nil::marshalling::trace_name<Stack>()), "msg_size_layer");
+    BOOST_CHECK_EQUAL(std::string(nil::marshalling::trace_name<TestHandler>()), "protocol_layer");
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    static const char Buf[] = {0x0, 0x4, 0x0, MessageType1, 0x01, 0x02};
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    auto &registry = nil::marshalling::trace_registry::instance();
+    registry.clear();
+
+    Stack stack;
+    TestHandler handler;
+    for (std::size_t idx = 0U; idx < 3U; ++idx) {
+        Stack::msg_ptr_type msg;
+        auto iter = &Buf[0];
+        BOOST_CHECK(stack.read(msg, iter, BufSize) == nil::marshalling::status_type::success);
+        BOOST_REQUIRE(msg);
+        msg->dispatch(handler);
+    }
+    BOOST_CHECK_EQUAL(handler.handled_, 3U);
+
+    auto trace = dump_trace();
+    BOOST_CHECK_EQUAL(trace.find("{\"traceEvents\":["), 0U);
+    BOOST_CHECK_EQUAL(count_spans(trace, "msg_size_layer"), 3U);
+    BOOST_CHECK_EQUAL(count_spans(trace, "msg_id_layer"), 3U);
+    BOOST_CHECK_EQUAL(count_spans(trace, "msg_data_layer"), 3U);
+    BOOST_CHECK_EQUAL(count_spans(trace, "factory_allocate"), 3U);
+    BOOST_CHECK_EQUAL(count_spans(trace, "dispatch"), 3U);
+
+    registry.clear();
+    BOOST_CHECK_EQUAL(count_spans(dump_trace(), "dispatch"), 0U);
+
+    registry.enable(false);
+    {
+        MARSHALLING_TRACE_SPAN("disabled");
+    }
+    registry.enable(true);
+    BOOST_CHECK_EQUAL(count_spans(dump_trace(), "disabled"), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    static const std::size_t SpansCount = MARSHALLING_TRACE_RING_CAPACITY + 100U;
+
+    auto &registry = nil::marshalling::trace_registry::instance();
+    registry.clear();
+
+    std::thread first([]() {
+        for (std::size_t idx = 0U; idx < SpansCount; ++idx) {
+            MARSHALLING_TRACE_SPAN("first");
+        }
+    });
+
+    std::thread second([]() {
+        for (std::size_t idx = 0U; idx < 10U; ++idx) {
+            MARSHALLING_TRACE_SPAN("second");
+        }
+    });
+
+    first.join();
+    second.join();
+
+    auto trace = dump_trace();
+    BOOST_CHECK_EQUAL(count_spans(trace, "first"), static_cast<std::size_t>(MARSHALLING_TRACE_RING_CAPACITY));
+    BOOST_CHECK_EQUAL(count_spans(trace, "second"), 10U);
+}
+
+BOOST_AUTO_TEST_CASE(test4) {
+    typedef nil::marshalling::trace_ring<64U> Ring;
+    static const std::uint64_t SpansCount = 200000U;
+
+    Ring ring(1U);
+    std::atomic<bool> done(false);
+    std::thread writer([&ring, &done]() {
+        for (std::uint64_t idx = 0U; idx < SpansCount; ++idx) {
+            ring.push("stress", idx, idx * 3U);
+        }
+        done.store(true);
+    });
+
+    std::size_t torn = 0U;
+    std::vector<nil::marshalling::trace_event> events;
+    while (!done.load()) {
+        events.clear();
+        ring.collect(events);
+        for (auto &event : events) {
+            if (event.end != event.begin * 3U) {
+                ++torn;
+            }
+        }
+    }
+    writer.join();
+
+    BOOST_CHECK_EQUAL(torn, 0U);
+    events.clear();
+    ring.collect(events);
+    BOOST_CHECK_EQUAL(events.size(), 64U);
+    BOOST_CHECK_EQUAL(events.back().begin, SpansCount - 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE marshalling_traffic_test
+
+#include "test_common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/traffic.hpp>
+
+#if MARSHALLING_TRAFFIC_HAS_POSIX
+#include <unistd.h>
+#endif
+
+typedef std::tuple<nil::marshalling::option::msg_id_type<message_type>, nil::marshalling::option::id_info_interface,
+                   nil::marshalling::option::read_iterator<const char *>,
+                   nil::marshalling::option::write_iterator<char *>, nil::marshalling::option::length_info_interface,
+                   nil::marshalling::option::big_endian>
+    BeTraits;
+
+typedef TestMessageBase<BeTraits> BeMsgBase;
+typedef BeMsgBase::field_type BeField;
+typedef Message1<BeMsgBase> BeMsg1;
+typedef Message2<BeMsgBase> BeMsg2;
+typedef std::tuple<BeMsg1, BeMsg2> TrafficMessages;
+
+typedef nil::marshalling::types::integral<BeField, unsigned, nil::marshalling::option::fixed_length<2>> SizeField;
+typedef nil::marshalling::types::enumeration<BeField, message_type, nil::marshalling::option::fixed_length<1>>
+    IdField;
+
+typedef nil::marshalling::protocol::msg_size_layer<
+    SizeField,
+    nil::marshalling::protocol::msg_id_layer<IdField, BeMsgBase, TrafficMessages,
+                                             nil::marshalling::protocol::msg_data_layer<>>>
+    ProtocolStack;
+
+namespace {
+
+    nil::marshalling::frame_pool make_pool(std::size_t count, const std::vector<double> &weights) {
+        ProtocolStack stack;
+        nil::marshalling::frame_pool pool;
+        nil::marshalling::traffic_random rand(12345U);
+        auto es = nil::marshalling::synthesise_frames<TrafficMessages>(stack, pool, count, weights, rand);
+        BOOST_CHECK(es == nil::marshalling::status_type::success);
+        return pool;
+    }
+
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(traffic_test_suite)
+
+BOOST_AUTO_TEST_CASE(test1) {
+    auto pool = make_pool(100U, std::vector<double>());
+    BOOST_CHECK_EQUAL(pool.size(), 100U);
+
+    ProtocolStack stack;
+    std::size_t counts[2] = {0U, 0U};
+    for (std::size_t idx = 0U; idx < pool.size(); ++idx) {
+        ProtocolStack::msg_ptr_type msg;
+        auto *begin = reinterpret_cast<const char *>(pool.data(idx));
+        auto iter = begin;
+        auto es = stack.read(msg, iter, pool.length(idx));
+        BOOST_CHECK(es == nil::marshalling::status_type::success);
+        BOOST_REQUIRE(msg);
+        BOOST_CHECK_EQUAL(static_cast<std::size_t>(iter - begin), pool.length(idx));
+        if (msg->get_id() == MessageType1) {
+            ++counts[0];
+        } else {
+            BOOST_CHECK(msg->get_id() == MessageType2);
+            ++counts[1];
+        }
+    }
+
+    BOOST_CHECK(0U < counts[0]);
+    BOOST_CHECK(0U < counts[1]);
+
+    auto onlyFirst = make_pool(20U, std::vector<double>({1.0, 0.0}));
+    for (std::size_t idx = 0U; idx < onlyFirst.size(); ++idx) {
+        BOOST_CHECK_EQUAL(onlyFirst.length(idx), 5U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test2) {
+    auto pool = make_pool(10U, std::vector<double>());
+    nil::marshalling::frame_capture capture;
+    for (std::size_t idx = 0U; idx < pool.size(); ++idx) {
+        capture.append(1000U * idx, pool.data(idx), pool.length(idx));
+    }
+
+    std::stringstream stream;
+    capture.save(stream);
+
+    nil::marshalling::frame_capture loaded;
+    BOOST_CHECK(loaded.load(stream));
+    BOOST_REQUIRE_EQUAL(loaded.frames.size(), pool.size());
+    BOOST_CHECK(loaded.times == capture.times);
+    for (std::size_t idx = 0U; idx < pool.size(); ++idx) {
+        BOOST_REQUIRE_EQUAL(loaded.frames.length(idx), pool.length(idx));
+        BOOST_CHECK(std::equal(pool.data(idx), pool.data(idx) + pool.length(idx), loaded.frames.data(idx)));
+    }
+
+    auto saved = stream.str();
+    std::stringstream truncated(saved.substr(0U, saved.size() - 1U));
+    nil::marshalling::frame_capture broken;
+    BOOST_CHECK(!broken.load(truncated));
+}
+
+BOOST_AUTO_TEST_CASE(test3) {
+    std::vector<std::uint64_t> mem((nil::marshalling::spsc_frame_ring::header_length() + 64U) / sizeof(std::uint64_t));
+    auto ring = nil::marshalling::spsc_frame_ring::create(mem.data(), mem.size() * sizeof(std::uint64_t));
+    BOOST_CHECK_EQUAL(ring.capacity(), 64U);
+
+    std::vector<std::uint8_t> frame(20U);
+    std::vector<std::uint8_t> received;
+    for (std::size_t iter = 0U; iter < 10U; ++iter) {
+        for (std::size_t idx = 0U; idx < frame.size(); ++idx) {
+            frame[idx] = static_cast<std::uint8_t>(iter + idx);
+        }
+        BOOST_CHECK(ring.try_push(frame.data(), frame.size()));
+
+        auto consumer = nil::marshalling::spsc_frame_ring::attach(mem.data());
+        BOOST_CHECK(consumer.try_pop([&received](const std::uint8_t *data, std::size_t len) {
+            received.assign(data, data + len);
+        }));
+        BOOST_CHECK(received == frame);
+        BOOST_CHECK(!consumer.try_pop([](const std::uint8_t *, std::size_t) {}));
+    }
+
+    BOOST_CHECK(ring.try_push(frame.data(), frame.size()));
+    BOOST_CHECK(!ring.try_push(frame.data(), frame.size() + 30U));
+}
+
+BOOST_AUTO_TEST_CASE(test6) {
+    std::vector<std::uint64_t> mem((nil::marshalling::spsc_frame_ring::header_length() + 64U) / sizeof(std::uint64_t));
+    auto ring = nil::marshalling::spsc_frame_ring::create(mem.data(), mem.size() * sizeof(std::uint64_t));
+    BOOST_CHECK_EQUAL(ring.max_frame_length(), 24U);
+
+    nil::marshalling::ring_sink sink(ring);
+    std::vector<std::uint8_t> received;
+    auto pop = [&received](const std::uint8_t *data, std::size_t len) { received.assign(data, data + len); };
+
+    // Small frames move the ring position off the start, so that the frames below
+    // wrap around the end of the ring at different offsets.
+    std::vector<std::uint8_t> small(8U, 0x5a);
+    BOOST_CHECK(sink.write(small.data(), 0U));
+    BOOST_CHECK(ring.try_pop(pop));
+    BOOST_CHECK(sink.write(small.data(), small.size()));
+    BOOST_CHECK(ring.try_pop(pop));
+    BOOST_CHECK(received == small);
+
+    std::vector<std::uint8_t> large(40U, 0xa5);
+    BOOST_CHECK(!ring.try_push(large.data(), large.size()));
+    BOOST_CHECK(!sink.write(large.data(), large.size()));
+
+    large.resize(ring.max_frame_length());
+    for (std::size_t iter = 0U; iter < 4U; ++iter) {
+        BOOST_CHECK(sink.write(large.data(), large.size()));
+        BOOST_CHECK(ring.try_pop(pop));
+        BOOST_CHECK(received == large);
+        BOOST_CHECK(sink.write(small.data(), small.size()));
+        BOOST_CHECK(ring.try_pop(pop));
+        BOOST_CHECK(received == small);
+    }
+    BOOST_CHECK(!ring.try_pop(pop));
+    BOOST_CHECK_EQUAL(sink.stalls(), 0U);
+}
+
+#if MARSHALLING_TRAFFIC_HAS_POSIX
+
+BOOST_AUTO_TEST_CASE(test4) {
+    auto pool = make_pool(50U, std::vector<double>());
+    int fds[2];
+    BOOST_REQUIRE(::pipe(fds) == 0);
+
+    nil::marshalling::fd_sink sink(fds[1]);
+    auto report = nil::marshalling::traffic_generator::run(pool, sink, 0.0, pool.size());
+    ::close(fds[1]);
+    BOOST_CHECK_EQUAL(report.frames, pool.size());
+    BOOST_CHECK_EQUAL(report.bytes, pool.total_length());
+    BOOST_CHECK_EQUAL(report.failures, 0U);
+
+    std::vector<std::uint8_t> received(pool.total_length() + 1U);
+    std::size_t total = 0U;
+    while (true) {
+        auto result = ::read(fds[0], &received[total], received.size() - total);
+        if (result <= 0) {
+            break;
+        }
+        total += static_cast<std::size_t>(result);
+    }
+    ::close(fds[0]);
+
+    BOOST_REQUIRE_EQUAL(total, pool.total_length());
+    BOOST_CHECK(std::equal(pool.data(0), pool.data(0) + total, received.begin()));
+}
+
+#endif    // #if MARSHALLING_TRAFFIC_HAS_POSIX
+
+BOOST_AUTO_TEST_CASE(test5) {
+    auto pool = make_pool(4U, std::vector<double>());
+
+    struct counting_sink {
+        bool write(const std::uint8_t *, std::size_t len) {
+            bytes_ += len;
+            return true;
+        }
+
+        std::size_t bytes_ = 0U;
+    } sink;
+
+    auto report = nil::marshalling::traffic_generator::run(pool, sink, 2000.0, 100U);
+    BOOST_CHECK_EQUAL(report.frames, 100U);
+    BOOST_CHECK(0.045 <= report.seconds);
+    BOOST_CHECK(report.rate <= 2200.0);
+
+    nil::marshalling::frame_capture capture;
+    for (std::size_t idx = 0U; idx < pool.size(); ++idx) {
+        capture.append(10000000U * idx, pool.data(idx), pool.length(idx));
+    }
+
+    auto replayed = nil::marshalling::traffic_generator::replay(capture, sink, 2.0);
+    BOOST_CHECK_EQUAL(replayed.frames, pool.size());
+    BOOST_CHECK(0.014 <= replayed.seconds);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
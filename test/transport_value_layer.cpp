@@ -88,6 +88,32 @@ using BeforeIdProtocolStack = nil::marshalling::protocol::msg_size_layer<
                    nil::marshalling::protocol::msg_id_layer<IdField, TMessage, all_messages_type<TMessage>,
                                                             nil::marshalling::protocol::msg_data_layer<>>>>;
 
+using FlagsField = nil::marshalling::types::integral<FieldBase, std::uint8_t>;
+
+typedef std::tuple<VersionField, FlagsField> ExtraHeaderTransport;
+
+template<typename TOptions = nil::marshalling::option::empty_option>
+struct ExtraHeaderMessageBase
+    : public nil::marshalling::message<TOptions,
+                                       nil::marshalling::option::extra_transport_fields<ExtraHeaderTransport>> {
+    using Base
+        = nil::marshalling::message<TOptions, nil::marshalling::option::extra_transport_fields<ExtraHeaderTransport>>;
+
+public:
+    MARSHALLING_MSG_TRANSPORT_FIELDS_ACCESS(version, flags);
+};
+
+template<typename TMessage>
+using MemoizedHeaderProtocolStack = nil::marshalling::protocol::msg_size_layer<
+    SizeField,
+    nil::marshalling::protocol::transport_value_layer<
+        VersionField, ExtraHeaderMessageBase<>::TransportFieldIdx_version,
+        nil::marshalling::protocol::transport_value_layer<
+            FlagsField, ExtraHeaderMessageBase<>::TransportFieldIdx_flags,
+            nil::marshalling::protocol::msg_id_layer<IdField, TMessage, all_messages_type<TMessage>,
+                                                     nil::marshalling::protocol::msg_data_layer<>>>,
+        nil::marshalling::option::memoized_header>>;
+
 template<typename TMessage>
 using NoVersionProtocolStack = nil::marshalling::protocol::msg_size_layer<
     SizeField, nil::marshalling::protocol::msg_id_layer<IdField, TMessage, all_messages_type<TMessage>,
@@ -221,4 +247,49 @@ BOOST_AUTO_TEST_CASE(test5) {
     BOOST_CHECK(msgPtr2->transportField_version().value() == 8U);
 }
 
+BOOST_AUTO_TEST_CASE(test6) {
+    static const char Buf[] = {0x0, 0x7, 0x0, 0x4, 0x1, 0x0, MessageType1, 0x01, 0x02};
+    static const char Buf2[] = {0x0, 0x7, 0x0, 0x4, 0x1, 0x0, MessageType1, 0x03, 0x04};
+    static const char Buf3[] = {0x0, 0x7, 0x0, 0x4, 0x2, 0x0, MessageType1, 0x03, 0x04};
+
+    static const std::size_t BufSize = std::extent<decltype(Buf)>::value;
+
+    using MsgBase = ExtraHeaderMessageBase<BeOptions>;
+    using Stack = MemoizedHeaderProtocolStack<MsgBase>;
+
+    Stack stack;
+    auto &memoLayer = stack.next_layer();
+    BOOST_CHECK(stack.length() == 7U);
+    BOOST_CHECK(memoLayer.memo_length == 3U);
+    BOOST_CHECK(!memoLayer.is_memo_valid());
+
+    auto msgPtr = common_read_write_msg_test(stack, &Buf[0], BufSize);
+    BOOST_CHECK(msgPtr);
+    BOOST_CHECK(msgPtr->transportField_version().value() == 4U);
+    BOOST_CHECK(msgPtr->transportField_flags().value() == 1U);
+    BOOST_CHECK(memoLayer.is_memo_valid());
+
+    auto msgPtr2 = common_read_write_msg_test(stack, &Buf2[0], BufSize);
+    BOOST_CHECK(msgPtr2);
+    BOOST_CHECK(msgPtr2->get_id() == MessageType1);
+    BOOST_CHECK(msgPtr2->transportField_version().value() == 4U);
+    BOOST_CHECK(msgPtr2->transportField_flags().value() == 1U);
+    auto &msg2 = dynamic_cast<Message1<MsgBase> &>(*msgPtr2);
+    BOOST_CHECK(std::get<0>(msg2.fields()).value() == 0x0304);
+
+    auto msgPtr3 = common_read_write_msg_test(stack, &Buf3[0], BufSize);
+    BOOST_CHECK(msgPtr3);
+    BOOST_CHECK(msgPtr3->transportField_version().value() == 4U);
+    BOOST_CHECK(msgPtr3->transportField_flags().value() == 2U);
+
+    memoLayer.reset_memo();
+    BOOST_CHECK(!memoLayer.is_memo_valid());
+    auto msgPtr4 = common_read_write_msg_test(stack, &Buf3[0], BufSize);
+    BOOST_CHECK(msgPtr4);
+    BOOST_CHECK(msgPtr4->transportField_flags().value() == 2U);
+    BOOST_CHECK(memoLayer.is_memo_valid());
+
+    common_read_write_msg_test(stack, &Buf[0], 4U, nil::marshalling::status_type::not_enough_data);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,191 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Prints compile time frame size information for the protocol stack.
+//
+// The stack is provided by the header referenced by the
+// MARSHALLING_FRAME_SIZE_REPORT_STACK_HEADER macro, which must define
+// "frame_size_report_stack" type alias in the global namespace. When the
+// macro isn't defined, the report is printed for the built-in example stack.
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <nil/network/marshalling/protocol/frame_size.hpp>
+
+#ifdef MARSHALLING_FRAME_SIZE_REPORT_STACK_HEADER
+#include MARSHALLING_FRAME_SIZE_REPORT_STACK_HEADER
+#else
+
+#include <nil/marshalling/types/enumeration.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/network/marshalling/message.hpp>
+#include <nil/network/marshalling/message_base.hpp>
+#include <nil/network/marshalling/protocol/msg_data_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_id_layer.hpp>
+#include <nil/network/marshalling/protocol/msg_size_layer.hpp>
+
+enum example_msg_id : std::uint8_t { example_msg_id_heartbeat, example_msg_id_quote, example_msg_id_trade };
+
+using example_msg_base
+    = nil::marshalling::message<nil::marshalling::option::msg_id_type<example_msg_id>,
+                                nil::marshalling::option::big_endian, nil::marshalling::option::id_info_interface,
+                                nil::marshalling::option::read_iterator<const std::uint8_t *>,
+                                nil::marshalling::option::write_iterator<std::uint8_t *>,
+                                nil::marshalling::option::length_info_interface>;
+
+using example_field = example_msg_base::field_type;
+
+class example_heartbeat
+    : public nil::marshalling::message_base<example_msg_base,
+                                            nil::marshalling::option::static_num_id_impl<example_msg_id_heartbeat>,
+                                            nil::marshalling::option::zero_fields_impl,
+                                            nil::marshalling::option::msg_type<example_heartbeat>,
+                                            nil::marshalling::option::has_name> {
+public:
+    static const char *eval_name() {
+        return "heartbeat";
+    }
+};
+
+class example_quote
+    : public nil::marshalling::message_base<
+          example_msg_base, nil::marshalling::option::static_num_id_impl<example_msg_id_quote>,
+          nil::marshalling::option::fields_impl<std::tuple<nil::marshalling::types::integral<example_field, std::uint32_t>,
+                                                           nil::marshalling::types::integral<example_field, std::int64_t>,
+                                                           nil::marshalling::types::integral<example_field, std::uint32_t>>>,
+          nil::marshalling::option::msg_type<example_quote>, nil::marshalling::option::has_name> {
+public:
+    static const char *eval_name() {
+        return "quote";
+    }
+};
+
+class example_trade
+    : public nil::marshalling::message_base<
+          example_msg_base, nil::marshalling::option::static_num_id_impl<example_msg_id_trade>,
+          nil::marshalling::option::fields_impl<std::tuple<
+              nil::marshalling::types::integral<example_field, std::uint32_t>,
+              nil::marshalling::types::integral<example_field, std::int64_t>,
+              nil::marshalling::types::integral<example_field, std::uint32_t>,
+              nil::marshalling::types::integral<example_field, std::uint64_t, nil::marshalling::option::var_length<1, 8>>>>,
+          nil::marshalling::option::msg_type<example_trade>, nil::marshalling::option::has_name> {
+public:
+    static const char *eval_name() {
+        return "trade";
+    }
+};
+
+using frame_size_report_stack = nil::marshalling::protocol::msg_size_layer<
+    nil::marshalling::types::integral<example_field, std::uint16_t>,
+    nil::marshalling::protocol::msg_id_layer<
+        nil::marshalling::types::enumeration<example_field, example_msg_id, nil::marshalling::option::fixed_length<1>>,
+        example_msg_base, std::tuple<example_heartbeat, example_quote, example_trade>,
+        nil::marshalling::protocol::msg_data_layer<>>>;
+
+#endif    // #ifdef MARSHALLING_FRAME_SIZE_REPORT_STACK_HEADER
+
+namespace {
+
+    template<typename T>
+    class has_eval_name {
+        template<typename U>
+        static auto test(int) -> decltype(U::eval_name(), std::true_type());
+
+        template<typename>
+        static std::false_type test(...);
+
+    public:
+        static const bool value = decltype(test<T>(0))::value;
+    };
+
+    template<typename TMsg>
+    std::string msg_name(std::true_type) {
+        return TMsg::eval_name();
+    }
+
+    template<typename TMsg>
+    std::string msg_name(std::false_type) {
+        return "<unnamed>";
+    }
+
+    std::string length_str(std::size_t value) {
+        if (value == std::numeric_limits<std::size_t>::max()) {
+            return "unbounded";
+        }
+
+        return std::to_string(value);
+    }
+
+    template<typename TStack>
+    class report_row_printer {
+    public:
+        explicit report_row_printer(std::ostream &out) : out_(out) {
+        }
+
+        template<typename TMsg>
+        void operator()() {
+            out_ << std::left << std::setw(6) << idx_ << std::setw(24)
+                 << msg_name<TMsg>(std::integral_constant<bool, has_eval_name<TMsg>::value>()) << std::right
+                 << std::setw(12) << length_str(nil::marshalling::protocol::frame_min_length<TStack, TMsg>())
+                 << std::setw(12) << length_str(nil::marshalling::protocol::frame_max_length<TStack, TMsg>())
+                 << std::setw(10) << sizeof(TMsg) << '\n';
+            ++idx_;
+        }
+
+    private:
+        std::ostream &out_;
+        std::size_t idx_ = 0;
+    };
+
+}    // namespace
+
+int main() {
+    using stack_type = frame_size_report_stack;
+    using all_messages = typename stack_type::all_messages_type;
+
+    std::cout << "transport length: " << nil::marshalling::protocol::transport_min_length<stack_type>() << " - "
+              << length_str(nil::marshalling::protocol::transport_max_length<stack_type>()) << "\n\n";
+
+    std::cout << std::left << std::setw(6) << "idx" << std::setw(24) << "message" << std::right << std::setw(12)
+              << "min frame" << std::setw(12) << "max frame" << std::setw(10) << "sizeof" << '\n';
+
+    nil::marshalling::processing::tuple_for_each_type<all_messages>(report_row_printer<stack_type>(std::cout));
+
+    std::cout << "\nmin frame length:   " << nil::marshalling::protocol::min_frame_length<stack_type>() << '\n'
+              << "max frame length:   " << length_str(nil::marshalling::protocol::max_frame_length<stack_type>())
+              << '\n'
+              << "max message sizeof: " << nil::marshalling::protocol::max_msg_object_size<all_messages>() << '\n'
+              << "max message align:  " << nil::marshalling::protocol::max_msg_object_alignment<all_messages>()
+              << std::endl;
+
+    return 0;
+}